@@ -0,0 +1,94 @@
+description(
+"Tests Array.prototype.sort with a compare function on arrays with holes, with compare functions that modify the array, and with compare functions that throw, including when they run out of memory."
+);
+
+function numbers(length)
+{
+    var result = [];
+    for (var i = 0; i < length; ++i)
+        result.push((i * 7919) % length);
+    return result;
+}
+
+function byValue(a, b)
+{
+    return a - b;
+}
+
+function isSorted(array, length)
+{
+    for (var i = 1; i < length; ++i) {
+        if (array[i - 1] > array[i])
+            return false;
+    }
+    return true;
+}
+
+// Holes and undefined values go to the end, holes last.
+var holes = [5, , 3, undefined, , 1, undefined, 4];
+holes.sort(byValue);
+shouldBe("holes.length", "8");
+shouldBe("holes.slice(0, 4).join()", "'1,3,4,5'");
+shouldBeTrue("holes[4] === undefined && 4 in holes");
+shouldBeTrue("holes[5] === undefined && 5 in holes");
+shouldBeFalse("6 in holes");
+shouldBeFalse("7 in holes");
+
+var sparse = [];
+sparse[100] = 2;
+sparse[50] = 1;
+sparse[200] = 0;
+sparse.sort(byValue);
+shouldBe("sparse.length", "201");
+shouldBe("sparse.slice(0, 3).join()", "'0,1,2'");
+shouldBeFalse("3 in sparse");
+
+// The sort is stable.
+var records = [];
+for (var i = 0; i < 100; ++i)
+    records.push({ key: i % 3, order: i });
+records.sort(function(a, b) { return a.key - b.key; });
+var stable = true;
+for (var i = 1; i < records.length; ++i) {
+    if (records[i - 1].key == records[i].key && records[i - 1].order > records[i].order)
+        stable = false;
+}
+shouldBeTrue("stable");
+
+// Compare functions that modify the array must not crash the sort, and the
+// values that are written back must be the ones that were sorted.
+var growing = numbers(50);
+growing.sort(function(a, b) { if (growing.length < 1000) growing.push(-1); return a - b; });
+shouldBeTrue("isSorted(growing, 50)");
+
+var shrinking = numbers(50);
+shrinking.sort(function(a, b) { shrinking.length = 0; return a - b; });
+shouldBe("shrinking.length", "0");
+
+var retyped = numbers(50);
+retyped.sort(function(a, b) { retyped[0] = "string"; retyped[1] = 0.5; return a - b; });
+shouldBe("retyped.length", "50");
+shouldBeTrue("isSorted(retyped, 50)");
+
+var punctured = numbers(50);
+punctured.sort(function(a, b) { delete punctured[10]; return a - b; });
+shouldBe("punctured.length", "50");
+shouldBeTrue("isSorted(punctured, 50)");
+
+// If the compare function throws, the array is left as it was.
+var untouched = numbers(50);
+var before = untouched.join();
+var calls = 0;
+shouldThrow("untouched.sort(function(a, b) { if (++calls == 20) throw 'compare failed'; return a - b; })", "'compare failed'");
+shouldBe("untouched.join()", "before");
+
+// Build a rope that is too long to flatten, so that flattening it from inside
+// the compare function runs out of memory.
+var huge = "\u0100";
+for (var i = 0; i < 31; ++i)
+    huge += huge;
+var outOfMemory = numbers(50);
+before = outOfMemory.join();
+calls = 0;
+shouldThrow("outOfMemory.sort(function(a, b) { if (++calls == 20) huge.toUpperCase(); return a - b; })", '"Error: Out of memory"');
+shouldBe("outOfMemory.join()", "before");
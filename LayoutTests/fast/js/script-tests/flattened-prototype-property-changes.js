@@ -0,0 +1,111 @@
+description(
+"Tests that property accesses through a prototype that has been turned into a dictionary and flattened, possibly several times, see properties that are later deleted, re-added or shadowed."
+);
+
+// Deleting a property, or adding a great many, turns an object into a dictionary.
+// Accessing a dictionary prototype from a loop flattens it.
+function makeDictionaryPrototype()
+{
+    var proto = { f: 1, g: 2, h: 3 };
+    delete proto.h;
+    return proto;
+}
+
+function readF(o)
+{
+    return o.f;
+}
+
+function readFLoop(o, iterations)
+{
+    var result;
+    for (var i = 0; i < iterations; ++i)
+        result = readF(o);
+    return result;
+}
+
+var proto = makeDictionaryPrototype();
+var instance = Object.create(proto);
+shouldBe("readFLoop(instance, 200)", "1");
+
+delete proto.f;
+shouldBe("readFLoop(instance, 200)", "undefined");
+
+proto.f = 2;
+shouldBe("readFLoop(instance, 200)", "2");
+
+instance.f = 3;
+shouldBe("readFLoop(instance, 200)", "3");
+delete instance.f;
+shouldBe("readFLoop(instance, 200)", "2");
+
+// Flatten the same prototype again and again, alternating with changes that
+// make it a dictionary, as code that uses a prototype as a hash map would.
+var mapProto = { f: 0 };
+var mapInstance = Object.create(mapProto);
+function churn(rounds)
+{
+    for (var round = 0; round < rounds; ++round) {
+        mapProto["key" + round] = round;
+        delete mapProto["key" + round];
+        mapProto.f = round;
+        if (readFLoop(mapInstance, 50) !== round)
+            return "wrong value in round " + round;
+        if (round % 3 == 0) {
+            delete mapProto.f;
+            if (readFLoop(mapInstance, 50) !== undefined)
+                return "deleted value read in round " + round;
+        }
+    }
+    return "ok";
+}
+shouldBe("churn(100)", "'ok'");
+
+// Deeper chains, where the dictionary is not the direct prototype.
+var top = makeDictionaryPrototype();
+var middle = Object.create(top);
+var bottom = Object.create(middle);
+shouldBe("readFLoop(bottom, 200)", "1");
+middle.f = 4;
+shouldBe("readFLoop(bottom, 200)", "4");
+delete middle.f;
+delete top.f;
+shouldBe("readFLoop(bottom, 200)", "undefined");
+top.f = 5;
+shouldBe("readFLoop(bottom, 200)", "5");
+
+// Methods called through a flattened prototype.
+var methodProto = { m: function() { return "first"; }, x: 0 };
+delete methodProto.x;
+var methodInstance = Object.create(methodProto);
+function callLoop(o, iterations)
+{
+    var result;
+    for (var i = 0; i < iterations; ++i)
+        result = o.m();
+    return result;
+}
+shouldBe("callLoop(methodInstance, 200)", "'first'");
+methodProto.m = function() { return "second"; };
+shouldBe("callLoop(methodInstance, 200)", "'second'");
+delete methodProto.m;
+shouldBe("typeof methodInstance.m", "'undefined'");
+shouldBeTrue("(function() { try { callLoop(methodInstance, 200); } catch (e) { return e instanceof TypeError; } })()");
+
+// Property enumeration caches the prototype chain too.
+function keys(o)
+{
+    var result = [];
+    for (var p in o)
+        result.push(p);
+    return result.sort().join();
+}
+var enumProto = makeDictionaryPrototype();
+var enumInstance = Object.create(enumProto);
+enumInstance.own = 1;
+readFLoop(enumInstance, 200);
+shouldBe("keys(enumInstance)", "'f,g,own'");
+delete enumProto.g;
+shouldBe("keys(enumInstance)", "'f,own'");
+enumProto.added = 1;
+shouldBe("keys(enumInstance)", "'added,f,own'");
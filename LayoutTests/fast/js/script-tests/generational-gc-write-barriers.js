@@ -0,0 +1,156 @@
+description(
+"Tests that objects stored into old objects survive eden collections, for stores made from C++, the LLInt, the baseline JIT and the DFG. Run in jsc with --enableGenerationalGC=true to get eden collections."
+);
+
+// jsc's edenGC() asks for an eden collection; elsewhere every collection is full.
+var edenCollect = this.edenGC || gc;
+
+var ownerCount = 50;
+var rounds = 6;
+
+function makeValue(round, index)
+{
+    return { round: round, index: index, payload: [round, index, "v" + round + "_" + index] };
+}
+
+function isValue(value, round, index)
+{
+    return !!value
+        && value.round === round
+        && value.index === index
+        && value.payload.length === 3
+        && value.payload[0] === round
+        && value.payload[1] === index
+        && value.payload[2] === "v" + round + "_" + index;
+}
+
+// Allocates enough to reuse the cells of anything the last collection freed.
+function churn()
+{
+    var garbage;
+    for (var i = 0; i < 20000; ++i)
+        garbage = { round: -1, index: -1, payload: [i, i, "x"] };
+    return garbage;
+}
+
+// Each store function gets its own executable, so each one tiers up on its own.
+function makeStoreFunction(body)
+{
+    return eval("(function(owner, value) { " + body + " })");
+}
+
+var storeBodies = {
+    putById: "owner.value = value;",
+    putByIdOutOfLine: "owner.p0 = owner.p1 = owner.p2 = owner.p3 = owner.p4 = owner.p5 = owner.p6 = owner.p7 = value;",
+    putByVal: "owner.array[1] = value;",
+    putByValAppend: "owner.array[owner.array.length] = value;",
+};
+
+function makeOwner()
+{
+    var captured;
+    return {
+        value: null,
+        array: [null, null],
+        setCaptured: function(value) { captured = value; },
+        getCaptured: function() { return captured; },
+    };
+}
+
+function storedValue(owner, site)
+{
+    if (site == "putById")
+        return owner.value;
+    if (site == "putByIdOutOfLine")
+        return owner.p7;
+    if (site == "putByVal")
+        return owner.array[1];
+    if (site == "putByValAppend" || site == "arrayPush")
+        return owner.array[owner.array.length - 1];
+    if (site == "putToClosureVariable")
+        return owner.getCaptured();
+    return owner.defined;
+}
+
+// Makes the owners old, then repeatedly stores new objects into them, alternating
+// between eden and full collections, and checks that every stored object survived.
+function testSite(site, store, warmUpCalls)
+{
+    var scratch = makeOwner();
+    for (var i = 0; i < warmUpCalls; ++i)
+        store(scratch, scratch.array);
+
+    var owners = [];
+    for (var i = 0; i < ownerCount; ++i)
+        owners.push(makeOwner());
+    gc();
+
+    for (var round = 0; round < rounds; ++round) {
+        for (var i = 0; i < ownerCount; ++i)
+            store(owners[i], makeValue(round, i));
+        if (round % 2)
+            gc();
+        else
+            edenCollect();
+        churn();
+        for (var i = 0; i < ownerCount; ++i) {
+            if (!isValue(storedValue(owners[i], site), round, i))
+                return "lost the value stored in owner " + i + " in round " + round;
+        }
+    }
+    return "ok";
+}
+
+// Few calls keep a function in the LLInt. Hundreds move it to the baseline JIT,
+// and thousands to the DFG.
+var tiers = { LLInt: 1, baseline: 500, DFG: 20000 };
+
+var store;
+for (var site in storeBodies) {
+    for (var tier in tiers) {
+        store = makeStoreFunction(storeBodies[site]);
+        shouldBe("testSite('" + site + "', store, tiers." + tier + ")", "'ok'");
+    }
+}
+
+// All owners share one setter, which starts in the LLInt and tiers up as the
+// test goes.
+var setCaptured = function(owner, value) {
+    owner.setCaptured(value);
+};
+for (var tier in tiers)
+    shouldBe("testSite('putToClosureVariable', setCaptured, tiers." + tier + ")", "'ok'");
+
+// Stores made by the runtime go through WriteBarrier in C++.
+var defineProperty = function(owner, value) {
+    Object.defineProperty(owner, "defined", { value: value, writable: true, configurable: true });
+};
+shouldBe("testSite('defineProperty', defineProperty, 0)", "'ok'");
+
+var arrayPush = function(owner, value) {
+    owner.array.push(value);
+};
+shouldBe("testSite('arrayPush', arrayPush, 0)", "'ok'");
+
+// The global object is always old.
+var globalValue;
+var storeGlobal = makeStoreFunction("globalValue = value;");
+function testGlobal(warmUpCalls)
+{
+    for (var i = 0; i < warmUpCalls; ++i)
+        storeGlobal(null, storeBodies);
+    gc();
+    for (var round = 0; round < rounds; ++round) {
+        storeGlobal(null, makeValue(round, 0));
+        if (round % 2)
+            gc();
+        else
+            edenCollect();
+        churn();
+        if (!isValue(globalValue, round, 0))
+            return "lost the global value in round " + round;
+    }
+    return "ok";
+}
+shouldBe("testGlobal(0)", "'ok'");
+shouldBe("testGlobal(20000)", "'ok'");
@@ -0,0 +1,112 @@
+description(
+"Tests that objects survive a collection whose marking was interleaved with the program: stores into objects that were already marked, objects moved out of objects that were not marked yet, and objects allocated during the marking. Run in jsc with --enableIncrementalMarking=true to get incremental marking."
+);
+
+// jsc's startIncrementalMarking() starts marking, which then advances as the
+// program allocates; the next gc() finishes it with a remark.
+var startMarking = this.startIncrementalMarking || function() { };
+
+var ownerCount = 200;
+
+function makeValue(tag)
+{
+    return { tag: tag, payload: [tag, "v" + tag] };
+}
+
+function isValue(value, tag)
+{
+    return !!value
+        && value.tag === tag
+        && value.payload.length === 2
+        && value.payload[0] === tag
+        && value.payload[1] === "v" + tag;
+}
+
+// Allocates enough to run several marking slices, or after the collection, to
+// reuse the cells of anything that was freed.
+function churn()
+{
+    var garbage;
+    for (var i = 0; i < 50000; ++i)
+        garbage = { tag: -1, payload: [i, "x"] };
+    return garbage;
+}
+
+function makeOwners(cycle)
+{
+    var owners = [];
+    for (var i = 0; i < ownerCount; ++i)
+        owners.push({ stored: null, moved: makeValue(cycle * 10000 + i), array: [null], list: [] });
+    return owners;
+}
+
+// Each store function gets its own executable, so each one tiers up on its own.
+function makeStoreFunction(body)
+{
+    return eval("(function(owner, value) { " + body + " })");
+}
+
+var storePutById = makeStoreFunction("owner.stored = value;");
+var storePutByVal = makeStoreFunction("owner.array[0] = value;");
+var storeMoved = makeStoreFunction("owner.moved = value;");
+
+function runCycle(cycle)
+{
+    var owners = makeOwners(cycle);
+    gc();
+
+    startMarking();
+    // Give the marking time to reach the owners before they change.
+    churn();
+
+    // Stores of new objects into owners the marking has probably visited.
+    for (var i = 0; i < ownerCount; ++i) {
+        storePutById(owners[i], makeValue(cycle * 10000 + 1000 + i));
+        storePutByVal(owners[i], makeValue(cycle * 10000 + 2000 + i));
+        owners[i].list.push(makeValue(cycle * 10000 + 3000 + i));
+    }
+
+    // Swap the old objects between owners. Each object is taken from an owner
+    // the marking may not have visited yet, so it is only reachable from an owner
+    // it may already have visited.
+    for (var i = 0; i < ownerCount / 2; ++i) {
+        var j = ownerCount - 1 - i;
+        var moved = owners[i].moved;
+        storeMoved(owners[i], owners[j].moved);
+        storeMoved(owners[j], moved);
+    }
+    moved = null;
+
+    // A graph that is allocated while the marking runs and only becomes reachable
+    // from an owner after more allocation.
+    var late = [];
+    for (var i = 0; i < ownerCount; ++i)
+        late.push(makeValue(cycle * 10000 + 4000 + i));
+    churn();
+    owners[0].late = late;
+    late = null;
+
+    gc();
+    churn();
+
+    for (var i = 0; i < ownerCount; ++i) {
+        var owner = owners[i];
+        var j = ownerCount - 1 - i;
+        if (!isValue(owner.stored, cycle * 10000 + 1000 + i))
+            return "lost the put_by_id value of owner " + i;
+        if (!isValue(owner.array[0], cycle * 10000 + 2000 + i))
+            return "lost the put_by_val value of owner " + i;
+        if (!isValue(owner.list[0], cycle * 10000 + 3000 + i))
+            return "lost the pushed value of owner " + i;
+        if (!isValue(owner.moved, cycle * 10000 + j))
+            return "lost the object moved into owner " + i;
+        if (!isValue(owners[0].late[i], cycle * 10000 + 4000 + i))
+            return "lost late object " + i;
+    }
+    return "ok";
+}
+
+// The store functions start in the LLInt and reach the baseline JIT and the DFG
+// in later cycles.
+for (var cycle = 0; cycle < 6; ++cycle)
+    shouldBe("runCycle(" + cycle + ")", "'ok'");
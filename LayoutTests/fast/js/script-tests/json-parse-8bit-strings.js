@@ -0,0 +1,95 @@
+description(
+"Tests that JSON.parse finds escapes, quotes, control characters and the end of white space at every alignment in 8-bit strings."
+);
+
+function repeat(string, count)
+{
+    var result = "";
+    for (var i = 0; i < count; ++i)
+        result += string;
+    return result;
+}
+
+// Puts the special text at every offset from the start of the input and from the
+// start of the string, so that it lands at every position in a machine word
+// wherever the characters start.
+function checkStrings(specialText, specialValue)
+{
+    for (var padding = 0; padding < 17; ++padding) {
+        for (var before = 0; before < 17; ++before) {
+            var after = 17 - before;
+            var text = repeat(" ", padding) + '"' + repeat("a", before) + specialText + repeat("\xe9", after) + '"';
+            var expected = repeat("a", before) + specialValue + repeat("\xe9", after);
+            var result;
+            try {
+                result = JSON.parse(text);
+            } catch (e) {
+                return "threw " + e + " for padding " + padding + " and offset " + before;
+            }
+            if (result !== expected)
+                return "wrong result for padding " + padding + " and offset " + before;
+        }
+    }
+    return "ok";
+}
+
+function checkRejected(specialText)
+{
+    for (var padding = 0; padding < 17; ++padding) {
+        for (var before = 0; before < 17; ++before) {
+            var text = repeat(" ", padding) + '"' + repeat("a", before) + specialText + repeat("b", 17 - before) + '"';
+            try {
+                JSON.parse(text);
+                return "accepted padding " + padding + " and offset " + before;
+            } catch (e) {
+                if (!(e instanceof SyntaxError))
+                    return "threw " + e;
+            }
+        }
+    }
+    return "ok";
+}
+
+shouldBe("checkStrings('', '')", "'ok'");
+shouldBe("checkStrings('\\\\\"', '\"')", "'ok'");
+shouldBe("checkStrings('\\\\\\\\', '\\\\')", "'ok'");
+shouldBe("checkStrings('\\\\n', '\\n')", "'ok'");
+shouldBe("checkStrings('\\\\u0001', '\\u0001')", "'ok'");
+shouldBe("checkStrings('\\\\u00ff', '\\u00ff')", "'ok'");
+shouldBe("checkStrings('\\\\/', '/')", "'ok'");
+shouldBe("checkStrings('\\x7f\\x80\\xff', '\\x7f\\x80\\xff')", "'ok'");
+shouldBe("checkStrings(' !#[]', ' !#[]')", "'ok'");
+
+// Raw control characters, tabs included, are not allowed in JSON strings.
+shouldBe("checkRejected('\\x00')", "'ok'");
+shouldBe("checkRejected('\\x01')", "'ok'");
+shouldBe("checkRejected('\\t')", "'ok'");
+shouldBe("checkRejected('\\n')", "'ok'");
+shouldBe("checkRejected('\\x1f')", "'ok'");
+// A quote ends the string early.
+shouldBe("checkRejected('\"')", "'ok'");
+// A backslash starts an escape.
+shouldBe("checkRejected('\\\\x')", "'ok'");
+
+// Indentation of every length, including ones that are not a multiple of the word size.
+function checkIndentation(unit)
+{
+    for (var length = 0; length < 34; ++length) {
+        var indentation = repeat(unit, length);
+        var spaces = repeat(" ", length);
+        var text = "{\n" + indentation + '"a": [\n' + indentation + indentation + "1,\n" + indentation + indentation + "2\n" + indentation + "],\n" + indentation + '"b" : "' + spaces + '"' + indentation + "\n}" + indentation;
+        var result;
+        try {
+            result = JSON.parse(text);
+        } catch (e) {
+            return "threw " + e + " for length " + length;
+        }
+        if (result.a.length !== 2 || result.a[0] !== 1 || result.a[1] !== 2 || result.b !== spaces)
+            return "wrong result for length " + length;
+    }
+    return "ok";
+}
+
+shouldBe("checkIndentation(' ')", "'ok'");
+shouldBe("checkIndentation('  \\t')", "'ok'");
+shouldBe("checkIndentation(' \\r\\n')", "'ok'");
@@ -0,0 +1,80 @@
+description(
+"Tests that JSON.parse builds the right objects when many of them have the same shape, including ones whose keys come in another order, repeat, or are array indices."
+);
+
+function keysOf(object)
+{
+    var keys = [];
+    for (var key in object)
+        keys.push(key + ":" + object[key]);
+    return keys.join(",");
+}
+
+function records(count, makeText)
+{
+    var texts = [];
+    for (var i = 0; i < count; ++i)
+        texts.push(makeText(i));
+    return JSON.parse("[" + texts.join(",") + "]");
+}
+
+function checkAll(parsed, expected)
+{
+    for (var i = 0; i < parsed.length; ++i) {
+        var keys = keysOf(parsed[i]);
+        if (keys !== expected(i))
+            return "record " + i + " is " + keys;
+    }
+    return "ok";
+}
+
+// The first records set up the shape, and the ones that follow it can take its transitions.
+var sameOrder = records(50, function(i) { return '{"id":' + i + ',"name":"n' + i + '","flag":' + (i % 2 ? "true" : "false") + '}'; });
+shouldBe("checkAll(sameOrder, function(i) { return 'id:' + i + ',name:n' + i + ',flag:' + !!(i % 2); })", "'ok'");
+
+var otherOrder = records(50, function(i) { return i % 3 ? '{"a":' + i + ',"b":' + -i + '}' : '{"b":' + -i + ',"a":' + i + '}'; });
+shouldBe("checkAll(otherOrder, function(i) { return i % 3 ? 'a:' + i + ',b:' + -i : 'b:' + -i + ',a:' + i; })", "'ok'");
+
+// Names that share a prefix with the one the shape predicts.
+var prefixes = JSON.parse('[{"name":1,"x":2},{"nam":3,"x":4},{"names":5,"x":6},{"namf":7,"x":8},{"name":9,"x":10}]');
+shouldBe("keysOf(prefixes[0])", "'name:1,x:2'");
+shouldBe("keysOf(prefixes[1])", "'nam:3,x:4'");
+shouldBe("keysOf(prefixes[2])", "'names:5,x:6'");
+shouldBe("keysOf(prefixes[3])", "'namf:7,x:8'");
+shouldBe("keysOf(prefixes[4])", "'name:9,x:10'");
+
+// A key written with an escape is the same key.
+var escaped = JSON.parse('[{"a":1,"b":2},{"\\u0061":3,"b":4},{"a":5,"\\u0062":6}]');
+shouldBe("keysOf(escaped[1])", "'a:3,b:4'");
+shouldBe("keysOf(escaped[2])", "'a:5,b:6'");
+
+// The last of duplicated keys wins, in the place of the first.
+var duplicated = records(20, function(i) { return i % 2 ? '{"a":' + i + ',"a":' + (i + 100) + ',"b":' + i + '}' : '{"a":' + i + ',"b":' + i + ',"b":' + (i + 100) + '}'; });
+shouldBe("checkAll(duplicated, function(i) { return i % 2 ? 'a:' + (i + 100) + ',b:' + i : 'a:' + i + ',b:' + (i + 100); })", "'ok'");
+var duplicatedAfterShape = JSON.parse('[{"a":1,"b":2,"c":3},{"a":4,"b":5,"a":6,"c":7},{"a":8,"b":9,"c":10}]');
+shouldBe("keysOf(duplicatedAfterShape[1])", "'a:6,b:5,c:7'");
+shouldBe("keysOf(duplicatedAfterShape[2])", "'a:8,b:9,c:10'");
+
+// Index-like keys are stored as indices, and enumerate first.
+var indexed = records(20, function(i) { return '{"a":' + i + ',"0":' + (i + 1) + ',"b":' + (i + 2) + ',"7":' + (i + 3) + '}'; });
+shouldBe("checkAll(indexed, function(i) { return '0:' + (i + 1) + ',7:' + (i + 3) + ',a:' + i + ',b:' + (i + 2); })", "'ok'");
+var mixedIndices = JSON.parse('[{"1":1,"a":2},{"a":3,"1":4},{"1":5,"01":6,"a":7}]');
+shouldBe("keysOf(mixedIndices[0])", "'1:1,a:2'");
+shouldBe("keysOf(mixedIndices[1])", "'1:4,a:3'");
+shouldBe("keysOf(mixedIndices[2])", "'1:5,01:6,a:7'");
+// 4294967295 is not an array index.
+var largeIndices = JSON.parse('[{"4294967294":1,"4294967295":2},{"4294967294":3,"4294967295":4}]');
+shouldBe("largeIndices[1][4294967294]", "3");
+shouldBe("largeIndices[1]['4294967295']", "4");
+
+// Objects nested in objects of the same shape.
+var nested = records(20, function(i) { return '{"outer":{"inner":' + i + ',"other":' + -i + '},"after":' + i + '}'; });
+shouldBe("checkAll(nested.map(function(record) { return record.outer; }), function(i) { return 'inner:' + i + ',other:' + -i; })", "'ok'");
+shouldBe("checkAll(nested, function(i) { return 'outer:[object Object],after:' + i; })", "'ok'");
+
+// Parsed objects are ordinary objects that can still change shape.
+sameOrder[3].extra = 1;
+delete sameOrder[4].name;
+shouldBe("keysOf(sameOrder[3])", "'id:3,name:n3,flag:true,extra:1'");
+shouldBe("keysOf(sameOrder[4])", "'id:4,flag:false'");
+shouldBe("keysOf(JSON.parse('{\"id\":1,\"name\":\"x\",\"flag\":true}'))", "'id:1,name:x,flag:true'");
@@ -0,0 +1,118 @@
+description(
+"Tests that JSON.stringify sees the right properties of objects that share a Structure, when toJSON functions or getters change those objects while they are being stringified, and when there are more Structures than it caches."
+);
+
+function record(i)
+{
+    return { a: i, b: "b" + i, c: [i] };
+}
+
+// Every record has the same Structure; the first one stringified sets up the cache.
+var records = [];
+for (var i = 0; i < 4; ++i)
+    records.push(record(i));
+shouldBe("JSON.stringify(records)", "'[{\"a\":0,\"b\":\"b0\",\"c\":[0]},{\"a\":1,\"b\":\"b1\",\"c\":[1]},{\"a\":2,\"b\":\"b2\",\"c\":[2]},{\"a\":3,\"b\":\"b3\",\"c\":[3]}]'");
+
+// A toJSON on an earlier value adds and deletes properties of siblings that have
+// not been stringified yet, and of the one being stringified, whose properties
+// that were already written stay and whose new ones are left out.
+var siblings = [record(0), record(1), record(2), record(3)];
+siblings[0].c = { toJSON: function() {
+    siblings[1].d = "added";
+    delete siblings[2].b;
+    siblings[3].a = "changed";
+    delete siblings[0].b;
+    siblings[0].e = "too late";
+    return "toJSON";
+} };
+shouldBe("JSON.stringify(siblings)", "'[{\"a\":0,\"b\":\"b0\",\"c\":\"toJSON\"},{\"a\":1,\"b\":\"b1\",\"c\":[1],\"d\":\"added\"},{\"a\":2,\"c\":[2]},{\"a\":\"changed\",\"b\":\"b3\",\"c\":[3]}]'");
+
+// The same, from a toJSON on the object itself.
+var changedBySelf = [record(0), record(1)];
+changedBySelf[1].toJSON = function() {
+    delete changedBySelf[1].toJSON;
+    changedBySelf[1].z = 1;
+    return changedBySelf[1];
+};
+shouldBe("JSON.stringify(changedBySelf)", "'[{\"a\":0,\"b\":\"b0\",\"c\":[0]},{\"a\":1,\"b\":\"b1\",\"c\":[1],\"z\":1}]'");
+
+// Getters run while the object is stringified; they see and change its siblings.
+function recordWithGetter(i, getter)
+{
+    var object = { a: i };
+    Object.defineProperty(object, "g", { get: getter, enumerable: true, configurable: true });
+    object.b = "b" + i;
+    return object;
+}
+var getterCalls = 0;
+var withGetters = [];
+for (var i = 0; i < 3; ++i) {
+    withGetters.push(recordWithGetter(i, function() {
+        ++getterCalls;
+        if (this === withGetters[0]) {
+            delete withGetters[1].b;
+            withGetters[2].b = "from getter";
+            delete this.b;
+        }
+        return "g" + this.a;
+    }));
+}
+shouldBe("JSON.stringify(withGetters)", "'[{\"a\":0,\"g\":\"g0\"},{\"a\":1,\"g\":\"g1\"},{\"a\":2,\"g\":\"g2\",\"b\":\"from getter\"}]'");
+shouldBe("getterCalls", "3");
+
+// A getter that replaces a data property later in the same object.
+var accessorLater = [{ x: 1, y: 2 }, { x: 3, y: 4 }];
+Object.defineProperty(accessorLater[1], "x", { get: function() {
+    Object.defineProperty(accessorLater[1], "y", { get: function() { return "getter"; }, enumerable: true });
+    return "x";
+}, enumerable: true });
+shouldBe("JSON.stringify(accessorLater)", "'[{\"x\":1,\"y\":2},{\"x\":\"x\",\"y\":\"getter\"}]'");
+
+// Non-enumerable properties are left out, also when they share a Structure with
+// enumerable ones on other objects.
+function recordWithHidden(i, enumerable)
+{
+    var object = { a: i };
+    Object.defineProperty(object, "hidden", { value: "h" + i, enumerable: enumerable, writable: true, configurable: true });
+    object.b = i;
+    return object;
+}
+var hidden = [recordWithHidden(0, false), recordWithHidden(1, true), recordWithHidden(2, false)];
+shouldBe("JSON.stringify(hidden)", "'[{\"a\":0,\"b\":0},{\"a\":1,\"hidden\":\"h1\",\"b\":1},{\"a\":2,\"b\":2}]'");
+var hiddenLater = [record(0), record(1)];
+hiddenLater[0].c = { toJSON: function() {
+    Object.defineProperty(hiddenLater[1], "b", { enumerable: false });
+    return 0;
+} };
+shouldBe("JSON.stringify(hiddenLater)", "'[{\"a\":0,\"b\":\"b0\",\"c\":0},{\"a\":1,\"c\":[1]}]'");
+
+// More Structures than are cached: each object has its own, and each one is seen twice.
+function manyShapes(count)
+{
+    var objects = [];
+    for (var i = 0; i < count; ++i) {
+        var object = {};
+        object["p" + i] = i;
+        object.q = "q" + i;
+        objects.push(object);
+    }
+    return objects.concat(objects);
+}
+function expectedManyShapes(count)
+{
+    var parts = [];
+    for (var i = 0; i < count; ++i)
+        parts.push('{"p' + i + '":' + i + ',"q":"q' + i + '"}');
+    return "[" + parts.concat(parts).join(",") + "]";
+}
+shouldBe("JSON.stringify(manyShapes(300)) === expectedManyShapes(300)", "true");
+shouldBe("JSON.stringify(manyShapes(300), null, 2) === JSON.stringify(JSON.parse(expectedManyShapes(300)), null, 2)", "true");
+
+// Past the limit, toJSON still sees its siblings change.
+var manyThenChanged = manyShapes(300);
+manyThenChanged[0].toJSON = function() {
+    manyThenChanged[299].p299 = "changed";
+    delete manyThenChanged[299].toJSON;
+    return "first";
+};
+shouldBe("JSON.stringify(manyThenChanged).indexOf('{\"p299\":\"changed\",\"q\":\"q299\"}') !== -1", "true");
@@ -0,0 +1,94 @@
+description(
+"Tests that get_by_id and put_by_id sites that see many object shapes, and objects whose structure changes underneath them, read and write the right properties."
+);
+
+// Objects with x at different offsets, some of them in out-of-line storage.
+function makeShapes()
+{
+    var shapes = [];
+    shapes.push({ x: 0 });
+    shapes.push({ a: 1, x: 0 });
+    shapes.push({ a: 1, b: 2, x: 0 });
+    shapes.push({ a: 1, b: 2, c: 3, x: 0 });
+    var outOfLine = {};
+    for (var i = 0; i < 20; ++i)
+        outOfLine["p" + i] = i;
+    outOfLine.x = 0;
+    shapes.push(outOfLine);
+    var fromPrototype = Object.create({ x: 0 });
+    shapes.push(fromPrototype);
+    return shapes;
+}
+
+function getX(o)
+{
+    return o.x;
+}
+
+function putX(o, value)
+{
+    o.x = value;
+}
+
+function checkShapes(shapes, iterations)
+{
+    for (var i = 0; i < iterations; ++i) {
+        var o = shapes[i % shapes.length];
+        putX(o, i);
+        if (getX(o) !== i)
+            return "wrong value at iteration " + i;
+    }
+    return "ok";
+}
+
+var shapes = makeShapes();
+shouldBe("checkShapes(shapes.slice(0, 2), 100)", "'ok'");
+shouldBe("checkShapes(shapes.slice(0, 4), 100)", "'ok'");
+shouldBe("checkShapes(shapes, 1000)", "'ok'");
+
+// Putting x on the object whose x was inherited shadows the prototype's x.
+shouldBe("Object.getPrototypeOf(shapes[5]).x", "0");
+shouldBeTrue("shapes[5].hasOwnProperty('x')");
+
+// Changing the structure of objects the caches have seen.
+function checkTransitions(iterations)
+{
+    var objects = [{ x: 1 }, { y: 2, x: 1 }, { z: 3, x: 1 }];
+    for (var i = 0; i < iterations; ++i) {
+        var o = objects[i % objects.length];
+        if (i % 7 == 0)
+            o["q" + i] = i;
+        if (i % 11 == 0) {
+            delete o.x;
+            if (getX(o) !== undefined)
+                return "deleted x still read at iteration " + i;
+        }
+        putX(o, i);
+        if (getX(o) !== i)
+            return "wrong value at iteration " + i;
+    }
+    return "ok";
+}
+shouldBe("checkTransitions(1000)", "'ok'");
+
+// Accessors and non-writable properties must not be treated as plain slots.
+function checkSpecialProperties()
+{
+    var log = [];
+    var objects = [{ x: 0 }, { a: 0, x: 0 }];
+    var accessor = { get x() { log.push("get"); return 42; }, set x(v) { log.push("set " + v); } };
+    var readOnly = {};
+    Object.defineProperty(readOnly, "x", { value: 7, writable: false });
+    for (var i = 0; i < 100; ++i) {
+        putX(objects[i % 2], i);
+        getX(objects[i % 2]);
+    }
+    putX(accessor, 5);
+    if (getX(accessor) !== 42)
+        return "accessor get";
+    putX(readOnly, 8);
+    if (getX(readOnly) !== 7)
+        return "read-only put";
+    return log.join(",");
+}
+shouldBe("checkSpecialProperties()", "'set 5,get'");
@@ -0,0 +1,118 @@
+description(
+"Tests that reading a rope without flattening it, with charAt, charCodeAt, indexing, substring and indexOf, gives the same results as reading the flattened string, including for matches that span several fibers."
+);
+
+// Ropes shorter than 256 characters are always flattened first, so every rope
+// here is longer than that. Each check builds a fresh rope, since a rope that
+// has been read in place often enough gets flattened.
+
+var chunk = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+function leftDeepRope(pieces)
+{
+    var result = "";
+    for (var i = 0; i < pieces.length; ++i)
+        result += pieces[i];
+    return result;
+}
+
+function rightDeepRope(pieces)
+{
+    var result = "";
+    for (var i = pieces.length; i--;)
+        result = pieces[i] + result;
+    return result;
+}
+
+function flat(pieces)
+{
+    return pieces.join("");
+}
+
+var pieces = [];
+for (var i = 0; i < 400; ++i)
+    pieces.push(chunk.charAt(i % chunk.length) + i);
+
+var expected = flat(pieces);
+
+function checkCharacters(makeRope)
+{
+    var positions = [0, 1, 2, 37, 500, expected.length - 2, expected.length - 1];
+    for (var i = 0; i < positions.length; ++i) {
+        var p = positions[i];
+        if (makeRope(pieces).charAt(p) !== expected.charAt(p))
+            return "charAt(" + p + ")";
+        if (makeRope(pieces).charCodeAt(p) !== expected.charCodeAt(p))
+            return "charCodeAt(" + p + ")";
+        if (makeRope(pieces)[p] !== expected[p])
+            return "[" + p + "]";
+    }
+    if (makeRope(pieces).charAt(expected.length) !== "")
+        return "charAt past the end";
+    return "ok";
+}
+
+function checkSubstrings(makeRope)
+{
+    var ranges = [[0, 1], [0, 2], [1, 3], [5, 300], [0, expected.length], [expected.length - 7, expected.length], [123, 124], [200, 200]];
+    for (var i = 0; i < ranges.length; ++i) {
+        var start = ranges[i][0];
+        var end = ranges[i][1];
+        if (makeRope(pieces).substring(start, end) !== expected.substring(start, end))
+            return "substring(" + start + ", " + end + ")";
+        if (makeRope(pieces).substr(start, end - start) !== expected.substr(start, end - start))
+            return "substr(" + start + ", " + (end - start) + ")";
+    }
+    return "ok";
+}
+
+function checkIndexOf(makeRope)
+{
+    var patterns = ["a0", "0b1", "9z", "z25", "a36b37", "b1c2d3e4f5", "x", "nope", expected.substring(700, 731), expected.substring(1000, 1040)];
+    for (var i = 0; i < patterns.length; ++i) {
+        var starts = [0, 1, 700, expected.length - 1, expected.length, expected.length + 5];
+        for (var j = 0; j < starts.length; ++j) {
+            if (makeRope(pieces).indexOf(patterns[i], starts[j]) !== expected.indexOf(patterns[i], starts[j]))
+                return "indexOf('" + patterns[i] + "', " + starts[j] + ")";
+        }
+    }
+    return "ok";
+}
+
+shouldBe("checkCharacters(leftDeepRope)", "'ok'");
+shouldBe("checkCharacters(rightDeepRope)", "'ok'");
+shouldBe("checkSubstrings(leftDeepRope)", "'ok'");
+shouldBe("checkSubstrings(rightDeepRope)", "'ok'");
+shouldBe("checkIndexOf(leftDeepRope)", "'ok'");
+shouldBe("checkIndexOf(rightDeepRope)", "'ok'");
+
+// A match that starts in one fiber, covers a whole one-character fiber and ends in a third.
+var straddling = chunk + chunk + chunk + chunk + chunk + chunk + chunk + chunk + "xy" + "z" + "w" + chunk;
+shouldBe("straddling.indexOf('xyzw')", "288");
+straddling = chunk + chunk + chunk + chunk + chunk + chunk + chunk + chunk + "xy" + "z" + "w" + chunk;
+shouldBe("straddling.indexOf('yzw0')", "-1");
+straddling = chunk + chunk + chunk + chunk + chunk + chunk + chunk + chunk + "xy" + "z" + "w" + chunk;
+shouldBe("straddling.indexOf('wabc', 289)", "291");
+straddling = chunk + chunk + chunk + chunk + chunk + chunk + chunk + chunk + "xy" + "z" + "w" + chunk;
+shouldBe("straddling.indexOf('9abc', 36)", "71");
+
+// Reading the same rope in place over and over eventually flattens it, which must
+// not change the answers.
+var reread = leftDeepRope(pieces);
+var rereadMatches = true;
+for (var i = 0; i < 2000; ++i) {
+    var p = (i * 7919) % expected.length;
+    if (reread.charAt(p) !== expected.charAt(p) || reread.indexOf("a0") !== 0 || reread.substring(p, p + 3) !== expected.substring(p, p + 3))
+        rereadMatches = false;
+}
+shouldBeTrue("rereadMatches");
+
+// 16-bit fibers mixed with 8-bit ones.
+var wide = "ĀāĂ";
+var mixedPieces = [];
+for (var i = 0; i < 200; ++i)
+    mixedPieces.push(i % 3 ? chunk.substring(i % 10, i % 10 + 3) : wide);
+var mixedExpected = flat(mixedPieces);
+shouldBeTrue("leftDeepRope(mixedPieces).indexOf('\\u0102abc') === mixedExpected.indexOf('\\u0102abc')");
+shouldBeTrue("leftDeepRope(mixedPieces).charCodeAt(401) === mixedExpected.charCodeAt(401)");
+shouldBeTrue("leftDeepRope(mixedPieces).substring(2, 9) === mixedExpected.substring(2, 9)");
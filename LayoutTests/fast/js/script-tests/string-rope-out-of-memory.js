@@ -0,0 +1,29 @@
+description(
+"Tests that reading a rope in place still works when the rope is too long to flatten, and that the out of memory error thrown by a failed flatten is thrown again by later reads of the same rope and of ropes containing it."
+);
+
+// Doubling a 16-bit string 31 times gives a rope of 2^31 characters, which is
+// more than a 16-bit StringImpl can hold, so flattening it always fails. The
+// rope is a DAG only 31 levels deep, so reading single characters in place
+// stays cheap.
+var big = "\u0100";
+for (var i = 0; i < 31; ++i)
+    big += big;
+var outer = big + "tail";
+
+shouldBe("big.length", "2147483648");
+shouldBe("big.charCodeAt(0)", "256");
+shouldBe("big.charCodeAt(big.length - 1)", "256");
+shouldBe("outer.charCodeAt(outer.length - 1)", "108");
+shouldBe("outer.indexOf('\u0100tail', big.length - 2)", "2147483647");
+
+// Copying almost the whole rope fails and falls back to flattening it, which
+// throws and clears the rope's fibers.
+shouldThrow("big.substring(0, big.length - 1)", '"Error: Out of memory"');
+shouldBe("big.length", "2147483648");
+
+// Reads that reach the cleared rope must fall back to flattening, and throw
+// again, rather than read the missing fibers.
+shouldThrow("outer.charAt(0)", '"Error: Out of memory"');
+shouldThrow("big.charAt(0)", '"Error: Out of memory"');
+shouldThrow("big.indexOf('x')", '"Error: Out of memory"');
@@ -78,10 +78,12 @@ SOURCES += \
     bytecode/Watchpoint.cpp \
     bytecompiler/BytecodeGenerator.cpp \
     bytecompiler/NodesCodegen.cpp \
+    heap/AllocationSiteProfiler.cpp \
     heap/CopiedSpace.cpp \
     heap/CopyVisitor.cpp \
     heap/ConservativeRoots.cpp \
     heap/DFGCodeBlocks.cpp \
+    heap/HeapSnapshotWriter.cpp \
     heap/Weak.cpp \
     heap/WeakBlock.cpp \
     heap/WeakHandleOwner.cpp \
@@ -122,6 +124,7 @@ SOURCES += \
     dfg/DFGConstantFoldingPhase.cpp \
     dfg/DFGCSEPhase.cpp \
     dfg/DFGDCEPhase.cpp \
+    dfg/DFGDesiredWatchpoints.cpp \
     dfg/DFGDisassembler.cpp \
     dfg/DFGDominators.cpp \
     dfg/DFGDriver.cpp \
@@ -141,6 +144,7 @@ SOURCES += \
     dfg/DFGOSRExitCompiler32_64.cpp \
     dfg/DFGOSRExitJumpPlaceholder.cpp \
     dfg/DFGPhase.cpp \
+    dfg/DFGPlan.cpp \
     dfg/DFGPredictionPropagationPhase.cpp \
     dfg/DFGPredictionInjectionPhase.cpp \
     dfg/DFGRepatch.cpp \
@@ -157,6 +161,7 @@ SOURCES += \
     dfg/DFGVariableEventStream.cpp \
     dfg/DFGValidate.cpp \
     dfg/DFGVirtualRegisterAllocationPhase.cpp \
+    dfg/DFGWorklist.cpp \
     disassembler/Disassembler.cpp \
     interpreter/AbstractPC.cpp \
     interpreter/CallFrame.cpp \
@@ -222,6 +227,7 @@ SOURCES += \
     profiler/ProfileGenerator.cpp \
     profiler/ProfileNode.cpp \
     profiler/LegacyProfiler.cpp \
+    profiler/SamplingProfiler.cpp \
     runtime/ArgList.cpp \
     runtime/Arguments.cpp \
     runtime/ArrayConstructor.cpp \
@@ -229,6 +235,7 @@ SOURCES += \
     runtime/BooleanConstructor.cpp \
     runtime/BooleanObject.cpp \
     runtime/BooleanPrototype.cpp \
+    runtime/BytecodeCache.cpp \
     runtime/CallData.cpp \
     runtime/CodeCache.cpp \
     runtime/CodeSpecializationKind.cpp \
@@ -262,6 +269,7 @@ SOURCES += \
     runtime/JSDateMath.cpp \
     runtime/JSFunction.cpp \
     runtime/JSBoundFunction.cpp \
+    runtime/RegExpJITCodeCache.cpp \
     runtime/VM.cpp \
     runtime/JSGlobalObject.cpp \
     runtime/JSGlobalObjectFunctions.cpp \
@@ -282,6 +290,7 @@ SOURCES += \
     runtime/JSVariableObject.cpp \
     runtime/JSWrapperObject.cpp \
     runtime/LiteralParser.cpp \
+    runtime/LocalTimeOffsetTable.cpp \
     runtime/Lookup.cpp \
     runtime/MathObject.cpp \
     runtime/MemoryStatistics.cpp \
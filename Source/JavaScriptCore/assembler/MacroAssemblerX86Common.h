@@ -185,6 +185,12 @@ public:
         and32(imm, dest);
     }
 
+    // The result is undefined if src is zero.
+    void countTrailingZeros32(RegisterID src, RegisterID dest)
+    {
+        m_assembler.bsfl_rr(src, dest);
+    }
+
     void lshift32(RegisterID shift_amount, RegisterID dest)
     {
         ASSERT(shift_amount != dest);
@@ -945,6 +951,44 @@ public:
         m_assembler.movd_rr(src, dst);
     }
 
+    // Operations on 16-byte vectors of packed integers, currently only used by the
+    // YARR JIT to scan its input for the first character of a pattern.
+
+    // Unlike loadDouble(), the address need not be aligned.
+    void loadPacked(BaseIndex address, XMMRegisterID dst)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.movdqu_mr(address.offset, address.base, address.index, address.scale, dst);
+    }
+
+    // Copies the low 32-bit lane of the register into the other three.
+    void splatInt32Packed(XMMRegisterID reg)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.pshufd_irr(0, reg, reg);
+    }
+
+    // Sets each 8-bit (or 16-bit) lane of dst to all ones if it is equal to the
+    // corresponding lane of src, and to zero otherwise.
+    void compareEqualInt8Packed(XMMRegisterID src, XMMRegisterID dst)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.pcmpeqb_rr(src, dst);
+    }
+
+    void compareEqualInt16Packed(XMMRegisterID src, XMMRegisterID dst)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.pcmpeqw_rr(src, dst);
+    }
+
+    // Gathers the top bit of each 8-bit lane into the low 16 bits of dst.
+    void moveMaskInt8Packed(XMMRegisterID src, RegisterID dst)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.pmovmskb_rr(src, dst);
+    }
+
     // Stack manipulation operations:
     //
     // The ABI is assumed to provide a stack abstraction to memory,
@@ -248,6 +248,9 @@ void CodeBlock::printGetByIdOp(PrintStream& out, ExecState* exec, int location,
     case op_get_by_id_out_of_line:
         op = "get_by_id_out_of_line";
         break;
+    case op_get_by_id_polymorphic:
+        op = "get_by_id_polymorphic";
+        break;
     case op_get_by_id_self:
         op = "get_by_id_self";
         break;
@@ -338,7 +341,17 @@ void CodeBlock::printGetByIdCacheStatus(PrintStream& out, ExecState* exec, int l
 #if ENABLE(LLINT)
     if (exec->interpreter()->getOpcodeID(instruction[0].u.opcode) == op_get_array_length)
         out.printf(" llint(array_length)");
-    else if (Structure* structure = instruction[4].u.structure.get()) {
+    else if (exec->interpreter()->getOpcodeID(instruction[0].u.opcode) == op_get_by_id_polymorphic) {
+        LLIntPolymorphicAccessCache* cache = instruction[4].u.polymorphicAccessCache;
+        out.printf(" llint(polymorphic, %u misses", cache->missCount);
+        for (unsigned i = 0; i < LLIntPolymorphicAccessCache::maximumSize; ++i) {
+            if (Structure* structure = cache->structures[i].get()) {
+                out.printf(", ");
+                dumpStructure(out, "struct", exec, structure, ident);
+            }
+        }
+        out.printf(")");
+    } else if (Structure* structure = instruction[4].u.structure.get()) {
         out.printf(" llint(");
         dumpStructure(out, "struct", exec, structure, ident);
         out.printf(")");
@@ -1050,6 +1063,7 @@ void CodeBlock::dumpBytecode(PrintStream& out, ExecState* exec, const Instructio
         }
         case op_get_by_id:
         case op_get_by_id_out_of_line:
+        case op_get_by_id_polymorphic:
         case op_get_by_id_self:
         case op_get_by_id_proto:
         case op_get_by_id_chain:
@@ -1080,6 +1094,10 @@ void CodeBlock::dumpBytecode(PrintStream& out, ExecState* exec, const Instructio
             printPutByIdOp(out, exec, location, it, "put_by_id_out_of_line");
             break;
         }
+        case op_put_by_id_polymorphic: {
+            printPutByIdOp(out, exec, location, it, "put_by_id_polymorphic");
+            break;
+        }
         case op_put_by_id_replace: {
             printPutByIdOp(out, exec, location, it, "put_by_id_replace");
             break;
@@ -1614,6 +1632,9 @@ CodeBlock::CodeBlock(CopyParsedBlockTag, CodeBlock& other)
     , m_osrExitCounter(0)
     , m_optimizationDelayCounter(0)
     , m_reoptimizationRetryCounter(0)
+    , m_wasEnteredSinceLastAging(0)
+    , m_llintExecuteCountAtLastAging(0)
+    , m_codeAge(0)
     , m_resolveOperations(other.m_resolveOperations)
     , m_putToBaseOperations(other.m_putToBaseOperations)
 #if ENABLE(JIT)
@@ -1657,6 +1678,9 @@ CodeBlock::CodeBlock(ScriptExecutable* ownerExecutable, UnlinkedCodeBlock* unlin
     , m_osrExitCounter(0)
     , m_optimizationDelayCounter(0)
     , m_reoptimizationRetryCounter(0)
+    , m_wasEnteredSinceLastAging(0)
+    , m_llintExecuteCountAtLastAging(0)
+    , m_codeAge(0)
 {
     m_vm->startedCompiling(this);
 
@@ -1917,6 +1941,7 @@ CodeBlock::CodeBlock(ScriptExecutable* ownerExecutable, UnlinkedCodeBlock* unlin
 #endif
             break;
         case op_get_by_id_out_of_line:
+        case op_get_by_id_polymorphic:
         case op_get_by_id_self:
         case op_get_by_id_proto:
         case op_get_by_id_chain:
@@ -1991,6 +2016,14 @@ CodeBlock::~CodeBlock()
 #if ENABLE(LLINT)    
     while (m_incomingLLIntCalls.begin() != m_incomingLLIntCalls.end())
         m_incomingLLIntCalls.begin()->remove();
+
+    if (Options::reportLLIntPropertyCacheStatistics() && m_llintPolymorphicAccessCaches.size()) {
+        unsigned long long misses = 0;
+        for (size_t i = 0; i < m_llintPolymorphicAccessCaches.size(); ++i)
+            misses += m_llintPolymorphicAccessCaches[i].missCount;
+        // Our owner executable may already be dead, so we cannot dump ourselves in full.
+        dataLog("LLInt property caches of CodeBlock ", RawPointer(this), ": ", m_llintPolymorphicAccessCaches.size(), " polymorphic, ", misses, " misses.\n");
+    }
 #endif // ENABLE(LLINT)
 #if ENABLE(JIT)
     // We may be destroyed before any CodeBlocks that refer to us are destroyed.
@@ -2237,6 +2270,19 @@ void CodeBlock::finalizeUnconditionally()
                 curInstruction[4].u.structure.clear();
                 curInstruction[5].u.operand = 0;
                 break;
+            case op_get_by_id_polymorphic:
+            case op_put_by_id_polymorphic: {
+                LLIntPolymorphicAccessCache* cache = curInstruction[4].u.polymorphicAccessCache;
+                for (unsigned j = 0; j < LLIntPolymorphicAccessCache::maximumSize; ++j) {
+                    if (!cache->structures[j] || Heap::isMarked(cache->structures[j].get()))
+                        continue;
+                    if (verboseUnlinking)
+                        dataLogF("Clearing LLInt polymorphic property access entry with structure %p.\n", cache->structures[j].get());
+                    cache->structures[j].clear();
+                    cache->offsets[j] = 0;
+                }
+                break;
+            }
             case op_put_by_id_transition_direct:
             case op_put_by_id_transition_normal:
             case op_put_by_id_transition_direct_out_of_line:
@@ -2412,6 +2458,22 @@ void CodeBlock::resetStubDuringGCInternal(RepatchBuffer& repatchBuffer, Structur
 }
 #endif
 
+#if ENABLE(DFG_JIT)
+void CodeBlock::visitStronglyForCompilation(SlotVisitor& visitor)
+{
+    ASSERT(!m_alternative);
+    stronglyVisitStrongReferences(visitor);
+    stronglyVisitWeakReferences(visitor);
+    if (!m_rareData)
+        return;
+    for (size_t i = 0; i < m_rareData->m_inlineCallFrames.size(); ++i) {
+        InlineCallFrame& inlineCallFrame = m_rareData->m_inlineCallFrames[i];
+        visitor.append(&inlineCallFrame.executable);
+        visitor.append(&inlineCallFrame.callee);
+    }
+}
+#endif
+
 void CodeBlock::stronglyVisitStrongReferences(SlotVisitor& visitor)
 {
     visitor.append(&m_globalObject);
@@ -3103,6 +3165,26 @@ void CodeBlock::optimizeSoon()
     m_jitExecuteCounter.setNewThreshold(counterValueForOptimizeSoon(), this);
 }
 
+unsigned CodeBlock::updateCodeAge()
+{
+    // Optimized code only runs its own prologue, while OSR exits and loop OSR
+    // entries run its alternatives, so any of them having been entered counts.
+    bool wasEntered = false;
+    for (CodeBlock* codeBlock = this; codeBlock; codeBlock = codeBlock->alternative()) {
+        double llintExecuteCount = codeBlock->m_llintExecuteCounter.count();
+        if (codeBlock->m_wasEnteredSinceLastAging || llintExecuteCount != codeBlock->m_llintExecuteCountAtLastAging)
+            wasEntered = true;
+        codeBlock->m_wasEnteredSinceLastAging = 0;
+        codeBlock->m_llintExecuteCountAtLastAging = llintExecuteCount;
+    }
+
+    if (wasEntered)
+        m_codeAge = 0;
+    else if (m_codeAge < std::numeric_limits<unsigned>::max())
+        m_codeAge++;
+    return m_codeAge;
+}
+
 #if ENABLE(JIT)
 uint32_t CodeBlock::adjustedExitCountThreshold(uint32_t desiredThreshold)
 {
@@ -59,6 +59,7 @@
 #include "JumpReplacementWatchpoint.h"
 #include "JumpTable.h"
 #include "LLIntCallLinkInfo.h"
+#include "LLIntPolymorphicAccessCache.h"
 #include "LazyOperandValueProfile.h"
 #include "LineInfo.h"
 #include "ProfilerCompilation.h"
@@ -149,6 +150,12 @@ public:
 #endif
 
     void visitAggregate(SlotVisitor&);
+#if ENABLE(DFG_JIT)
+    // For a replacement that a DFG::Plan is still compiling. Nothing could jettison it
+    // if one of its weak references died before it is installed, so everything it
+    // refers to is kept alive instead.
+    void visitStronglyForCompilation(SlotVisitor&);
+#endif
 
     static void dumpStatistics();
 
@@ -252,6 +259,12 @@ public:
     {
         m_incomingLLIntCalls.push(incoming);
     }
+
+    LLIntPolymorphicAccessCache* addLLIntPolymorphicAccessCache()
+    {
+        m_llintPolymorphicAccessCaches.append(LLIntPolymorphicAccessCache());
+        return &m_llintPolymorphicAccessCaches.last();
+    }
 #endif // ENABLE(LLINT)
         
     void unlinkIncomingCalls();
@@ -1029,6 +1042,14 @@ public:
         
     static ptrdiff_t offsetOfOSRExitCounter() { return OBJECT_OFFSETOF(CodeBlock, m_osrExitCounter); }
 
+    // Code aging. Baseline and DFG code set this flag in their prologues, and
+    // the LLInt bumps its execute counter on entry, so between the two the heap
+    // can tell whether a CodeBlock, or any of its alternatives, has been entered
+    // since the last full collection. Returns the number of full collections
+    // that have gone by without that happening.
+    uint32_t* addressOfWasEnteredSinceLastAging() { return &m_wasEnteredSinceLastAging; }
+    unsigned updateCodeAge();
+
 #if ENABLE(JIT)
     uint32_t adjustedExitCountThreshold(uint32_t desiredThreshold);
     uint32_t exitCountThresholdForReoptimization();
@@ -1185,6 +1206,7 @@ private:
 #if ENABLE(LLINT)
     SegmentedVector<LLIntCallLinkInfo, 8> m_llintCallLinkInfos;
     SentinelLinkedList<LLIntCallLinkInfo, BasicRawSentinelNode<LLIntCallLinkInfo> > m_incomingLLIntCalls;
+    SegmentedVector<LLIntPolymorphicAccessCache, 4> m_llintPolymorphicAccessCaches;
 #endif
 #if ENABLE(JIT)
     Vector<StructureStubInfo> m_structureStubInfos;
@@ -1273,6 +1295,10 @@ private:
     uint16_t m_optimizationDelayCounter;
     uint16_t m_reoptimizationRetryCounter;
 
+    uint32_t m_wasEnteredSinceLastAging;
+    double m_llintExecuteCountAtLastAging;
+    unsigned m_codeAge;
+
     Vector<ResolveOperations> m_resolveOperations;
     Vector<PutToBaseOperation, 1> m_putToBaseOperations;
 
@@ -45,6 +45,9 @@ GetByIdStatus GetByIdStatus::computeFromLLInt(CodeBlock* profiledBlock, unsigned
     if (instruction[0].u.opcode == LLInt::getOpcode(llint_op_get_array_length))
         return GetByIdStatus(NoInformation, false);
 
+    if (instruction[0].u.opcode == LLInt::getOpcode(llint_op_get_by_id_polymorphic))
+        return computeFromLLIntPolymorphicAccessCache(profiledBlock, instruction[4].u.polymorphicAccessCache, ident);
+
     Structure* structure = instruction[4].u.structure.get();
     if (!structure)
         return GetByIdStatus(NoInformation, false);
@@ -64,6 +67,44 @@ GetByIdStatus GetByIdStatus::computeFromLLInt(CodeBlock* profiledBlock, unsigned
 #endif
 }
 
+#if ENABLE(LLINT)
+GetByIdStatus GetByIdStatus::computeFromLLIntPolymorphicAccessCache(CodeBlock* profiledBlock, LLIntPolymorphicAccessCache* cache, Identifier& ident)
+{
+    // We can only turn this into a simple access if every structure has the
+    // property at the same offset.
+    StructureSet structureSet;
+    PropertyOffset offset = invalidOffset;
+    JSCell* specificValue = 0;
+    for (unsigned i = 0; i < LLIntPolymorphicAccessCache::maximumSize; ++i) {
+        Structure* structure = cache->structures[i].get();
+        if (!structure)
+            continue;
+        unsigned attributesIgnored;
+        JSCell* specificValueForStructure;
+        PropertyOffset offsetForStructure = structure->get(
+            *profiledBlock->vm(), ident, attributesIgnored, specificValueForStructure);
+        if (structure->isDictionary())
+            specificValueForStructure = 0;
+        if (!isValidOffset(offsetForStructure))
+            return GetByIdStatus(TakesSlowPath, false);
+        if (!structureSet.size()) {
+            offset = offsetForStructure;
+            specificValue = specificValueForStructure;
+        } else {
+            if (offsetForStructure != offset)
+                return GetByIdStatus(TakesSlowPath, false);
+            if (specificValueForStructure != specificValue)
+                specificValue = 0;
+        }
+        structureSet.add(structure);
+    }
+
+    if (!structureSet.size())
+        return GetByIdStatus(NoInformation, false);
+    return GetByIdStatus(Simple, false, structureSet, offset, specificValue);
+}
+#endif
+
 void GetByIdStatus::computeForChain(GetByIdStatus& result, CodeBlock* profiledBlock, Identifier& ident, Structure* structure)
 {
 #if ENABLE(JIT) && ENABLE(VALUE_PROFILER)
@@ -34,6 +34,7 @@ namespace JSC {
 
 class CodeBlock;
 class Identifier;
+struct LLIntPolymorphicAccessCache;
 
 class GetByIdStatus {
 public:
@@ -92,6 +93,9 @@ public:
 private:
     static void computeForChain(GetByIdStatus& result, CodeBlock*, Identifier&, Structure*);
     static GetByIdStatus computeFromLLInt(CodeBlock*, unsigned bytecodeIndex, Identifier&);
+#if ENABLE(LLINT)
+    static GetByIdStatus computeFromLLIntPolymorphicAccessCache(CodeBlock*, LLIntPolymorphicAccessCache*, Identifier&);
+#endif
     
     State m_state;
     StructureSet m_structureSet;
@@ -44,6 +44,7 @@ class ArrayAllocationProfile;
 class ArrayProfile;
 class ObjectAllocationProfile;
 struct LLIntCallLinkInfo;
+struct LLIntPolymorphicAccessCache;
 struct ValueProfile;
 
 struct Instruction {
@@ -111,6 +112,7 @@ struct Instruction {
         Special::Pointer specialPointer;
         PropertySlot::GetValueFunc getterFunc;
         LLIntCallLinkInfo* callLinkInfo;
+        LLIntPolymorphicAccessCache* polymorphicAccessCache;
         ValueProfile* profile;
         ArrayProfile* arrayProfile;
         ArrayAllocationProfile* arrayAllocationProfile;
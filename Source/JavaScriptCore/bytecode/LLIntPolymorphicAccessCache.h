@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef LLIntPolymorphicAccessCache_h
+#define LLIntPolymorphicAccessCache_h
+
+#include "Structure.h"
+#include "WriteBarrier.h"
+
+namespace JSC {
+
+// The cache of a get_by_id or put_by_id that the LLInt has seen more than one
+// structure at. The LLInt checks the entries in order; the slow path fills empty
+// entries first and then replaces them round-robin. Structures are held weakly:
+// CodeBlock::finalizeUnconditionally() clears entries whose structure has died.
+//
+// The structures and offsets are kept in parallel arrays so that the LLInt can
+// index them. An offset is relative to the object if the property is in inline
+// storage, in which case it is positive, or relative to the butterfly if it is
+// in out-of-line storage, in which case it is negative.
+struct LLIntPolymorphicAccessCache {
+    static const unsigned maximumSize = 4;
+
+    LLIntPolymorphicAccessCache()
+        : missCount(0)
+        , nextEntryToReplace(0)
+    {
+        for (unsigned i = 0; i < maximumSize; ++i)
+            offsets[i] = 0;
+    }
+
+    void add(VM& vm, JSCell* owner, Structure* structure, int offset, unsigned size)
+    {
+        ASSERT(size >= 2 && size <= maximumSize);
+        unsigned index = indexOf(structure, size);
+        if (index == size)
+            index = indexOf(0, size);
+        if (index == size) {
+            index = nextEntryToReplace;
+            nextEntryToReplace = (nextEntryToReplace + 1) % size;
+        }
+        structures[index].set(vm, owner, structure);
+        offsets[index] = offset;
+    }
+
+    unsigned indexOf(Structure* structure, unsigned size) const
+    {
+        unsigned index;
+        for (index = 0; index < size; ++index) {
+            if (structures[index].get() == structure)
+                break;
+        }
+        return index;
+    }
+
+    unsigned numberOfEntries() const
+    {
+        unsigned result = 0;
+        for (unsigned i = 0; i < maximumSize; ++i) {
+            if (structures[i])
+                result++;
+        }
+        return result;
+    }
+
+    WriteBarrier<Structure> structures[maximumSize];
+    int offsets[maximumSize];
+
+    // Counted by the slow paths, and reported if
+    // Options::reportLLIntPropertyCacheStatistics() is set. Hits are not counted, so
+    // that the LLInt fast paths do not write to the cache.
+    unsigned missCount;
+
+    unsigned nextEntryToReplace;
+};
+
+} // namespace JSC
+
+#endif // LLIntPolymorphicAccessCache_h
@@ -123,6 +123,7 @@ namespace JSC {
     macro(op_init_global_const_check, 5) \
     macro(op_get_by_id, 9) /* has value profiling */ \
     macro(op_get_by_id_out_of_line, 9) /* has value profiling */ \
+    macro(op_get_by_id_polymorphic, 9) /* has value profiling */ \
     macro(op_get_by_id_self, 9) /* has value profiling */ \
     macro(op_get_by_id_proto, 9) /* has value profiling */ \
     macro(op_get_by_id_chain, 9) /* has value profiling */ \
@@ -138,6 +139,7 @@ namespace JSC {
     macro(op_get_arguments_length, 4) \
     macro(op_put_by_id, 9) \
     macro(op_put_by_id_out_of_line, 9) \
+    macro(op_put_by_id_polymorphic, 9) \
     macro(op_put_by_id_transition, 9) \
     macro(op_put_by_id_transition_direct, 9) \
     macro(op_put_by_id_transition_direct_out_of_line, 9) \
@@ -43,6 +43,22 @@ PutByIdStatus PutByIdStatus::computeFromLLInt(CodeBlock* profiledBlock, unsigned
 #if ENABLE(LLINT)
     Instruction* instruction = profiledBlock->instructions().begin() + bytecodeIndex;
 
+    if (instruction[0].u.opcode == LLInt::getOpcode(llint_op_put_by_id_polymorphic)) {
+        // We can only describe a replace at a single structure.
+        LLIntPolymorphicAccessCache* cache = instruction[4].u.polymorphicAccessCache;
+        if (cache->numberOfEntries() != 1)
+            return PutByIdStatus(cache->numberOfEntries() ? TakesSlowPath : NoInformation);
+        for (unsigned i = 0; i < LLIntPolymorphicAccessCache::maximumSize; ++i) {
+            Structure* structure = cache->structures[i].get();
+            if (!structure)
+                continue;
+            PropertyOffset offset = structure->get(*profiledBlock->vm(), ident);
+            if (!isValidOffset(offset))
+                return PutByIdStatus(NoInformation, 0, 0, 0, invalidOffset);
+            return PutByIdStatus(SimpleReplace, structure, 0, 0, offset);
+        }
+    }
+
     Structure* structure = instruction[4].u.structure.get();
     if (!structure)
         return PutByIdStatus(NoInformation, 0, 0, 0, invalidOffset);
@@ -97,6 +97,27 @@ UnlinkedFunctionExecutable::UnlinkedFunctionExecutable(VM* vm, Structure* struct
     , m_sourceLength(node->source().length())
     , m_features(node->features())
     , m_functionNameIsInScopeToggle(node->functionNameIsInScopeToggle())
+    , m_cachedCodeBlockForCallOffset(0)
+    , m_cachedCodeBlockForConstructOffset(0)
+{
+}
+
+UnlinkedFunctionExecutable::UnlinkedFunctionExecutable(VM* vm, Structure* structure)
+    : Base(*vm, structure)
+    , m_numCapturedVariables(0)
+    , m_forceUsesArguments(false)
+    , m_isInStrictContext(false)
+    , m_hasCapturedVariables(false)
+    , m_firstLineOffset(0)
+    , m_lineCount(0)
+    , m_functionStartOffset(0)
+    , m_functionStartColumn(0)
+    , m_startOffset(0)
+    , m_sourceLength(0)
+    , m_features(0)
+    , m_functionNameIsInScopeToggle(FunctionNameIsNotInScope)
+    , m_cachedCodeBlockForCallOffset(0)
+    , m_cachedCodeBlockForConstructOffset(0)
 {
 }
 
@@ -158,7 +179,11 @@ UnlinkedFunctionCodeBlock* UnlinkedFunctionExecutable::codeBlockFor(VM& vm, JSSc
         break;
     }
 
-    UnlinkedFunctionCodeBlock* result = generateFunctionCodeBlock(vm, scope, this, source, specializationKind, debuggerMode, profilerMode, error);
+    UnlinkedFunctionCodeBlock* result = 0;
+    if (debuggerMode == DebuggerOff && profilerMode == ProfilerOff)
+        result = cachedCodeBlockFor(vm, specializationKind);
+    if (!result)
+        result = generateFunctionCodeBlock(vm, scope, this, source, specializationKind, debuggerMode, profilerMode, error);
     
     if (error.m_type != ParserError::ErrorNone)
         return 0;
@@ -176,6 +201,16 @@ UnlinkedFunctionCodeBlock* UnlinkedFunctionExecutable::codeBlockFor(VM& vm, JSSc
     return result;
 }
 
+UnlinkedFunctionCodeBlock* UnlinkedFunctionExecutable::cachedCodeBlockFor(VM& vm, CodeSpecializationKind specializationKind)
+{
+    if (!m_bytecodeCacheFile)
+        return 0;
+    unsigned offset = specializationKind == CodeForCall ? m_cachedCodeBlockForCallOffset : m_cachedCodeBlockForConstructOffset;
+    if (!offset)
+        return 0;
+    return m_bytecodeCacheFile->readFunctionCodeBlock(vm, offset);
+}
+
 String UnlinkedFunctionExecutable::paramString() const
 {
     FunctionParameters& parameters = *m_parameters;
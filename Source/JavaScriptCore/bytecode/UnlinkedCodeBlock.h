@@ -26,6 +26,7 @@
 #ifndef UnlinkedCodeBlock_h
 #define UnlinkedCodeBlock_h
 
+#include "BytecodeCache.h"
 #include "BytecodeConventions.h"
 #include "CodeCache.h"
 #include "CodeSpecializationKind.h"
@@ -80,6 +81,8 @@ struct ExecutableInfo {
 
 class UnlinkedFunctionExecutable : public JSCell {
 public:
+    friend class BytecodeCacheReader;
+    friend class BytecodeCacheWriter;
     friend class CodeCache;
     typedef JSCell Base;
     static UnlinkedFunctionExecutable* create(VM* vm, const SourceCode& source, FunctionBodyNode* node)
@@ -143,6 +146,10 @@ public:
 
 private:
     UnlinkedFunctionExecutable(VM*, Structure*, const SourceCode&, FunctionBodyNode*);
+    UnlinkedFunctionExecutable(VM*, Structure*);
+
+    UnlinkedFunctionCodeBlock* cachedCodeBlockFor(VM&, CodeSpecializationKind);
+
     WriteBarrier<UnlinkedFunctionCodeBlock> m_codeBlockForCall;
     WriteBarrier<UnlinkedFunctionCodeBlock> m_codeBlockForConstruct;
 
@@ -168,6 +175,12 @@ private:
 
     FunctionNameIsInScopeToggle m_functionNameIsInScopeToggle;
 
+    // Set if we were read from a bytecode cache file, in which case our code blocks
+    // may still be sitting, encoded, at these offsets within it.
+    RefPtr<BytecodeCacheFile> m_bytecodeCacheFile;
+    unsigned m_cachedCodeBlockForCallOffset;
+    unsigned m_cachedCodeBlockForConstructOffset;
+
 protected:
     void finishCreation(VM& vm)
     {
@@ -234,6 +247,8 @@ struct UnlinkedInstruction {
 
 class UnlinkedCodeBlock : public JSCell {
 public:
+    friend class BytecodeCacheReader;
+    friend class BytecodeCacheWriter;
     typedef JSCell Base;
     static const bool needsDestruction = true;
     static const bool hasImmortalStructure = true;
@@ -592,6 +607,7 @@ protected:
 
 class UnlinkedProgramCodeBlock : public UnlinkedGlobalCodeBlock {
 private:
+    friend class BytecodeCacheReader;
     friend class CodeCache;
     static UnlinkedProgramCodeBlock* create(VM* vm, const ExecutableInfo& info)
     {
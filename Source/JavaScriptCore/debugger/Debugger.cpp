@@ -119,6 +119,9 @@ void Debugger::recompileAllJSFunctions(VM* vm)
     if (vm->dynamicGlobalObject)
         return;
 
+    // Throwing away code in the middle of incremental marking is not allowed.
+    vm->heap.finishIncrementalMarking();
+
     Recompiler recompiler(this);
     vm->heap.objectSpace().forEachLiveCell(recompiler);
 }
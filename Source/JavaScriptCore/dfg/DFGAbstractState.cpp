@@ -1287,7 +1287,7 @@ bool AbstractState::executeEffects(unsigned indexInBlock, Node* node)
             m_isValid = false;
             break;
         }
-        if (isCellSpeculation(node->child1()->prediction())) {
+        if (isCellSpeculation(node->child1()->prediction()) && m_graph.canQueryStructures()) {
             if (Structure* structure = forNode(node->child1()).bestProvenStructure()) {
                 GetByIdStatus status = GetByIdStatus::computeFor(
                     m_graph.m_vm, structure,
@@ -1485,6 +1485,10 @@ bool AbstractState::executeEffects(unsigned indexInBlock, Node* node)
     case PutById:
     case PutByIdDirect:
         node->setCanExit(true);
+        if (!m_graph.canQueryStructures()) {
+            clobberWorld(node->codeOrigin, indexInBlock);
+            break;
+        }
         if (Structure* structure = forNode(node->child1()).bestProvenStructure()) {
             PutByIdStatus status = PutByIdStatus::computeFor(
                 m_graph.m_vm,
@@ -43,10 +43,12 @@ typedef void (*V_DFGDebugOperation_EPP)(ExecState*, void*, void*);
 
 class AssemblyHelpers : public MacroAssembler {
 public:
-    AssemblyHelpers(VM* vm, CodeBlock* codeBlock)
+    // The baseline CodeBlock may be passed explicitly when compiling a replacement
+    // that has not been linked to its alternative yet.
+    AssemblyHelpers(VM* vm, CodeBlock* codeBlock, CodeBlock* baselineCodeBlock = 0)
         : m_vm(vm)
         , m_codeBlock(codeBlock)
-        , m_baselineCodeBlock(codeBlock ? codeBlock->baselineVersion() : 0)
+        , m_baselineCodeBlock(baselineCodeBlock ? baselineCodeBlock : codeBlock ? codeBlock->baselineVersion() : 0)
     {
         if (m_codeBlock) {
             ASSERT(m_baselineCodeBlock);
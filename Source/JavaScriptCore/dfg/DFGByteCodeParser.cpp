@@ -1924,9 +1924,10 @@ bool ByteCodeParser::parseResolveOperations(SpeculatedType prediction, unsigned
         // executes once, we use the following performance trade-off:
         // - The node refers directly to the register pointer to make CSE super cheap.
         // - To perform backend code generation, the node only contains the identifier
-        //   number, from which it is possible to get (via a few average-time O(1)
-        //   lookups) to the WatchpointSet.
+        //   number, from which the graph gets us to the WatchpointSet. We look the set
+        //   up here since the backend may not be running on the main thread.
 
+        m_graph.addGlobalVarWatchpointSet(globalObject, identifier, entry.watchpointSet());
         addToGraph(GlobalVarWatchpoint, OpInfo(globalObject->assertRegisterIsInThisObject(pc->m_registerAddress)), OpInfo(identifier));
 
         JSValue specificValue = globalObject->registerAt(entry.getIndex()).get();
@@ -2557,6 +2558,7 @@ bool ByteCodeParser::parseBlock(unsigned limit)
             
         case op_get_by_id:
         case op_get_by_id_out_of_line:
+        case op_get_by_id_polymorphic:
         case op_get_array_length: {
             SpeculatedType prediction = getPrediction();
             
@@ -2574,6 +2576,7 @@ bool ByteCodeParser::parseBlock(unsigned limit)
         }
         case op_put_by_id:
         case op_put_by_id_out_of_line:
+        case op_put_by_id_polymorphic:
         case op_put_by_id_transition_direct:
         case op_put_by_id_transition_normal:
         case op_put_by_id_transition_direct_out_of_line:
@@ -2717,6 +2720,7 @@ bool ByteCodeParser::parseBlock(unsigned limit)
                     value);
                 NEXT_OPCODE(op_init_global_const_check);
             }
+            m_graph.addGlobalVarWatchpointSet(globalObject, identifierNumber, entry.watchpointSet());
             addToGraph(
                 PutGlobalVarCheck,
                 OpInfo(codeBlock->globalObject()->assertRegisterIsInThisObject(currentInstruction[1].u.registerPointer)),
@@ -3175,6 +3179,7 @@ bool ByteCodeParser::parseBlock(unsigned limit)
                 JSGlobalObject* globalObject = codeBlock->globalObject();
                 SymbolTableEntry entry = globalObject->symbolTable()->get(m_codeBlock->identifier(identifier).impl());
                 if (entry.couldBeWatched()) {
+                    m_graph.addGlobalVarWatchpointSet(globalObject, identifier, entry.watchpointSet());
                     addToGraph(PutGlobalVarCheck,
                                OpInfo(codeBlock->globalObject()->assertRegisterIsInThisObject(putToBase->m_registerAddress)),
                                OpInfo(identifier),
@@ -3771,11 +3776,10 @@ bool ByteCodeParser::parse()
     return true;
 }
 
-bool parse(ExecState*, Graph& graph)
+bool parse(Graph& graph)
 {
     SamplingRegion samplingRegion("DFG Parsing");
 #if DFG_DEBUG_LOCAL_DISBALE
-    UNUSED_PARAM(exec);
     UNUSED_PARAM(graph);
     return false;
 #else
@@ -37,8 +37,8 @@ namespace JSC { namespace DFG {
 
 class CCallHelpers : public AssemblyHelpers {
 public:
-    CCallHelpers(VM* vm, CodeBlock* codeBlock = 0)
-        : AssemblyHelpers(vm, codeBlock)
+    CCallHelpers(VM* vm, CodeBlock* codeBlock = 0, CodeBlock* baselineCodeBlock = 0)
+        : AssemblyHelpers(vm, codeBlock, baselineCodeBlock)
     {
     }
 
@@ -130,9 +130,11 @@ inline CapabilityLevel canCompileOpcode(OpcodeID opcodeID, CodeBlock*, Instructi
     case op_put_by_val:
     case op_get_by_id:
     case op_get_by_id_out_of_line:
+    case op_get_by_id_polymorphic:
     case op_get_array_length:
     case op_put_by_id:
     case op_put_by_id_out_of_line:
+    case op_put_by_id_polymorphic:
     case op_put_by_id_transition_direct:
     case op_put_by_id_transition_direct_out_of_line:
     case op_put_by_id_transition_normal:
@@ -147,6 +147,9 @@ private:
                 if (childEdge.useKind() != CellUse)
                     break;
                 
+                if (!m_graph.canQueryStructures())
+                    break;
+                
                 Structure* structure = m_state.forNode(child).bestProvenStructure();
                 if (!structure)
                     break;
@@ -212,6 +215,9 @@ private:
                 
                 ASSERT(childEdge.useKind() == CellUse);
                 
+                if (!m_graph.canQueryStructures())
+                    break;
+                
                 Structure* structure = m_state.forNode(child).bestProvenStructure();
                 if (!structure)
                     break;
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DFGDesiredWatchpoints.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "JSFunction.h"
+#include "Operations.h"
+#include "SlotVisitorInlines.h"
+#include "Structure.h"
+#include "Watchpoint.h"
+
+namespace JSC { namespace DFG {
+
+DesiredWatchpoints::DesiredWatchpoints() { }
+DesiredWatchpoints::~DesiredWatchpoints() { }
+
+void DesiredWatchpoints::addLazily(WatchpointSet* set, Watchpoint* watchpoint)
+{
+    // speculationWatchpoint() returns null once the compilation has already failed.
+    if (!watchpoint)
+        return;
+    m_sets.append(Desired<WatchpointSet>(set, watchpoint));
+}
+
+void DesiredWatchpoints::addTransitionWatchpointLazily(Structure* structure, Watchpoint* watchpoint)
+{
+    if (!watchpoint)
+        return;
+    m_transitions.append(Desired<Structure>(structure, watchpoint));
+}
+
+void DesiredWatchpoints::addAllocationProfileWatchpointLazily(JSFunction* function, Watchpoint* watchpoint)
+{
+    if (!watchpoint)
+        return;
+    m_allocationProfiles.append(Desired<JSFunction>(function, watchpoint));
+}
+
+bool DesiredWatchpoints::areStillValid() const
+{
+    for (size_t i = 0; i < m_sets.size(); ++i) {
+        if (!m_sets[i].object->isStillValid())
+            return false;
+    }
+    for (size_t i = 0; i < m_transitions.size(); ++i) {
+        if (!m_transitions[i].object->transitionWatchpointSetIsStillValid())
+            return false;
+    }
+    for (size_t i = 0; i < m_allocationProfiles.size(); ++i) {
+        if (!m_allocationProfiles[i].object->tryGetAllocationProfile())
+            return false;
+    }
+    return true;
+}
+
+void DesiredWatchpoints::reallyAdd()
+{
+    ASSERT(areStillValid());
+    for (size_t i = 0; i < m_sets.size(); ++i)
+        m_sets[i].object->add(m_sets[i].watchpoint);
+    for (size_t i = 0; i < m_transitions.size(); ++i)
+        m_transitions[i].object->addTransitionWatchpoint(m_transitions[i].watchpoint);
+    for (size_t i = 0; i < m_allocationProfiles.size(); ++i)
+        m_allocationProfiles[i].object->addAllocationProfileWatchpoint(m_allocationProfiles[i].watchpoint);
+    m_sets.clear();
+    m_transitions.clear();
+    m_allocationProfiles.clear();
+}
+
+void DesiredWatchpoints::visitChildren(SlotVisitor& visitor)
+{
+    // The watchpoint sets themselves belong to cells that the code block keeps alive.
+    for (size_t i = 0; i < m_transitions.size(); ++i)
+        visitor.appendUnbarrieredPointer(&m_transitions[i].object);
+    for (size_t i = 0; i < m_allocationProfiles.size(); ++i)
+        visitor.appendUnbarrieredPointer(&m_allocationProfiles[i].object);
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DFGDesiredWatchpoints_h
+#define DFGDesiredWatchpoints_h
+
+#include <wtf/Platform.h>
+
+#if ENABLE(DFG_JIT)
+
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class JSFunction;
+class SlotVisitor;
+class Structure;
+class Watchpoint;
+class WatchpointSet;
+
+namespace DFG {
+
+// Watchpoints that the generated code relies on. Code generation may run on a
+// compiler thread, which must not mutate watchpoint sets owned by the main thread,
+// so it only records what it wants here. Once we are back on the main thread,
+// areStillValid() tells us whether any of the sets fired in the meantime, in which
+// case the code must be thrown away, and reallyAdd() registers the watchpoints.
+class DesiredWatchpoints {
+public:
+    DesiredWatchpoints();
+    ~DesiredWatchpoints();
+
+    void addLazily(WatchpointSet*, Watchpoint*);
+    void addTransitionWatchpointLazily(Structure*, Watchpoint*);
+    void addAllocationProfileWatchpointLazily(JSFunction*, Watchpoint*);
+
+    bool areStillValid() const;
+    void reallyAdd();
+
+    void visitChildren(SlotVisitor&);
+
+private:
+    template<typename T>
+    struct Desired {
+        Desired() : object(0), watchpoint(0) { }
+        Desired(T* object, Watchpoint* watchpoint) : object(object), watchpoint(watchpoint) { }
+
+        T* object;
+        Watchpoint* watchpoint;
+    };
+
+    Vector<Desired<WatchpointSet> > m_sets;
+    Vector<Desired<Structure> > m_transitions;
+    Vector<Desired<JSFunction> > m_allocationProfiles;
+};
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
+#endif // DFGDesiredWatchpoints_h
+
@@ -32,23 +32,10 @@
 
 #if ENABLE(DFG_JIT)
 
-#include "DFGArgumentsSimplificationPhase.h"
-#include "DFGBackwardsPropagationPhase.h"
-#include "DFGByteCodeParser.h"
-#include "DFGCFAPhase.h"
-#include "DFGCFGSimplificationPhase.h"
-#include "DFGCPSRethreadingPhase.h"
-#include "DFGCSEPhase.h"
-#include "DFGConstantFoldingPhase.h"
-#include "DFGDCEPhase.h"
-#include "DFGFixupPhase.h"
+#include "CodeBlock.h"
 #include "DFGJITCompiler.h"
-#include "DFGPredictionInjectionPhase.h"
-#include "DFGPredictionPropagationPhase.h"
-#include "DFGTypeCheckHoistingPhase.h"
-#include "DFGUnificationPhase.h"
-#include "DFGValidate.h"
-#include "DFGVirtualRegisterAllocationPhase.h"
+#include "DFGPlan.h"
+#include "DFGWorklist.h"
 #include "Operations.h"
 #include "Options.h"
 
@@ -61,19 +48,8 @@ unsigned getNumCompilations()
     return numCompilations;
 }
 
-enum CompileMode { CompileFunction, CompileOther };
-inline bool compile(CompileMode compileMode, ExecState* exec, CodeBlock* codeBlock, JITCode& jitCode, MacroAssemblerCodePtr* jitCodeWithArityCheck, unsigned osrEntryBytecodeIndex)
+static bool shouldCompile(CodeBlock* codeBlock)
 {
-    SamplingRegion samplingRegion("DFG Compilation (Driver)");
-    
-    numCompilations++;
-    
-    ASSERT(codeBlock);
-    ASSERT(codeBlock->alternative());
-    ASSERT(codeBlock->alternative()->getJITType() == JITCode::BaselineJIT);
-    
-    ASSERT(osrEntryBytecodeIndex != UINT_MAX);
-
     if (!Options::useDFGJIT())
         return false;
 
@@ -82,15 +58,20 @@ inline bool compile(CompileMode compileMode, ExecState* exec, CodeBlock* codeBlo
 
     if (logCompilationChanges())
         dataLog("DFG compiling ", *codeBlock, ", number of instructions = ", codeBlock->instructionCount(), "\n");
-    
-    // Derive our set of must-handle values. The compilation must be at least conservative
-    // enough to allow for OSR entry with these values.
+
+    return true;
+}
+
+// Derive our set of must-handle values. The compilation must be at least conservative
+// enough to allow for OSR entry with these values.
+static void computeMustHandleValues(CompileMode compileMode, ExecState* exec, CodeBlock* codeBlock, unsigned osrEntryBytecodeIndex, Operands<JSValue>& mustHandleValues)
+{
     unsigned numVarsWithValues;
     if (osrEntryBytecodeIndex)
         numVarsWithValues = codeBlock->m_numVars;
     else
         numVarsWithValues = 0;
-    Operands<JSValue> mustHandleValues(codeBlock->numParameters(), numVarsWithValues);
+    mustHandleValues = Operands<JSValue>(codeBlock->numParameters(), numVarsWithValues);
     for (size_t i = 0; i < mustHandleValues.size(); ++i) {
         int operand = mustHandleValues.operandForIndex(i);
         if (operandIsArgument(operand)
@@ -105,71 +86,82 @@ inline bool compile(CompileMode compileMode, ExecState* exec, CodeBlock* codeBlo
         } else
             mustHandleValues[i] = exec->uncheckedR(operand).jsValue();
     }
+}
+
+inline bool compile(CompileMode compileMode, ExecState* exec, CodeBlock* codeBlock, JITCode& jitCode, MacroAssemblerCodePtr* jitCodeWithArityCheck, unsigned osrEntryBytecodeIndex)
+{
+    SamplingRegion samplingRegion("DFG Compilation (Driver)");
     
-    Graph dfg(exec->vm(), codeBlock, osrEntryBytecodeIndex, mustHandleValues);
-    if (!parse(exec, dfg))
-        return false;
-    
-    // By this point the DFG bytecode parser will have potentially mutated various tables
-    // in the CodeBlock. This is a good time to perform an early shrink, which is more
-    // powerful than a late one. It's safe to do so because we haven't generated any code
-    // that references any of the tables directly, yet.
-    codeBlock->shrinkToFit(CodeBlock::EarlyShrink);
-
-    if (validationEnabled())
-        validate(dfg);
-    
-    performCPSRethreading(dfg);
-    performUnification(dfg);
-    performPredictionInjection(dfg);
-    
-    if (validationEnabled())
-        validate(dfg);
-    
-    performBackwardsPropagation(dfg);
-    performPredictionPropagation(dfg);
-    performFixup(dfg);
-    performTypeCheckHoisting(dfg);
+    numCompilations++;
     
-    dfg.m_fixpointState = FixpointNotConverged;
-
-    performCSE(dfg);
-    performArgumentsSimplification(dfg);
-    performCPSRethreading(dfg); // This should usually be a no-op since CSE rarely dethreads, and arguments simplification rarely does anything.
-    performCFA(dfg);
-    performConstantFolding(dfg);
-    performCFGSimplification(dfg);
-
-    dfg.m_fixpointState = FixpointConverged;
-
-    performStoreElimination(dfg);
-    performCPSRethreading(dfg);
-    performDCE(dfg);
-    performVirtualRegisterAllocation(dfg);
-
-    GraphDumpMode modeForFinalValidate = DumpGraph;
-    if (verboseCompilationEnabled()) {
-        dataLogF("Graph after optimization:\n");
-        dfg.dump();
-        modeForFinalValidate = DontDumpGraph;
-    }
-    if (validationEnabled())
-        validate(dfg, modeForFinalValidate);
+    ASSERT(codeBlock);
+    ASSERT(codeBlock->alternative());
+    ASSERT(codeBlock->alternative()->getJITType() == JITCode::BaselineJIT);
     
-    JITCompiler dataFlowJIT(dfg);
-    bool result;
+    ASSERT(osrEntryBytecodeIndex != UINT_MAX);
+
+    if (!shouldCompile(codeBlock))
+        return false;
+
+    Operands<JSValue> mustHandleValues;
+    computeMustHandleValues(compileMode, exec, codeBlock, osrEntryBytecodeIndex, mustHandleValues);
+
+    RefPtr<Plan> plan = adoptRef(new Plan(compileMode, codeBlock, osrEntryBytecodeIndex, mustHandleValues));
+    if (!plan->parse())
+        return false;
+    if (!plan->compileInThread())
+        return false;
+    if (!plan->finalizeWatchpoints())
+        return false;
+
+    jitCode = plan->jitCode();
     if (compileMode == CompileFunction) {
         ASSERT(jitCodeWithArityCheck);
-        
-        result = dataFlowJIT.compileFunction(jitCode, *jitCodeWithArityCheck);
-    } else {
-        ASSERT(compileMode == CompileOther);
+        *jitCodeWithArityCheck = plan->jitCodeWithArityCheck();
+    } else
         ASSERT(!jitCodeWithArityCheck);
-        
-        result = dataFlowJIT.compile(jitCode);
+    return true;
+}
+
+static PassOwnPtr<CodeBlock> createReplacement(CodeBlock* profiledBlock)
+{
+    switch (profiledBlock->codeType()) {
+    case GlobalCode:
+        return adoptPtr(new ProgramCodeBlock(CodeBlock::CopyParsedBlock, *static_cast<ProgramCodeBlock*>(profiledBlock)));
+    case EvalCode:
+        return adoptPtr(new EvalCodeBlock(CodeBlock::CopyParsedBlock, *static_cast<EvalCodeBlock*>(profiledBlock)));
+    case FunctionCode:
+        return adoptPtr(new FunctionCodeBlock(CodeBlock::CopyParsedBlock, *static_cast<FunctionCodeBlock*>(profiledBlock)));
     }
-    
-    return result;
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+
+bool enqueueCompilation(ExecState* exec, CodeBlock* profiledBlock, unsigned bytecodeIndex)
+{
+    SamplingRegion samplingRegion("DFG Compilation (Enqueue)");
+
+    VM& vm = exec->vm();
+    Worklist* worklist = vm.dfgWorklist();
+    ASSERT(worklist);
+    ASSERT(profiledBlock->getJITType() == JITCode::BaselineJIT);
+    ASSERT(worklist->compilationState(profiledBlock) == Worklist::NotKnown);
+
+    numCompilations++;
+
+    if (!vm.canUseJIT() || !shouldCompile(profiledBlock))
+        return false;
+
+    CompileMode compileMode = profiledBlock->codeType() == FunctionCode ? CompileFunction : CompileOther;
+    Operands<JSValue> mustHandleValues;
+    computeMustHandleValues(compileMode, exec, profiledBlock, bytecodeIndex, mustHandleValues);
+
+    RefPtr<Plan> plan = adoptRef(new Plan(compileMode, createReplacement(profiledBlock), profiledBlock, bytecodeIndex, mustHandleValues));
+    if (!plan->parse())
+        return false;
+
+    worklist->enqueue(plan.release());
+    return true;
 }
 
 bool tryCompile(ExecState* exec, CodeBlock* codeBlock, JITCode& jitCode, unsigned bytecodeIndex)
@@ -43,9 +43,14 @@ JS_EXPORT_PRIVATE unsigned getNumCompilations();
 #if ENABLE(DFG_JIT)
 bool tryCompile(ExecState*, CodeBlock*, JITCode&, unsigned bytecodeIndex);
 bool tryCompileFunction(ExecState*, CodeBlock*, JITCode&, MacroAssemblerCodePtr& jitCodeWithArityCheck, unsigned bytecodeIndex);
+
+// Parses the given baseline CodeBlock on the current thread and hands the rest of
+// the compilation to the VM's DFG::Worklist. Only valid when concurrent JIT is on.
+bool enqueueCompilation(ExecState*, CodeBlock* profiledBlock, unsigned bytecodeIndex);
 #else
 inline bool tryCompile(ExecState*, CodeBlock*, JITCode&, unsigned) { return false; }
 inline bool tryCompileFunction(ExecState*, CodeBlock*, JITCode&, MacroAssemblerCodePtr&, unsigned) { return false; }
+inline bool enqueueCompilation(ExecState*, CodeBlock*, unsigned) { return false; }
 #endif
 
 } } // namespace JSC::DFG
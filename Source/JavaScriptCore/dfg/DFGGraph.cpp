@@ -31,6 +31,7 @@
 #include "DFGVariableAccessDataDump.h"
 #include "FunctionExecutableDump.h"
 #include "Operations.h"
+#include "SlotVisitorInlines.h"
 #include <wtf/CommaPrinter.h>
 
 #if ENABLE(DFG_JIT)
@@ -44,12 +45,12 @@ static const char* dfgOpNames[] = {
 #undef STRINGIZE_DFG_OP_ENUM
 };
 
-Graph::Graph(VM& vm, CodeBlock* codeBlock, unsigned osrEntryBytecodeIndex, const Operands<JSValue>& mustHandleValues)
+Graph::Graph(VM& vm, CodeBlock* codeBlock, CodeBlock* profiledBlock, LongLivedState& longLivedState, unsigned osrEntryBytecodeIndex, const Operands<JSValue>& mustHandleValues)
     : m_vm(vm)
     , m_codeBlock(codeBlock)
     , m_compilation(vm.m_perBytecodeProfiler ? vm.m_perBytecodeProfiler->newCompilation(codeBlock, Profiler::DFG) : 0)
-    , m_profiledBlock(codeBlock->alternative())
-    , m_allocator(vm.m_dfgState->m_allocator)
+    , m_profiledBlock(profiledBlock)
+    , m_allocator(longLivedState.m_allocator)
     , m_hasArguments(false)
     , m_osrEntryBytecodeIndex(osrEntryBytecodeIndex)
     , m_mustHandleValues(mustHandleValues)
@@ -57,6 +58,7 @@ Graph::Graph(VM& vm, CodeBlock* codeBlock, unsigned osrEntryBytecodeIndex, const
     , m_form(LoadStore)
     , m_unificationState(LocallyUnified)
     , m_refCountState(EverythingIsLive)
+    , m_isConcurrent(false)
 {
     ASSERT(m_profiledBlock);
 }
@@ -66,6 +68,50 @@ Graph::~Graph()
     m_allocator.freeAll();
 }
 
+void Graph::visitChildren(SlotVisitor& visitor)
+{
+    for (BlockIndex blockIndex = 0; blockIndex < m_blocks.size(); ++blockIndex) {
+        BasicBlock* block = m_blocks[blockIndex].get();
+        if (!block)
+            continue;
+        for (unsigned indexInBlock = 0; indexInBlock < block->size(); ++indexInBlock) {
+            Node* node = block->at(indexInBlock);
+            JSCell* cell = 0;
+            if (node->isWeakConstant())
+                cell = node->weakConstant();
+            else if (node->hasStructure())
+                cell = node->structure();
+            else if (node->hasFunction())
+                cell = node->function();
+            else if (node->hasExecutable())
+                cell = node->executable();
+            if (cell)
+                visitor.appendUnbarrieredPointer(&cell);
+        }
+    }
+
+    for (unsigned i = 0; i < m_structureSet.size(); ++i) {
+        StructureSet& set = m_structureSet[i];
+        for (size_t j = 0; j < set.size(); ++j) {
+            Structure* structure = set[j];
+            visitor.appendUnbarrieredPointer(&structure);
+        }
+    }
+    for (unsigned i = 0; i < m_structureTransitionData.size(); ++i) {
+        visitor.appendUnbarrieredPointer(&m_structureTransitionData[i].previousStructure);
+        visitor.appendUnbarrieredPointer(&m_structureTransitionData[i].newStructure);
+    }
+
+    HashSet<ExecutableBase*>::iterator end = m_executablesWhoseArgumentsEscaped.end();
+    for (HashSet<ExecutableBase*>::iterator iter = m_executablesWhoseArgumentsEscaped.begin(); iter != end; ++iter) {
+        ExecutableBase* executable = *iter;
+        visitor.appendUnbarrieredPointer(&executable);
+    }
+
+    for (size_t i = 0; i < m_mustHandleValues.size(); ++i)
+        visitor.appendUnbarrieredValue(&m_mustHandleValues[i]);
+}
+
 const char *Graph::opName(NodeType op)
 {
     return dfgOpNames[op];
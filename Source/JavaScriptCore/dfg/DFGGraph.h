@@ -50,6 +50,8 @@ namespace JSC {
 
 class CodeBlock;
 class ExecState;
+class SlotVisitor;
+class WatchpointSet;
 
 namespace DFG {
 
@@ -89,7 +91,7 @@ enum AddSpeculationMode {
 // Nodes that are 'dead' remain in the vector with refCount 0.
 class Graph {
 public:
-    Graph(VM&, CodeBlock*, unsigned osrEntryBytecodeIndex, const Operands<JSValue>& mustHandleValues);
+    Graph(VM&, CodeBlock*, CodeBlock* profiledBlock, LongLivedState&, unsigned osrEntryBytecodeIndex, const Operands<JSValue>& mustHandleValues);
     ~Graph();
     
     void changeChild(Edge& edge, Node* newNode)
@@ -692,6 +694,27 @@ public:
         }
     }
     
+    // Looking a property up in a Structure may materialize its property table, which
+    // only the thread that owns the VM may do. Concurrent compilations skip the
+    // optimizations that need such lookups.
+    bool canQueryStructures() const { return !m_isConcurrent; }
+
+    // The symbol table may only be read on the main thread, so the parser records the
+    // watchpoint set of every global variable that the generated code checks.
+    void addGlobalVarWatchpointSet(JSGlobalObject* globalObject, unsigned identifierNumber, WatchpointSet* set)
+    {
+        m_globalVarWatchpointSets.add(std::make_pair(globalObject, identifierNumber), set);
+    }
+    WatchpointSet* globalVarWatchpointSetFor(JSGlobalObject* globalObject, unsigned identifierNumber)
+    {
+        WatchpointSet* set = m_globalVarWatchpointSets.get(std::make_pair(globalObject, identifierNumber));
+        ASSERT(set);
+        return set;
+    }
+
+    // Keeps every cell that the graph refers to alive while it waits to be compiled.
+    void visitChildren(SlotVisitor&);
+
     VM& m_vm;
     CodeBlock* m_codeBlock;
     RefPtr<Profiler::Compilation> m_compilation;
@@ -724,6 +747,7 @@ public:
     GraphForm m_form;
     UnificationState m_unificationState;
     RefCountState m_refCountState;
+    bool m_isConcurrent;
 private:
     
     void handleSuccessor(Vector<BlockIndex, 16>& worklist, BlockIndex blockIndex, BlockIndex successorIndex);
@@ -773,6 +797,8 @@ private:
 
         return mul->canSpeculateInteger();
     }
+
+    HashMap<std::pair<JSGlobalObject*, unsigned>, WatchpointSet*> m_globalVarWatchpointSets;
 };
 
 class GetBytecodeBeginForBlock {
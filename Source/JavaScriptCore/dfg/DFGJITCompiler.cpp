@@ -34,16 +34,16 @@
 #include "DFGRegisterBank.h"
 #include "DFGSlowPathGenerator.h"
 #include "DFGSpeculativeJIT.h"
-#include "DFGThunks.h"
 #include "JSCJSValueInlines.h"
 #include "VM.h"
 #include "LinkBuffer.h"
 
 namespace JSC { namespace DFG {
 
-JITCompiler::JITCompiler(Graph& dfg)
-    : CCallHelpers(&dfg.m_vm, dfg.m_codeBlock)
+JITCompiler::JITCompiler(Graph& dfg, Plan& plan)
+    : CCallHelpers(&dfg.m_vm, dfg.m_codeBlock, dfg.m_profiledBlock)
     , m_graph(dfg)
+    , m_plan(plan)
     , m_currentCodeOriginIndex(0)
 {
     if (shouldShowDisassembly() || m_graph.m_vm.m_perBytecodeProfiler)
@@ -93,6 +93,7 @@ void JITCompiler::compileEntry()
     preserveReturnAddressAfterCall(GPRInfo::regT2);
     emitPutToCallFrameHeader(GPRInfo::regT2, JSStack::ReturnPC);
     emitPutImmediateToCallFrameHeader(m_codeBlock, JSStack::CodeBlock);
+    store32(TrustedImm32(1), m_codeBlock->addressOfWasEnteredSinceLastAging());
 }
 
 void JITCompiler::compileBody(SpeculativeJIT& speculative)
@@ -206,15 +207,14 @@ void JITCompiler::link(LinkBuffer& linkBuffer)
         info.callType = m_jsCalls[i].m_callType;
         info.isDFG = true;
         info.codeOrigin = m_jsCalls[i].m_codeOrigin;
-        linkBuffer.link(m_jsCalls[i].m_slowCall, FunctionPtr((m_vm->getCTIStub(info.callType == CallLinkInfo::Construct ? linkConstructThunkGenerator : linkCallThunkGenerator)).code().executableAddress()));
+        linkBuffer.link(m_jsCalls[i].m_slowCall, FunctionPtr((info.callType == CallLinkInfo::Construct ? m_plan.linkConstructThunk() : m_plan.linkCallThunk()).code().executableAddress()));
         info.callReturnLocation = linkBuffer.locationOfNearCall(m_jsCalls[i].m_slowCall);
         info.hotPathBegin = linkBuffer.locationOf(m_jsCalls[i].m_targetToCheck);
         info.hotPathOther = linkBuffer.locationOfNearCall(m_jsCalls[i].m_fastCall);
         info.calleeGPR = static_cast<unsigned>(m_jsCalls[i].m_callee);
     }
     
-    MacroAssemblerCodeRef osrExitThunk = vm()->getCTIStub(osrExitGenerationThunkGenerator);
-    CodeLocationLabel target = CodeLocationLabel(osrExitThunk.code());
+    CodeLocationLabel target = CodeLocationLabel(m_plan.osrExitGenerationThunk().code());
     for (unsigned i = 0; i < codeBlock()->numberOfOSRExits(); ++i) {
         OSRExit& exit = codeBlock()->osrExit(i);
         linkBuffer.link(exit.getPatchableCodeOffsetAsJump(), target);
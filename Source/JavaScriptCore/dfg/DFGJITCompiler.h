@@ -35,6 +35,7 @@
 #include "DFGGPRInfo.h"
 #include "DFGGraph.h"
 #include "DFGOSRExitCompilationInfo.h"
+#include "DFGPlan.h"
 #include "DFGRegisterBank.h"
 #include "DFGRegisterSet.h"
 #include "JITCode.h"
@@ -243,13 +244,14 @@ struct PropertyAccessRecord {
 // call to be linked).
 class JITCompiler : public CCallHelpers {
 public:
-    JITCompiler(Graph& dfg);
+    JITCompiler(Graph& dfg, Plan&);
     
     bool compile(JITCode& entry);
     bool compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWithArityCheck);
 
     // Accessors for properties.
     Graph& graph() { return m_graph; }
+    DesiredWatchpoints& watchpoints() { return m_plan.watchpoints(); }
     
     // Methods to set labels for the disassembler.
     void setStartOfCode()
@@ -438,6 +440,10 @@ private:
     // The dataflow graph currently being generated.
     Graph& m_graph;
 
+    // The plan holds everything that has to be looked up on the main thread, like
+    // the thunks we link against, and collects the watchpoints we want installed.
+    Plan& m_plan;
+
     OwnPtr<Disassembler> m_disassembler;
     
     // Vector of calls out from JIT code, including exception handler information.
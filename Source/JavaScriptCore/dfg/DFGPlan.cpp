@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2011, 2012, 2013 Apple Inc. All rights reserved.
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DFGPlan.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "CodeBlock.h"
+#include "DFGArgumentsSimplificationPhase.h"
+#include "DFGBackwardsPropagationPhase.h"
+#include "DFGByteCodeParser.h"
+#include "DFGCFAPhase.h"
+#include "DFGCFGSimplificationPhase.h"
+#include "DFGCPSRethreadingPhase.h"
+#include "DFGCSEPhase.h"
+#include "DFGConstantFoldingPhase.h"
+#include "DFGDCEPhase.h"
+#include "DFGFixupPhase.h"
+#include "DFGJITCompiler.h"
+#include "DFGLongLivedState.h"
+#include "DFGPredictionInjectionPhase.h"
+#include "DFGPredictionPropagationPhase.h"
+#include "DFGThunks.h"
+#include "DFGTypeCheckHoistingPhase.h"
+#include "DFGUnificationPhase.h"
+#include "DFGValidate.h"
+#include "DFGVirtualRegisterAllocationPhase.h"
+#include "Executable.h"
+#include "Operations.h"
+#include "SlotVisitorInlines.h"
+#include <wtf/CurrentTime.h>
+
+namespace JSC { namespace DFG {
+
+Plan::Plan(CompileMode compileMode, CodeBlock* codeBlock, unsigned osrEntryBytecodeIndex, const Operands<JSValue>& mustHandleValues)
+    : m_vm(*codeBlock->vm())
+    , m_compileMode(compileMode)
+    , m_codeBlock(codeBlock)
+    , m_profiledBlock(codeBlock->alternative())
+    , m_osrEntryBytecodeIndex(osrEntryBytecodeIndex)
+    , m_mustHandleValues(mustHandleValues)
+    , m_didSucceed(false)
+    , m_stage(Preparing)
+    , m_isCancelled(false)
+    , m_timeBeforeQueue(0)
+    , m_timeBeforeCompile(0)
+    , m_timeAfterCompile(0)
+{
+    ASSERT(m_profiledBlock);
+    initializeThunks();
+}
+
+Plan::Plan(CompileMode compileMode, PassOwnPtr<CodeBlock> replacement, CodeBlock* profiledBlock, unsigned osrEntryBytecodeIndex, const Operands<JSValue>& mustHandleValues)
+    : m_vm(*profiledBlock->vm())
+    , m_compileMode(compileMode)
+    , m_ownedCodeBlock(replacement)
+    , m_profiledBlock(profiledBlock)
+    , m_osrEntryBytecodeIndex(osrEntryBytecodeIndex)
+    , m_mustHandleValues(mustHandleValues)
+    , m_ownedState(adoptPtr(new LongLivedState()))
+    , m_didSucceed(false)
+    , m_stage(Preparing)
+    , m_isCancelled(false)
+    , m_timeBeforeQueue(0)
+    , m_timeBeforeCompile(0)
+    , m_timeAfterCompile(0)
+{
+    m_codeBlock = m_ownedCodeBlock.get();
+    ASSERT(m_codeBlock);
+    ASSERT(!m_codeBlock->alternative());
+    initializeThunks();
+}
+
+void Plan::initializeThunks()
+{
+    m_linkCallThunk = m_vm.getCTIStub(linkCallThunkGenerator);
+    m_linkConstructThunk = m_vm.getCTIStub(linkConstructThunkGenerator);
+    m_osrExitGenerationThunk = m_vm.getCTIStub(osrExitGenerationThunkGenerator);
+}
+
+Plan::~Plan()
+{
+    // The graph allocates out of the long lived state, so it has to go first.
+    m_graph.clear();
+}
+
+bool Plan::parse()
+{
+    LongLivedState& state = m_ownedState ? *m_ownedState : *m_vm.m_dfgState;
+    m_graph = adoptPtr(new Graph(m_vm, m_codeBlock, m_profiledBlock, state, m_osrEntryBytecodeIndex, m_mustHandleValues));
+    Graph& dfg = *m_graph;
+    dfg.m_isConcurrent = !!m_ownedCodeBlock;
+    if (!DFG::parse(dfg))
+        return false;
+
+    // By this point the DFG bytecode parser will have potentially mutated various tables
+    // in the CodeBlock. This is a good time to perform an early shrink, which is more
+    // powerful than a late one. It's safe to do so because we haven't generated any code
+    // that references any of the tables directly, yet.
+    m_codeBlock->shrinkToFit(CodeBlock::EarlyShrink);
+
+    if (validationEnabled())
+        validate(dfg);
+
+    // The phases up to and including fixup read the baseline CodeBlocks' value, array
+    // and exit profiles, which the baseline code keeps writing to, and fixup also looks
+    // properties up in Structures. So they have to run before we leave the main thread.
+    performCPSRethreading(dfg);
+    performUnification(dfg);
+    performPredictionInjection(dfg);
+
+    if (validationEnabled())
+        validate(dfg);
+
+    performBackwardsPropagation(dfg);
+    performPredictionPropagation(dfg);
+    performFixup(dfg);
+    return true;
+}
+
+void Plan::noteQueued()
+{
+    m_timeBeforeQueue = monotonicallyIncreasingTime();
+}
+
+bool Plan::compileInThread()
+{
+    ASSERT(m_graph);
+    Graph& dfg = *m_graph;
+
+    m_timeBeforeCompile = monotonicallyIncreasingTime();
+
+    performTypeCheckHoisting(dfg);
+
+    dfg.m_fixpointState = FixpointNotConverged;
+
+    performCSE(dfg);
+    performArgumentsSimplification(dfg);
+    performCPSRethreading(dfg); // This should usually be a no-op since CSE rarely dethreads, and arguments simplification rarely does anything.
+    performCFA(dfg);
+    performConstantFolding(dfg);
+    performCFGSimplification(dfg);
+
+    dfg.m_fixpointState = FixpointConverged;
+
+    performStoreElimination(dfg);
+    performCPSRethreading(dfg);
+    performDCE(dfg);
+    performVirtualRegisterAllocation(dfg);
+
+    GraphDumpMode modeForFinalValidate = DumpGraph;
+    if (verboseCompilationEnabled()) {
+        dataLogF("Graph after optimization:\n");
+        dfg.dump();
+        modeForFinalValidate = DontDumpGraph;
+    }
+    if (validationEnabled())
+        validate(dfg, modeForFinalValidate);
+
+    JITCompiler dataFlowJIT(dfg, *this);
+    if (m_compileMode == CompileFunction)
+        m_didSucceed = dataFlowJIT.compileFunction(m_jitCode, m_jitCodeWithArityCheck);
+    else {
+        ASSERT(m_compileMode == CompileOther);
+        m_didSucceed = dataFlowJIT.compile(m_jitCode);
+    }
+
+    m_timeAfterCompile = monotonicallyIncreasingTime();
+
+    // Nobody needs the graph after this point, and the thread-private state can be
+    // reclaimed right away rather than when the main thread gets around to us.
+    m_graph.clear();
+    m_ownedState.clear();
+
+    return m_didSucceed;
+}
+
+bool Plan::finalize()
+{
+    ASSERT(m_ownedCodeBlock);
+    if (!m_didSucceed)
+        return false;
+
+    // Nothing can fire a watchpoint between this check and the end of this function,
+    // since we are on the main thread and do not run any JS.
+    if (!m_watchpoints.areStillValid())
+        return false;
+
+    ScriptExecutable* executable = m_profiledBlock->ownerExecutable();
+    bool installed = false;
+    switch (m_codeBlock->codeType()) {
+    case GlobalCode:
+        installed = jsCast<ProgramExecutable*>(executable)->installOptimizedCode(m_profiledBlock, m_ownedCodeBlock.release(), m_jitCode);
+        break;
+    case EvalCode:
+        installed = jsCast<EvalExecutable*>(executable)->installOptimizedCode(m_profiledBlock, m_ownedCodeBlock.release(), m_jitCode);
+        break;
+    case FunctionCode:
+        installed = jsCast<FunctionExecutable*>(executable)->installOptimizedCodeFor(m_codeBlock->specializationKind(), m_profiledBlock, m_ownedCodeBlock.release(), m_jitCode, m_jitCodeWithArityCheck);
+        break;
+    }
+    if (!installed)
+        return false;
+
+    m_watchpoints.reallyAdd();
+    return true;
+}
+
+bool Plan::finalizeWatchpoints()
+{
+    ASSERT(!m_ownedCodeBlock);
+    if (!m_didSucceed || !m_watchpoints.areStillValid())
+        return false;
+    m_watchpoints.reallyAdd();
+    return true;
+}
+
+void Plan::visitChildren(SlotVisitor& visitor)
+{
+    // Compiler threads hold on to their right to run for as long as a plan is in the
+    // Compiling stage, so nobody is mutating what we look at here.
+    ASSERT(m_stage != Compiling);
+
+    // Keeping the executable alive keeps the profiled block alive. The replacement
+    // is not reachable from anywhere but us until it gets installed.
+    ScriptExecutable* executable = m_profiledBlock->ownerExecutable();
+    visitor.appendUnbarrieredPointer(&executable);
+    for (size_t i = 0; i < m_mustHandleValues.size(); ++i)
+        visitor.appendUnbarrieredValue(&m_mustHandleValues[i]);
+    if (m_ownedCodeBlock)
+        m_ownedCodeBlock->visitStronglyForCompilation(visitor);
+
+    // Until the plan has been compiled, the graph is the only thing that refers to
+    // most of the structures and cells the code will be specialized for.
+    if (m_graph)
+        m_graph->visitChildren(visitor);
+    m_watchpoints.visitChildren(visitor);
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
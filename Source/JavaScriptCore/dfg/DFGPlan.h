@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DFGPlan_h
+#define DFGPlan_h
+
+#include <wtf/Platform.h>
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGDesiredWatchpoints.h"
+#include "JITCode.h"
+#include "MacroAssemblerCodeRef.h"
+#include "Operands.h"
+#include <wtf/OwnPtr.h>
+#include <wtf/ThreadSafeRefCounted.h>
+
+namespace JSC {
+
+class CodeBlock;
+class SlotVisitor;
+class VM;
+
+namespace DFG {
+
+class Graph;
+class LongLivedState;
+
+enum CompileMode { CompileFunction, CompileOther };
+
+// A Plan holds everything needed to take one CodeBlock through the DFG. parse()
+// runs on the main thread: it builds the graph and runs every phase that consults
+// the baseline CodeBlocks' value, array and exit profiles, so that what the graph
+// holds afterwards is a snapshot. The plan also looks up the thunks that the code
+// links against up front, since the VM's thunk table is main-thread only. The
+// remaining phases and code generation (compileInThread()) may run either
+// synchronously or on a Worklist thread. Code generation does not register
+// watchpoints; it records them in watchpoints(), and finalize() (or
+// finalizeWatchpoints() for synchronous compiles) checks on the main thread that
+// none of them fired before it installs the code and registers them.
+class Plan : public ThreadSafeRefCounted<Plan> {
+public:
+    enum Stage { Preparing, Queued, Compiling, Ready };
+
+    // Synchronous compilation of a replacement that is already owned by the executable.
+    Plan(CompileMode, CodeBlock* codeBlock, unsigned osrEntryBytecodeIndex, const Operands<JSValue>& mustHandleValues);
+
+    // Deferred compilation. The plan owns the replacement until it is installed.
+    Plan(CompileMode, PassOwnPtr<CodeBlock> replacement, CodeBlock* profiledBlock, unsigned osrEntryBytecodeIndex, const Operands<JSValue>& mustHandleValues);
+
+    ~Plan();
+
+    bool parse();
+    bool compileInThread();
+
+    // Installs the code into the owning executable. Returns false if the compilation
+    // failed, if a watchpoint that the code relies on fired while we were compiling,
+    // or if the baseline CodeBlock we profiled is no longer current.
+    bool finalize();
+
+    // Registers the desired watchpoints, unless one of them has already fired.
+    bool finalizeWatchpoints();
+
+    void visitChildren(SlotVisitor&);
+
+    VM& vm() const { return m_vm; }
+    CompileMode compileMode() const { return m_compileMode; }
+    CodeBlock* codeBlock() const { return m_codeBlock; }
+    CodeBlock* profiledBlock() const { return m_profiledBlock; }
+    CodeBlock* key() const { return m_profiledBlock; }
+
+    const MacroAssemblerCodeRef& linkCallThunk() const { return m_linkCallThunk; }
+    const MacroAssemblerCodeRef& linkConstructThunk() const { return m_linkConstructThunk; }
+    const MacroAssemblerCodeRef& osrExitGenerationThunk() const { return m_osrExitGenerationThunk; }
+    DesiredWatchpoints& watchpoints() { return m_watchpoints; }
+
+    bool didSucceed() const { return m_didSucceed; }
+    const JITCode& jitCode() const { return m_jitCode; }
+    MacroAssemblerCodePtr jitCodeWithArityCheck() const { return m_jitCodeWithArityCheck; }
+
+    Stage stage() const { return m_stage; }
+    void setStage(Stage stage) { m_stage = stage; }
+    bool isCancelled() const { return m_isCancelled; }
+    void cancel() { m_isCancelled = true; }
+
+    double timeBeforeQueue() const { return m_timeBeforeQueue; }
+    double timeBeforeCompile() const { return m_timeBeforeCompile; }
+    double timeAfterCompile() const { return m_timeAfterCompile; }
+    void noteQueued();
+
+private:
+    void initializeThunks();
+
+    VM& m_vm;
+    CompileMode m_compileMode;
+    CodeBlock* m_codeBlock;
+    OwnPtr<CodeBlock> m_ownedCodeBlock;
+    CodeBlock* m_profiledBlock;
+    unsigned m_osrEntryBytecodeIndex;
+    Operands<JSValue> m_mustHandleValues;
+
+    OwnPtr<LongLivedState> m_ownedState;
+    OwnPtr<Graph> m_graph;
+
+    MacroAssemblerCodeRef m_linkCallThunk;
+    MacroAssemblerCodeRef m_linkConstructThunk;
+    MacroAssemblerCodeRef m_osrExitGenerationThunk;
+    DesiredWatchpoints m_watchpoints;
+
+    bool m_didSucceed;
+    JITCode m_jitCode;
+    MacroAssemblerCodePtr m_jitCodeWithArityCheck;
+
+    Stage m_stage;
+    bool m_isCancelled;
+
+    double m_timeBeforeQueue;
+    double m_timeBeforeCompile;
+    double m_timeAfterCompile;
+};
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
+#endif // DFGPlan_h
+
@@ -929,12 +929,42 @@ void SpeculativeJIT::useChildren(Node* node)
     }
 }
 
+// Dirties the card covering the owner's header, borrowing scratch registers from
+// the stack if the caller could not spare any.
+static void markCardFor(MacroAssembler& jit, GPRReg owner, GPRReg preserve, GPRReg scratch1, GPRReg scratch2)
+{
+    bool needToRestoreScratch1 = scratch1 == InvalidGPRReg;
+    if (needToRestoreScratch1) {
+        scratch1 = SpeculativeJIT::selectScratchGPR(owner, preserve, scratch2);
+        jit.push(scratch1);
+    }
+    bool needToRestoreScratch2 = scratch2 == InvalidGPRReg;
+    if (needToRestoreScratch2) {
+        scratch2 = SpeculativeJIT::selectScratchGPR(owner, preserve, scratch1);
+        jit.push(scratch2);
+    }
+
+    jit.move(owner, scratch1);
+    jit.andPtr(MacroAssembler::TrustedImm32(static_cast<int32_t>(MarkedBlock::blockMask)), scratch1);
+    jit.move(owner, scratch2);
+    jit.andPtr(MacroAssembler::TrustedImm32(static_cast<int32_t>(MarkedBlock::blockSize - 1)), scratch2);
+    jit.urshift32(MacroAssembler::TrustedImm32(MarkedBlock::cardShift), scratch2);
+#if CPU(X86) || CPU(X86_64)
+    jit.store8(MacroAssembler::TrustedImm32(1), MacroAssembler::BaseIndex(scratch1, scratch2, MacroAssembler::TimesOne, MarkedBlock::offsetOfCards()));
+#else
+    // Any non-zero byte marks the card, so store the biased card index itself.
+    jit.add32(MacroAssembler::TrustedImm32(1), scratch2);
+    jit.store8(scratch2, MacroAssembler::BaseIndex(scratch1, scratch2, MacroAssembler::TimesOne, MarkedBlock::offsetOfCards() - 1));
+#endif
+
+    if (needToRestoreScratch2)
+        jit.pop(scratch2);
+    if (needToRestoreScratch1)
+        jit.pop(scratch1);
+}
+
 void SpeculativeJIT::writeBarrier(MacroAssembler& jit, GPRReg owner, GPRReg scratch1, GPRReg scratch2, WriteBarrierUseKind useKind)
 {
-    UNUSED_PARAM(jit);
-    UNUSED_PARAM(owner);
-    UNUSED_PARAM(scratch1);
-    UNUSED_PARAM(scratch2);
     UNUSED_PARAM(useKind);
     ASSERT(owner != scratch1);
     ASSERT(owner != scratch2);
@@ -943,14 +973,14 @@ void SpeculativeJIT::writeBarrier(MacroAssembler& jit, GPRReg owner, GPRReg scra
 #if ENABLE(WRITE_BARRIER_PROFILING)
     JITCompiler::emitCount(jit, WriteBarrierCounters::jitCounterFor(useKind));
 #endif
+
+    if (!Heap::isWriteBarrierEnabled())
+        return;
+    markCardFor(jit, owner, InvalidGPRReg, scratch1, scratch2);
 }
 
 void SpeculativeJIT::writeBarrier(GPRReg ownerGPR, GPRReg valueGPR, Edge valueUse, WriteBarrierUseKind useKind, GPRReg scratch1, GPRReg scratch2)
 {
-    UNUSED_PARAM(ownerGPR);
-    UNUSED_PARAM(valueGPR);
-    UNUSED_PARAM(scratch1);
-    UNUSED_PARAM(scratch2);
     UNUSED_PARAM(useKind);
 
     if (isKnownNotCell(valueUse.node()))
@@ -959,27 +989,28 @@ void SpeculativeJIT::writeBarrier(GPRReg ownerGPR, GPRReg valueGPR, Edge valueUs
 #if ENABLE(WRITE_BARRIER_PROFILING)
     JITCompiler::emitCount(m_jit, WriteBarrierCounters::jitCounterFor(useKind));
 #endif
+
+    if (!Heap::isWriteBarrierEnabled())
+        return;
+    markCardFor(m_jit, ownerGPR, valueGPR, scratch1, scratch2);
 }
 
 void SpeculativeJIT::writeBarrier(GPRReg ownerGPR, JSCell* value, WriteBarrierUseKind useKind, GPRReg scratch1, GPRReg scratch2)
 {
-    UNUSED_PARAM(ownerGPR);
-    UNUSED_PARAM(value);
-    UNUSED_PARAM(scratch1);
-    UNUSED_PARAM(scratch2);
     UNUSED_PARAM(useKind);
-    
-    if (Heap::isMarked(value))
-        return;
+    UNUSED_PARAM(value);
 
 #if ENABLE(WRITE_BARRIER_PROFILING)
     JITCompiler::emitCount(m_jit, WriteBarrierCounters::jitCounterFor(useKind));
 #endif
+
+    if (!Heap::isWriteBarrierEnabled())
+        return;
+    markCardFor(m_jit, ownerGPR, InvalidGPRReg, scratch1, scratch2);
 }
 
 void SpeculativeJIT::writeBarrier(JSCell* owner, GPRReg valueGPR, Edge valueUse, WriteBarrierUseKind useKind, GPRReg scratch)
 {
-    UNUSED_PARAM(owner);
     UNUSED_PARAM(valueGPR);
     UNUSED_PARAM(scratch);
     UNUSED_PARAM(useKind);
@@ -990,6 +1021,10 @@ void SpeculativeJIT::writeBarrier(JSCell* owner, GPRReg valueGPR, Edge valueUse,
 #if ENABLE(WRITE_BARRIER_PROFILING)
     JITCompiler::emitCount(m_jit, WriteBarrierCounters::jitCounterFor(useKind));
 #endif
+
+    if (!Heap::isWriteBarrierEnabled())
+        return;
+    m_jit.store8(MacroAssembler::TrustedImm32(1), Heap::addressOfCardFor(owner));
 }
 
 bool SpeculativeJIT::nonSpeculativeCompare(Node* node, MacroAssembler::RelationalCondition cond, S_DFGOperation_EJJ helperFunction)
@@ -1413,7 +1448,7 @@ void SpeculativeJIT::compilePeepHoleObjectEquality(Node* node, Node* branchNode)
     GPRReg op2GPR = op2.gpr();
     
     if (m_jit.graph().globalObjectFor(node->codeOrigin)->masqueradesAsUndefinedWatchpoint()->isStillValid()) {
-        m_jit.graph().globalObjectFor(node->codeOrigin)->masqueradesAsUndefinedWatchpoint()->add(speculationWatchpoint());
+        m_jit.watchpoints().addLazily(m_jit.graph().globalObjectFor(node->codeOrigin)->masqueradesAsUndefinedWatchpoint(), speculationWatchpoint());
         if (m_state.forNode(node->child1()).m_type & ~SpecObject) {
             speculationCheck(
                 BadType, JSValueSource::unboxedCell(op1GPR), node->child1(), 
@@ -2867,7 +2867,6 @@ void SpeculativeJIT::speculateStringObjectForStructure(Edge edge, StructureLocat
     Structure* stringObjectStructure =
         m_jit.globalObjectFor(m_currentNode->codeOrigin)->stringObjectStructure();
     Structure* stringPrototypeStructure = stringObjectStructure->storedPrototype().asCell()->structure();
-    ASSERT(stringPrototypeStructure->transitionWatchpointSetIsStillValid());
     
     if (!m_state.forNode(edge).m_currentKnownStructure.isSubsetOf(StructureSet(m_jit.globalObjectFor(m_currentNode->codeOrigin)->stringObjectStructure()))) {
         speculationCheck(
@@ -2875,7 +2874,7 @@ void SpeculativeJIT::speculateStringObjectForStructure(Edge edge, StructureLocat
             m_jit.branchPtr(
                 JITCompiler::NotEqual, structureLocation, TrustedImmPtr(stringObjectStructure)));
     }
-    stringPrototypeStructure->addTransitionWatchpoint(speculationWatchpoint(NotStringObject));
+    m_jit.watchpoints().addTransitionWatchpointLazily(stringPrototypeStructure, speculationWatchpoint(NotStringObject));
 }
 
 #define DFG_TYPE_CHECK(source, edge, typesPassedThrough, jumpToFail) do { \
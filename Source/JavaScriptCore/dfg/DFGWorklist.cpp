@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DFGWorklist.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "CodeBlock.h"
+#include "DFGCommon.h"
+#include "Executable.h"
+#include <wtf/CurrentTime.h>
+
+namespace JSC { namespace DFG {
+
+Worklist::Worklist()
+    : m_numberOfActiveThreads(0)
+    , m_shouldStop(false)
+    , m_numberOfEnqueuedPlans(0)
+    , m_numberOfCompletedPlans(0)
+    , m_numberOfCancelledPlans(0)
+    , m_maximumQueueLength(0)
+    , m_totalQueueTime(0)
+    , m_totalCompileTime(0)
+    , m_maximumCompileTime(0)
+{
+}
+
+Worklist::~Worklist()
+{
+    {
+        MutexLocker locker(m_lock);
+        m_shouldStop = true;
+        m_planEnqueued.broadcast();
+    }
+    for (unsigned i = 0; i < m_threads.size(); ++i)
+        waitForThreadCompletion(m_threads[i]->m_identifier);
+    ASSERT(!m_numberOfActiveThreads);
+
+    if (Options::reportCompileTimes())
+        dataLog("DFG worklist at exit: ", *this, "\n");
+}
+
+void Worklist::finishCreation(unsigned numberOfThreads)
+{
+    RELEASE_ASSERT(numberOfThreads);
+    for (unsigned i = numberOfThreads; i--;) {
+        OwnPtr<ThreadData> data = adoptPtr(new ThreadData(this));
+        data->m_identifier = createThread(threadFunction, data.get(), "JSC Compilation Thread");
+        m_threads.append(data.release());
+    }
+}
+
+PassOwnPtr<Worklist> Worklist::create(unsigned numberOfThreads)
+{
+    OwnPtr<Worklist> result = adoptPtr(new Worklist());
+    result->finishCreation(numberOfThreads);
+    return result.release();
+}
+
+void Worklist::enqueue(PassRefPtr<Plan> passedPlan)
+{
+    RefPtr<Plan> plan = passedPlan;
+    MutexLocker locker(m_lock);
+    if (Options::verboseCompilationQueue())
+        dataLog("DFG worklist: enqueueing plan to optimize ", *plan->profiledBlock(), "\n");
+    ASSERT(m_plans.find(plan->key()) == m_plans.end());
+    plan->noteQueued();
+    plan->setStage(Plan::Queued);
+    m_plans.add(plan->key(), plan);
+    m_queue.append(plan);
+    m_numberOfEnqueuedPlans++;
+    m_maximumQueueLength = std::max(m_maximumQueueLength, static_cast<size_t>(m_queue.size()));
+    m_planEnqueued.signal();
+}
+
+Worklist::State Worklist::compilationState(CodeBlock* profiledBlock)
+{
+    MutexLocker locker(m_lock);
+    PlanMap::iterator iter = m_plans.find(profiledBlock);
+    if (iter == m_plans.end())
+        return NotKnown;
+    return iter->value->stage() == Plan::Ready ? Compiled : Compiling;
+}
+
+Worklist::State Worklist::completeAllReadyPlans(CodeBlock* requestedProfiledBlock)
+{
+    Vector<RefPtr<Plan>, 16> readyPlans;
+    State resultingState = NotKnown;
+    {
+        MutexLocker locker(m_lock);
+        readyPlans.swap(m_readyPlans);
+        if (requestedProfiledBlock && m_plans.contains(requestedProfiledBlock))
+            resultingState = Compiling;
+    }
+
+    for (size_t i = 0; i < readyPlans.size(); ++i) {
+        RefPtr<Plan> plan = readyPlans[i];
+        CodeBlock* profiledBlock = plan->profiledBlock();
+
+        // Plans stay in the map, and so stay visible to the GC, until they are
+        // finalized; installing code may allocate.
+        {
+            MutexLocker locker(m_lock);
+            if (plan->isCancelled())
+                continue;
+            m_plans.remove(plan->key());
+        }
+
+        if (profiledBlock == requestedProfiledBlock)
+            resultingState = Compiled;
+
+        if (Options::verboseCompilationQueue())
+            dataLog("DFG worklist: completing plan to optimize ", *profiledBlock, "\n");
+
+        if (!plan->finalize()) {
+            // Either the compilation failed, or the baseline code block we profiled has
+            // been replaced while we were compiling. In the former case, back off the
+            // same way a failed synchronous compile would.
+            if (plan->didSucceed())
+                continue;
+            profiledBlock->dontOptimizeAnytimeSoon();
+        }
+    }
+
+    return resultingState;
+}
+
+void Worklist::cancelPlansFor(ScriptExecutable* executable)
+{
+    ASSERT(executable);
+    MutexLocker locker(m_lock);
+    Vector<CodeBlock*, 4> deadKeys;
+    PlanMap::iterator end = m_plans.end();
+    for (PlanMap::iterator iter = m_plans.begin(); iter != end; ++iter) {
+        if (iter->value->profiledBlock()->ownerExecutable() != executable)
+            continue;
+        deadKeys.append(iter->key);
+    }
+
+    for (size_t i = 0; i < deadKeys.size(); ++i) {
+        RefPtr<Plan> plan = m_plans.take(deadKeys[i]);
+        plan->cancel();
+        m_numberOfCancelledPlans++;
+
+        // A compiler thread may be reading the profiled block right now, so we
+        // cannot let the caller free it until that thread is done.
+        while (plan->stage() == Plan::Compiling)
+            m_planCompiled.wait(m_lock);
+    }
+
+    if (!deadKeys.isEmpty()) {
+        Vector<RefPtr<Plan>, 16> survivingPlans;
+        for (size_t i = 0; i < m_readyPlans.size(); ++i) {
+            if (!m_readyPlans[i]->isCancelled())
+                survivingPlans.append(m_readyPlans[i]);
+        }
+        m_readyPlans.swap(survivingPlans);
+    }
+}
+
+void Worklist::suspendAllThreads()
+{
+    for (unsigned i = m_threads.size(); i--;)
+        m_threads[i]->m_rightToRun.lock();
+}
+
+void Worklist::resumeAllThreads()
+{
+    for (unsigned i = m_threads.size(); i--;)
+        m_threads[i]->m_rightToRun.unlock();
+}
+
+void Worklist::visitChildren(SlotVisitor& visitor)
+{
+    // Only called during GC, with all compiler threads suspended.
+    MutexLocker locker(m_lock);
+    PlanMap::iterator end = m_plans.end();
+    for (PlanMap::iterator iter = m_plans.begin(); iter != end; ++iter)
+        iter->value->visitChildren(visitor);
+}
+
+size_t Worklist::queueLength()
+{
+    MutexLocker locker(m_lock);
+    return m_queue.size();
+}
+
+void Worklist::dump(PrintStream& out) const
+{
+    MutexLocker locker(m_lock);
+    out.print(
+        "Worklist(", RawPointer(this), ")[Queue Length = ", m_queue.size(),
+        ", Map Size = ", m_plans.size(), ", Num Ready = ", m_readyPlans.size());
+    out.print(
+        ", Num Active Threads = ", m_numberOfActiveThreads, "/", m_threads.size(),
+        ", Enqueued = ", m_numberOfEnqueuedPlans, ", Completed = ", m_numberOfCompletedPlans);
+    out.print(
+        ", Cancelled = ", m_numberOfCancelledPlans, ", Max Queue Length = ", m_maximumQueueLength);
+    if (m_numberOfCompletedPlans) {
+        out.print(
+            ", Average Queue Time = ", m_totalQueueTime * 1000 / m_numberOfCompletedPlans, " ms",
+            ", Average Compile Time = ", m_totalCompileTime * 1000 / m_numberOfCompletedPlans, " ms",
+            ", Max Compile Time = ", m_maximumCompileTime * 1000, " ms");
+    }
+    out.print("]");
+}
+
+void Worklist::runThread(ThreadData* data)
+{
+    for (;;) {
+        {
+            MutexLocker locker(m_lock);
+            while (m_queue.isEmpty() && !m_shouldStop)
+                m_planEnqueued.wait(m_lock);
+            if (m_shouldStop)
+                return;
+        }
+
+        // Holding the right to run from before a plan leaves the queue until it is
+        // ready means that no plan is ever in the Compiling stage while the GC has
+        // us suspended, so cancelling plans during a collection cannot deadlock.
+        MutexLocker rightToRunLocker(data->m_rightToRun);
+
+        RefPtr<Plan> plan;
+        {
+            MutexLocker locker(m_lock);
+            if (m_queue.isEmpty())
+                continue;
+            plan = m_queue.takeFirst();
+            if (plan->isCancelled())
+                continue;
+            plan->setStage(Plan::Compiling);
+            m_numberOfActiveThreads++;
+        }
+
+        plan->compileInThread();
+
+        {
+            MutexLocker locker(m_lock);
+            plan->setStage(Plan::Ready);
+            m_numberOfActiveThreads--;
+
+            double queueTime = plan->timeBeforeCompile() - plan->timeBeforeQueue();
+            double compileTime = plan->timeAfterCompile() - plan->timeBeforeCompile();
+            m_numberOfCompletedPlans++;
+            m_totalQueueTime += queueTime;
+            m_totalCompileTime += compileTime;
+            m_maximumCompileTime = std::max(m_maximumCompileTime, compileTime);
+
+            if (Options::reportCompileTimes())
+                dataLog("DFG worklist: compiled ", *plan->codeBlock(), " in ", compileTime * 1000, " ms after waiting ", queueTime * 1000, " ms.\n");
+
+            if (!plan->isCancelled())
+                m_readyPlans.append(plan);
+            m_planCompiled.broadcast();
+        }
+    }
+}
+
+void Worklist::threadFunction(void* argument)
+{
+    ThreadData* data = static_cast<ThreadData*>(argument);
+    data->m_worklist->runThread(data);
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
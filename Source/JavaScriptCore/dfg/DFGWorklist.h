@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DFGWorklist_h
+#define DFGWorklist_h
+
+#include <wtf/Platform.h>
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGPlan.h"
+#include <wtf/Deque.h>
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/PrintStream.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class CodeBlock;
+class ScriptExecutable;
+class SlotVisitor;
+class VM;
+
+namespace DFG {
+
+// A per-VM queue of DFG compilations that run on helper threads. The main thread
+// enqueues a parsed Plan and keeps running baseline code; when the baseline
+// CodeBlock next trips its optimization counter it asks the worklist whether the
+// plan is ready and, if so, installs it. The GC suspends all compiler threads for
+// the duration of a collection and visits the pending plans as roots.
+class Worklist {
+    WTF_MAKE_NONCOPYABLE(Worklist); WTF_MAKE_FAST_ALLOCATED;
+public:
+    enum State { NotKnown, Compiling, Compiled };
+
+    static PassOwnPtr<Worklist> create(unsigned numberOfThreads);
+    ~Worklist();
+
+    void enqueue(PassRefPtr<Plan>);
+
+    State compilationState(CodeBlock* profiledBlock);
+
+    // Installs every plan that has finished compiling. Returns the state of the
+    // plan for the given CodeBlock, if any, from before it was completed.
+    State completeAllReadyPlans(CodeBlock* requestedProfiledBlock = 0);
+
+    // Drops the executable's plans because their profiled blocks are about to go
+    // away. Waits for any of them that is currently being compiled.
+    void cancelPlansFor(ScriptExecutable*);
+
+    void suspendAllThreads();
+    void resumeAllThreads();
+
+    void visitChildren(SlotVisitor&);
+
+    size_t queueLength();
+    void dump(PrintStream&) const;
+
+private:
+    Worklist();
+    void finishCreation(unsigned numberOfThreads);
+
+    struct ThreadData {
+        ThreadData(Worklist* worklist)
+            : m_worklist(worklist)
+            , m_identifier(0)
+        {
+        }
+
+        Worklist* m_worklist;
+        ThreadIdentifier m_identifier;
+        Mutex m_rightToRun;
+    };
+
+    static void threadFunction(void* argument);
+    void runThread(ThreadData*);
+
+    typedef HashMap<CodeBlock*, RefPtr<Plan> > PlanMap;
+
+    // Every plan that has not been completed or cancelled, keyed by profiled block.
+    PlanMap m_plans;
+    Deque<RefPtr<Plan> > m_queue;
+    Vector<RefPtr<Plan>, 16> m_readyPlans;
+
+    mutable Mutex m_lock;
+    ThreadCondition m_planEnqueued;
+    ThreadCondition m_planCompiled;
+    Vector<OwnPtr<ThreadData> > m_threads;
+    unsigned m_numberOfActiveThreads;
+    bool m_shouldStop;
+
+    // Statistics, guarded by m_lock.
+    unsigned m_numberOfEnqueuedPlans;
+    unsigned m_numberOfCompletedPlans;
+    unsigned m_numberOfCancelledPlans;
+    size_t m_maximumQueueLength;
+    double m_totalQueueTime;
+    double m_totalCompileTime;
+    double m_maximumCompileTime;
+};
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
+#endif // DFGWorklist_h
+
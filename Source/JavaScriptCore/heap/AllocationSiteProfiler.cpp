@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "AllocationSiteProfiler.h"
+
+#include "CallFrame.h"
+#include "CodeBlock.h"
+#include "HeapSnapshotWriter.h"
+#include "Interpreter.h"
+#include "JSStack.h"
+#include "Operations.h"
+#include "VM.h"
+
+namespace JSC {
+
+AllocationSiteProfiler::AllocationSiteProfiler(VM& vm)
+    : m_vm(vm)
+{
+}
+
+// Native functions do not have CodeBlocks, so their allocations are charged to the
+// code that called them. topCallFrame is only brought up to date when JS calls out
+// to the runtime, so when no JS is running it may point at a frame that has since
+// returned and whose slots have been reused. We only trust it while JS is running,
+// and only follow frames that lie within the JS stack.
+CallFrame* AllocationSiteProfiler::topFrameWithCodeBlock() const
+{
+    if (!m_vm.dynamicGlobalObject)
+        return 0;
+
+    JSStack& stack = m_vm.interpreter->stack();
+    CallFrame* callFrame = m_vm.topCallFrame;
+    while (callFrame && callFrame != CallFrame::noCaller()) {
+        callFrame = callFrame->removeHostCallFrameFlag();
+        if (callFrame->registers() < stack.begin() || callFrame->registers() >= stack.end())
+            return 0;
+        if (callFrame->codeBlock())
+            return callFrame;
+        callFrame = callFrame->callerFrame();
+    }
+    return 0;
+}
+
+void AllocationSiteProfiler::didExhaustFreeList(size_t bytesAllocatedFromFreeList)
+{
+    if (!bytesAllocatedFromFreeList)
+        return;
+
+    CallFrame* callFrame = topFrameWithCodeBlock();
+    if (!callFrame) {
+        m_unattributedSite.samples++;
+        m_unattributedSite.bytes += bytesAllocatedFromFreeList;
+        return;
+    }
+
+    CodeBlock* codeBlock = callFrame->codeBlock();
+    unsigned bytecodeOffset = 0;
+#if ENABLE(DFG_JIT)
+    if (codeBlock->getJITType() == JITCode::DFGJIT) {
+        unsigned codeOriginIndex = callFrame->codeOriginIndexForDFG();
+        if (codeBlock->canGetCodeOrigin(codeOriginIndex)) {
+            CodeOrigin codeOrigin = codeBlock->codeOrigin(codeOriginIndex);
+            bytecodeOffset = codeOrigin.bytecodeIndex;
+            if (codeOrigin.inlineCallFrame)
+                codeBlock = codeOrigin.inlineCallFrame->baselineCodeBlock();
+        }
+    } else
+#endif
+        bytecodeOffset = callFrame->bytecodeOffsetForNonDFGCode();
+
+    // The frame only records its bytecode offset when it calls out, so the offset
+    // may be stale, but it should never be out of range.
+    if (bytecodeOffset >= codeBlock->instructionCount())
+        bytecodeOffset = 0;
+
+    SiteKey key(
+        codeBlock->ownerExecutable()->sourceID(),
+        (static_cast<uint64_t>(codeBlock->sourceOffset()) << 33)
+            | (static_cast<uint64_t>(codeBlock->specializationKind()) << 32)
+            | bytecodeOffset);
+    SiteMap::AddResult result = m_sites.add(key, Site());
+    Site& site = result.iterator->value;
+    if (result.isNewEntry) {
+        site.url = codeBlock->ownerExecutable()->sourceURL();
+        site.codeBlockHash = codeBlock->hash().hash();
+        site.bytecodeOffset = bytecodeOffset;
+        site.lineNumber = codeBlock->lineNumberForBytecodeOffset(bytecodeOffset);
+    }
+    site.samples++;
+    site.bytes += bytesAllocatedFromFreeList;
+}
+
+void AllocationSiteProfiler::writeTo(HeapSnapshotWriter& writer) const
+{
+    if (m_unattributedSite.samples)
+        writer.appendAllocationSite(String(), 0, 0, 0, m_unattributedSite.samples, m_unattributedSite.bytes);
+
+    SiteMap::const_iterator end = m_sites.end();
+    for (SiteMap::const_iterator iter = m_sites.begin(); iter != end; ++iter) {
+        const Site& site = iter->value;
+        writer.appendAllocationSite(site.url, site.codeBlockHash, site.bytecodeOffset, site.lineNumber, site.samples, site.bytes);
+    }
+}
+
+} // namespace JSC
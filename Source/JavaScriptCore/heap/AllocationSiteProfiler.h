@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef AllocationSiteProfiler_h
+#define AllocationSiteProfiler_h
+
+#include <wtf/FastAllocBase.h>
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class ExecState;
+class HeapSnapshotWriter;
+class VM;
+
+// Attributes allocations in the MarkedSpace to the bytecode that was running when
+// they happened. Sampling every allocation would be too slow, so the allocators
+// call us each time they run out of free cells, and we charge all the bytes handed
+// out from the exhausted free list to whatever code is running now. Sites are keyed by
+// source position rather than by CodeBlock, so a site keeps its samples when its
+// code is recompiled or thrown away.
+//
+// Enabled by Options::sampleAllocationSites(). The sites are written out as part of
+// each heap snapshot.
+class AllocationSiteProfiler {
+    WTF_MAKE_NONCOPYABLE(AllocationSiteProfiler); WTF_MAKE_FAST_ALLOCATED;
+public:
+    explicit AllocationSiteProfiler(VM&);
+
+    void didExhaustFreeList(size_t bytesAllocatedFromFreeList);
+
+    void writeTo(HeapSnapshotWriter&) const;
+
+private:
+    ExecState* topFrameWithCodeBlock() const;
+
+    struct Site {
+        Site()
+            : codeBlockHash(0)
+            , bytecodeOffset(0)
+            , lineNumber(0)
+            , samples(0)
+            , bytes(0)
+        {
+        }
+
+        String url;
+        unsigned codeBlockHash;
+        unsigned bytecodeOffset;
+        unsigned lineNumber;
+        uint64_t samples;
+        uint64_t bytes;
+    };
+
+    // The source provider, and the position within it of the code block's source,
+    // its specialization and the bytecode offset.
+    typedef std::pair<intptr_t, uint64_t> SiteKey;
+    typedef HashMap<SiteKey, Site> SiteMap;
+
+    VM& m_vm;
+    SiteMap m_sites;
+
+    // Allocations made while no JavaScript was running.
+    Site m_unattributedSite;
+};
+
+} // namespace JSC
+
+#endif // AllocationSiteProfiler_h
@@ -67,6 +67,10 @@ public:
     void pin(CopiedBlock*);
     bool isPinned(void*);
 
+    // Used by eden collections, which neither evacuate nor free backing stores.
+    void pinAllBlocks();
+    void unpinAllBlocks();
+
     bool contains(CopiedBlock*);
     bool contains(void*, CopiedBlock*&);
     
@@ -76,6 +76,8 @@ public:
     // is free to make use of m_dfgData->isMarked and m_dfgData->isJettisoned.
     void traceMarkedCodeBlocks(SlotVisitor&);
 
+    const HashSet<CodeBlock*>& jettisonedCodeBlocks() const { return m_set; }
+
 private:
     friend class CodeBlock;
     
@@ -21,13 +21,16 @@
 #include "config.h"
 #include "Heap.h"
 
+#include "AllocationSiteProfiler.h"
 #include "CodeBlock.h"
 #include "ConservativeRoots.h"
 #include "CopiedSpace.h"
 #include "CopiedSpaceInlines.h"
 #include "CopyVisitorInlines.h"
+#include "DFGWorklist.h"
 #include "GCActivityCallback.h"
 #include "HeapRootVisitor.h"
+#include "HeapSnapshotWriter.h"
 #include "HeapStatistics.h"
 #include "IncrementalSweeper.h"
 #include "Interpreter.h"
@@ -36,6 +39,8 @@
 #include "JSLock.h"
 #include "JSONObject.h"
 #include "Operations.h"
+#include "SamplingProfiler.h"
+#include "SlotVisitorInlines.h"
 #include "Tracing.h"
 #include "UnlinkedCodeBlock.h"
 #include "WeakSetInlines.h"
@@ -246,6 +251,11 @@ Heap::Heap(VM* vm, HeapType heapType)
     , m_ramSize(ramSize())
     , m_minBytesPerCycle(minHeapSize(m_heapType, m_ramSize))
     , m_sizeAfterLastCollect(0)
+    , m_storageCapacityAfterLastFullCollection(0)
+    , m_edenCollectionsSinceLastFullCollection(0)
+    , m_isMarkingIncrementally(false)
+    , m_nextIncrementalMarkingSliceTime(0)
+    , m_isWriteBarrierEnabled(isWriteBarrierEnabled())
     , m_bytesAllocatedLimit(m_minBytesPerCycle)
     , m_bytesAllocated(0)
     , m_bytesAbandoned(0)
@@ -261,11 +271,12 @@ Heap::Heap(VM* vm, HeapType heapType)
     , m_isSafeToCollect(false)
     , m_vm(vm)
     , m_lastGCLength(0)
-    , m_lastCodeDiscardTime(WTF::currentTime())
     , m_activityCallback(DefaultGCActivityCallback::create(this))
     , m_sweeper(IncrementalSweeper::create(this))
 {
     m_storageSpace.init();
+    if (Options::sampleAllocationSites())
+        m_allocationSiteProfiler = adoptPtr(new AllocationSiteProfiler(*vm));
 }
 
 Heap::~Heap()
@@ -284,6 +295,9 @@ void Heap::lastChanceToFinalize()
     RELEASE_ASSERT(!m_vm->dynamicGlobalObject);
     RELEASE_ASSERT(m_operationInProgress == NoOperation);
 
+    // Marking has pinned every copied block and may have work left on the mark stack.
+    finishIncrementalMarking();
+
     m_objectSpace.lastChanceToFinalize();
 
 #if ENABLE(SIMPLE_HEAP_PROFILING)
@@ -374,6 +388,17 @@ void Heap::popTempSortVector(Vector<ValueStringPair, 0, UnsafeVectorOverflow>* t
     m_tempSortingVectors.removeLast();
 }
 
+void Heap::pushTempSortVector(Vector<JSValue, 0, UnsafeVectorOverflow>* tempVector)
+{
+    m_tempSortingValueVectors.append(tempVector);
+}
+
+void Heap::popTempSortVector(Vector<JSValue, 0, UnsafeVectorOverflow>* tempVector)
+{
+    ASSERT_UNUSED(tempVector, tempVector == m_tempSortingValueVectors.last());
+    m_tempSortingValueVectors.removeLast();
+}
+
 void Heap::markTempSortVectors(HeapRootVisitor& heapRootVisitor)
 {
     typedef Vector<Vector<ValueStringPair, 0, UnsafeVectorOverflow>* > VectorOfValueStringVectors;
@@ -388,6 +413,11 @@ void Heap::markTempSortVectors(HeapRootVisitor& heapRootVisitor)
                 heapRootVisitor.visit(&vectorIt->first);
         }
     }
+
+    for (size_t i = 0; i < m_tempSortingValueVectors.size(); ++i) {
+        Vector<JSValue, 0, UnsafeVectorOverflow>* tempSortingVector = m_tempSortingValueVectors[i];
+        heapRootVisitor.visit(tempSortingVector->data(), tempSortingVector->size());
+    }
 }
 
 void Heap::harvestWeakReferences()
@@ -423,7 +453,108 @@ void Heap::getConservativeRegisterRoots(HashSet<JSCell*>& roots)
     }
 }
 
-void Heap::markRoots()
+class WriteHeapSnapshotNode : public MarkedBlock::VoidFunctor {
+public:
+    WriteHeapSnapshotNode(HeapSnapshotWriter& writer, SlotVisitor& visitor)
+        : m_writer(writer)
+        , m_visitor(visitor)
+    {
+    }
+
+    void operator()(JSCell* cell)
+    {
+        m_writer.appendNode(cell);
+        m_visitor.visitChildrenForHeapSnapshot(cell);
+    }
+
+private:
+    HeapSnapshotWriter& m_writer;
+    SlotVisitor& m_visitor;
+};
+
+bool Heap::writeHeapSnapshot(int fd)
+{
+    ASSERT(isValidThreadState(m_vm));
+    if (!m_isSafeToCollect)
+        return false;
+
+    // The walk below uses the mark bits to find the live cells, and only a full
+    // collection leaves exactly those marked.
+    collectAllGarbage();
+
+#if ENABLE(DFG_JIT)
+    // Visiting a CodeBlock updates its value profiles, which compiler threads read.
+    DFG::Worklist* worklist = m_vm->dfgWorklist();
+    if (worklist)
+        worklist->suspendAllThreads();
+#endif
+
+    HeapSnapshotWriter writer(fd);
+    SlotVisitor visitor(m_sharedData);
+    visitor.setHeapSnapshotWriter(&writer);
+    HeapRootVisitor heapRootVisitor(visitor);
+
+    // The same roots that markRoots() starts from, less the ones that only exist
+    // while code is being compiled.
+    void* dummy;
+    ConservativeRoots machineThreadRoots(&m_objectSpace.blocks(), &m_storageSpace);
+    m_machineThreads.gatherConservativeRoots(machineThreadRoots, &dummy);
+    visitor.append(machineThreadRoots);
+    ConservativeRoots stackRoots(&m_objectSpace.blocks(), &m_storageSpace);
+    stack().gatherConservativeRoots(stackRoots);
+    visitor.append(stackRoots);
+    m_vm->smallStrings.visitStrongReferences(visitor);
+    markProtectedObjects(heapRootVisitor);
+    markTempSortVectors(heapRootVisitor);
+    if (m_markListSet && m_markListSet->size())
+        MarkedArgumentBuffer::markLists(heapRootVisitor, *m_markListSet);
+    if (m_vm->exception)
+        heapRootVisitor.visit(&m_vm->exception);
+    m_handleSet.visitStrongHandles(heapRootVisitor);
+    m_handleStack.visit(heapRootVisitor);
+
+    WriteHeapSnapshotNode functor(writer, visitor);
+    m_objectSpace.forEachLiveCell(functor);
+
+    if (m_allocationSiteProfiler)
+        m_allocationSiteProfiler->writeTo(writer);
+
+    visitor.setHeapSnapshotWriter(0);
+
+#if ENABLE(DFG_JIT)
+    if (worklist)
+        worklist->resumeAllThreads();
+#endif
+
+    return writer.finish();
+}
+
+struct VisitRememberedCells : MarkedBlock::VoidFunctor {
+    VisitRememberedCells(SlotVisitor& visitor)
+        : m_visitor(visitor)
+    {
+    }
+
+    void operator()(MarkedBlock* block) { block->forEachRememberedCell(*this); }
+    void operator()(JSCell* cell) { m_visitor.appendToMarkStack(cell); }
+
+    SlotVisitor& m_visitor;
+};
+
+void Heap::visitRememberedSet(SlotVisitor& visitor)
+{
+    VisitRememberedCells functor(visitor);
+    m_objectSpace.forEachBlock(functor);
+
+    // CodeBlocks and the inline caches in JIT code are not covered by the write
+    // barrier, so every old executable that owns code is treated as remembered.
+    for (ExecutableBase* current = m_compiledCode.head(); current; current = current->next()) {
+        if (isMarked(current))
+            visitor.appendToMarkStack(current);
+    }
+}
+
+void Heap::markRoots(CollectionType collectionType)
 {
     SamplingRegion samplingRegion("Garbage Collection: Tracing");
 
@@ -461,25 +592,50 @@ void Heap::markRoots()
     }
 #endif
 
-    {
+    SlotVisitor& visitor = m_slotVisitor;
+    bool isRemark = m_isMarkingIncrementally;
+    if (collectionType == FullCollection && !isRemark) {
         GCPHASE(clearMarks);
         m_objectSpace.clearMarks();
+        visitor.clearOpaqueRoots();
+    } else {
+        // Cells that survived the last collection keep their mark bits and so
+        // will not be visited again unless they are on a dirty card. Objects
+        // that own opaque roots may not be visited either, so their roots are
+        // kept until the next full collection. A remark treats the cells that
+        // incremental marking has already visited the same way.
+        GCPHASE(ClearNewlyAllocated);
+        m_objectSpace.clearNewlyAllocated();
+        m_storageSpace.pinAllBlocks();
     }
 
     m_sharedData.didStartMarking();
-    SlotVisitor& visitor = m_slotVisitor;
     visitor.setup();
     HeapRootVisitor heapRootVisitor(visitor);
 
     {
         ParallelModeEnabler enabler(visitor);
 
+        if (collectionType == EdenCollection || isRemark) {
+            GCPHASE(VisitRememberedSet);
+            MARK_LOG_ROOT(visitor, "Remembered Set");
+            visitRememberedSet(visitor);
+            visitor.donateAndDrain();
+        }
+
         if (m_vm->codeBlocksBeingCompiled.size()) {
             GCPHASE(VisitActiveCodeBlock);
             for (size_t i = 0; i < m_vm->codeBlocksBeingCompiled.size(); i++)
                 m_vm->codeBlocksBeingCompiled[i]->visitAggregate(visitor);
         }
 
+#if ENABLE(DFG_JIT)
+        if (DFG::Worklist* worklist = m_vm->dfgWorklist()) {
+            GCPHASE(VisitDFGWorklist);
+            worklist->visitChildren(visitor);
+        }
+#endif
+
         m_vm->smallStrings.visitStrongReferences(visitor);
 
         {
@@ -588,7 +744,7 @@ void Heap::markRoots()
 #if ENABLE(PARALLEL_GC)
     visitCount += m_sharedData.childVisitCount();
 #endif
-    MARK_LOG_MESSAGE2("\nNumber of live Objects after full GC %lu, took %.6f secs\n", visitCount, WTF::currentTime() - gcStartTime);
+    MARK_LOG_MESSAGE2("\nNumber of live Objects after GC %lu, took %.6f secs\n", visitCount, WTF::currentTime() - gcStartTime);
 #endif
 
     visitor.reset();
@@ -654,6 +810,18 @@ PassOwnPtr<TypeCountSet> Heap::objectTypeCounts()
     return m_objectSpace.forEachLiveCell<RecordType>();
 }
 
+static inline void processSamplingProfilerSamples(VM* vm)
+{
+#if ENABLE(SAMPLING_PROFILER)
+    // Samples name CodeBlocks by address, so they have to be resolved before any
+    // code that they may name gets deleted.
+    if (SamplingProfiler* samplingProfiler = vm->samplingProfiler())
+        samplingProfiler->processSamples();
+#else
+    UNUSED_PARAM(vm);
+#endif
+}
+
 void Heap::deleteAllCompiledCode()
 {
     // If JavaScript is running, it's not safe to delete code, since we'll end
@@ -661,6 +829,14 @@ void Heap::deleteAllCompiledCode()
     if (m_vm->dynamicGlobalObject)
         return;
 
+    // Incremental marking may have put CodeBlocks on the weak reference harvester
+    // and unconditional finalizer lists, so they have to outlive it. No JavaScript
+    // is running, so we can finish the marking now and delete the code afterwards.
+    finishIncrementalMarking();
+    ASSERT(!m_isMarkingIncrementally);
+
+    processSamplingProfilerSamples(m_vm);
+
     for (ExecutableBase* current = m_compiledCode.head(); current; current = current->next()) {
         if (!current->isFunctionExecutable())
             continue;
@@ -671,6 +847,61 @@ void Heap::deleteAllCompiledCode()
     m_dfgCodeBlocks.deleteUnmarkedJettisonedCodeBlocks();
 }
 
+void Heap::deleteOldCompiledCode()
+{
+    // Code that has not been entered for a while is probably not coming back, so
+    // we give its executable memory back and keep only the unlinked bytecode; if
+    // the function does get called again it gets relinked, and then tiers up
+    // again if it is hot. Every full collection ages the code, but it is only
+    // safe to delete it when no JavaScript is running, which is the case for the
+    // collections that the activity callback starts.
+    unsigned maximumAge = Options::numberOfFullCollectionsBeforeCodeEviction();
+    if (!maximumAge)
+        return;
+
+    bool mayDeleteCode = !m_vm->dynamicGlobalObject;
+    for (ExecutableBase* current = m_compiledCode.head(); current; current = current->next()) {
+        if (!current->isFunctionExecutable())
+            continue;
+        FunctionExecutable* executable = static_cast<FunctionExecutable*>(current);
+        if (executable->updateCodeAge() < maximumAge || !mayDeleteCode)
+            continue;
+        executable->clearCodeIfNotCompiling();
+    }
+}
+
+static void addCodeBlockAndAlternatives(HashSet<CodeBlock*>& codeBlocks, CodeBlock* codeBlock)
+{
+    for (; codeBlock; codeBlock = codeBlock->alternative())
+        codeBlocks.add(codeBlock);
+}
+
+void Heap::gatherCodeBlocks(HashSet<CodeBlock*>& codeBlocks)
+{
+    for (ExecutableBase* current = m_compiledCode.head(); current; current = current->next()) {
+        if (current->isFunctionExecutable()) {
+            FunctionExecutable* executable = static_cast<FunctionExecutable*>(current);
+            if (executable->isGeneratedForCall())
+                addCodeBlockAndAlternatives(codeBlocks, &executable->generatedBytecodeForCall());
+            if (executable->isGeneratedForConstruct())
+                addCodeBlockAndAlternatives(codeBlocks, &executable->generatedBytecodeForConstruct());
+        } else if (ProgramExecutable* executable = jsDynamicCast<ProgramExecutable*>(current)) {
+            if (executable->isGenerated())
+                addCodeBlockAndAlternatives(codeBlocks, &executable->generatedBytecode());
+        } else if (EvalExecutable* executable = jsDynamicCast<EvalExecutable*>(current)) {
+            if (executable->isGenerated())
+                addCodeBlockAndAlternatives(codeBlocks, &executable->generatedBytecode());
+        }
+    }
+
+#if ENABLE(DFG_JIT)
+    const HashSet<CodeBlock*>& jettisonedCodeBlocks = m_dfgCodeBlocks.jettisonedCodeBlocks();
+    HashSet<CodeBlock*>::const_iterator end = jettisonedCodeBlocks.end();
+    for (HashSet<CodeBlock*>::const_iterator iter = jettisonedCodeBlocks.begin(); iter != end; ++iter)
+        codeBlocks.add(*iter);
+#endif
+}
+
 void Heap::deleteUnmarkedCompiledCode()
 {
     ExecutableBase* next;
@@ -697,10 +928,171 @@ void Heap::collectAllGarbage()
     collect(DoSweep);
 }
 
-static double minute = 60.0;
+Heap::CollectionType Heap::collectionTypeFor(SweepToggle sweepToggle)
+{
+    if (m_isMarkingIncrementally)
+        return FullCollection;
+
+    if (!Options::enableGenerationalGC())
+        return FullCollection;
+
+    // Callers that ask for a sweep want all the memory back.
+    if (sweepToggle == DoSweep)
+        return FullCollection;
+
+    if (m_edenCollectionsSinceLastFullCollection >= Options::maximumEdenCollectionsBeforeFullCollection())
+        return FullCollection;
+
+    // Eden collections never compact or free backing stores.
+    if (m_storageSpace.capacity() > m_storageCapacityAfterLastFullCollection * Options::storageGrowthFactorForFullCollection())
+        return FullCollection;
+
+    return EdenCollection;
+}
+
+bool Heap::shouldStartIncrementalMarking(SweepToggle sweepToggle)
+{
+    if (!Options::enableIncrementalMarking() || m_isMarkingIncrementally)
+        return false;
+
+    // Incremental marking never compacts copied space, so collections that are
+    // supposed to give memory back stay stop-the-world.
+    if (sweepToggle == DoSweep)
+        return false;
+    if (m_storageSpace.capacity() > m_storageCapacityAfterLastFullCollection * Options::storageGrowthFactorForFullCollection())
+        return false;
+
+    return collectionTypeFor(sweepToggle) == FullCollection;
+}
+
+void Heap::startIncrementalMarking()
+{
+    SamplingRegion samplingRegion("Garbage Collection: Incremental Marking");
+
+    GCPHASE(StartIncrementalMarking);
+    ASSERT(vm()->apiLock().currentThreadIsHoldingLock());
+    ASSERT(m_isSafeToCollect);
+    RELEASE_ASSERT(m_operationInProgress == NoOperation);
+    m_operationInProgress = Collection;
+
+    m_activityCallback->willCollect();
+
+    double startTime = WTF::currentTime();
+    processSamplingProfilerSamples(m_vm);
+    deleteOldCompiledCode();
+
+#if ENABLE(DFG_JIT)
+    DFG::Worklist* worklist = m_vm->dfgWorklist();
+    if (worklist)
+        worklist->suspendAllThreads();
+#endif
+
+    {
+        GCPHASE(Canonicalize);
+        m_objectSpace.canonicalizeCellLivenessData();
+    }
+
+    // We gather conservative roots before clearing mark bits because conservative
+    // gathering uses the mark bits to determine whether a reference is valid. The
+    // rest of the roots, and everything to do with code, waits for the remark.
+    void* dummy;
+    ConservativeRoots machineThreadRoots(&m_objectSpace.blocks(), &m_storageSpace);
+    m_machineThreads.gatherConservativeRoots(machineThreadRoots, &dummy);
+    ConservativeRoots stackRoots(&m_objectSpace.blocks(), &m_storageSpace);
+    stack().gatherConservativeRoots(stackRoots);
+
+    // The mutator keeps running until the remark, but it must not sweep a block
+    // or evacuate a backing store based on marks that are not final.
+    m_sweeper->willFinishSweeping();
+    m_objectSpace.clearMarksPreservingLiveness();
+    m_objectSpace.retireExistingBlocks();
+    m_storageSpace.pinAllBlocks();
+
+    SlotVisitor& visitor = m_slotVisitor;
+    visitor.clearOpaqueRoots();
+    visitor.setup();
+    HeapRootVisitor heapRootVisitor(visitor);
+    visitor.append(machineThreadRoots);
+    visitor.append(stackRoots);
+    markProtectedObjects(heapRootVisitor);
+    m_handleSet.visitStrongHandles(heapRootVisitor);
+    m_vm->smallStrings.visitStrongReferences(visitor);
+
+#if ENABLE(DFG_JIT)
+    if (worklist)
+        worklist->resumeAllThreads();
+#endif
+
+    m_isMarkingIncrementally = true;
+    m_nextIncrementalMarkingSliceTime = 0;
+
+    // The mutator gets a fresh allocation budget to run on while we mark. If it
+    // uses it up before marking is done, the remark finishes the job.
+    m_bytesAllocated = 0;
+
+    double endTime = WTF::currentTime();
+    if (Options::recordGCPauseTimes())
+        HeapStatistics::recordGCPauseTime(startTime, endTime);
+    RELEASE_ASSERT(m_operationInProgress == Collection);
+    m_operationInProgress = NoOperation;
+}
+
+void Heap::markIncrementally()
+{
+    ASSERT(m_isMarkingIncrementally);
+    if (!m_isSafeToCollect || m_operationInProgress != NoOperation)
+        return;
+
+    double sliceStartTime = WTF::monotonicallyIncreasingTime();
+    if (sliceStartTime < m_nextIncrementalMarkingSliceTime)
+        return;
+
+    SamplingRegion samplingRegion("Garbage Collection: Incremental Marking");
+    GCPHASE(MarkIncrementally);
+    ASSERT(vm()->apiLock().currentThreadIsHoldingLock());
+    m_operationInProgress = Collection;
+
+#if ENABLE(DFG_JIT)
+    DFG::Worklist* worklist = m_vm->dfgWorklist();
+    if (worklist)
+        worklist->suspendAllThreads();
+#endif
+
+    double startTime = WTF::currentTime();
+    m_slotVisitor.drainUntil(sliceStartTime + Options::incrementalMarkingSliceMilliseconds() / 1000);
+    double endTime = WTF::currentTime();
+
+#if ENABLE(DFG_JIT)
+    if (worklist)
+        worklist->resumeAllThreads();
+#endif
+
+    // Give the mutator enough time before the next slice that, over the course of
+    // the marking, it gets at least the requested share of the CPU.
+    double sliceEndTime = WTF::monotonicallyIncreasingTime();
+    double utilization = std::max(0.0, std::min(Options::minimumMutatorUtilizationDuringIncrementalMarking(), 0.99));
+    m_nextIncrementalMarkingSliceTime = sliceEndTime + (sliceEndTime - sliceStartTime) * utilization / (1 - utilization);
+
+    if (Options::recordGCPauseTimes())
+        HeapStatistics::recordGCPauseTime(startTime, endTime);
+    RELEASE_ASSERT(m_operationInProgress == Collection);
+    m_operationInProgress = NoOperation;
+}
+
+void Heap::finishIncrementalMarking()
+{
+    if (!m_isMarkingIncrementally)
+        return;
+    collect(DoNotSweep);
+}
 
 void Heap::collect(SweepToggle sweepToggle)
 {
+    if (shouldStartIncrementalMarking(sweepToggle)) {
+        startIncrementalMarking();
+        return;
+    }
+
     SamplingRegion samplingRegion("Garbage Collection");
     
     GCPHASE(Collect);
@@ -714,17 +1106,28 @@ void Heap::collect(SweepToggle sweepToggle)
     m_activityCallback->willCollect();
 
     double lastGCStartTime = WTF::currentTime();
-    if (lastGCStartTime - m_lastCodeDiscardTime > minute) {
-        deleteAllCompiledCode();
-        m_lastCodeDiscardTime = WTF::currentTime();
-    }
+    processSamplingProfilerSamples(m_vm);
+    // The remark of an incremental collection was aged when the marking started.
+    if (!m_isMarkingIncrementally && collectionTypeFor(sweepToggle) == FullCollection)
+        deleteOldCompiledCode();
+
+#if ENABLE(DFG_JIT)
+    // Compiler threads read the CodeBlocks that we are about to mark and maybe
+    // delete, so keep them parked until we are done with code.
+    DFG::Worklist* worklist = m_vm->dfgWorklist();
+    if (worklist)
+        worklist->suspendAllThreads();
+#endif
 
     {
         GCPHASE(Canonicalize);
         m_objectSpace.canonicalizeCellLivenessData();
     }
 
-    markRoots();
+    CollectionType collectionType = collectionTypeFor(sweepToggle);
+    bool isRemark = m_isMarkingIncrementally;
+    markRoots(collectionType);
+    m_isMarkingIncrementally = false;
     
     {
         GCPHASE(ReapingWeakHandles);
@@ -739,7 +1142,10 @@ void Heap::collect(SweepToggle sweepToggle)
         m_objectSpace.forEachBlock(functor);
     }
 
-    copyBackingStores();
+    if (collectionType == FullCollection && !isRemark)
+        copyBackingStores();
+    else
+        m_storageSpace.unpinAllBlocks();
 
     {
         GCPHASE(FinalizeUnconditionalFinalizers);
@@ -756,6 +1162,11 @@ void Heap::collect(SweepToggle sweepToggle)
         deleteUnmarkedCompiledCode();
     }
 
+#if ENABLE(DFG_JIT)
+    if (worklist)
+        worklist->resumeAllThreads();
+#endif
+
     {
         GCPHASE(DeleteSourceProviderCaches);
         m_vm->clearSourceProviderCaches();
@@ -781,6 +1192,13 @@ void Heap::collect(SweepToggle sweepToggle)
         HeapStatistics::exitWithFailure();
 
     m_sizeAfterLastCollect = currentHeapSize;
+    if (collectionType == FullCollection) {
+        // Only collections that compacted copied space reset its growth allowance.
+        if (!isRemark)
+            m_storageCapacityAfterLastFullCollection = m_storageSpace.capacity();
+        m_edenCollectionsSinceLastFullCollection = 0;
+    } else
+        m_edenCollectionsSinceLastFullCollection++;
 
     // To avoid pathological GC churn in very small and very large heaps, we set
     // the new allocation limit based on the current size of the heap, with a
@@ -838,6 +1256,8 @@ void Heap::didAllocate(size_t bytes)
 {
     m_activityCallback->didAllocate(m_bytesAllocated + m_bytesAbandoned);
     m_bytesAllocated += bytes;
+    if (m_isMarkingIncrementally)
+        markIncrementally();
 }
 
 bool Heap::isValidAllocation(size_t)
@@ -44,6 +44,7 @@
 
 namespace JSC {
 
+    class AllocationSiteProfiler;
     class CopiedSpace;
     class CodeBlock;
     class ExecutableBase;
@@ -132,6 +133,12 @@ namespace JSC {
         bool shouldCollect();
         void collect(SweepToggle);
 
+        // With Options::enableIncrementalMarking(), a collection that would be a full
+        // one starts marking instead, and marks a little more each time the mutator
+        // allocates. The collection that finishes the marking is a short remark.
+        JS_EXPORT_PRIVATE void finishIncrementalMarking();
+        bool isMarkingIncrementally() const { return m_isMarkingIncrementally; }
+
         void reportExtraMemoryCost(size_t cost);
         JS_EXPORT_PRIVATE void reportAbandonedObjectGraph();
 
@@ -152,6 +159,8 @@ namespace JSC {
 
         void pushTempSortVector(Vector<ValueStringPair, 0, UnsafeVectorOverflow>*);
         void popTempSortVector(Vector<ValueStringPair, 0, UnsafeVectorOverflow>*);
+        void pushTempSortVector(Vector<JSValue, 0, UnsafeVectorOverflow>*);
+        void popTempSortVector(Vector<JSValue, 0, UnsafeVectorOverflow>*);
     
         HashSet<MarkedArgumentBuffer*>& markListSet() { if (!m_markListSet) m_markListSet = adoptPtr(new HashSet<MarkedArgumentBuffer*>); return *m_markListSet; }
         
@@ -164,10 +173,21 @@ namespace JSC {
         void canonicalizeCellLivenessData();
         void getConservativeRegisterRoots(HashSet<JSCell*>& roots);
 
+        // Collects all garbage, then streams every live cell and the references between
+        // them to the file descriptor, followed by the allocation sites sampled so far
+        // if Options::sampleAllocationSites() is set. The format is described in
+        // HeapSnapshotWriter.h. Returns false if the snapshot could not be written.
+        JS_EXPORT_PRIVATE bool writeHeapSnapshot(int fd);
+
         double lastGCLength() { return m_lastGCLength; }
         void increaseLastGCLength(double amount) { m_lastGCLength += amount; }
 
         JS_EXPORT_PRIVATE void deleteAllCompiledCode();
+        void deleteOldCompiledCode();
+
+        // Adds every CodeBlock that belongs to a compiled executable, including the
+        // alternatives it keeps and jettisoned DFG code that may still be running.
+        void gatherCodeBlocks(HashSet<CodeBlock*>&);
 
         void didAllocate(size_t);
         void didAbandon(size_t);
@@ -210,7 +230,14 @@ namespace JSC {
         JS_EXPORT_PRIVATE bool isValidAllocation(size_t);
         JS_EXPORT_PRIVATE void reportExtraMemoryCostSlowCase(size_t);
 
-        void markRoots();
+        enum CollectionType { EdenCollection, FullCollection };
+        CollectionType collectionTypeFor(SweepToggle);
+        bool shouldStartIncrementalMarking(SweepToggle);
+        void startIncrementalMarking();
+        void markIncrementally();
+
+        void markRoots(CollectionType);
+        void visitRememberedSet(SlotVisitor&);
         void markProtectedObjects(HeapRootVisitor&);
         void markTempSortVectors(HeapRootVisitor&);
         void copyBackingStores();
@@ -227,6 +254,12 @@ namespace JSC {
         const size_t m_ramSize;
         const size_t m_minBytesPerCycle;
         size_t m_sizeAfterLastCollect;
+        size_t m_storageCapacityAfterLastFullCollection;
+        unsigned m_edenCollectionsSinceLastFullCollection;
+        bool m_isMarkingIncrementally;
+        double m_nextIncrementalMarkingSliceTime;
+        // Cached copy of isWriteBarrierEnabled() that the LLInt can test without calling out.
+        bool m_isWriteBarrierEnabled;
 
         size_t m_bytesAllocatedLimit;
         size_t m_bytesAllocated;
@@ -243,6 +276,7 @@ namespace JSC {
 
         ProtectCountSet m_protectedValues;
         Vector<Vector<ValueStringPair, 0, UnsafeVectorOverflow>* > m_tempSortingVectors;
+        Vector<Vector<JSValue, 0, UnsafeVectorOverflow>* > m_tempSortingValueVectors;
         OwnPtr<HashSet<MarkedArgumentBuffer*> > m_markListSet;
 
         MachineThreads m_machineThreads;
@@ -261,13 +295,14 @@ namespace JSC {
 
         VM* m_vm;
         double m_lastGCLength;
-        double m_lastCodeDiscardTime;
 
         DoublyLinkedList<ExecutableBase> m_compiledCode;
         
         OwnPtr<GCActivityCallback> m_activityCallback;
         OwnPtr<IncrementalSweeper> m_sweeper;
         Vector<MarkedBlock*> m_blockSnapshot;
+
+        OwnPtr<AllocationSiteProfiler> m_allocationSiteProfiler;
     };
 
     struct MarkedBlockSnapshotFunctor : public MarkedBlock::VoidFunctor {
@@ -285,9 +320,14 @@ namespace JSC {
 
     inline bool Heap::shouldCollect()
     {
+        if (!m_isSafeToCollect || m_operationInProgress != NoOperation)
+            return false;
+        // Once incremental marking has run out of work, the remark will not get any shorter.
+        if (m_isMarkingIncrementally && m_slotVisitor.isEmpty())
+            return true;
         if (Options::gcMaxHeapSize())
-            return m_bytesAllocated > Options::gcMaxHeapSize() && m_isSafeToCollect && m_operationInProgress == NoOperation;
-        return m_bytesAllocated > m_bytesAllocatedLimit && m_isSafeToCollect && m_operationInProgress == NoOperation;
+            return m_bytesAllocated > Options::gcMaxHeapSize();
+        return m_bytesAllocated > m_bytesAllocatedLimit;
     }
 
     bool Heap::isBusy()
@@ -332,18 +372,37 @@ namespace JSC {
 #if ENABLE(WRITE_BARRIER_PROFILING)
         return true;
 #else
-        return false;
+        return Options::enableGenerationalGC() || Options::enableIncrementalMarking();
 #endif
     }
 
-    inline void Heap::writeBarrier(const JSCell*, JSCell*)
+    inline void Heap::writeBarrier(const JSCell* owner, JSCell* cell)
     {
         WriteBarrierCounters::countWriteBarrier();
+        if (!isWriteBarrierEnabled())
+            return;
+        if (!owner || !cell)
+            return;
+        // Only marked objects need to be remembered: an eden collection does not
+        // visit old objects, and incremental marking may have visited them already.
+        MarkedBlock* block = MarkedBlock::blockFor(owner);
+        if (!block->isMarked(owner))
+            return;
+        block->dirtyCard(owner);
     }
 
-    inline void Heap::writeBarrier(const JSCell*, JSValue)
+    inline void Heap::writeBarrier(const JSCell* owner, JSValue value)
     {
-        WriteBarrierCounters::countWriteBarrier();
+        if (!value.isCell()) {
+            WriteBarrierCounters::countWriteBarrier();
+            return;
+        }
+        writeBarrier(owner, value.asCell());
+    }
+
+    inline uint8_t* Heap::addressOfCardFor(JSCell* cell)
+    {
+        return MarkedBlock::blockFor(cell)->addressOfCardFor(cell);
     }
 
     inline void Heap::reportExtraMemoryCost(size_t cost)
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "HeapSnapshotWriter.h"
+
+#include "JSCell.h"
+#include "MarkedBlock.h"
+#include "Operations.h"
+#include <errno.h>
+#include <wtf/text/CString.h>
+
+#if OS(UNIX)
+#include <unistd.h>
+#endif
+
+namespace JSC {
+
+HeapSnapshotWriter::HeapSnapshotWriter(int fd)
+    : m_fd(fd)
+    , m_didFail(false)
+    , m_nodeCount(0)
+    , m_edgeCount(0)
+{
+    m_buffer.reserveInitialCapacity(bufferSize);
+    writeBytes("JSCHEAP", 8);
+    writeUInt32(formatVersion);
+    writeUInt32(sizeof(void*));
+}
+
+HeapSnapshotWriter::~HeapSnapshotWriter()
+{
+}
+
+void HeapSnapshotWriter::appendRoot(JSCell* cell)
+{
+    ASSERT(!m_nodeCount);
+    writeTag('R');
+    writeUInt64(bitwise_cast<uintptr_t>(cell));
+    flushIfNecessary();
+}
+
+void HeapSnapshotWriter::appendNode(JSCell* cell)
+{
+    const ClassInfo* classInfo = cell->classInfo();
+    HashMap<const ClassInfo*, unsigned>::AddResult result = m_classNames.add(classInfo, 0);
+    if (result.isNewEntry)
+        result.iterator->value = stringID(String(classInfo->className));
+
+    writeTag('N');
+    writeUInt64(bitwise_cast<uintptr_t>(cell));
+    writeUInt32(result.iterator->value);
+    writeUInt32(MarkedBlock::blockFor(cell)->cellSize());
+    m_nodeCount++;
+    flushIfNecessary();
+}
+
+void HeapSnapshotWriter::appendEdge(JSCell* cell)
+{
+    ASSERT(m_nodeCount);
+    writeTag('E');
+    writeUInt64(bitwise_cast<uintptr_t>(cell));
+    m_edgeCount++;
+    flushIfNecessary();
+}
+
+void HeapSnapshotWriter::appendAllocationSite(const String& url, unsigned codeBlockHash, unsigned bytecodeOffset, unsigned lineNumber, uint64_t samples, uint64_t bytes)
+{
+    unsigned urlID = stringID(url);
+    writeTag('A');
+    writeUInt32(urlID);
+    writeUInt32(codeBlockHash);
+    writeUInt32(bytecodeOffset);
+    writeUInt32(lineNumber);
+    writeUInt64(samples);
+    writeUInt64(bytes);
+    flushIfNecessary();
+}
+
+bool HeapSnapshotWriter::finish()
+{
+    writeTag('X');
+    writeUInt64(m_nodeCount);
+    writeUInt64(m_edgeCount);
+    flush();
+    return !m_didFail;
+}
+
+unsigned HeapSnapshotWriter::stringID(const String& string)
+{
+    if (string.isEmpty())
+        return 0;
+
+    HashMap<String, unsigned>::AddResult result = m_strings.add(string, m_strings.size() + 1);
+    if (!result.isNewEntry)
+        return result.iterator->value;
+
+    CString utf8 = string.utf8();
+    writeTag('S');
+    writeUInt32(result.iterator->value);
+    writeUInt32(utf8.length());
+    writeBytes(utf8.data(), utf8.length());
+    return result.iterator->value;
+}
+
+void HeapSnapshotWriter::writeUInt32(uint32_t value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void HeapSnapshotWriter::writeUInt64(uint64_t value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void HeapSnapshotWriter::writeBytes(const void* data, size_t size)
+{
+    m_buffer.append(static_cast<const uint8_t*>(data), size);
+}
+
+void HeapSnapshotWriter::flushIfNecessary()
+{
+    // Records are small, so we can let the buffer run a little past its size rather
+    // than checking before every field.
+    if (m_buffer.size() >= bufferSize)
+        flush();
+}
+
+void HeapSnapshotWriter::flush()
+{
+#if OS(UNIX)
+    const uint8_t* data = m_buffer.data();
+    size_t remaining = m_buffer.size();
+    while (remaining && !m_didFail) {
+        ssize_t written = write(m_fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            m_didFail = true;
+            break;
+        }
+        data += written;
+        remaining -= written;
+    }
+#else
+    m_didFail = true;
+#endif
+    m_buffer.shrink(0);
+}
+
+} // namespace JSC
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HeapSnapshotWriter_h
+#define HeapSnapshotWriter_h
+
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class JSCell;
+struct ClassInfo;
+
+// Streams a heap snapshot to a file descriptor as it is taken, so that the object
+// graph never has to be held in memory. See Heap::writeHeapSnapshot().
+//
+// The file starts with the eight bytes "JSCHEAP\0", followed by the format version
+// and the size of a pointer as 32-bit integers. Then comes a sequence of records,
+// each of which starts with a one byte tag. All integers are in host byte order.
+//
+//   'S' string:          u32 id, u32 length, length bytes of UTF-8
+//   'R' root:            u64 cell
+//   'N' node:            u64 cell, u32 class name string id, u32 cell size
+//   'E' edge:            u64 cell, referenced by the last node
+//   'A' allocation site: u32 url string id, u32 code block hash, u32 bytecode offset,
+//                        u32 line, u64 samples, u64 bytes
+//   'X' end:             u64 node count, u64 edge count
+//
+// A string is written before the first record that refers to it. String id 0 is the
+// empty string and is never written. Roots come before all nodes, and the edges of
+// a node follow it directly.
+class HeapSnapshotWriter {
+    WTF_MAKE_NONCOPYABLE(HeapSnapshotWriter);
+public:
+    static const unsigned formatVersion = 1;
+
+    explicit HeapSnapshotWriter(int fd);
+    ~HeapSnapshotWriter();
+
+    void appendRoot(JSCell*);
+    void appendNode(JSCell*);
+    void appendEdge(JSCell*);
+
+    // Edges from roots until the first node has been appended, from that node after.
+    void appendReference(JSCell* cell)
+    {
+        if (m_nodeCount)
+            appendEdge(cell);
+        else
+            appendRoot(cell);
+    }
+
+    void appendAllocationSite(const String& url, unsigned codeBlockHash, unsigned bytecodeOffset, unsigned lineNumber, uint64_t samples, uint64_t bytes);
+
+    // Writes the end record and flushes. Returns false if any write failed.
+    bool finish();
+
+private:
+    unsigned stringID(const String&);
+
+    void writeTag(char tag) { m_buffer.append(static_cast<uint8_t>(tag)); }
+    void writeUInt32(uint32_t);
+    void writeUInt64(uint64_t);
+    void writeBytes(const void*, size_t);
+    void flushIfNecessary();
+    void flush();
+
+    static const size_t bufferSize = 64 * 1024;
+
+    int m_fd;
+    bool m_didFail;
+    Vector<uint8_t> m_buffer;
+    HashMap<String, unsigned> m_strings;
+    HashMap<const ClassInfo*, unsigned> m_classNames;
+    uint64_t m_nodeCount;
+    uint64_t m_edgeCount;
+};
+
+} // namespace JSC
+
+#endif // HeapSnapshotWriter_h
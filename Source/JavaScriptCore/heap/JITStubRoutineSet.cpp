@@ -34,7 +34,12 @@
 
 namespace JSC {
 
-JITStubRoutineSet::JITStubRoutineSet() { }
+JITStubRoutineSet::JITStubRoutineSet()
+    : m_filteringStartAddress(0)
+    , m_filteringExtentSize(0)
+{
+}
+
 JITStubRoutineSet::~JITStubRoutineSet()
 {
     for (size_t i = m_listOfRoutines.size(); i--;) {
@@ -72,6 +77,10 @@ void JITStubRoutineSet::clearMarks()
 {
     for (size_t i = m_listOfRoutines.size(); i--;)
         m_listOfRoutines[i]->m_mayBeExecuting = false;
+
+    // Routines are only added on this thread, so any routine that mark() could
+    // find lies within the pool as it is now.
+    JITStubRoutine::getFilteringRange(m_filteringStartAddress, m_filteringExtentSize);
 }
 
 void JITStubRoutineSet::markSlow(uintptr_t address)
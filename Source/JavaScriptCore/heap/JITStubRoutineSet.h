@@ -55,7 +55,7 @@ public:
     void mark(void* candidateAddress)
     {
         uintptr_t address = reinterpret_cast<uintptr_t>(candidateAddress);
-        if (!JITStubRoutine::passesFilter(address))
+        if (!JITStubRoutine::passesFilter(address, m_filteringStartAddress, m_filteringExtentSize))
             return;
         
         markSlow(address);
@@ -73,6 +73,10 @@ private:
     
     HashMap<uintptr_t, GCAwareJITStubRoutine*> m_addressToRoutineMap;
     Vector<GCAwareJITStubRoutine*> m_listOfRoutines;
+
+    // The range of the executable pool, as of the last clearMarks().
+    uintptr_t m_filteringStartAddress;
+    size_t m_filteringExtentSize;
 };
 
 #else // !ENABLE(JIT)
@@ -1,6 +1,7 @@
 #include "config.h"
 #include "MarkedAllocator.h"
 
+#include "AllocationSiteProfiler.h"
 #include "GCActivityCallback.h"
 #include "Heap.h"
 #include "IncrementalSweeper.h"
@@ -78,6 +79,8 @@ void* MarkedAllocator::allocateSlowCase(size_t bytes)
     
     ASSERT(!m_freeList.head);
     m_heap->didAllocate(m_freeList.bytes);
+    if (UNLIKELY(!!m_heap->m_allocationSiteProfiler))
+        m_heap->m_allocationSiteProfiler->didExhaustFreeList(m_freeList.bytes);
     
     void* result = tryAllocate(bytes);
     
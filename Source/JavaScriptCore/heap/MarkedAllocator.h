@@ -22,6 +22,7 @@ public:
 
     MarkedAllocator();
     void reset();
+    void retireExistingBlocks();
     void canonicalizeCellLivenessData();
     size_t cellSize() { return m_cellSize; }
     MarkedBlock::DestructorType destructorType() { return m_destructorType; }
@@ -100,6 +101,16 @@ inline void MarkedAllocator::reset()
     m_blocksToSweep = m_blockList.head();
 }
 
+inline void MarkedAllocator::retireExistingBlocks()
+{
+    // Sweeping a block whose mark bits are still being computed would free live
+    // cells, so while marking is incremental we only allocate out of blocks added
+    // after this point. The next reset() makes every block available again.
+    ASSERT(!m_currentBlock);
+    ASSERT(!m_freeList.head);
+    m_blocksToSweep = 0;
+}
+
 inline void MarkedAllocator::canonicalizeCellLivenessData()
 {
     if (!m_currentBlock) {
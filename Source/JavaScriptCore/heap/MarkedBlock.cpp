@@ -51,6 +51,7 @@ MarkedBlock::MarkedBlock(Region* region, MarkedAllocator* allocator, size_t cell
 {
     ASSERT(allocator);
     HEAP_LOG_BLOCK_STATE_TRANSITION(this);
+    clearCards();
 }
 
 inline void MarkedBlock::callDestructor(JSCell* cell)
@@ -199,4 +200,28 @@ void MarkedBlock::canonicalizeCellLivenessData(const FreeList& freeList)
     m_state = Marked;
 }
 
+void MarkedBlock::clearMarksPreservingLiveness()
+{
+    HEAP_LOG_BLOCK_STATE_TRANSITION(this);
+
+    ASSERT(m_state != New && m_state != FreeListed);
+
+    // Incremental marking clears the mark bits long before it is done, but until
+    // then conservative root gathering still has to tell live cells from dead
+    // ones. Cells that were live when marking started are recorded as newly
+    // allocated, which the remark discards. Allocated blocks need no record,
+    // since all of their cells are live.
+    if (m_state == Marked) {
+        if (!m_newlyAllocated)
+            m_newlyAllocated = adoptPtr(new WTF::Bitmap<atomsPerBlock>());
+        for (size_t i = firstAtom(); i < m_endAtom; i += m_atomsPerCell) {
+            if (m_marks.get(i))
+                m_newlyAllocated->set(i);
+        }
+    }
+
+    m_marks.clearAll();
+    clearCards();
+}
+
 } // namespace JSC
@@ -52,6 +52,7 @@ namespace JSC {
     
     class Heap;
     class JSCell;
+    class LLIntOffsetsExtractor;
     class MarkedAllocator;
 
     typedef uintptr_t Bits;
@@ -77,6 +78,13 @@ namespace JSC {
         static const size_t atomsPerBlock = blockSize / atomSize;
         static const size_t atomMask = atomsPerBlock - 1;
 
+        // The remembered set is kept as a card table at the head of each block.
+        // The write barrier dirties the card covering the owner of a store; eden
+        // collections rescan the old cells that start on dirty cards.
+        static const size_t cardShift = 9;
+        static const size_t bytesPerCard = 1 << cardShift;
+        static const size_t cardsPerBlock = blockSize / bytesPerCard;
+
         struct FreeCell {
             FreeCell* next;
         };
@@ -135,6 +143,8 @@ namespace JSC {
         void canonicalizeCellLivenessData(const FreeList&);
 
         void clearMarks();
+        void clearNewlyAllocated();
+        void clearMarksPreservingLiveness();
         size_t markCount();
         bool isEmpty();
 
@@ -157,11 +167,19 @@ namespace JSC {
 
         bool needsSweeping();
 
+        uint8_t* addressOfCardFor(const void*);
+        void dirtyCard(const void*);
+        void clearCards();
+        static ptrdiff_t offsetOfCards() { return OBJECT_OFFSETOF(MarkedBlock, m_cards); }
+
         template <typename Functor> void forEachCell(Functor&);
         template <typename Functor> void forEachLiveCell(Functor&);
         template <typename Functor> void forEachDeadCell(Functor&);
+        template <typename Functor> void forEachRememberedCell(Functor&);
 
     private:
+        friend class LLIntOffsetsExtractor;
+
         static const size_t atomAlignmentMask = atomSize - 1; // atomSize must be a power of two.
 
         enum BlockState { New, FreeListed, Allocated, Marked };
@@ -183,6 +201,7 @@ namespace JSC {
         WTF::Bitmap<atomsPerBlock, WTF::BitmapNotAtomic> m_marks;
 #endif
         OwnPtr<WTF::Bitmap<atomsPerBlock> > m_newlyAllocated;
+        uint8_t m_cards[cardsPerBlock];
 
         DestructorType m_destructorType;
         MarkedAllocator* m_allocator;
@@ -280,12 +299,26 @@ namespace JSC {
         ASSERT(m_state != New && m_state != FreeListed);
         m_marks.clearAll();
         m_newlyAllocated.clear();
+        clearCards();
 
         // This will become true at the end of the mark phase. We set it now to
         // avoid an extra pass to do so later.
         m_state = Marked;
     }
 
+    inline void MarkedBlock::clearNewlyAllocated()
+    {
+        HEAP_LOG_BLOCK_STATE_TRANSITION(this);
+
+        ASSERT(m_state != New && m_state != FreeListed);
+
+        // An eden collection keeps the mark bits from the last collection, so
+        // every cell that survived it is treated as old and is not visited again.
+        // Cells allocated since then are live only if this collection marks them.
+        m_newlyAllocated.clear();
+        m_state = Marked;
+    }
+
     inline size_t MarkedBlock::markCount()
     {
         return m_marks.count();
@@ -426,6 +459,44 @@ namespace JSC {
         return m_state == Marked;
     }
 
+    inline uint8_t* MarkedBlock::addressOfCardFor(const void* p)
+    {
+        return &m_cards[(reinterpret_cast<Bits>(p) - reinterpret_cast<Bits>(this)) >> cardShift];
+    }
+
+    inline void MarkedBlock::dirtyCard(const void* p)
+    {
+        *addressOfCardFor(p) = 1;
+    }
+
+    inline void MarkedBlock::clearCards()
+    {
+        memset(m_cards, 0, sizeof(m_cards));
+    }
+
+    template <typename Functor> inline void MarkedBlock::forEachRememberedCell(Functor& functor)
+    {
+        for (size_t card = 0; card < cardsPerBlock; ++card) {
+            if (!m_cards[card])
+                continue;
+            m_cards[card] = 0;
+
+            // Visit the old cells that start on this card. A cell that spans a card
+            // boundary is found through the card holding its header, which is the
+            // one the barrier dirties.
+            size_t begin = std::max(firstAtom(), card * bytesPerCard / atomSize);
+            size_t end = std::min(m_endAtom, (card + 1) * bytesPerCard / atomSize);
+            size_t offset = (begin - firstAtom()) % m_atomsPerCell;
+            if (offset)
+                begin += m_atomsPerCell - offset;
+            for (size_t i = begin; i < end; i += m_atomsPerCell) {
+                if (!m_marks.get(i))
+                    continue;
+                functor(reinterpret_cast_ptr<JSCell*>(&atoms()[i]));
+            }
+        }
+    }
+
 } // namespace JSC
 
 namespace WTF {
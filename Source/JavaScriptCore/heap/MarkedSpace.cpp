@@ -138,6 +138,25 @@ void MarkedSpace::resetAllocators()
     m_immortalStructureDestructorSpace.largeAllocator.reset();
 }
 
+void MarkedSpace::retireExistingBlocks()
+{
+    for (size_t cellSize = preciseStep; cellSize <= preciseCutoff; cellSize += preciseStep) {
+        allocatorFor(cellSize).retireExistingBlocks();
+        normalDestructorAllocatorFor(cellSize).retireExistingBlocks();
+        immortalStructureDestructorAllocatorFor(cellSize).retireExistingBlocks();
+    }
+
+    for (size_t cellSize = impreciseStep; cellSize <= impreciseCutoff; cellSize += impreciseStep) {
+        allocatorFor(cellSize).retireExistingBlocks();
+        normalDestructorAllocatorFor(cellSize).retireExistingBlocks();
+        immortalStructureDestructorAllocatorFor(cellSize).retireExistingBlocks();
+    }
+
+    m_normalSpace.largeAllocator.retireExistingBlocks();
+    m_normalDestructorSpace.largeAllocator.retireExistingBlocks();
+    m_immortalStructureDestructorSpace.largeAllocator.retireExistingBlocks();
+}
+
 void MarkedSpace::visitWeakSets(HeapRootVisitor& heapRootVisitor)
 {
     VisitWeakSet visitWeakSet(heapRootVisitor);
@@ -47,6 +47,14 @@ struct ClearMarks : MarkedBlock::VoidFunctor {
     void operator()(MarkedBlock* block) { block->clearMarks(); }
 };
 
+struct ClearNewlyAllocated : MarkedBlock::VoidFunctor {
+    void operator()(MarkedBlock* block) { block->clearNewlyAllocated(); }
+};
+
+struct ClearMarksPreservingLiveness : MarkedBlock::VoidFunctor {
+    void operator()(MarkedBlock* block) { block->clearMarksPreservingLiveness(); }
+};
+
 struct Sweep : MarkedBlock::VoidFunctor {
     void operator()(MarkedBlock* block) { block->sweep(); }
 };
@@ -79,6 +87,7 @@ public:
     void* allocateWithoutDestructor(size_t);
  
     void resetAllocators();
+    void retireExistingBlocks();
 
     void visitWeakSets(HeapRootVisitor&);
     void reapWeakSets();
@@ -104,6 +113,8 @@ public:
     void didConsumeFreeList(MarkedBlock*);
 
     void clearMarks();
+    void clearNewlyAllocated();
+    void clearMarksPreservingLiveness();
     void sweep();
     size_t objectCount();
     size_t size();
@@ -252,6 +263,16 @@ inline void MarkedSpace::clearMarks()
     forEachBlock<ClearMarks>();
 }
 
+inline void MarkedSpace::clearNewlyAllocated()
+{
+    forEachBlock<ClearNewlyAllocated>();
+}
+
+inline void MarkedSpace::clearMarksPreservingLiveness()
+{
+    forEachBlock<ClearMarksPreservingLiveness>();
+}
+
 inline size_t MarkedSpace::objectCount()
 {
     return forEachBlock<MarkCount>();
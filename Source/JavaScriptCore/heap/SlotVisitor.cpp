@@ -6,12 +6,14 @@
 #include "CopiedSpace.h"
 #include "CopiedSpaceInlines.h"
 #include "GCThread.h"
+#include "HeapSnapshotWriter.h"
 #include "JSArray.h"
 #include "JSDestructibleObject.h"
 #include "VM.h"
 #include "JSObject.h"
 #include "JSString.h"
 #include "Operations.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/StackStats.h>
 
 namespace JSC {
@@ -22,6 +24,7 @@ SlotVisitor::SlotVisitor(GCThreadSharedData& shared)
     , m_isInParallelMode(false)
     , m_shared(shared)
     , m_shouldHashCons(false)
+    , m_heapSnapshotWriter(0)
 #if !ASSERT_DISABLED
     , m_isCheckingForDefaultMarkViolation(false)
     , m_isDraining(false)
@@ -50,8 +53,6 @@ void SlotVisitor::reset()
     ASSERT(m_stack.isEmpty());
 #if ENABLE(PARALLEL_GC)
     ASSERT(m_opaqueRoots.isEmpty()); // Should have merged by now.
-#else
-    m_opaqueRoots.clear();
 #endif
     if (m_shouldHashCons) {
         m_uniqueStrings.clear();
@@ -59,6 +60,18 @@ void SlotVisitor::reset()
     }
 }
 
+void SlotVisitor::clearOpaqueRoots()
+{
+    // Opaque roots outlive reset() so that eden collections can see the roots
+    // added by old objects that they do not visit.
+#if ENABLE(PARALLEL_GC)
+    ASSERT(m_opaqueRoots.isEmpty());
+    m_shared.m_opaqueRoots.clear();
+#else
+    m_opaqueRoots.clear();
+#endif
+}
+
 void SlotVisitor::append(ConservativeRoots& conservativeRoots)
 {
     StackStats::probe();
@@ -95,6 +108,17 @@ ALWAYS_INLINE static void visitChildren(SlotVisitor& visitor, const JSCell* cell
     cell->methodTable()->visitChildren(const_cast<JSCell*>(cell), visitor);
 }
 
+void SlotVisitor::visitChildrenForHeapSnapshot(JSCell* cell)
+{
+    ASSERT(m_heapSnapshotWriter);
+    visitChildren(*this, cell);
+}
+
+void SlotVisitor::appendToHeapSnapshot(JSCell* cell)
+{
+    m_heapSnapshotWriter->appendReference(cell);
+}
+
 void SlotVisitor::donateKnownParallel()
 {
     StackStats::probe();
@@ -149,6 +173,26 @@ void SlotVisitor::drain()
     }
 }
 
+void SlotVisitor::drainUntil(double deadline)
+{
+    StackStats::probe();
+    ASSERT(!m_isInParallelMode);
+
+    // Incremental marking slices run on the main thread while the parallel
+    // markers sleep, so unlike drain() we never donate work to them.
+    while (!m_stack.isEmpty()) {
+        m_stack.refill();
+        for (unsigned countdown = Options::minimumNumberOfScansBetweenRebalance(); m_stack.canRemoveLast() && countdown--;)
+            visitChildren(*this, m_stack.removeLast());
+        if (WTF::monotonicallyIncreasingTime() >= deadline)
+            break;
+    }
+
+#if ENABLE(PARALLEL_GC)
+    mergeOpaqueRootsIfNecessary();
+#endif
+}
+
 void SlotVisitor::drainFromShared(SharedDrainMode sharedDrainMode)
 {
     StackStats::probe();
@@ -36,6 +36,7 @@ namespace JSC {
 class ConservativeRoots;
 class GCThreadSharedData;
 class Heap;
+class HeapSnapshotWriter;
 template<typename T> class Weak;
 template<typename T> class WriteBarrierBase;
 template<typename T> class JITWriteBarrier;
@@ -59,11 +60,15 @@ public:
     void appendUnbarrieredValue(JSValue*);
     template<typename T>
     void appendUnbarrieredWeak(Weak<T>*);
+
+    // Schedules an already marked cell to be visited again.
+    void appendToMarkStack(JSCell*);
     
     void addOpaqueRoot(void*);
     bool containsOpaqueRoot(void*);
     TriState containsOpaqueRootTriState(void*);
     int opaqueRootCount();
+    void clearOpaqueRoots();
 
     GCThreadSharedData& sharedData() { return m_shared; }
     bool isEmpty() { return m_stack.isEmpty(); }
@@ -76,6 +81,9 @@ public:
     void donate();
     void drain();
     void donateAndDrain();
+    // Visits cells until the mark stack is empty or the deadline, in seconds of
+    // monotonicallyIncreasingTime(), has passed.
+    void drainUntil(double deadline);
     
     enum SharedDrainMode { SlaveDrain, MasterDrain };
     void drainFromShared(SharedDrainMode);
@@ -92,6 +100,13 @@ public:
     void addWeakReferenceHarvester(WeakReferenceHarvester*);
     void addUnconditionalFinalizer(UnconditionalFinalizer*);
 
+    // While a heap snapshot is being written, the cells that visitChildren() methods
+    // append are reported to the writer instead of being marked, and requests to
+    // copy backing stores, add opaque roots or register finalizers are ignored.
+    // See Heap::writeHeapSnapshot().
+    void setHeapSnapshotWriter(HeapSnapshotWriter* writer) { m_heapSnapshotWriter = writer; }
+    void visitChildrenForHeapSnapshot(JSCell*);
+
 #if ENABLE(OBJECT_MARK_LOGGING)
     inline void resetChildCount() { m_logChildCount = 0; }
     inline unsigned childCount() { return m_logChildCount; }
@@ -110,6 +125,7 @@ private:
     void internalAppend(JSCell*);
     void internalAppend(JSValue);
     void internalAppend(JSValue*);
+    void appendToHeapSnapshot(JSCell*);
     
     JS_EXPORT_PRIVATE void mergeOpaqueRoots();
     void mergeOpaqueRootsIfNecessary();
@@ -129,6 +145,8 @@ private:
     typedef HashMap<StringImpl*, JSValue> UniqueStringMap;
     UniqueStringMap m_uniqueStrings;
 
+    HeapSnapshotWriter* m_heapSnapshotWriter;
+
 #if ENABLE(OBJECT_MARK_LOGGING)
     unsigned m_logChildCount;
 #endif
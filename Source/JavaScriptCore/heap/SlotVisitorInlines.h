@@ -77,6 +77,14 @@ ALWAYS_INLINE void SlotVisitor::appendUnbarrieredWeak(Weak<T>* weak)
         internalAppend(weak->get());
 }
 
+inline void SlotVisitor::appendToMarkStack(JSCell* cell)
+{
+    ASSERT(Heap::isMarked(cell));
+    ASSERT(!cell->isZapped());
+    m_visitCount++;
+    m_stack.append(cell);
+}
+
 ALWAYS_INLINE void SlotVisitor::internalAppend(JSValue value)
 {
     if (!value || !value.isCell())
@@ -86,16 +94,22 @@ ALWAYS_INLINE void SlotVisitor::internalAppend(JSValue value)
 
 inline void SlotVisitor::addWeakReferenceHarvester(WeakReferenceHarvester* weakReferenceHarvester)
 {
+    if (UNLIKELY(!!m_heapSnapshotWriter))
+        return;
     m_shared.m_weakReferenceHarvesters.addThreadSafe(weakReferenceHarvester);
 }
 
 inline void SlotVisitor::addUnconditionalFinalizer(UnconditionalFinalizer* unconditionalFinalizer)
 {
+    if (UNLIKELY(!!m_heapSnapshotWriter))
+        return;
     m_shared.m_unconditionalFinalizers.addThreadSafe(unconditionalFinalizer);
 }
 
 inline void SlotVisitor::addOpaqueRoot(void* root)
 {
+    if (UNLIKELY(!!m_heapSnapshotWriter))
+        return;
 #if ENABLE(PARALLEL_GC)
     if (Options::numberOfGCMarkers() == 1) {
         // Put directly into the shared HashSet.
@@ -174,6 +188,9 @@ inline void SlotVisitor::donateAndDrain()
 
 inline void SlotVisitor::copyLater(JSCell* owner, void* ptr, size_t bytes)
 {
+    if (UNLIKELY(!!m_heapSnapshotWriter))
+        return;
+
     CopiedBlock* block = CopiedSpace::blockFor(ptr);
     if (block->isOversize()) {
         m_shared.m_copiedSpace->pin(block);
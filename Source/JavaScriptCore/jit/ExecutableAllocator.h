@@ -110,7 +110,20 @@ static const size_t fixedExecutableMemoryPoolSize = 1024 * 1024 * 1024;
 static const size_t fixedExecutableMemoryPoolSize = 32 * 1024 * 1024;
 #endif
 
-extern uintptr_t startOfFixedExecutableMemoryPool;
+// Once the initial reservation fills up, the pool grows by further reservations,
+// as long as all of them together stay within reach of the branches the JIT emits.
+#if CPU(X86_64) && !CPU(X32)
+// 32-bit relative branches reach 2GB either way, so the pool has to fit in a 2GB span.
+static const size_t maximumExecutableMemoryPoolSize = 2047u * 1024 * 1024;
+static const size_t executableMemoryPoolGrowthSize = 64 * 1024 * 1024;
+#elif CPU(X86)
+// Relative branches wrap around the address space, so any address will do.
+static const size_t maximumExecutableMemoryPoolSize = 128 * 1024 * 1024;
+static const size_t executableMemoryPoolGrowthSize = 16 * 1024 * 1024;
+#else
+static const size_t maximumExecutableMemoryPoolSize = fixedExecutableMemoryPoolSize;
+static const size_t executableMemoryPoolGrowthSize = 0;
+#endif
 #endif
 
 class ExecutableAllocator {
@@ -153,6 +166,14 @@ public:
 
     static size_t committedByteCount();
 
+#if ENABLE(EXECUTABLE_ALLOCATOR_FIXED)
+    JS_EXPORT_PRIVATE static void dumpStatistics();
+
+    // The lowest and highest addresses that the pool's reservations span. The pool
+    // can grow on any thread that allocates, so this takes the allocator's lock.
+    static void getFixedPoolBounds(uintptr_t& start, uintptr_t& end);
+#endif
+
 private:
 
 #if ENABLE(ASSEMBLER_WX_EXCLUSIVE)
@@ -32,6 +32,7 @@
 #include "CodeProfiling.h"
 #include <errno.h>
 #include <unistd.h>
+#include <wtf/DataLog.h>
 #include <wtf/MetaAllocator.h>
 #include <wtf/PageReservation.h>
 #include <wtf/VMTags.h>
@@ -53,33 +54,85 @@ using namespace WTF;
 
 namespace JSC {
     
-uintptr_t startOfFixedExecutableMemoryPool;
-
 class FixedVMPoolExecutableAllocator : public MetaAllocator {
     WTF_MAKE_FAST_ALLOCATED;
 public:
     FixedVMPoolExecutableAllocator()
         : MetaAllocator(jitAllocationGranule) // round up all allocations to 32 bytes
+        , m_start(0)
+        , m_end(0)
+        , m_canGrow(false)
     {
-        m_reservation = PageReservation::reserveWithGuardPages(fixedExecutableMemoryPoolSize, OSAllocator::JSJITCodePages, EXECUTABLE_POOL_WRITABLE, true);
+        PageReservation reservation = PageReservation::reserveWithGuardPages(fixedExecutableMemoryPoolSize, OSAllocator::JSJITCodePages, EXECUTABLE_POOL_WRITABLE, true);
 #if !ENABLE(LLINT)
-        RELEASE_ASSERT(m_reservation);
+        RELEASE_ASSERT(reservation);
 #endif
-        if (m_reservation) {
-            ASSERT(m_reservation.size() == fixedExecutableMemoryPoolSize);
-            addFreshFreeSpace(m_reservation.base(), m_reservation.size());
+        if (reservation) {
+            ASSERT(reservation.size() == fixedExecutableMemoryPoolSize);
+            m_reservations.append(reservation);
+            addFreshFreeSpace(reservation.base(), reservation.size());
             
-            startOfFixedExecutableMemoryPool = reinterpret_cast<uintptr_t>(m_reservation.base());
+            m_start = reinterpret_cast<uintptr_t>(reservation.base());
+            m_end = m_start + reservation.size();
+            m_canGrow = !!executableMemoryPoolGrowthSize;
         }
     }
 
     virtual ~FixedVMPoolExecutableAllocator();
+
+    void getBounds(uintptr_t& start, uintptr_t& end)
+    {
+        SpinLockHolder locker(&lock());
+        start = m_start;
+        end = m_end;
+    }
+
+    size_t numberOfReservations()
+    {
+        SpinLockHolder locker(&lock());
+        return m_reservations.size();
+    }
     
 protected:
-    virtual void* allocateNewSpace(size_t&)
+    virtual void* allocateNewSpace(size_t& numberOfPages)
     {
-        // We're operating in a fixed pool, so new allocation is always prohibited.
-        return 0;
+        // We get here, with the allocator's lock held, when none of our free space is
+        // big enough. Rather than failing the compilation, reserve some more.
+        if (!m_canGrow)
+            return 0;
+
+        size_t bytesInReservations = 0;
+        for (size_t i = 0; i < m_reservations.size(); ++i)
+            bytesInReservations += m_reservations[i].size();
+        size_t sizeInBytes = roundUpToMultipleOf(pageSize(), std::max(numberOfPages * pageSize(), executableMemoryPoolGrowthSize));
+        if (bytesInReservations + sizeInBytes > maximumExecutableMemoryPoolSize) {
+            m_canGrow = false;
+            return 0;
+        }
+
+        PageReservation reservation = PageReservation::reserveWithGuardPages(sizeInBytes, OSAllocator::JSJITCodePages, EXECUTABLE_POOL_WRITABLE, true);
+        if (!reservation) {
+            m_canGrow = false;
+            return 0;
+        }
+
+        uintptr_t start = std::min(m_start, reinterpret_cast<uintptr_t>(reservation.base()));
+        uintptr_t end = std::max(m_end, reinterpret_cast<uintptr_t>(reservation.base()) + reservation.size());
+#if CPU(X86_64) && !CPU(X32)
+        if (end - start > maximumExecutableMemoryPoolSize) {
+            // The OS put it out of reach of the code we already have. Trying again
+            // would most likely give us the same answer.
+            reservation.deallocate();
+            m_canGrow = false;
+            return 0;
+        }
+#endif
+
+        m_reservations.append(reservation);
+        m_start = start;
+        m_end = end;
+        numberOfPages = sizeInBytes / pageSize();
+        return reservation.base();
     }
     
     virtual void notifyNeedPage(void* page)
@@ -87,7 +140,7 @@ protected:
 #if USE(MADV_FREE_FOR_JIT_MEMORY)
         UNUSED_PARAM(page);
 #else
-        m_reservation.commit(page, pageSize());
+        reservationFor(page).commit(page, pageSize());
 #endif
     }
     
@@ -105,12 +158,27 @@ protected:
             }
         }
 #else
-        m_reservation.decommit(page, pageSize());
+        reservationFor(page).decommit(page, pageSize());
 #endif
     }
 
 private:
-    PageReservation m_reservation;
+    PageReservation& reservationFor(void* page)
+    {
+        for (size_t i = 0; i < m_reservations.size(); ++i) {
+            uintptr_t offset = reinterpret_cast<uintptr_t>(page) - reinterpret_cast<uintptr_t>(m_reservations[i].base());
+            if (offset < m_reservations[i].size())
+                return m_reservations[i];
+        }
+        RELEASE_ASSERT_NOT_REACHED();
+        return m_reservations[0];
+    }
+
+    // These are only changed with the allocator's lock held.
+    Vector<PageReservation, 4> m_reservations;
+    uintptr_t m_start;
+    uintptr_t m_end;
+    bool m_canGrow;
 };
 
 static FixedVMPoolExecutableAllocator* allocator;
@@ -133,7 +201,8 @@ ExecutableAllocator::~ExecutableAllocator()
 
 FixedVMPoolExecutableAllocator::~FixedVMPoolExecutableAllocator()
 {
-    m_reservation.deallocate();
+    for (size_t i = 0; i < m_reservations.size(); ++i)
+        m_reservations[i].deallocate();
 }
 
 bool ExecutableAllocator::isValid() const
@@ -141,6 +210,13 @@ bool ExecutableAllocator::isValid() const
     return !!allocator->bytesReserved();
 }
 
+void ExecutableAllocator::getFixedPoolBounds(uintptr_t& start, uintptr_t& end)
+{
+    allocator->getBounds(start, end);
+}
+
+// Pressure is measured against what we have reserved, not against what the pool
+// could grow to, since growing can fail.
 bool ExecutableAllocator::underMemoryPressure()
 {
     MetaAllocator::Statistics statistics = allocator->currentStatistics();
@@ -181,6 +257,18 @@ size_t ExecutableAllocator::committedByteCount()
     return allocator->bytesCommitted();
 }
 
+void ExecutableAllocator::dumpStatistics()
+{
+    MetaAllocator::Statistics statistics = allocator->currentStatistics();
+    dataLogF("Executable memory: %lu bytes allocated (at most %lu), %lu reserved in %lu reservations, %lu committed.\n",
+        static_cast<unsigned long>(statistics.bytesAllocated), static_cast<unsigned long>(statistics.maximumBytesAllocated),
+        static_cast<unsigned long>(statistics.bytesReserved), static_cast<unsigned long>(allocator->numberOfReservations()),
+        static_cast<unsigned long>(statistics.bytesCommitted));
+    dataLogF("Executable memory: %lu bytes free in %lu pieces, the largest of which is %lu bytes.\n",
+        static_cast<unsigned long>(statistics.bytesReserved - statistics.bytesAllocated), static_cast<unsigned long>(statistics.numberOfFreeSpaces),
+        static_cast<unsigned long>(statistics.bytesInLargestFreeSpace));
+}
+
 #if ENABLE(META_ALLOCATOR_PROFILE)
 void ExecutableAllocator::dumpProfile()
 {
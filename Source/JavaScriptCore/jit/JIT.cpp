@@ -240,6 +240,7 @@ void JIT::privateCompileMainPass()
         DEFINE_OP(op_eq)
         DEFINE_OP(op_eq_null)
         case op_get_by_id_out_of_line:
+        case op_get_by_id_polymorphic:
         case op_get_array_length:
         DEFINE_OP(op_get_by_id)
         DEFINE_OP(op_get_arguments_length)
@@ -293,6 +294,7 @@ void JIT::privateCompileMainPass()
         DEFINE_OP(op_push_name_scope)
         DEFINE_OP(op_push_with_scope)
         case op_put_by_id_out_of_line:
+        case op_put_by_id_polymorphic:
         case op_put_by_id_transition_direct:
         case op_put_by_id_transition_normal:
         case op_put_by_id_transition_direct_out_of_line:
@@ -436,6 +438,7 @@ void JIT::privateCompileSlowCases()
         DEFINE_SLOWCASE_OP(op_div)
         DEFINE_SLOWCASE_OP(op_eq)
         case op_get_by_id_out_of_line:
+        case op_get_by_id_polymorphic:
         case op_get_array_length:
         DEFINE_SLOWCASE_OP(op_get_by_id)
         DEFINE_SLOWCASE_OP(op_get_arguments_length)
@@ -466,6 +469,7 @@ void JIT::privateCompileSlowCases()
         DEFINE_SLOWCASE_OP(op_dec)
         DEFINE_SLOWCASE_OP(op_inc)
         case op_put_by_id_out_of_line:
+        case op_put_by_id_polymorphic:
         case op_put_by_id_transition_direct:
         case op_put_by_id_transition_normal:
         case op_put_by_id_transition_direct_out_of_line:
@@ -611,6 +615,8 @@ JITCode JIT::privateCompile(CodePtr* functionEntryArityCheck, JITCompilationEffo
 
     Label beginLabel(this);
 
+    store32(TrustedImm32(1), m_codeBlock->addressOfWasEnteredSinceLastAging());
+
     sampleCodeBlock(m_codeBlock);
 #if ENABLE(OPCODE_SAMPLING)
     sampleInstruction(m_codeBlock->instructions().begin());
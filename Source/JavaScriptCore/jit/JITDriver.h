@@ -115,6 +115,27 @@ inline bool jitCompileFunctionIfAppropriate(ExecState* exec, OwnPtr<FunctionCode
     return true;
 }
 
+// Installs a DFG replacement that was compiled off the main thread. The replacement
+// must have been built from profiledBlock, which has to still be the current code
+// block; otherwise the executable was recompiled in the meantime and we drop it.
+template<typename CodeBlockType>
+inline bool installOptimizedCodeBlock(OwnPtr<CodeBlockType>& codeBlock, PassOwnPtr<CodeBlockType> passedReplacement, CodeBlock* profiledBlock, const JITCode& jitCode, MacroAssemblerCodePtr jitCodeWithArityCheck)
+{
+    OwnPtr<CodeBlockType> replacement = passedReplacement;
+    if (codeBlock.get() != profiledBlock)
+        return false;
+
+    ASSERT(jitCode.jitType() == JITCode::DFGJIT);
+    ASSERT(!replacement->alternative());
+    ASSERT(codeBlock->getJITType() == JITCode::BaselineJIT);
+
+    codeBlock->unlinkIncomingCalls();
+    replacement->setAlternative(static_pointer_cast<CodeBlock>(codeBlock.release()));
+    codeBlock = replacement.release();
+    codeBlock->setJITCode(jitCode, jitCodeWithArityCheck);
+    return true;
+}
+
 } // namespace JSC
 
 #endif // ENABLE(JIT)
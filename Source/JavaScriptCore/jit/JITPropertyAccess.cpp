@@ -1308,9 +1308,6 @@ void JIT::resetPatchPutById(RepatchBuffer& repatchBuffer, StructureStubInfo* stu
 
 void JIT::emitWriteBarrier(RegisterID owner, RegisterID value, RegisterID scratch, RegisterID scratch2, WriteBarrierMode mode, WriteBarrierUseKind useKind)
 {
-    UNUSED_PARAM(owner);
-    UNUSED_PARAM(scratch);
-    UNUSED_PARAM(scratch2);
     UNUSED_PARAM(useKind);
     UNUSED_PARAM(value);
     UNUSED_PARAM(mode);
@@ -1320,11 +1317,29 @@ void JIT::emitWriteBarrier(RegisterID owner, RegisterID value, RegisterID scratc
 #if ENABLE(WRITE_BARRIER_PROFILING)
     emitCount(WriteBarrierCounters::jitCounterFor(useKind));
 #endif
+
+    if (!Heap::isWriteBarrierEnabled())
+        return;
+
+    // Dirty the card covering the owner's header. Stores of non-cells are not
+    // filtered out; a spurious dirty card only costs the next eden collection
+    // or remark a rescan of the cells on it.
+    move(owner, scratch);
+    andPtr(TrustedImm32(static_cast<int32_t>(MarkedBlock::blockMask)), scratch);
+    move(owner, scratch2);
+    andPtr(TrustedImm32(static_cast<int32_t>(MarkedBlock::blockSize - 1)), scratch2);
+    urshift32(TrustedImm32(MarkedBlock::cardShift), scratch2);
+#if CPU(X86) || CPU(X86_64)
+    store8(TrustedImm32(1), BaseIndex(scratch, scratch2, TimesOne, MarkedBlock::offsetOfCards()));
+#else
+    // Any non-zero byte marks the card, so store the biased card index itself.
+    add32(TrustedImm32(1), scratch2);
+    store8(scratch2, BaseIndex(scratch, scratch2, TimesOne, MarkedBlock::offsetOfCards() - 1));
+#endif
 }
 
 void JIT::emitWriteBarrier(JSCell* owner, RegisterID value, RegisterID scratch, WriteBarrierMode mode, WriteBarrierUseKind useKind)
 {
-    UNUSED_PARAM(owner);
     UNUSED_PARAM(scratch);
     UNUSED_PARAM(useKind);
     UNUSED_PARAM(value);
@@ -1333,6 +1348,10 @@ void JIT::emitWriteBarrier(JSCell* owner, RegisterID value, RegisterID scratch,
 #if ENABLE(WRITE_BARRIER_PROFILING)
     emitCount(WriteBarrierCounters::jitCounterFor(useKind));
 #endif
+
+    if (!Heap::isWriteBarrierEnabled())
+        return;
+    store8(TrustedImm32(1), Heap::addressOfCardFor(owner));
 }
 
 JIT::Jump JIT::addStructureTransitionCheck(JSCell* object, Structure* structure, StructureStubInfo* stubInfo, RegisterID scratch)
@@ -110,25 +110,20 @@ public:
         return false;
 #endif
     }
-    static uintptr_t filteringStartAddress()
+    // The executable pool can grow, so callers read its range once, with
+    // getFilteringRange(), and pass it to every passesFilter() call.
+    static void getFilteringRange(uintptr_t& start, size_t& extentSize)
     {
 #if ENABLE(EXECUTABLE_ALLOCATOR_FIXED)
-        return startOfFixedExecutableMemoryPool;
+        uintptr_t end;
+        ExecutableAllocator::getFixedPoolBounds(start, end);
+        extentSize = end - start;
 #else
-        UNREACHABLE_FOR_PLATFORM();
-        return 0;
+        start = 0;
+        extentSize = 0;
 #endif
     }
-    static size_t filteringExtentSize()
-    {
-#if ENABLE(EXECUTABLE_ALLOCATOR_FIXED)
-        return fixedExecutableMemoryPoolSize;
-#else
-        UNREACHABLE_FOR_PLATFORM();
-        return 0;
-#endif
-    }
-    static bool passesFilter(uintptr_t address)
+    static bool passesFilter(uintptr_t address, uintptr_t filteringStartAddress, size_t filteringExtentSize)
     {
         if (!canPerformRangeFilter()) {
             // Just check that the address doesn't use any special values that would make
@@ -136,7 +131,7 @@ public:
             return address >= jitAllocationGranule && address != std::numeric_limits<uintptr_t>::max();
         }
         
-        if (address - filteringStartAddress() >= filteringExtentSize())
+        if (address - filteringStartAddress >= filteringExtentSize)
             return false;
         
         return true;
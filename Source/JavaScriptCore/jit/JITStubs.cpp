@@ -39,7 +39,9 @@
 #include "CallFrame.h"
 #include "CodeBlock.h"
 #include "CodeProfiling.h"
+#include "DFGDriver.h"
 #include "DFGOSREntry.h"
+#include "DFGWorklist.h"
 #include "Debugger.h"
 #include "ExceptionHelpers.h"
 #include "GetterSetter.h"
@@ -1057,6 +1059,11 @@ NEVER_INLINE static void tryCacheGetByID(CallFrame* callFrame, CodeBlock* codeBl
         // Since we're accessing a prototype in a loop, it's a good bet that it
         // should not be treated as a dictionary.
         if (slotBaseObject->structure()->isDictionary()) {
+            if (slotBaseObject->structure()->hasBeenFlattenedBefore()) {
+                stubInfo->accessType = access_get_by_id_generic;
+                ctiPatchCallByReturnAddress(codeBlock, returnAddress, FunctionPtr(cti_op_get_by_id_generic));
+                return;
+            }
             slotBaseObject->flattenDictionaryObject(callFrame->vm());
             offset = slotBaseObject->structure()->get(callFrame->vm(), propertyName);
         }
@@ -1863,6 +1870,10 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list)
         // Since we're accessing a prototype in a loop, it's a good bet that it
         // should not be treated as a dictionary.
         if (slotBaseObject->structure()->isDictionary()) {
+            if (slotBaseObject->structure()->hasBeenFlattenedBefore()) {
+                ctiPatchCallByReturnAddress(codeBlock, STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_id_proto_fail));
+                return JSValue::encode(result);
+            }
             slotBaseObject->flattenDictionaryObject(callFrame->vm());
             offset = slotBaseObject->structure()->get(callFrame->vm(), propertyName);
         }
@@ -1999,6 +2010,25 @@ DEFINE_STUB_FUNCTION(void, optimize)
         return;
     }
 
+    // This is a safepoint for concurrent compilations: install anything that has
+    // finished, and keep running baseline code if our own plan is still in flight.
+    if (DFG::Worklist* worklist = callFrame->vm().dfgWorklist()) {
+        DFG::Worklist::State worklistState = worklist->completeAllReadyPlans(codeBlock);
+        if (worklistState == DFG::Worklist::Compiling) {
+#if ENABLE(JIT_VERBOSE_OSR)
+            dataLog("Waiting for concurrent compilation of ", *codeBlock, "\n");
+#endif
+            codeBlock->updateAllPredictions();
+            codeBlock->optimizeAfterWarmUp();
+            return;
+        }
+        if (worklistState == DFG::Worklist::Compiled && !codeBlock->hasOptimizedReplacement()) {
+            // The compilation failed or was thrown away; finalization already
+            // adjusted our thresholds.
+            return;
+        }
+    }
+
     if (codeBlock->hasOptimizedReplacement()) {
 #if ENABLE(JIT_VERBOSE_OSR)
         dataLog("Considering OSR ", *codeBlock, " -> ", *codeBlock->replacement(), ".\n");
@@ -2035,6 +2065,18 @@ DEFINE_STUB_FUNCTION(void, optimize)
         dataLog("Triggering optimized compilation of ", *codeBlock, "\n");
 #endif
         
+        if (callFrame->vm().dfgWorklist()) {
+            if (!DFG::enqueueCompilation(callFrame, codeBlock, bytecodeIndex)) {
+#if ENABLE(JIT_VERBOSE_OSR)
+                dataLog("Optimizing ", *codeBlock, " failed.\n");
+#endif
+                codeBlock->dontOptimizeAnytimeSoon();
+                return;
+            }
+            codeBlock->optimizeAfterWarmUp();
+            return;
+        }
+
         JSScope* scope = callFrame->scope();
         JSObject* error = codeBlock->compileOptimized(callFrame, scope, bytecodeIndex);
 #if ENABLE(JIT_VERBOSE_OSR)
@@ -28,6 +28,7 @@
 #include "Completion.h"
 #include "CopiedSpaceInlines.h"
 #include "ExceptionHelpers.h"
+#include "ExecutableAllocator.h"
 #include "HeapStatistics.h"
 #include "InitializeThreading.h"
 #include "Interpreter.h"
@@ -50,6 +51,7 @@
 #include <wtf/text/StringBuilder.h>
 
 #if !OS(WINDOWS)
+#include <fcntl.h>
 #include <unistd.h>
 #endif
 
@@ -104,6 +106,9 @@ static EncodedJSValue JSC_HOST_CALL functionDebug(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionDescribe(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionJSCStack(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionGC(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionEdenGC(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionStartIncrementalMarking(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionWriteHeapSnapshot(ExecState*);
 #ifndef NDEBUG
 static EncodedJSValue JSC_HOST_CALL functionReleaseExecutableMemory(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionDumpCallFrame(ExecState*);
@@ -220,6 +225,9 @@ protected:
         addFunction(vm, "print", functionPrint, 1);
         addFunction(vm, "quit", functionQuit, 0);
         addFunction(vm, "gc", functionGC, 0);
+        addFunction(vm, "edenGC", functionEdenGC, 0);
+        addFunction(vm, "startIncrementalMarking", functionStartIncrementalMarking, 0);
+        addFunction(vm, "writeHeapSnapshot", functionWriteHeapSnapshot, 1);
 #ifndef NDEBUG
         addFunction(vm, "dumpCallFrame", functionDumpCallFrame, 0);
         addFunction(vm, "releaseExecutableMemory", functionReleaseExecutableMemory, 0);
@@ -360,6 +368,45 @@ EncodedJSValue JSC_HOST_CALL functionGC(ExecState* exec)
     return JSValue::encode(jsUndefined());
 }
 
+// An eden collection with --enableGenerationalGC=true, unless the heap decides that
+// the next collection has to be a full one. Otherwise a full collection.
+EncodedJSValue JSC_HOST_CALL functionEdenGC(ExecState* exec)
+{
+    JSLockHolder lock(exec);
+    Heap* heap = exec->heap();
+    if (heap->isSafeToCollect())
+        heap->collect(Heap::DoNotSweep);
+    return JSValue::encode(jsUndefined());
+}
+
+// With --enableIncrementalMarking=true, starts marking unless it is already under way.
+// The marking then advances as the program allocates, and the next gc() finishes it.
+EncodedJSValue JSC_HOST_CALL functionStartIncrementalMarking(ExecState* exec)
+{
+    JSLockHolder lock(exec);
+    Heap* heap = exec->heap();
+    if (Options::enableIncrementalMarking() && heap->isSafeToCollect() && !heap->isMarkingIncrementally())
+        heap->collect(Heap::DoNotSweep);
+    return JSValue::encode(jsUndefined());
+}
+
+EncodedJSValue JSC_HOST_CALL functionWriteHeapSnapshot(ExecState* exec)
+{
+    String fileName = exec->argument(0).toString(exec)->value(exec);
+#if !OS(WINDOWS)
+    int fd = open(fileName.utf8().data(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return JSValue::encode(throwError(exec, createError(exec, "Could not open file.")));
+
+    bool succeeded = exec->heap()->writeHeapSnapshot(fd);
+    close(fd);
+    return JSValue::encode(jsBoolean(succeeded));
+#else
+    UNUSED_PARAM(fileName);
+    return JSValue::encode(jsBoolean(false));
+#endif
+}
+
 #ifndef NDEBUG
 EncodedJSValue JSC_HOST_CALL functionReleaseExecutableMemory(ExecState* exec)
 {
@@ -559,6 +606,10 @@ int main(int argc, char** argv)
     EXCEPT(res = 3)
     if (Options::logHeapStatisticsAtExit())
         HeapStatistics::reportSuccess();
+#if ENABLE(EXECUTABLE_ALLOCATOR_FIXED)
+    if (Options::logExecutableMemoryStatisticsAtExit())
+        ExecutableAllocator::dumpStatistics();
+#endif
 
 #if PLATFORM(EFL)
     ecore_shutdown();
@@ -32,6 +32,8 @@
 #include "CodeType.h"
 #include "Instruction.h"
 #include "LLIntCLoop.h"
+#include "LLIntPolymorphicAccessCache.h"
+#include "MarkedBlock.h"
 #include "Opcode.h"
 
 namespace JSC { namespace LLInt {
@@ -111,6 +113,9 @@ void Data::performAssertions(VM& vm)
     ASSERT(GlobalCode == 0);
     ASSERT(EvalCode == 1);
     ASSERT(FunctionCode == 2);
+    ASSERT(MarkedBlock::blockSize == 65536);
+    ASSERT(MarkedBlock::cardShift == 9);
+    ASSERT(LLIntPolymorphicAccessCache::maximumSize == 4);
     
     // FIXME: make these assertions less horrible.
 #if !ASSERT_DISABLED
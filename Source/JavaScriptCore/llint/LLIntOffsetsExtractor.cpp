@@ -44,6 +44,7 @@
 #include "JSVariableObject.h"
 #include "JumpTable.h"
 #include "LLIntOfflineAsmConfig.h"
+#include "LLIntPolymorphicAccessCache.h"
 #include "MarkedSpace.h"
 
 #include "Structure.h"
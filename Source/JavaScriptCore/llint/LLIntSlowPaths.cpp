@@ -888,11 +888,53 @@ LLINT_SLOW_PATH_DECL(slow_path_init_global_const_check)
     LLINT_END();
 }
 
+// The offset of a property in the form the LLInt's property access fast paths expect:
+// relative to the object for inline storage, or to the butterfly for out-of-line storage.
+static int llintOffsetFor(PropertyOffset offset)
+{
+    if (isInlineOffset(offset))
+        return offsetInInlineStorage(offset) * sizeof(JSValue) + JSObject::offsetOfInlineStorage();
+    return offsetInButterfly(offset) * sizeof(JSValue);
+}
+
+// Adds the structure to the access's polymorphic cache, first creating the cache if the
+// access is monomorphic and has already cached some other structure. Returns false if
+// the access should stay monomorphic. A site only ever gets one polymorphic cache, and
+// keeps it; we never go back to the monomorphic opcode.
+static bool tryCachePolymorphicAccess(VM& vm, CodeBlock* codeBlock, Instruction* pc, bool isMonomorphic, OpcodeID polymorphicOpcodeID, Structure* structure, PropertyOffset offset)
+{
+    unsigned size = Options::llintPolymorphicAccessCacheSize();
+    if (size > LLIntPolymorphicAccessCache::maximumSize)
+        size = LLIntPolymorphicAccessCache::maximumSize;
+    if (pc[0].u.opcode == LLInt::getOpcode(polymorphicOpcodeID)) {
+        pc[4].u.polymorphicAccessCache->add(vm, codeBlock->ownerExecutable(), structure, llintOffsetFor(offset), size);
+        return true;
+    }
+
+    if (!isMonomorphic || size < 2)
+        return false;
+    Structure* oldStructure = pc[4].u.structure.get();
+    if (!oldStructure || oldStructure == structure)
+        return false;
+
+    LLIntPolymorphicAccessCache* cache = codeBlock->addLLIntPolymorphicAccessCache();
+    cache->add(vm, codeBlock->ownerExecutable(), oldStructure, pc[5].u.operand, size);
+    cache->add(vm, codeBlock->ownerExecutable(), structure, llintOffsetFor(offset), size);
+    cache->missCount = 1;
+    pc[0].u.opcode = LLInt::getOpcode(polymorphicOpcodeID);
+    pc[4].u.polymorphicAccessCache = cache;
+    pc[5].u.operand = 0;
+    return true;
+}
+
 LLINT_SLOW_PATH_DECL(slow_path_get_by_id)
 {
     LLINT_BEGIN();
     CodeBlock* codeBlock = exec->codeBlock();
     Identifier& ident = codeBlock->identifier(pc[3].u.operand);
+    bool isPolymorphic = pc[0].u.opcode == LLInt::getOpcode(llint_op_get_by_id_polymorphic);
+    if (isPolymorphic)
+        pc[4].u.polymorphicAccessCache->missCount++;
     JSValue baseValue = LLINT_OP_C(2).jsValue();
     PropertySlot slot(baseValue);
 
@@ -909,8 +951,11 @@ LLINT_SLOW_PATH_DECL(slow_path_get_by_id)
         JSCell* baseCell = baseValue.asCell();
         Structure* structure = baseCell->structure();
         
+        bool isMonomorphic = pc[0].u.opcode == LLInt::getOpcode(llint_op_get_by_id)
+            || pc[0].u.opcode == LLInt::getOpcode(llint_op_get_by_id_out_of_line);
         if (!structure->isUncacheableDictionary()
-            && !structure->typeInfo().prohibitsPropertyCaching()) {
+            && !structure->typeInfo().prohibitsPropertyCaching()
+            && !tryCachePolymorphicAccess(vm, codeBlock, pc, isMonomorphic, op_get_by_id_polymorphic, structure, slot.cachedOffset())) {
             pc[4].u.structure.set(
                 vm, codeBlock->ownerExecutable(), structure);
             if (isInlineOffset(slot.cachedOffset())) {
@@ -924,6 +969,7 @@ LLINT_SLOW_PATH_DECL(slow_path_get_by_id)
     }
 
     if (!LLINT_ALWAYS_ACCESS_SLOW
+        && !isPolymorphic
         && isJSArray(baseValue)
         && ident == exec->propertyNames().length) {
         pc[0].u.opcode = LLInt::getOpcode(llint_op_get_array_length);
@@ -955,6 +1001,9 @@ LLINT_SLOW_PATH_DECL(slow_path_put_by_id)
     LLINT_BEGIN();
     CodeBlock* codeBlock = exec->codeBlock();
     Identifier& ident = codeBlock->identifier(pc[2].u.operand);
+    bool isPolymorphic = pc[0].u.opcode == LLInt::getOpcode(llint_op_put_by_id_polymorphic);
+    if (isPolymorphic)
+        pc[4].u.polymorphicAccessCache->missCount++;
     
     JSValue baseValue = LLINT_OP_C(1).jsValue();
     PutPropertySlot slot(codeBlock->isStrictMode());
@@ -976,7 +1025,7 @@ LLINT_SLOW_PATH_DECL(slow_path_put_by_id)
             && baseCell == slot.base()) {
             
             if (slot.type() == PutPropertySlot::NewProperty) {
-                if (!structure->isDictionary() && structure->previousID()->outOfLineCapacity() == structure->outOfLineCapacity()) {
+                if (!isPolymorphic && !structure->isDictionary() && structure->previousID()->outOfLineCapacity() == structure->outOfLineCapacity()) {
                     ASSERT(structure->previousID()->transitionWatchpointSetHasBeenInvalidated());
                     
                     // This is needed because some of the methods we call
@@ -1011,7 +1060,10 @@ LLINT_SLOW_PATH_DECL(slow_path_put_by_id)
                         }
                     }
                 }
-            } else {
+            } else if (!tryCachePolymorphicAccess(
+                vm, codeBlock, pc,
+                pc[0].u.opcode == LLInt::getOpcode(llint_op_put_by_id) || pc[0].u.opcode == LLInt::getOpcode(llint_op_put_by_id_out_of_line),
+                op_put_by_id_polymorphic, structure, slot.cachedOffset())) {
                 pc[4].u.structure.set(
                     vm, codeBlock->ownerExecutable(), structure);
                 if (isInlineOffset(slot.cachedOffset())) {
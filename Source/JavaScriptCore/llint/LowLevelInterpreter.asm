@@ -123,6 +123,9 @@ const HashFlags8BitBuffer = 64
 # Copied from PropertyOffset.h
 const firstOutOfLineOffset = 100
 
+# Copied from LLIntPolymorphicAccessCache.h
+const LLIntPolymorphicAccessCacheSize = 4
+
 # From ResolveOperations.h
 const ResolveOperationFail = 0
 const ResolveOperationSetBaseToUndefined = 1
@@ -161,6 +164,12 @@ else
     const VectorSizeOffset = 8
 end
 
+# These must match MarkedBlock.h.
+const MarkedBlockSize = 65536
+const MarkedBlockMask = -MarkedBlockSize
+const MarkedBlockOffsetMask = MarkedBlockSize - 1
+const MarkedBlockCardShift = 9
+
 
 # Some common utilities.
 macro crash()
@@ -262,6 +271,22 @@ macro checkSwitchToJITForEpilogue()
         end)
 end
 
+# When write barriers are enabled, dirties the card that covers the given cell,
+# so that the next eden collection or remark rescans it. This must match
+# MarkedBlock::dirtyCard().
+macro writeBarrier(cell, scratch1, scratch2)
+    loadp JITStackFrame::vm[sp], scratch1
+    loadb VM::heap + Heap::m_isWriteBarrierEnabled[scratch1], scratch2
+    btbz scratch2, .done
+    move cell, scratch1
+    andp MarkedBlockMask, scratch1
+    move cell, scratch2
+    andp MarkedBlockOffsetMask, scratch2
+    urshiftp MarkedBlockCardShift, scratch2
+    storeb 1, MarkedBlock::m_cards[scratch1, scratch2, 1]
+.done:
+end
+
 macro assertNotConstant(index)
     assert(macro (ok) bilt index, FirstConstantRegisterIndex, ok end)
 end
@@ -546,6 +571,7 @@ end
 macro putToBaseVariableBody(variableOffset, scratch1, scratch2, scratch3)
     loadisFromInstruction(1, scratch1)
     loadp PayloadOffset[cfr, scratch1, 8], scratch1
+    writeBarrier(scratch1, scratch2, scratch3)
     loadp JSVariableObject::m_registers[scratch1], scratch1
     loadisFromInstruction(3, scratch2)
     if JSVALUE64
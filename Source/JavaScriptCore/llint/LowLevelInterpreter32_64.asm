@@ -289,10 +289,6 @@ macro loadConstantOrVariablePayloadUnchecked(index, payload)
         payload)
 end
 
-macro writeBarrier(tag, payload)
-    # Nothing to do, since we don't have a generational or incremental collector.
-end
-
 macro valueProfile(tag, payload, profile)
     if VALUE_PROFILER
         storei tag, ValueProfile::m_buckets + TagOffset[profile]
@@ -972,9 +968,11 @@ _llint_op_init_global_const:
     loadi 8[PC], t1
     loadi 4[PC], t0
     loadConstantOrVariable(t1, t2, t3)
-    writeBarrier(t2, t3)
     storei t2, TagOffset[t0]
     storei t3, PayloadOffset[t0]
+    loadp CodeBlock[cfr], t0
+    loadp CodeBlock::m_globalObject[t0], t0
+    writeBarrier(t0, t1, t2)
     dispatch(5)
 
 
@@ -985,9 +983,11 @@ _llint_op_init_global_const_check:
     loadi 4[PC], t0
     btbnz [t2], .opInitGlobalConstCheckSlow
     loadConstantOrVariable(t1, t2, t3)
-    writeBarrier(t2, t3)
     storei t2, TagOffset[t0]
     storei t3, PayloadOffset[t0]
+    loadp CodeBlock[cfr], t0
+    loadp CodeBlock::m_globalObject[t0], t0
+    writeBarrier(t0, t1, t2)
     dispatch(5)
 .opInitGlobalConstCheckSlow:
     callSlowPath(_llint_slow_path_init_global_const_check)
@@ -1033,6 +1033,40 @@ _llint_op_get_by_id_out_of_line:
     getById(withOutOfLineStorage)
 
 
+# The structures of a polymorphic cache are checked in order. Empty entries are
+# null, so they never match.
+_llint_op_get_by_id_polymorphic:
+    traceExecution()
+    loadi 8[PC], t0
+    loadp 16[PC], t1
+    loadConstantOrVariablePayload(t0, CellTag, t3, .opGetByIdPolymorphicSlow)
+    loadp JSCell::m_structure[t3], t2
+    move 0, t0
+.opGetByIdPolymorphicLoop:
+    bpeq LLIntPolymorphicAccessCache::structures[t1, t0, 4], t2, .opGetByIdPolymorphicHit
+    addi 1, t0
+    bilt t0, LLIntPolymorphicAccessCacheSize, .opGetByIdPolymorphicLoop
+    jmp .opGetByIdPolymorphicSlow
+
+.opGetByIdPolymorphicHit:
+    loadi LLIntPolymorphicAccessCache::offsets[t1, t0, 4], t2
+    bigteq t2, 0, .opGetByIdPolymorphicInline
+    loadp JSObject::m_butterfly[t3], t3
+.opGetByIdPolymorphicInline:
+    loadi 4[PC], t1
+    loadi TagOffset[t3, t2], t0
+    loadi PayloadOffset[t3, t2], t2
+    storei t0, TagOffset[cfr, t1, 8]
+    storei t2, PayloadOffset[cfr, t1, 8]
+    loadi 32[PC], t1
+    valueProfile(t0, t2, t1)
+    dispatch(9)
+
+.opGetByIdPolymorphicSlow:
+    callSlowPath(_llint_slow_path_get_by_id)
+    dispatch(9)
+
+
 _llint_op_get_array_length:
     traceExecution()
     loadi 8[PC], t0
@@ -1078,6 +1112,7 @@ macro putById(getPropertyStorage)
     loadi 4[PC], t3
     loadi 16[PC], t1
     loadConstantOrVariablePayload(t3, CellTag, t0, .opPutByIdSlow)
+    writeBarrier(t0, t2, t3)
     loadi 12[PC], t2
     getPropertyStorage(
         t0,
@@ -1086,7 +1121,6 @@ macro putById(getPropertyStorage)
             bpneq JSCell::m_structure[t0], t1, .opPutByIdSlow
             loadi 20[PC], t1
             loadConstantOrVariable2Reg(t2, scratch, t2)
-            writeBarrier(scratch, t2)
             storei scratch, TagOffset[propertyStorage, t1]
             storei t2, PayloadOffset[propertyStorage, t1]
             dispatch(9)
@@ -1105,11 +1139,43 @@ _llint_op_put_by_id_out_of_line:
     putById(withOutOfLineStorage)
 
 
+_llint_op_put_by_id_polymorphic:
+    traceExecution()
+    loadi 4[PC], t3
+    loadp 16[PC], t1
+    loadConstantOrVariablePayload(t3, CellTag, t0, .opPutByIdPolymorphicSlow)
+    writeBarrier(t0, t2, t3)
+    loadp JSCell::m_structure[t0], t2
+    move 0, t3
+.opPutByIdPolymorphicLoop:
+    bpeq LLIntPolymorphicAccessCache::structures[t1, t3, 4], t2, .opPutByIdPolymorphicHit
+    addi 1, t3
+    bilt t3, LLIntPolymorphicAccessCacheSize, .opPutByIdPolymorphicLoop
+    jmp .opPutByIdPolymorphicSlow
+
+.opPutByIdPolymorphicHit:
+    loadi LLIntPolymorphicAccessCache::offsets[t1, t3, 4], t2
+    bigteq t2, 0, .opPutByIdPolymorphicInline
+    loadp JSObject::m_butterfly[t0], t0
+.opPutByIdPolymorphicInline:
+    addp t2, t0
+    loadi 12[PC], t1
+    loadConstantOrVariable2Reg(t1, t2, t1)
+    storei t2, TagOffset[t0]
+    storei t1, PayloadOffset[t0]
+    dispatch(9)
+
+.opPutByIdPolymorphicSlow:
+    callSlowPath(_llint_slow_path_put_by_id)
+    dispatch(9)
+
+
 macro putByIdTransition(additionalChecks, getPropertyStorage)
     traceExecution()
     loadi 4[PC], t3
     loadi 16[PC], t1
     loadConstantOrVariablePayload(t3, CellTag, t0, .opPutByIdSlow)
+    writeBarrier(t0, t2, t3)
     loadi 12[PC], t2
     bpneq JSCell::m_structure[t0], t1, .opPutByIdSlow
     additionalChecks(t1, t3)
@@ -1120,7 +1186,6 @@ macro putByIdTransition(additionalChecks, getPropertyStorage)
         macro (propertyStorage, scratch)
             addp t1, propertyStorage, t3
             loadConstantOrVariable2Reg(t2, t1, t2)
-            writeBarrier(t1, t2)
             storei t1, TagOffset[t3]
             loadi 24[PC], t1
             storei t2, PayloadOffset[t3]
@@ -1301,6 +1366,7 @@ _llint_op_put_by_val:
     traceExecution()
     loadi 4[PC], t0
     loadConstantOrVariablePayload(t0, CellTag, t1, .opPutByValSlow)
+    writeBarrier(t1, t2, t3)
     loadp JSCell::m_structure[t1], t2
     loadp 16[PC], t3
     arrayProfile(t2, t3, t0)
@@ -1340,7 +1406,6 @@ _llint_op_put_by_val:
             const tag = scratch
             const payload = operand
             loadConstantOrVariable2Reg(operand, tag, payload)
-            writeBarrier(tag, payload)
             storei tag, TagOffset[base, index, 8]
             storei payload, PayloadOffset[base, index, 8]
         end)
@@ -1352,7 +1417,6 @@ _llint_op_put_by_val:
 .opPutByValArrayStorageStoreResult:
     loadi 12[PC], t2
     loadConstantOrVariable2Reg(t2, t1, t2)
-    writeBarrier(t1, t2)
     storei t1, ArrayStorage::m_vector + TagOffset[t0, t3, 8]
     storei t2, ArrayStorage::m_vector + PayloadOffset[t0, t3, 8]
     dispatch(5)
@@ -1800,10 +1864,10 @@ _llint_op_get_scoped_var:
 _llint_op_put_scoped_var:
     traceExecution()
     getDeBruijnScope(8[PC], macro (scope, scratch) end)
+    writeBarrier(t0, t1, t3)
     loadi 12[PC], t1
     loadConstantOrVariable(t1, t3, t2)
     loadi 4[PC], t1
-    writeBarrier(t3, t2)
     loadp JSVariableObject::m_registers[t0], t0
     storei t3, TagOffset[t0, t1, 8]
     storei t2, PayloadOffset[t0, t1, 8]
@@ -175,10 +175,6 @@ macro loadConstantOrVariableCell(index, value, slow)
     btqnz value, tagMask, slow
 end
 
-macro writeBarrier(value)
-    # Nothing to do, since we don't have a generational or incremental collector.
-end
-
 macro valueProfile(value, profile)
     if VALUE_PROFILER
         storeq value, ValueProfile::m_buckets[profile]
@@ -818,8 +814,10 @@ _llint_op_init_global_const:
     loadisFromInstruction(2, t1)
     loadpFromInstruction(1, t0)
     loadConstantOrVariable(t1, t2)
-    writeBarrier(t2)
     storeq t2, [t0]
+    loadp CodeBlock[cfr], t0
+    loadp CodeBlock::m_globalObject[t0], t0
+    writeBarrier(t0, t1, t2)
     dispatch(5)
 
 
@@ -830,8 +828,10 @@ _llint_op_init_global_const_check:
     loadpFromInstruction(1, t0)
     btbnz [t2], .opInitGlobalConstCheckSlow
     loadConstantOrVariable(t1, t2)
-    writeBarrier(t2)
     storeq t2, [t0]
+    loadp CodeBlock[cfr], t0
+    loadp CodeBlock::m_globalObject[t0], t0
+    writeBarrier(t0, t1, t2)
     dispatch(5)
 .opInitGlobalConstCheckSlow:
     callSlowPath(_llint_slow_path_init_global_const_check)
@@ -874,6 +874,38 @@ _llint_op_get_by_id_out_of_line:
     getById(withOutOfLineStorage)
 
 
+# The structures of a polymorphic cache are checked in order. Empty entries are
+# null, so they never match.
+_llint_op_get_by_id_polymorphic:
+    traceExecution()
+    loadisFromInstruction(2, t0)
+    loadpFromInstruction(4, t1)
+    loadConstantOrVariableCell(t0, t3, .opGetByIdPolymorphicSlow)
+    loadp JSCell::m_structure[t3], t2
+    move 0, t0
+.opGetByIdPolymorphicLoop:
+    bpeq LLIntPolymorphicAccessCache::structures[t1, t0, 8], t2, .opGetByIdPolymorphicHit
+    addi 1, t0
+    bilt t0, LLIntPolymorphicAccessCacheSize, .opGetByIdPolymorphicLoop
+    jmp .opGetByIdPolymorphicSlow
+
+.opGetByIdPolymorphicHit:
+    loadis LLIntPolymorphicAccessCache::offsets[t1, t0, 4], t2
+    bigteq t2, 0, .opGetByIdPolymorphicInline
+    loadp JSObject::m_butterfly[t3], t3
+.opGetByIdPolymorphicInline:
+    loadisFromInstruction(1, t1)
+    loadq [t3, t2], t0
+    storeq t0, [cfr, t1, 8]
+    loadpFromInstruction(8, t1)
+    valueProfile(t0, t1)
+    dispatch(9)
+
+.opGetByIdPolymorphicSlow:
+    callSlowPath(_llint_slow_path_get_by_id)
+    dispatch(9)
+
+
 _llint_op_get_array_length:
     traceExecution()
     loadisFromInstruction(2, t0)
@@ -919,6 +951,7 @@ macro putById(getPropertyStorage)
     loadisFromInstruction(1, t3)
     loadpFromInstruction(4, t1)
     loadConstantOrVariableCell(t3, t0, .opPutByIdSlow)
+    writeBarrier(t0, t2, t3)
     loadisFromInstruction(3, t2)
     getPropertyStorage(
         t0,
@@ -927,7 +960,6 @@ macro putById(getPropertyStorage)
             bpneq JSCell::m_structure[t0], t1, .opPutByIdSlow
             loadisFromInstruction(5, t1)
             loadConstantOrVariable(t2, scratch)
-            writeBarrier(t0)
             storeq scratch, [propertyStorage, t1]
             dispatch(9)
         end)
@@ -945,11 +977,42 @@ _llint_op_put_by_id_out_of_line:
     putById(withOutOfLineStorage)
 
 
+_llint_op_put_by_id_polymorphic:
+    traceExecution()
+    loadisFromInstruction(1, t3)
+    loadpFromInstruction(4, t1)
+    loadConstantOrVariableCell(t3, t0, .opPutByIdPolymorphicSlow)
+    writeBarrier(t0, t2, t3)
+    loadp JSCell::m_structure[t0], t2
+    move 0, t3
+.opPutByIdPolymorphicLoop:
+    bpeq LLIntPolymorphicAccessCache::structures[t1, t3, 8], t2, .opPutByIdPolymorphicHit
+    addi 1, t3
+    bilt t3, LLIntPolymorphicAccessCacheSize, .opPutByIdPolymorphicLoop
+    jmp .opPutByIdPolymorphicSlow
+
+.opPutByIdPolymorphicHit:
+    loadis LLIntPolymorphicAccessCache::offsets[t1, t3, 4], t2
+    bigteq t2, 0, .opPutByIdPolymorphicInline
+    loadp JSObject::m_butterfly[t0], t0
+.opPutByIdPolymorphicInline:
+    addp t2, t0
+    loadisFromInstruction(3, t1)
+    loadConstantOrVariable(t1, t2)
+    storeq t2, [t0]
+    dispatch(9)
+
+.opPutByIdPolymorphicSlow:
+    callSlowPath(_llint_slow_path_put_by_id)
+    dispatch(9)
+
+
 macro putByIdTransition(additionalChecks, getPropertyStorage)
     traceExecution()
     loadisFromInstruction(1, t3)
     loadpFromInstruction(4, t1)
     loadConstantOrVariableCell(t3, t0, .opPutByIdSlow)
+    writeBarrier(t0, t2, t3)
     loadisFromInstruction(3, t2)
     bpneq JSCell::m_structure[t0], t1, .opPutByIdSlow
     additionalChecks(t1, t3)
@@ -960,7 +1023,6 @@ macro putByIdTransition(additionalChecks, getPropertyStorage)
         macro (propertyStorage, scratch)
             addp t1, propertyStorage, t3
             loadConstantOrVariable(t2, t1)
-            writeBarrier(t1)
             storeq t1, [t3]
             loadpFromInstruction(6, t1)
             storep t1, JSCell::m_structure[t0]
@@ -1138,6 +1200,7 @@ _llint_op_put_by_val:
     traceExecution()
     loadisFromInstruction(1, t0)
     loadConstantOrVariableCell(t0, t1, .opPutByValSlow)
+    writeBarrier(t1, t2, t3)
     loadp JSCell::m_structure[t1], t2
     loadpFromInstruction(4, t3)
     arrayProfile(t2, t3, t0)
@@ -1175,7 +1238,6 @@ _llint_op_put_by_val:
     contiguousPutByVal(
         macro (operand, scratch, address)
             loadConstantOrVariable(operand, scratch)
-            writeBarrier(scratch)
             storep scratch, address
         end)
 
@@ -1186,7 +1248,6 @@ _llint_op_put_by_val:
 .opPutByValArrayStorageStoreResult:
     loadisFromInstruction(3, t2)
     loadConstantOrVariable(t2, t1)
-    writeBarrier(t1)
     storeq t1, ArrayStorage::m_vector[t0, t3, 8]
     dispatch(5)
 
@@ -1659,10 +1720,10 @@ _llint_op_get_scoped_var:
 _llint_op_put_scoped_var:
     traceExecution()
     getDeBruijnScope(16[PB, PC, 8], macro (scope, scratch) end)
+    writeBarrier(t0, t1, t3)
     loadis 24[PB, PC, 8], t1
     loadConstantOrVariable(t1, t3)
     loadis 8[PB, PC, 8], t1
-    writeBarrier(t3)
     loadp JSVariableObject::m_registers[t0], t0
     storep t3, [t0, t1, 8]
     dispatch(4)
@@ -1461,6 +1461,7 @@ namespace JSC {
         WTF_MAKE_FAST_ALLOCATED;
     public:
         static PassRefPtr<FunctionParameters> create(ParameterNode*);
+        static PassRefPtr<FunctionParameters> create(const Vector<Identifier>&);
         ~FunctionParameters();
 
         unsigned size() const { return m_size; }
@@ -1468,6 +1469,7 @@ namespace JSC {
 
     private:
         FunctionParameters(ParameterNode*, unsigned size);
+        FunctionParameters(const Vector<Identifier>&);
 
         Identifier* identifiers() { return reinterpret_cast<Identifier*>(&m_storage); }
         const Identifier* identifiers() const { return reinterpret_cast<const Identifier*>(&m_storage); }
@@ -31,9 +31,16 @@
 
 namespace JSC {
 
-ParserArena::ParserArena()
+ParserArenaPoolCache::~ParserArenaPoolCache()
+{
+    for (size_t i = 0; i < m_pools.size(); ++i)
+        fastFree(m_pools[i]);
+}
+
+ParserArena::ParserArena(PassRefPtr<ParserArenaPoolCache> poolCache)
     : m_freeableMemory(0)
     , m_freeablePoolEnd(0)
+    , m_poolCache(poolCache)
 {
 }
 
@@ -50,11 +57,11 @@ inline void ParserArena::deallocateObjects()
         m_deletableObjects[i]->~ParserArenaDeletable();
 
     if (m_freeablePoolEnd)
-        fastFree(freeablePool());
+        deallocateFreeablePool(freeablePool());
 
     size = m_freeablePools.size();
     for (size_t i = 0; i < size; ++i)
-        fastFree(m_freeablePools[i]);
+        deallocateFreeablePool(m_freeablePools[i]);
 }
 
 ParserArena::~ParserArena()
@@ -79,9 +86,8 @@ void ParserArena::removeLast()
 
 void ParserArena::reset()
 {
-    // Since this code path is used only when parsing fails, it's not bothering to reuse
-    // any of the memory the arena allocated. We could improve that later if we want to
-    // efficiently reuse the same arena.
+    // This code path is used only when parsing fails. The pools go back to the
+    // cache, if we have one, like they do when the arena is destroyed.
 
     deallocateObjects();
 
@@ -99,12 +105,20 @@ void ParserArena::allocateFreeablePool()
     if (m_freeablePoolEnd)
         m_freeablePools.append(freeablePool());
 
-    char* pool = static_cast<char*>(fastMalloc(freeablePoolSize));
+    void* reusedPool = m_poolCache ? m_poolCache->takePool() : 0;
+    char* pool = static_cast<char*>(reusedPool ? reusedPool : fastMalloc(freeablePoolSize));
     m_freeableMemory = pool;
     m_freeablePoolEnd = pool + freeablePoolSize;
     ASSERT(freeablePool() == pool);
 }
 
+void ParserArena::deallocateFreeablePool(void* pool)
+{
+    if (m_poolCache && m_poolCache->givePool(pool))
+        return;
+    fastFree(pool);
+}
+
 bool ParserArena::isEmpty() const
 {
     return !m_freeablePoolEnd
@@ -27,6 +27,8 @@
 #define ParserArena_h
 
 #include "Identifier.h"
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefCounted.h>
 #include <wtf/SegmentedVector.h>
 
 namespace JSC {
@@ -117,12 +119,51 @@ namespace JSC {
         return m_identifiers.last();
     }
 
+    // Keeps the pools that a VM's ParserArenas give back, so that the next parse
+    // can reuse them rather than going back to fastMalloc. This matters most for
+    // lazily compiled functions, each of which reparses its body with a fresh
+    // arena. The arena that the VM parses into and the arenas that ScopeNodes
+    // take their nodes over into all share the VM's cache.
+    class ParserArenaPoolCache : public RefCounted<ParserArenaPoolCache> {
+    public:
+        static PassRefPtr<ParserArenaPoolCache> create() { return adoptRef(new ParserArenaPoolCache); }
+        ~ParserArenaPoolCache();
+
+        // Returns 0 if there is no pool to reuse.
+        void* takePool()
+        {
+            if (m_pools.isEmpty())
+                return 0;
+            void* pool = m_pools.last();
+            m_pools.removeLast();
+            return pool;
+        }
+
+        // Returns false if the cache is full, in which case the caller frees the pool.
+        bool givePool(void* pool)
+        {
+            if (m_pools.size() >= maximumNumberOfCachedPools)
+                return false;
+            m_pools.append(pool);
+            return true;
+        }
+
+    private:
+        ParserArenaPoolCache() { }
+
+        static const size_t maximumNumberOfCachedPools = 64;
+
+        Vector<void*> m_pools;
+    };
+
     class ParserArena {
         WTF_MAKE_NONCOPYABLE(ParserArena);
     public:
-        ParserArena();
+        explicit ParserArena(PassRefPtr<ParserArenaPoolCache> = 0);
         ~ParserArena();
 
+        ParserArenaPoolCache* poolCache() const { return m_poolCache.get(); }
+
         void swap(ParserArena& otherArena)
         {
             std::swap(m_freeableMemory, otherArena.m_freeableMemory);
@@ -178,6 +219,7 @@ namespace JSC {
 
         void* freeablePool();
         void allocateFreeablePool();
+        void deallocateFreeablePool(void*);
         void deallocateObjects();
 
         char* m_freeableMemory;
@@ -187,6 +229,7 @@ namespace JSC {
         Vector<void*> m_freeablePools;
         Vector<ParserArenaDeletable*> m_deletableObjects;
         Vector<RefPtr<ParserArenaRefCounted> > m_refCountedObjects;
+        RefPtr<ParserArenaPoolCache> m_poolCache;
     };
 
 }
@@ -25,6 +25,7 @@
 
 #include "config.h"
 #include "SourceProvider.h"
+#include <wtf/SHA1.h>
 #include <wtf/StdLibExtras.h>
 #include <wtf/TCSpinLock.h>
 
@@ -42,6 +43,23 @@ SourceProvider::~SourceProvider()
 {
 }
 
+void computeSourceDigest(const String& source, Vector<uint8_t, 20>& digest)
+{
+    SHA1 sha1;
+    if (source.is8Bit())
+        sha1.addBytes(source.characters8(), source.length());
+    else
+        sha1.addBytes(reinterpret_cast<const uint8_t*>(source.characters16()), source.length() * sizeof(UChar));
+    sha1.computeHash(digest);
+}
+
+const Vector<uint8_t, 20>& SourceProvider::sourceDigest()
+{
+    if (m_sourceDigest.isEmpty())
+        computeSourceDigest(source(), m_sourceDigest);
+    return m_sourceDigest;
+}
+
 static inline size_t charPositionExtractor(const size_t* value)
 {
     return *value;
@@ -31,11 +31,14 @@
 
 #include <wtf/PassOwnPtr.h>
 #include <wtf/RefCounted.h>
+#include <wtf/Vector.h>
 #include <wtf/text/TextPosition.h>
 #include <wtf/text/WTFString.h>
 
 namespace JSC {
 
+    JS_EXPORT_PRIVATE void computeSourceDigest(const String&, Vector<uint8_t, 20>&);
+
     class SourceProvider : public RefCounted<SourceProvider> {
     public:
         static const intptr_t nullID = 1;
@@ -65,6 +68,20 @@ namespace JSC {
         bool isValid() const { return m_validated; }
         void setValid() { m_validated = true; }
 
+        // SHA-1 digest of source(), computed the first time it is asked for. Caches
+        // that outlive this provider use it to recognize the same source later.
+        JS_EXPORT_PRIVATE const Vector<uint8_t, 20>& sourceDigest();
+
+        // A function cache serialized from an earlier parse of the same source, see
+        // SourceProviderCache::serialize(). The VM saves one here when asked to, see
+        // VM::serializeSourceProviderCaches() and the serializeSourceProviderCachesOnGC
+        // option, and an embedder may hand one back from an earlier load. The
+        // parser uses it to skip over the bodies of functions it has already checked.
+        // Data that does not match the source is ignored.
+        void setSerializedFunctionCache(const Vector<uint8_t>& data) { m_serializedFunctionCache = data; }
+        const Vector<uint8_t>& serializedFunctionCache() const { return m_serializedFunctionCache; }
+        void clearSerializedFunctionCache() { m_serializedFunctionCache.clear(); }
+
     private:
 
         JS_EXPORT_PRIVATE void getID();
@@ -72,6 +89,8 @@ namespace JSC {
 
         String m_url;
         TextPosition m_startPosition;
+        Vector<uint8_t, 20> m_sourceDigest;
+        Vector<uint8_t> m_serializedFunctionCache;
         bool m_validated : 1;
         uintptr_t m_id : sizeof(uintptr_t) * 8 - 1;
     };
@@ -26,8 +26,117 @@
 #include "config.h"
 #include "SourceProviderCache.h"
 
+#include "Identifier.h"
+#include "SourceProvider.h"
+#include "VM.h"
+
 namespace JSC {
 
+static const uint32_t serializedCacheMagic = 0x4350534a; // "JSPC"
+static const uint32_t serializedCacheVersion = 1;
+
+enum SerializedItemFlag {
+    NeedsFullActivationFlag = 1 << 0,
+    UsesEvalFlag = 1 << 1,
+    StrictModeFlag = 1 << 2
+};
+
+static void appendBytes(Vector<uint8_t>& buffer, const void* data, size_t size)
+{
+    buffer.append(static_cast<const uint8_t*>(data), size);
+}
+
+static void appendWord(Vector<uint8_t>& buffer, uint32_t value)
+{
+    appendBytes(buffer, &value, sizeof(value));
+}
+
+static void appendString(Vector<uint8_t>& buffer, StringImpl* string)
+{
+    // The low bit says whether the characters are 8-bit.
+    appendWord(buffer, (string->length() << 1) | string->is8Bit());
+    if (string->is8Bit())
+        appendBytes(buffer, string->characters8(), string->length());
+    else
+        appendBytes(buffer, string->characters16(), string->length() * sizeof(UChar));
+}
+
+class SerializedCacheReader {
+public:
+    SerializedCacheReader(const Vector<uint8_t>& data)
+        : m_data(data)
+        , m_offset(0)
+        , m_failed(false)
+    {
+    }
+
+    bool failed() const { return m_failed; }
+    bool atEnd() const { return m_offset == m_data.size(); }
+
+    const uint8_t* readBytes(size_t size)
+    {
+        if (m_failed || size > m_data.size() - m_offset) {
+            m_failed = true;
+            return 0;
+        }
+        const uint8_t* result = m_data.data() + m_offset;
+        m_offset += size;
+        return result;
+    }
+
+    uint32_t readWord()
+    {
+        uint32_t result = 0;
+        if (const uint8_t* bytes = readBytes(sizeof(result)))
+            memcpy(&result, bytes, sizeof(result));
+        return result;
+    }
+
+    PassRefPtr<StringImpl> readIdentifier(VM& vm)
+    {
+        uint32_t lengthAndFlag = readWord();
+        unsigned length = lengthAndFlag >> 1;
+        if (lengthAndFlag & 1) {
+            const uint8_t* characters = readBytes(length);
+            if (!characters)
+                return 0;
+            return Identifier(&vm, reinterpret_cast<const LChar*>(characters), length).impl();
+        }
+        if (length > std::numeric_limits<uint32_t>::max() / sizeof(UChar)) {
+            m_failed = true;
+            return 0;
+        }
+        const uint8_t* bytes = readBytes(length * sizeof(UChar));
+        if (!bytes)
+            return 0;
+        Vector<UChar> characters(length);
+        memcpy(characters.data(), bytes, length * sizeof(UChar));
+        return Identifier(&vm, characters.data(), length).impl();
+    }
+
+    bool readIdentifiers(VM& vm, unsigned count, Vector<RefPtr<StringImpl> >& result)
+    {
+        // Every identifier takes at least one word, which bounds a corrupt count.
+        if (count > (m_data.size() - m_offset) / sizeof(uint32_t)) {
+            m_failed = true;
+            return false;
+        }
+        result.reserveInitialCapacity(count);
+        for (unsigned i = 0; i < count; ++i) {
+            RefPtr<StringImpl> identifier = readIdentifier(vm);
+            if (!identifier)
+                return false;
+            result.uncheckedAppend(identifier.release());
+        }
+        return true;
+    }
+
+private:
+    const Vector<uint8_t>& m_data;
+    size_t m_offset;
+    bool m_failed;
+};
+
 SourceProviderCache::~SourceProviderCache()
 {
     clear();
@@ -36,11 +145,105 @@ SourceProviderCache::~SourceProviderCache()
 void SourceProviderCache::clear()
 {
     m_map.clear();
+    m_hasUnserializedItems = false;
 }
 
 void SourceProviderCache::add(int sourcePosition, PassOwnPtr<SourceProviderCacheItem> item)
 {
     m_map.add(sourcePosition, item);
+    m_hasUnserializedItems = true;
+}
+
+void SourceProviderCache::serialize(SourceProvider* provider, Vector<uint8_t>& buffer)
+{
+    const Vector<uint8_t, 20>& sourceDigest = provider->sourceDigest();
+
+    buffer.clear();
+    appendWord(buffer, serializedCacheMagic);
+    appendWord(buffer, serializedCacheVersion);
+    appendWord(buffer, provider->source().length());
+    appendBytes(buffer, sourceDigest.data(), sourceDigest.size());
+    appendWord(buffer, m_map.size());
+
+    HashMap<int, OwnPtr<SourceProviderCacheItem> >::const_iterator end = m_map.end();
+    for (HashMap<int, OwnPtr<SourceProviderCacheItem> >::const_iterator iter = m_map.begin(); iter != end; ++iter) {
+        const SourceProviderCacheItem* item = iter->value.get();
+        appendWord(buffer, iter->key);
+        appendWord(buffer, item->functionStart);
+        appendWord(buffer, item->closeBraceLine);
+        appendWord(buffer, item->closeBraceOffset);
+        appendWord(buffer, item->closeBraceLineStartOffset);
+        appendWord(buffer, (item->needsFullActivation ? NeedsFullActivationFlag : 0) | (item->usesEval ? UsesEvalFlag : 0) | (item->strictMode ? StrictModeFlag : 0));
+        appendWord(buffer, item->usedVariablesCount);
+        appendWord(buffer, item->writtenVariablesCount);
+        for (unsigned i = 0; i < item->usedVariablesCount; ++i)
+            appendString(buffer, item->usedVariables()[i]);
+        for (unsigned i = 0; i < item->writtenVariablesCount; ++i)
+            appendString(buffer, item->writtenVariables()[i]);
+    }
+
+    m_hasUnserializedItems = false;
+}
+
+bool SourceProviderCache::deserialize(VM& vm, SourceProvider* provider, const Vector<uint8_t>& data)
+{
+    SerializedCacheReader reader(data);
+    if (reader.readWord() != serializedCacheMagic || reader.readWord() != serializedCacheVersion)
+        return false;
+    const String& source = provider->source();
+    unsigned sourceLength = source.length();
+    if (reader.readWord() != sourceLength)
+        return false;
+    const Vector<uint8_t, 20>& sourceDigest = provider->sourceDigest();
+    const uint8_t* serializedDigest = reader.readBytes(sourceDigest.size());
+    if (!serializedDigest || memcmp(serializedDigest, sourceDigest.data(), sourceDigest.size()))
+        return false;
+
+    // Items are only committed once the whole table has been read, so that a bad
+    // table cannot leave us with a partial one.
+    unsigned itemCount = reader.readWord();
+    Vector<int> openBraceOffsets;
+    Vector<OwnPtr<SourceProviderCacheItem> > items;
+    for (unsigned i = 0; i < itemCount && !reader.failed(); ++i) {
+        unsigned openBraceOffset = reader.readWord();
+        SourceProviderCacheItemCreationParameters parameters;
+        parameters.functionStart = reader.readWord();
+        parameters.closeBraceLine = reader.readWord();
+        parameters.closeBraceOffset = reader.readWord();
+        parameters.closeBraceLineStartOffset = reader.readWord();
+        unsigned flags = reader.readWord();
+        parameters.needsFullActivation = flags & NeedsFullActivationFlag;
+        parameters.usesEval = flags & UsesEvalFlag;
+        parameters.strictMode = flags & StrictModeFlag;
+        unsigned usedVariablesCount = reader.readWord();
+        unsigned writtenVariablesCount = reader.readWord();
+        if (!reader.readIdentifiers(vm, usedVariablesCount, parameters.usedVariables)
+            || !reader.readIdentifiers(vm, writtenVariablesCount, parameters.writtenVariables))
+            return false;
+
+        // The parser jumps straight to the close brace, so make sure that is where
+        // the offsets actually point. The digest makes this a sanity check rather
+        // than a defense.
+        if (!openBraceOffset
+            || parameters.functionStart >= openBraceOffset
+            || openBraceOffset >= parameters.closeBraceOffset
+            || parameters.closeBraceOffset >= sourceLength
+            || parameters.closeBraceOffset > static_cast<unsigned>(std::numeric_limits<int>::max())
+            || parameters.closeBraceLineStartOffset > parameters.closeBraceOffset
+            || parameters.closeBraceLine >= 1u << 31
+            || source[openBraceOffset] != '{'
+            || source[parameters.closeBraceOffset] != '}')
+            return false;
+
+        openBraceOffsets.append(openBraceOffset);
+        items.append(SourceProviderCacheItem::create(parameters));
+    }
+    if (reader.failed() || !reader.atEnd())
+        return false;
+
+    for (size_t i = 0; i < items.size(); ++i)
+        m_map.add(openBraceOffsets[i], items[i].release());
+    return true;
 }
 
 }
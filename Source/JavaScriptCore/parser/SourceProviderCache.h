@@ -31,21 +31,43 @@
 #include <wtf/OwnPtr.h>
 #include <wtf/PassOwnPtr.h>
 #include <wtf/RefCounted.h>
+#include <wtf/Vector.h>
 
 namespace JSC {
 
+class SourceProvider;
+class VM;
+
 class SourceProviderCache : public RefCounted<SourceProviderCache> {
     WTF_MAKE_FAST_ALLOCATED;
 public:
-    SourceProviderCache() { }
+    SourceProviderCache()
+        : m_hasUnserializedItems(false)
+    {
+    }
     JS_EXPORT_PRIVATE ~SourceProviderCache();
 
     JS_EXPORT_PRIVATE void clear();
-    void add(int sourcePosition, PassOwnPtr<SourceProviderCacheItem>);
+    JS_EXPORT_PRIVATE void add(int sourcePosition, PassOwnPtr<SourceProviderCacheItem>);
     const SourceProviderCacheItem* get(int sourcePosition) const { return m_map.get(sourcePosition); }
 
+    // The serialized form records, for each function the parser can skip, its start and
+    // end offsets, its flags and the variables it closes over. It is tied to the exact
+    // source text it was built from, and is handed back through
+    // SourceProvider::setSerializedFunctionCache(). Items added after this are
+    // reported by hasUnserializedItems().
+    JS_EXPORT_PRIVATE void serialize(SourceProvider*, Vector<uint8_t>&);
+
+    // Adds the items in the serialized form to this cache. Returns false, and adds
+    // nothing, if the data is malformed or was not built from this provider's source.
+    JS_EXPORT_PRIVATE bool deserialize(VM&, SourceProvider*, const Vector<uint8_t>&);
+
+    // Whether the parser added items that the provider's serialized form lacks.
+    bool hasUnserializedItems() const { return m_hasUnserializedItems; }
+
 private:
     HashMap<int, OwnPtr<SourceProviderCacheItem> > m_map;
+    bool m_hasUnserializedItems;
 };
 
 }
@@ -0,0 +1,411 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SamplingProfiler.h"
+
+#if ENABLE(SAMPLING_PROFILER)
+
+#include "CallFrame.h"
+#include "CodeBlock.h"
+#include "ExecutableAllocator.h"
+#include "Interpreter.h"
+#include "JSStack.h"
+#include "LLIntData.h"
+#include "Operations.h"
+#include "Options.h"
+#include "VM.h"
+#include <algorithm>
+#include <errno.h>
+#include <semaphore.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <wtf/Atomics.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/FilePrintStream.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace JSC {
+
+static int profilerCounter;
+
+// The signal handler finds the profiler that asked for the sample through this
+// global, so only one request may be outstanding at a time. The handler claims
+// the request by clearing it.
+static SamplingProfiler* volatile profilerBeingSampled;
+static sem_t sampleTaken;
+
+// Requests whose signal had not been handled when the sampling thread stopped
+// waiting for it. The signal is still pending on a thread that has it blocked.
+static int volatile numberOfAbandonedRequests;
+
+// How long the sampling thread waits for a thread that has SIGPROF blocked.
+static const time_t sampleTimeoutInSeconds = 1;
+
+// The rest of the state is guarded by the sampling mutex, which is never held
+// while waiting for a signal to be handled.
+static bool isSampling;
+static unsigned numberOfProfilers;
+static bool isSignalHandlerInstalled;
+static struct sigaction previousAction;
+
+static Mutex& samplingMutex()
+{
+    AtomicallyInitializedStatic(Mutex&, mutex = *new Mutex);
+    return mutex;
+}
+
+static void callPreviousSignalHandler(int signal, siginfo_t* info, void* context)
+{
+    if (previousAction.sa_flags & SA_SIGINFO) {
+        previousAction.sa_sigaction(signal, info, context);
+        return;
+    }
+    // The default action would terminate the process, which is not something a
+    // stray SIGPROF did before the profiler was installed either.
+    if (previousAction.sa_handler != SIG_DFL && previousAction.sa_handler != SIG_IGN)
+        previousAction.sa_handler(signal);
+}
+
+SamplingProfiler::SamplingProfiler(VM& vm)
+    : m_vm(vm)
+    , m_profilerID(atomicIncrement(&profilerCounter))
+    , m_jsThread(pthread_self())
+    , m_llintBegin(LLInt::getCodePtr(llint_begin))
+    , m_llintEnd(LLInt::getCodePtr(llint_end))
+    , m_executableMemoryBegin(0)
+    , m_executableMemoryEnd(0)
+    , m_writeIndex(0)
+    , m_readIndex(0)
+    , m_numberOfIdleSamples(0)
+    , m_numberOfDroppedSamples(0)
+    , m_thread(0)
+    , m_shouldStop(false)
+{
+    COMPILE_ASSERT(!(bufferCapacity & (bufferCapacity - 1)), bufferCapacity_is_a_power_of_two);
+    m_buffer.resize(bufferCapacity);
+}
+
+PassOwnPtr<SamplingProfiler> SamplingProfiler::create(VM& vm)
+{
+    {
+        MutexLocker locker(samplingMutex());
+        static bool didInitializeSemaphore;
+        if (!didInitializeSemaphore) {
+            sem_init(&sampleTaken, 0, 0);
+            didInitializeSemaphore = true;
+        }
+
+        numberOfProfilers++;
+        if (!isSignalHandlerInstalled) {
+            struct sigaction action;
+            memset(&action, 0, sizeof(action));
+            action.sa_sigaction = signalHandler;
+            sigemptyset(&action.sa_mask);
+            action.sa_flags = SA_SIGINFO | SA_RESTART;
+            sigaction(SIGPROF, &action, &previousAction);
+            isSignalHandlerInstalled = true;
+        }
+    }
+
+    OwnPtr<SamplingProfiler> result = adoptPtr(new SamplingProfiler(vm));
+    result->m_thread = createThread(threadFunction, result.get(), "JSC Sampling Profiler");
+    return result.release();
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    {
+        MutexLocker locker(m_lock);
+        m_shouldStop = true;
+        m_stopCondition.signal();
+    }
+    waitForThreadCompletion(m_thread);
+
+    MutexLocker locker(samplingMutex());
+    // An abandoned request would be delivered to the previous handler once its
+    // thread unblocks the signal, so we leave ours installed to swallow it.
+    if (!--numberOfProfilers && !numberOfAbandonedRequests) {
+        sigaction(SIGPROF, &previousAction, 0);
+        isSignalHandlerInstalled = false;
+    }
+}
+
+void SamplingProfiler::threadFunction(void* argument)
+{
+    static_cast<SamplingProfiler*>(argument)->runThread();
+}
+
+void SamplingProfiler::runThread()
+{
+    double interval = Options::samplingProfilerIntervalInMicroseconds() / 1000000.0;
+    for (;;) {
+        {
+            MutexLocker locker(m_lock);
+            if (!m_shouldStop)
+                m_stopCondition.timedWait(m_lock, currentTime() + interval);
+            if (m_shouldStop)
+                return;
+        }
+
+        {
+            MutexLocker locker(samplingMutex());
+            // Another profiler is still waiting for its sample; skip this one.
+            if (isSampling)
+                continue;
+            // The handler cannot take the executable allocator's lock, since the thread
+            // it interrupts may hold it, so we read the pool's bounds for it.
+            ExecutableAllocator::getFixedPoolBounds(m_executableMemoryBegin, m_executableMemoryEnd);
+            profilerBeingSampled = this;
+            if (pthread_kill(m_jsThread, SIGPROF)) {
+                profilerBeingSampled = 0;
+                continue;
+            }
+            isSampling = true;
+        }
+
+        // The handler runs on the JavaScript thread, so the thread is stopped
+        // for as long as it takes to walk the stack, and no longer.
+        waitForSample();
+
+        MutexLocker locker(samplingMutex());
+        isSampling = false;
+    }
+}
+
+void SamplingProfiler::waitForSample()
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += sampleTimeoutInSeconds;
+    while (sem_timedwait(&sampleTaken, &deadline)) {
+        if (errno == EINTR)
+            continue;
+
+        // The JavaScript thread has the signal blocked. Count the request as
+        // abandoned before withdrawing it, so that the handler never mistakes
+        // it for someone else's signal.
+        atomicIncrement(&numberOfAbandonedRequests);
+        if (WTF::weakCompareAndSwap(reinterpret_cast<void* volatile*>(&profilerBeingSampled), this, 0))
+            return;
+
+        // The handler claimed the request just now, and is about to post.
+        atomicDecrement(&numberOfAbandonedRequests);
+        while (sem_wait(&sampleTaken) && errno == EINTR) { }
+        return;
+    }
+}
+
+void SamplingProfiler::signalHandler(int signal, siginfo_t* info, void* context)
+{
+    int savedErrno = errno;
+
+    // Our requests are sent with pthread_kill() from this process.
+    bool isRequest = info->si_code == SI_TKILL && info->si_pid == getpid();
+    SamplingProfiler* profiler = isRequest ? profilerBeingSampled : 0;
+    if (!profiler || !pthread_equal(pthread_self(), profiler->m_jsThread)
+        || !WTF::weakCompareAndSwap(reinterpret_cast<void* volatile*>(&profilerBeingSampled), profiler, 0)) {
+        if (isRequest && numberOfAbandonedRequests > 0)
+            atomicDecrement(&numberOfAbandonedRequests);
+        else
+            callPreviousSignalHandler(signal, info, context);
+        errno = savedErrno;
+        return;
+    }
+
+    mcontext_t& machineContext = static_cast<ucontext_t*>(context)->uc_mcontext;
+    // Both the JIT and the LLInt keep the current call frame in r13.
+    profiler->takeSample(
+        reinterpret_cast<void*>(machineContext.gregs[REG_RIP]),
+        reinterpret_cast<void*>(machineContext.gregs[REG_R13]));
+    sem_post(&sampleTaken);
+    errno = savedErrno;
+}
+
+void SamplingProfiler::takeSample(void* programCounter, void* callFrameRegister)
+{
+    // This runs in a signal handler, so it must not allocate, lock, or touch
+    // anything that it cannot prove is mapped.
+    if (!m_vm.dynamicGlobalObject) {
+        m_numberOfIdleSamples++;
+        return;
+    }
+
+    bool isInGeneratedCode = (programCounter >= m_llintBegin && programCounter <= m_llintEnd)
+        || (reinterpret_cast<uintptr_t>(programCounter) >= m_executableMemoryBegin
+            && reinterpret_cast<uintptr_t>(programCounter) < m_executableMemoryEnd);
+    // Outside of generated code we are in C++ called from JavaScript, which is
+    // expected to publish its frame before doing anything that could take a while.
+    CallFrame* callFrame = isInGeneratedCode ? static_cast<CallFrame*>(callFrameRegister) : m_vm.topCallFrame;
+
+    JSStack& stack = m_vm.interpreter->stack();
+    Register* lowestFrame = stack.begin() + JSStack::CallFrameHeaderSize;
+    Register* limit = stack.end();
+
+    uintptr_t frames[2 * maximumStackDepth];
+    unsigned depth = 0;
+    while (callFrame && depth < maximumStackDepth) {
+        callFrame = callFrame->removeHostCallFrameFlag();
+        // Callers sit below their callees on the stack. Anything else means the
+        // interrupted code was in the middle of setting up a frame, or that the
+        // published frame was stale.
+        if (callFrame->registers() < lowestFrame || callFrame->registers() >= limit)
+            break;
+        frames[2 * depth] = bitwise_cast<uintptr_t>(callFrame->codeBlock());
+        frames[2 * depth + 1] = callFrame->codeOriginIndexForDFG();
+        ++depth;
+        limit = callFrame->registers();
+        callFrame = callFrame->callerFrame();
+    }
+
+    size_t writeIndex = m_writeIndex;
+    if (bufferCapacity - (writeIndex - m_readIndex) < 1 + 2 * depth) {
+        m_numberOfDroppedSamples++;
+        return;
+    }
+
+    uintptr_t* buffer = m_buffer.data();
+    const size_t mask = bufferCapacity - 1;
+    buffer[writeIndex++ & mask] = depth;
+    for (unsigned i = 0; i < 2 * depth; ++i)
+        buffer[writeIndex++ & mask] = frames[i];
+    WTF::compilerFence();
+    m_writeIndex = writeIndex;
+}
+
+static String frameName(const String& inferredName, ScriptExecutable* executable)
+{
+    StringBuilder builder;
+    builder.append(inferredName.isEmpty() ? String("(anonymous)") : inferredName);
+    builder.append(' ');
+    builder.append(executable->sourceURL());
+    builder.append(':');
+    builder.append(String::number(executable->lineNo()));
+
+    // Semicolons separate the frames of a stack trace.
+    String result = builder.toString();
+    result.replace(';', ',');
+    return result;
+}
+
+void SamplingProfiler::appendFrame(Vector<String, 32>& frames, CodeBlock* codeBlock, unsigned codeOriginIndex, bool isTopFrame, const HashSet<CodeBlock*>& liveCodeBlocks)
+{
+    if (!codeBlock) {
+        frames.append(ASCIILiteral("(native)"));
+        return;
+    }
+    if (!liveCodeBlocks.contains(codeBlock)) {
+        frames.append(ASCIILiteral("(unknown)"));
+        return;
+    }
+
+#if ENABLE(DFG_JIT)
+    // A DFG frame that has called out records the code origin of the call, which
+    // tells us which functions had been inlined at that point. The top frame was
+    // interrupted somewhere other than a call, so its index may be stale.
+    if (!isTopFrame && codeBlock->getJITType() == JITCode::DFGJIT && codeBlock->canGetCodeOrigin(codeOriginIndex)) {
+        CodeOrigin codeOrigin = codeBlock->codeOrigin(codeOriginIndex);
+        for (InlineCallFrame* inlineCallFrame = codeOrigin.inlineCallFrame; inlineCallFrame; inlineCallFrame = inlineCallFrame->caller.inlineCallFrame)
+            frames.append(frameName(inlineCallFrame->inferredName(), jsCast<ScriptExecutable*>(inlineCallFrame->executable.get())));
+    }
+#else
+    UNUSED_PARAM(codeOriginIndex);
+    UNUSED_PARAM(isTopFrame);
+#endif
+
+    frames.append(frameName(codeBlock->inferredName(), codeBlock->ownerExecutable()));
+}
+
+void SamplingProfiler::processSamples()
+{
+    size_t writeIndex = m_writeIndex;
+    WTF::compilerFence();
+    size_t readIndex = m_readIndex;
+    if (readIndex == writeIndex)
+        return;
+
+    HashSet<CodeBlock*> liveCodeBlocks;
+    m_vm.heap.gatherCodeBlocks(liveCodeBlocks);
+
+    const uintptr_t* buffer = m_buffer.data();
+    const size_t mask = bufferCapacity - 1;
+    Vector<String, 32> frames;
+    StringBuilder stackTrace;
+    while (readIndex != writeIndex) {
+        unsigned depth = buffer[readIndex++ & mask];
+        frames.shrink(0);
+        for (unsigned i = 0; i < depth; ++i) {
+            CodeBlock* codeBlock = bitwise_cast<CodeBlock*>(buffer[readIndex++ & mask]);
+            unsigned codeOriginIndex = buffer[readIndex++ & mask];
+            appendFrame(frames, codeBlock, codeOriginIndex, !i, liveCodeBlocks);
+        }
+
+        // Frames were recorded innermost first.
+        stackTrace.clear();
+        for (size_t i = frames.size(); i--;) {
+            if (!stackTrace.isEmpty())
+                stackTrace.append(';');
+            stackTrace.append(frames[i]);
+        }
+        if (stackTrace.isEmpty())
+            stackTrace.append("(unknown)");
+        m_stackTraces.add(stackTrace.toString(), 0).iterator->value++;
+    }
+
+    WTF::compilerFence();
+    m_readIndex = readIndex;
+}
+
+void SamplingProfiler::writeStackTraces(PrintStream& out)
+{
+    processSamples();
+
+    Vector<String> stackTraces;
+    copyKeysToVector(m_stackTraces, stackTraces);
+    std::sort(stackTraces.begin(), stackTraces.end(), WTF::codePointCompareLessThan);
+    for (size_t i = 0; i < stackTraces.size(); ++i)
+        out.print(stackTraces[i], " ", m_stackTraces.get(stackTraces[i]), "\n");
+
+    if (m_numberOfIdleSamples)
+        out.print("(idle) ", m_numberOfIdleSamples, "\n");
+    if (m_numberOfDroppedSamples)
+        out.print("(dropped) ", m_numberOfDroppedSamples, "\n");
+}
+
+bool SamplingProfiler::save(const char* filename)
+{
+    OwnPtr<FilePrintStream> out = FilePrintStream::open(filename, "w");
+    if (!out)
+        return false;
+
+    writeStackTraces(*out);
+    return true;
+}
+
+} // namespace JSC
+
+#endif // ENABLE(SAMPLING_PROFILER)
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SamplingProfiler_h
+#define SamplingProfiler_h
+
+#include <wtf/Platform.h>
+
+#if ENABLE(SAMPLING_PROFILER)
+
+#include <pthread.h>
+#include <signal.h>
+#include <wtf/FastAllocBase.h>
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/PrintStream.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class CodeBlock;
+class VM;
+
+// Periodically interrupts the thread that created the VM and records which
+// JavaScript functions were on its stack. Unlike the LegacyProfiler, which
+// instruments every call, this costs nothing between samples, so it can be left
+// running in a release build.
+//
+// A helper thread sends the JavaScript thread SIGPROF once per interval. The
+// handler is installed while any profiler exists, and passes signals that did
+// not come from a profiler on to whatever handler was installed before. The
+// signal handler walks the CallFrames, recording each frame's CodeBlock and the
+// code origin index that the DFG stores in the frame at call sites, into a
+// fixed-size ring buffer. The handler must not allocate or take locks, and it
+// cannot tell a live CodeBlock from a stale word on the stack, so it records raw
+// bits. processSamples() turns them into stack traces on the JavaScript thread;
+// the heap calls it before it deletes any code, so every CodeBlock a sample can
+// name is still alive and can be checked against the set of known ones.
+//
+// Stack traces are aggregated in the collapsed format of flame graph tools: one
+// line per distinct stack, with the frames from outermost to innermost separated
+// by semicolons, followed by the number of samples that hit it.
+class SamplingProfiler {
+    WTF_MAKE_NONCOPYABLE(SamplingProfiler); WTF_MAKE_FAST_ALLOCATED;
+public:
+    JS_EXPORT_PRIVATE static PassOwnPtr<SamplingProfiler> create(VM&);
+    JS_EXPORT_PRIVATE ~SamplingProfiler();
+
+    int profilerID() const { return m_profilerID; }
+
+    // Must be called on the JavaScript thread, with the API lock held.
+    void processSamples();
+
+    JS_EXPORT_PRIVATE void writeStackTraces(PrintStream&);
+    JS_EXPORT_PRIVATE bool save(const char* filename);
+
+private:
+    SamplingProfiler(VM&);
+
+    static void threadFunction(void*);
+    void runThread();
+    void waitForSample();
+
+    static void signalHandler(int, siginfo_t*, void*);
+    void takeSample(void* programCounter, void* callFrameRegister);
+
+    void appendFrame(Vector<String, 32>& frames, CodeBlock*, unsigned codeOriginIndex, bool isTopFrame, const HashSet<CodeBlock*>& liveCodeBlocks);
+
+    static const unsigned maximumStackDepth = 128;
+    // Each sample takes a depth word and two words per frame.
+    static const size_t bufferCapacity = 64 * 1024;
+
+    VM& m_vm;
+    int m_profilerID;
+    pthread_t m_jsThread;
+    void* m_llintBegin;
+    void* m_llintEnd;
+    // Set by the sampling thread before each signal.
+    uintptr_t m_executableMemoryBegin;
+    uintptr_t m_executableMemoryEnd;
+
+    // Written only by the signal handler, and read only on the JavaScript
+    // thread, which the handler interrupts; the indices grow without bound and
+    // are masked on access.
+    Vector<uintptr_t> m_buffer;
+    volatile size_t m_writeIndex;
+    volatile size_t m_readIndex;
+    volatile unsigned m_numberOfIdleSamples;
+    volatile unsigned m_numberOfDroppedSamples;
+
+    HashMap<String, unsigned> m_stackTraces;
+
+    ThreadIdentifier m_thread;
+    Mutex m_lock;
+    ThreadCondition m_stopCondition;
+    bool m_shouldStop;
+};
+
+} // namespace JSC
+
+#endif // ENABLE(SAMPLING_PROFILER)
+
+#endif // SamplingProfiler_h
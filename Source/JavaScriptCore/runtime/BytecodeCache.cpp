@@ -0,0 +1,1191 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "BytecodeCache.h"
+
+#include "Nodes.h"
+#include "Opcode.h"
+#include "Operations.h"
+#include "Options.h"
+#include "RegExp.h"
+#include "SourceCode.h"
+#include "SymbolTable.h"
+#include "UnlinkedCodeBlock.h"
+#include "WeakInlines.h"
+#include <limits>
+#include <stdio.h>
+#include <string.h>
+#include <wtf/ProcessID.h>
+#include <wtf/SHA1.h>
+#include <wtf/text/StringBuilder.h>
+
+#if OS(UNIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace JSC {
+
+// A cache file is a header followed by the encoded UnlinkedProgramCodeBlock. All
+// integers are stored in host byte order; the magic number doubles as a check
+// that the file was written by a machine of the same endianness.
+//
+// The header records a fingerprint of the opcode table, so that bytecode from a
+// different build of the engine is ignored, and the length and SHA-1 digest of
+// the source, so that a digest collision in the file name is caught.
+//
+// Every function body is prefixed by its length and refers to nothing outside
+// itself. Reading an UnlinkedFunctionExecutable records where its bodies start
+// and skips over them; they are only decoded when the function is first linked.
+// This also lets us copy a body that was never decoded into a new file verbatim.
+
+static const uint32_t bytecodeCacheMagic = 0x4342534a; // "JSBC"
+
+// Bump this whenever the encoding, or the bytecode generator's output for a
+// given opcode table, changes.
+static const uint32_t bytecodeCacheFormatVersion = 1;
+
+static const size_t sourceDigestSize = 20;
+
+enum CodeBlockFlags {
+    NeedsFullScopeChainFlag = 1 << 0,
+    UsesEvalFlag = 1 << 1,
+    IsStrictModeFlag = 1 << 2,
+    IsConstructorFlag = 1 << 3,
+    IsNumericCompareFunctionFlag = 1 << 4,
+    HasCapturedVariablesFlag = 1 << 5,
+    HasSymbolTableFlag = 1 << 6,
+    HasRareDataFlag = 1 << 7
+};
+
+enum FunctionExecutableFlags {
+    ForceUsesArgumentsFlag = 1 << 0,
+    IsInStrictContextFlag = 1 << 1,
+    FunctionHasCapturedVariablesFlag = 1 << 2
+};
+
+enum ValueTag {
+    EmptyValueTag,
+    UndefinedValueTag,
+    NullValueTag,
+    TrueValueTag,
+    FalseValueTag,
+    Int32ValueTag,
+    DoubleValueTag,
+    StringValueTag,
+    ConstantRegisterValueTag
+};
+
+static const uint32_t nullStringLength = 0xffffffff;
+
+static uint32_t opcodeFingerprint()
+{
+    static uint32_t fingerprint;
+    if (fingerprint)
+        return fingerprint;
+
+    SHA1 sha1;
+#define ADD_OPCODE_TO_FINGERPRINT(id, length) { \
+        static const char name[] = #id; \
+        uint8_t lengthByte = length; \
+        sha1.addBytes(reinterpret_cast<const uint8_t*>(name), sizeof(name)); \
+        sha1.addBytes(&lengthByte, 1); \
+    }
+    FOR_EACH_OPCODE_ID(ADD_OPCODE_TO_FINGERPRINT)
+#undef ADD_OPCODE_TO_FINGERPRINT
+
+    Vector<uint8_t, 20> digest;
+    sha1.computeHash(digest);
+    fingerprint = digest[0] | (digest[1] << 8) | (digest[2] << 16) | (static_cast<uint32_t>(digest[3]) << 24) | 1;
+    return fingerprint;
+}
+
+class BytecodeCacheWriter {
+public:
+    BytecodeCacheWriter()
+        : m_failed(false)
+        , m_numberOfNewFunctionBodies(0)
+    {
+    }
+
+    bool failed() const { return m_failed; }
+    unsigned numberOfNewFunctionBodies() const { return m_numberOfNewFunctionBodies; }
+    const Vector<uint8_t>& buffer() const { return m_buffer; }
+
+    void writeHeader(unsigned sourceLength, JSParserStrictness strictness, const Vector<uint8_t, 20>& sourceDigest)
+    {
+        write(bytecodeCacheMagic);
+        write(bytecodeCacheFormatVersion);
+        write(opcodeFingerprint());
+        write(sourceLength);
+        write(static_cast<uint32_t>(strictness));
+        ASSERT(sourceDigest.size() == sourceDigestSize);
+        writeBytes(sourceDigest.data(), sourceDigestSize);
+    }
+
+    void writeProgramCodeBlock(UnlinkedProgramCodeBlock*);
+
+private:
+    void writeBytes(const void* data, size_t size)
+    {
+        m_buffer.append(static_cast<const uint8_t*>(data), size);
+    }
+
+    void write(uint32_t value) { writeBytes(&value, sizeof(value)); }
+    void write(int32_t value) { write(static_cast<uint32_t>(value)); }
+    void write(uint64_t value) { writeBytes(&value, sizeof(value)); }
+
+    void writeString(const String&);
+    void writeIdentifier(const Identifier& identifier) { writeString(identifier.string()); }
+    void writeValue(JSValue, UnlinkedCodeBlock* constantRegisterOwner = 0);
+    void writeCodeBlock(UnlinkedCodeBlock*);
+    void writeSymbolTable(SharedSymbolTable*);
+    void writeFunctionExecutable(UnlinkedFunctionExecutable*);
+    void writeFunctionBody(UnlinkedFunctionExecutable*, CodeSpecializationKind);
+
+    Vector<uint8_t> m_buffer;
+    bool m_failed;
+    unsigned m_numberOfNewFunctionBodies;
+};
+
+void BytecodeCacheWriter::writeString(const String& string)
+{
+    if (string.isNull()) {
+        write(nullStringLength);
+        return;
+    }
+    write(string.length());
+    uint8_t is8Bit = string.is8Bit();
+    writeBytes(&is8Bit, 1);
+    if (is8Bit)
+        writeBytes(string.characters8(), string.length());
+    else
+        writeBytes(string.characters16(), string.length() * sizeof(UChar));
+}
+
+void BytecodeCacheWriter::writeValue(JSValue value, UnlinkedCodeBlock* constantRegisterOwner)
+{
+    if (value.isEmpty()) {
+        write(static_cast<uint32_t>(EmptyValueTag));
+        return;
+    }
+    if (value.isUndefined()) {
+        write(static_cast<uint32_t>(UndefinedValueTag));
+        return;
+    }
+    if (value.isNull()) {
+        write(static_cast<uint32_t>(NullValueTag));
+        return;
+    }
+    if (value.isBoolean()) {
+        write(static_cast<uint32_t>(value.isTrue() ? TrueValueTag : FalseValueTag));
+        return;
+    }
+    if (value.isInt32()) {
+        write(static_cast<uint32_t>(Int32ValueTag));
+        write(value.asInt32());
+        return;
+    }
+    if (value.isDouble()) {
+        write(static_cast<uint32_t>(DoubleValueTag));
+        write(bitwise_cast<uint64_t>(value.asDouble()));
+        return;
+    }
+    if (value.isString()) {
+        // Constant buffers are not visited by the GC; their strings are kept alive
+        // by the constant pool, so that is what we have to point them back at.
+        if (constantRegisterOwner) {
+            const Vector<WriteBarrier<Unknown> >& constants = constantRegisterOwner->constantRegisters();
+            for (size_t i = 0; i < constants.size(); ++i) {
+                if (constants[i].get() != value)
+                    continue;
+                write(static_cast<uint32_t>(ConstantRegisterValueTag));
+                write(static_cast<uint32_t>(i));
+                return;
+            }
+            m_failed = true;
+            return;
+        }
+        const String& string = asString(value)->tryGetValue();
+        if (string.isNull()) {
+            m_failed = true;
+            return;
+        }
+        write(static_cast<uint32_t>(StringValueTag));
+        writeString(string);
+        return;
+    }
+
+    // The bytecode generator only ever puts primitives in the constant pool. If
+    // that changes we would rather not cache than cache something wrong.
+    m_failed = true;
+}
+
+void BytecodeCacheWriter::writeSymbolTable(SharedSymbolTable* symbolTable)
+{
+    write(static_cast<uint32_t>(symbolTable->usesNonStrictEval()));
+    write(symbolTable->captureStart());
+    write(symbolTable->captureEnd());
+    write(symbolTable->parameterCountIncludingThis());
+
+    if (const SlowArgument* slowArguments = symbolTable->slowArguments()) {
+        write(1u);
+        for (int i = 0; i < symbolTable->parameterCount(); ++i) {
+            write(static_cast<uint32_t>(slowArguments[i].status));
+            write(slowArguments[i].index);
+        }
+    } else
+        write(0u);
+
+    write(symbolTable->size());
+    SymbolTable::iterator end = symbolTable->end();
+    for (SymbolTable::iterator iter = symbolTable->begin(); iter != end; ++iter) {
+        writeString(iter->key.get());
+        write(iter->value.getIndex());
+        write(iter->value.getAttributes());
+    }
+}
+
+void BytecodeCacheWriter::writeCodeBlock(UnlinkedCodeBlock* codeBlock)
+{
+    UnlinkedCodeBlock::RareData* rareData = codeBlock->m_rareData.get();
+
+    uint32_t flags = 0;
+    if (codeBlock->needsFullScopeChain())
+        flags |= NeedsFullScopeChainFlag;
+    if (codeBlock->usesEval())
+        flags |= UsesEvalFlag;
+    if (codeBlock->isStrictMode())
+        flags |= IsStrictModeFlag;
+    if (codeBlock->isConstructor())
+        flags |= IsConstructorFlag;
+    if (codeBlock->isNumericCompareFunction())
+        flags |= IsNumericCompareFunctionFlag;
+    if (codeBlock->hasCapturedVariables())
+        flags |= HasCapturedVariablesFlag;
+    if (codeBlock->symbolTable())
+        flags |= HasSymbolTableFlag;
+    if (rareData)
+        flags |= HasRareDataFlag;
+    write(flags);
+    write(static_cast<uint32_t>(codeBlock->codeType()));
+
+    write(codeBlock->m_numVars);
+    write(codeBlock->m_numCapturedVars);
+    write(codeBlock->m_numCalleeRegisters);
+    write(codeBlock->numParameters());
+    write(codeBlock->thisRegister());
+    write(codeBlock->argumentsRegister());
+    write(codeBlock->activationRegister());
+    write(codeBlock->globalObjectRegister());
+    write(codeBlock->firstLine());
+    write(codeBlock->lineCount());
+    write(static_cast<uint32_t>(codeBlock->codeFeatures()));
+
+    write(codeBlock->m_resolveOperationCount);
+    write(codeBlock->m_putToBaseOperationCount);
+    write(codeBlock->m_arrayProfileCount);
+    write(codeBlock->m_arrayAllocationProfileCount);
+    write(codeBlock->m_objectAllocationProfileCount);
+    write(codeBlock->m_valueProfileCount);
+    write(codeBlock->m_llintCallLinkInfoCount);
+
+    const RefCountedArray<UnlinkedInstruction>& instructions = codeBlock->instructions();
+    write(static_cast<uint32_t>(instructions.size()));
+    for (size_t i = 0; i < instructions.size();) {
+        OpcodeID opcodeID = instructions[i].u.opcode;
+        write(static_cast<uint32_t>(opcodeID));
+        for (int j = 1; j < opcodeLengths[opcodeID]; ++j)
+            write(instructions[i + j].u.operand);
+        i += opcodeLengths[opcodeID];
+    }
+
+    write(static_cast<uint32_t>(codeBlock->m_jumpTargets.size()));
+    for (size_t i = 0; i < codeBlock->m_jumpTargets.size(); ++i)
+        write(codeBlock->m_jumpTargets[i]);
+
+    write(static_cast<uint32_t>(codeBlock->m_propertyAccessInstructions.size()));
+    for (size_t i = 0; i < codeBlock->m_propertyAccessInstructions.size(); ++i)
+        write(codeBlock->m_propertyAccessInstructions[i]);
+
+    write(static_cast<uint32_t>(codeBlock->m_identifiers.size()));
+    for (size_t i = 0; i < codeBlock->m_identifiers.size(); ++i)
+        writeIdentifier(codeBlock->m_identifiers[i]);
+
+    write(static_cast<uint32_t>(codeBlock->m_constantRegisters.size()));
+    for (size_t i = 0; i < codeBlock->m_constantRegisters.size(); ++i)
+        writeValue(codeBlock->m_constantRegisters[i].get());
+
+    write(static_cast<uint32_t>(codeBlock->m_functionDecls.size()));
+    for (size_t i = 0; i < codeBlock->m_functionDecls.size(); ++i)
+        writeFunctionExecutable(codeBlock->m_functionDecls[i].get());
+
+    write(static_cast<uint32_t>(codeBlock->m_functionExprs.size()));
+    for (size_t i = 0; i < codeBlock->m_functionExprs.size(); ++i)
+        writeFunctionExecutable(codeBlock->m_functionExprs[i].get());
+
+    if (SharedSymbolTable* symbolTable = codeBlock->symbolTable())
+        writeSymbolTable(symbolTable);
+
+    write(static_cast<uint32_t>(codeBlock->m_expressionInfo.size()));
+    for (size_t i = 0; i < codeBlock->m_expressionInfo.size(); ++i) {
+        const ExpressionRangeInfo& info = codeBlock->m_expressionInfo[i];
+        write(static_cast<uint32_t>(info.instructionOffset | (info.startOffset << 25)));
+        write(static_cast<uint32_t>(info.divotPoint | (info.endOffset << 25)));
+        write(static_cast<uint32_t>(info.mode | (info.position << 2)));
+    }
+
+    if (!rareData)
+        return;
+
+    write(static_cast<uint32_t>(rareData->m_exceptionHandlers.size()));
+    for (size_t i = 0; i < rareData->m_exceptionHandlers.size(); ++i) {
+        const UnlinkedHandlerInfo& handler = rareData->m_exceptionHandlers[i];
+        write(handler.start);
+        write(handler.end);
+        write(handler.target);
+        write(handler.scopeDepth);
+    }
+
+    write(static_cast<uint32_t>(rareData->m_regexps.size()));
+    for (size_t i = 0; i < rareData->m_regexps.size(); ++i) {
+        RegExp* regExp = rareData->m_regexps[i].get();
+        uint32_t regExpFlags = NoFlags;
+        if (regExp->global())
+            regExpFlags |= FlagGlobal;
+        if (regExp->ignoreCase())
+            regExpFlags |= FlagIgnoreCase;
+        if (regExp->multiline())
+            regExpFlags |= FlagMultiline;
+        writeString(regExp->pattern());
+        write(regExpFlags);
+    }
+
+    write(static_cast<uint32_t>(rareData->m_constantBuffers.size()));
+    for (size_t i = 0; i < rareData->m_constantBuffers.size(); ++i) {
+        const UnlinkedCodeBlock::ConstantBuffer& buffer = rareData->m_constantBuffers[i];
+        write(static_cast<uint32_t>(buffer.size()));
+        for (size_t j = 0; j < buffer.size(); ++j)
+            writeValue(buffer[j], codeBlock);
+    }
+
+    Vector<UnlinkedSimpleJumpTable>* simpleJumpTables[] = { &rareData->m_immediateSwitchJumpTables, &rareData->m_characterSwitchJumpTables };
+    for (size_t kind = 0; kind < WTF_ARRAY_LENGTH(simpleJumpTables); ++kind) {
+        Vector<UnlinkedSimpleJumpTable>& jumpTables = *simpleJumpTables[kind];
+        write(static_cast<uint32_t>(jumpTables.size()));
+        for (size_t i = 0; i < jumpTables.size(); ++i) {
+            write(jumpTables[i].min);
+            write(static_cast<uint32_t>(jumpTables[i].branchOffsets.size()));
+            for (size_t j = 0; j < jumpTables[i].branchOffsets.size(); ++j)
+                write(jumpTables[i].branchOffsets[j]);
+        }
+    }
+
+    write(static_cast<uint32_t>(rareData->m_stringSwitchJumpTables.size()));
+    for (size_t i = 0; i < rareData->m_stringSwitchJumpTables.size(); ++i) {
+        const UnlinkedStringJumpTable::StringOffsetTable& offsetTable = rareData->m_stringSwitchJumpTables[i].offsetTable;
+        write(static_cast<uint32_t>(offsetTable.size()));
+        UnlinkedStringJumpTable::StringOffsetTable::const_iterator end = offsetTable.end();
+        for (UnlinkedStringJumpTable::StringOffsetTable::const_iterator iter = offsetTable.begin(); iter != end; ++iter) {
+            writeString(iter->key.get());
+            write(iter->value);
+        }
+    }
+
+    write(static_cast<uint32_t>(rareData->m_expressionInfoFatPositions.size()));
+    for (size_t i = 0; i < rareData->m_expressionInfoFatPositions.size(); ++i) {
+        write(rareData->m_expressionInfoFatPositions[i].line);
+        write(rareData->m_expressionInfoFatPositions[i].column);
+    }
+}
+
+void BytecodeCacheWriter::writeFunctionExecutable(UnlinkedFunctionExecutable* executable)
+{
+    writeIdentifier(executable->m_name);
+    writeIdentifier(executable->m_inferredName);
+
+    FunctionParameters* parameters = executable->parameters();
+    unsigned parameterCount = parameters ? parameters->size() : 0;
+    write(parameterCount);
+    for (unsigned i = 0; i < parameterCount; ++i)
+        writeIdentifier(parameters->at(i));
+
+    uint32_t flags = 0;
+    if (executable->m_forceUsesArguments)
+        flags |= ForceUsesArgumentsFlag;
+    if (executable->m_isInStrictContext)
+        flags |= IsInStrictContextFlag;
+    if (executable->m_hasCapturedVariables)
+        flags |= FunctionHasCapturedVariablesFlag;
+    write(flags);
+    write(static_cast<uint32_t>(executable->m_numCapturedVariables));
+    write(executable->m_firstLineOffset);
+    write(executable->m_lineCount);
+    write(executable->m_functionStartOffset);
+    write(executable->m_functionStartColumn);
+    write(executable->m_startOffset);
+    write(executable->m_sourceLength);
+    write(static_cast<uint32_t>(executable->m_features));
+    write(static_cast<uint32_t>(executable->m_functionNameIsInScopeToggle));
+
+    writeFunctionBody(executable, CodeForCall);
+    writeFunctionBody(executable, CodeForConstruct);
+}
+
+void BytecodeCacheWriter::writeFunctionBody(UnlinkedFunctionExecutable* executable, CodeSpecializationKind kind)
+{
+    UnlinkedFunctionCodeBlock* codeBlock = kind == CodeForCall ? executable->m_codeBlockForCall.get() : executable->m_codeBlockForConstruct.get();
+    unsigned cachedOffset = kind == CodeForCall ? executable->m_cachedCodeBlockForCallOffset : executable->m_cachedCodeBlockForConstructOffset;
+
+    if (!codeBlock) {
+        if (!cachedOffset) {
+            write(0u);
+            return;
+        }
+        // The reader checked the length of this body when it recorded the offset.
+        const uint8_t* body = executable->m_bytecodeCacheFile->data() + cachedOffset;
+        uint32_t length;
+        memcpy(&length, body, sizeof(length));
+        writeBytes(body, sizeof(length) + length);
+        return;
+    }
+
+    // Re-encode bodies we have in memory even if they came from the cache, since
+    // they may hold functions that have been compiled since.
+    if (!cachedOffset)
+        m_numberOfNewFunctionBodies++;
+
+    size_t lengthOffset = m_buffer.size();
+    write(0u);
+    writeCodeBlock(codeBlock);
+    uint32_t length = m_buffer.size() - lengthOffset - sizeof(length);
+    memcpy(m_buffer.data() + lengthOffset, &length, sizeof(length));
+}
+
+void BytecodeCacheWriter::writeProgramCodeBlock(UnlinkedProgramCodeBlock* codeBlock)
+{
+    writeCodeBlock(codeBlock);
+
+    const UnlinkedProgramCodeBlock::VariableDeclations& variableDeclarations = codeBlock->variableDeclarations();
+    write(static_cast<uint32_t>(variableDeclarations.size()));
+    for (size_t i = 0; i < variableDeclarations.size(); ++i) {
+        writeIdentifier(variableDeclarations[i].first);
+        write(static_cast<uint32_t>(variableDeclarations[i].second));
+    }
+
+    const UnlinkedProgramCodeBlock::FunctionDeclations& functionDeclarations = codeBlock->functionDeclarations();
+    write(static_cast<uint32_t>(functionDeclarations.size()));
+    for (size_t i = 0; i < functionDeclarations.size(); ++i) {
+        writeIdentifier(functionDeclarations[i].first);
+        writeFunctionExecutable(functionDeclarations[i].second.get());
+    }
+}
+
+// Decodes part of a cache file. Reads are bounds checked and failure is sticky,
+// so callers only need to check failed() before acting on what they have read.
+// Cells are attached to their owners as soon as they are created, which keeps
+// them alive across any GC that the allocations below may trigger.
+class BytecodeCacheReader {
+public:
+    BytecodeCacheReader(VM& vm, BytecodeCacheFile* file, size_t begin, size_t end)
+        : m_vm(vm)
+        , m_file(file)
+        , m_cursor(begin)
+        , m_end(end)
+        , m_failed(false)
+    {
+        ASSERT(begin <= end && end <= file->size());
+    }
+
+    bool failed() const { return m_failed; }
+    bool atEnd() const { return m_cursor == m_end; }
+
+    bool readHeader(unsigned sourceLength, JSParserStrictness strictness, const Vector<uint8_t, 20>& sourceDigest)
+    {
+        if (read32() != bytecodeCacheMagic || read32() != bytecodeCacheFormatVersion || read32() != opcodeFingerprint())
+            return false;
+        if (read32() != sourceLength || read32() != static_cast<uint32_t>(strictness))
+            return false;
+        const uint8_t* digest = readBytes(sourceDigestSize);
+        return digest && !memcmp(digest, sourceDigest.data(), sourceDigestSize);
+    }
+
+    UnlinkedProgramCodeBlock* readProgramCodeBlock();
+    UnlinkedFunctionCodeBlock* readFunctionBody();
+
+private:
+    const uint8_t* readBytes(size_t size)
+    {
+        if (m_failed || size > m_end - m_cursor) {
+            m_failed = true;
+            return 0;
+        }
+        const uint8_t* result = m_file->data() + m_cursor;
+        m_cursor += size;
+        return result;
+    }
+
+    uint32_t read32()
+    {
+        uint32_t result = 0;
+        if (const uint8_t* data = readBytes(sizeof(result)))
+            memcpy(&result, data, sizeof(result));
+        return result;
+    }
+
+    int32_t readInt32() { return static_cast<int32_t>(read32()); }
+
+    uint64_t read64()
+    {
+        uint64_t result = 0;
+        if (const uint8_t* data = readBytes(sizeof(result)))
+            memcpy(&result, data, sizeof(result));
+        return result;
+    }
+
+    // Guards against allocating absurd amounts for a corrupt count.
+    uint32_t readCount(size_t minimumEncodedSizeOfElement)
+    {
+        uint32_t count = read32();
+        if (m_failed || count > (m_end - m_cursor) / minimumEncodedSizeOfElement) {
+            m_failed = true;
+            return 0;
+        }
+        return count;
+    }
+
+    String readString();
+    Identifier readIdentifier();
+    JSValue readValue(UnlinkedCodeBlock* constantRegisterOwner = 0);
+    ExecutableInfo readExecutableInfo(uint32_t& flags, CodeType expectedCodeType);
+    bool readCodeBlock(UnlinkedCodeBlock*, uint32_t flags);
+    bool readSymbolTable(SharedSymbolTable*);
+    UnlinkedFunctionExecutable* readFunctionExecutable();
+    unsigned readFunctionBodyOffset();
+
+    VM& m_vm;
+    BytecodeCacheFile* m_file;
+    size_t m_cursor;
+    size_t m_end;
+    bool m_failed;
+};
+
+String BytecodeCacheReader::readString()
+{
+    uint32_t length = read32();
+    if (m_failed || length == nullStringLength)
+        return String();
+    const uint8_t* is8Bit = readBytes(1);
+    if (!is8Bit)
+        return String();
+    if (*is8Bit) {
+        const uint8_t* characters = readBytes(length);
+        return characters ? String(characters, length) : String();
+    }
+    if (length > (m_end - m_cursor) / sizeof(UChar)) {
+        m_failed = true;
+        return String();
+    }
+    const uint8_t* characters = readBytes(length * sizeof(UChar));
+    if (!characters)
+        return String();
+    UChar* buffer;
+    RefPtr<StringImpl> result = StringImpl::createUninitialized(length, buffer);
+    memcpy(buffer, characters, length * sizeof(UChar));
+    return result.release();
+}
+
+Identifier BytecodeCacheReader::readIdentifier()
+{
+    String string = readString();
+    if (string.isNull())
+        return Identifier();
+    return Identifier(&m_vm, string);
+}
+
+JSValue BytecodeCacheReader::readValue(UnlinkedCodeBlock* constantRegisterOwner)
+{
+    switch (read32()) {
+    case EmptyValueTag:
+        return JSValue();
+    case UndefinedValueTag:
+        return jsUndefined();
+    case NullValueTag:
+        return jsNull();
+    case TrueValueTag:
+        return jsBoolean(true);
+    case FalseValueTag:
+        return jsBoolean(false);
+    case Int32ValueTag:
+        return jsNumber(readInt32());
+    case DoubleValueTag:
+        return JSValue(JSValue::EncodeAsDouble, bitwise_cast<double>(read64()));
+    case StringValueTag: {
+        String string = readString();
+        if (m_failed || string.isNull())
+            break;
+        return jsString(&m_vm, Identifier(&m_vm, string).string());
+    }
+    case ConstantRegisterValueTag: {
+        uint32_t index = read32();
+        if (!constantRegisterOwner || index >= constantRegisterOwner->numberOfConstantRegisters())
+            break;
+        return constantRegisterOwner->constantRegisters()[index].get();
+    }
+    default:
+        break;
+    }
+    m_failed = true;
+    return JSValue();
+}
+
+bool BytecodeCacheReader::readSymbolTable(SharedSymbolTable* symbolTable)
+{
+    symbolTable->setUsesNonStrictEval(read32());
+    symbolTable->setCaptureStart(readInt32());
+    symbolTable->setCaptureEnd(readInt32());
+    int parameterCountIncludingThis = readInt32();
+    if (m_failed || parameterCountIncludingThis < 1)
+        return false;
+    symbolTable->setParameterCountIncludingThis(parameterCountIncludingThis);
+
+    if (read32()) {
+        int parameterCount = parameterCountIncludingThis - 1;
+        if (static_cast<size_t>(parameterCount) > (m_end - m_cursor) / (2 * sizeof(uint32_t)))
+            return false;
+        OwnArrayPtr<SlowArgument> slowArguments = adoptArrayPtr(new SlowArgument[parameterCount]);
+        for (int i = 0; i < parameterCount; ++i) {
+            uint32_t status = read32();
+            if (status > SlowArgument::Deleted)
+                return false;
+            slowArguments[i].status = static_cast<SlowArgument::Status>(status);
+            slowArguments[i].index = readInt32();
+        }
+        symbolTable->setSlowArguments(slowArguments.release());
+    }
+
+    uint32_t count = readCount(3 * sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; ++i) {
+        Identifier name = readIdentifier();
+        int index = readInt32();
+        unsigned attributes = read32();
+        if (m_failed || name.isNull())
+            return false;
+        symbolTable->add(name.impl(), SymbolTableEntry(index, attributes));
+    }
+    return !m_failed;
+}
+
+ExecutableInfo BytecodeCacheReader::readExecutableInfo(uint32_t& flags, CodeType expectedCodeType)
+{
+    flags = read32();
+    if (read32() != static_cast<uint32_t>(expectedCodeType))
+        m_failed = true;
+    return ExecutableInfo(flags & NeedsFullScopeChainFlag, flags & UsesEvalFlag, flags & IsStrictModeFlag, flags & IsConstructorFlag);
+}
+
+bool BytecodeCacheReader::readCodeBlock(UnlinkedCodeBlock* codeBlock, uint32_t flags)
+{
+    codeBlock->setIsNumericCompareFunction(flags & IsNumericCompareFunctionFlag);
+
+    codeBlock->m_numVars = readInt32();
+    codeBlock->m_numCapturedVars = readInt32();
+    codeBlock->m_numCalleeRegisters = readInt32();
+    codeBlock->setNumParameters(readInt32());
+    codeBlock->setThisRegister(readInt32());
+    codeBlock->setArgumentsRegister(readInt32());
+    codeBlock->setActivationRegister(readInt32());
+    codeBlock->setGlobalObjectRegister(readInt32());
+    unsigned firstLine = read32();
+    unsigned lineCount = read32();
+    CodeFeatures features = read32();
+    codeBlock->recordParse(features, flags & HasCapturedVariablesFlag, firstLine, lineCount);
+
+    codeBlock->m_resolveOperationCount = read32();
+    codeBlock->m_putToBaseOperationCount = read32();
+    codeBlock->m_arrayProfileCount = read32();
+    codeBlock->m_arrayAllocationProfileCount = read32();
+    codeBlock->m_objectAllocationProfileCount = read32();
+    codeBlock->m_valueProfileCount = read32();
+    codeBlock->m_llintCallLinkInfoCount = read32();
+
+    uint32_t instructionCount = readCount(sizeof(uint32_t));
+    if (m_failed || !instructionCount)
+        return false;
+    RefCountedArray<UnlinkedInstruction> instructions(instructionCount);
+    for (uint32_t i = 0; i < instructionCount;) {
+        uint32_t opcodeID = read32();
+        if (m_failed || opcodeID >= static_cast<uint32_t>(numOpcodeIDs))
+            return false;
+        unsigned length = opcodeLengths[opcodeID];
+        if (length > instructionCount - i)
+            return false;
+        instructions[i] = UnlinkedInstruction(static_cast<OpcodeID>(opcodeID));
+        for (unsigned j = 1; j < length; ++j)
+            instructions[i + j] = UnlinkedInstruction(readInt32());
+        i += length;
+    }
+    codeBlock->m_unlinkedInstructions = instructions;
+
+    uint32_t count = readCount(sizeof(uint32_t));
+    codeBlock->m_jumpTargets.reserveInitialCapacity(count);
+    for (uint32_t i = 0; i < count; ++i)
+        codeBlock->addJumpTarget(read32());
+
+    count = readCount(sizeof(uint32_t));
+    codeBlock->m_propertyAccessInstructions.reserveInitialCapacity(count);
+    for (uint32_t i = 0; i < count; ++i)
+        codeBlock->addPropertyAccessInstruction(read32());
+
+    count = readCount(sizeof(uint32_t));
+    codeBlock->m_identifiers.reserveInitialCapacity(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        Identifier identifier = readIdentifier();
+        if (m_failed || identifier.isNull())
+            return false;
+        codeBlock->addIdentifier(identifier);
+    }
+
+    count = readCount(sizeof(uint32_t));
+    codeBlock->m_constantRegisters.reserveInitialCapacity(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        JSValue value = readValue();
+        if (m_failed)
+            return false;
+        codeBlock->addConstant(value);
+    }
+
+    count = readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; ++i) {
+        UnlinkedFunctionExecutable* executable = readFunctionExecutable();
+        if (!executable)
+            return false;
+        codeBlock->addFunctionDecl(executable);
+    }
+
+    count = readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; ++i) {
+        UnlinkedFunctionExecutable* executable = readFunctionExecutable();
+        if (!executable)
+            return false;
+        codeBlock->addFunctionExpr(executable);
+    }
+
+    if (flags & HasSymbolTableFlag) {
+        if (!codeBlock->symbolTable() || !readSymbolTable(codeBlock->symbolTable()))
+            return false;
+    }
+
+    count = readCount(3 * sizeof(uint32_t));
+    codeBlock->m_expressionInfo.reserveInitialCapacity(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t words[3] = { read32(), read32(), read32() };
+        ExpressionRangeInfo info;
+        info.instructionOffset = words[0] & ((1 << 25) - 1);
+        info.startOffset = words[0] >> 25;
+        info.divotPoint = words[1] & ((1 << 25) - 1);
+        info.endOffset = words[1] >> 25;
+        info.mode = words[2] & 3;
+        info.position = words[2] >> 2;
+        codeBlock->m_expressionInfo.append(info);
+    }
+
+    if (!(flags & HasRareDataFlag))
+        return !m_failed;
+
+    codeBlock->createRareDataIfNecessary();
+    UnlinkedCodeBlock::RareData* rareData = codeBlock->m_rareData.get();
+
+    count = readCount(4 * sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; ++i) {
+        UnlinkedHandlerInfo handler;
+        handler.start = read32();
+        handler.end = read32();
+        handler.target = read32();
+        handler.scopeDepth = read32();
+        codeBlock->addExceptionHandler(handler);
+    }
+
+    count = readCount(2 * sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; ++i) {
+        String pattern = readString();
+        uint32_t regExpFlags = read32();
+        if (m_failed || pattern.isNull() || regExpFlags >= InvalidFlags)
+            return false;
+        codeBlock->addRegExp(RegExp::create(m_vm, pattern, static_cast<RegExpFlags>(regExpFlags)));
+    }
+
+    count = readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t length = readCount(sizeof(uint32_t));
+        if (m_failed)
+            return false;
+        unsigned index = codeBlock->addConstantBuffer(length);
+        UnlinkedCodeBlock::ConstantBuffer& buffer = codeBlock->constantBuffer(index);
+        for (uint32_t j = 0; j < length; ++j)
+            buffer[j] = readValue(codeBlock);
+    }
+
+    Vector<UnlinkedSimpleJumpTable>* simpleJumpTables[] = { &rareData->m_immediateSwitchJumpTables, &rareData->m_characterSwitchJumpTables };
+    for (size_t kind = 0; kind < WTF_ARRAY_LENGTH(simpleJumpTables); ++kind) {
+        count = readCount(2 * sizeof(uint32_t));
+        for (uint32_t i = 0; i < count; ++i) {
+            simpleJumpTables[kind]->append(UnlinkedSimpleJumpTable());
+            UnlinkedSimpleJumpTable& jumpTable = simpleJumpTables[kind]->last();
+            jumpTable.min = readInt32();
+            uint32_t length = readCount(sizeof(uint32_t));
+            jumpTable.branchOffsets.reserveInitialCapacity(length);
+            for (uint32_t j = 0; j < length; ++j)
+                jumpTable.branchOffsets.uncheckedAppend(readInt32());
+        }
+    }
+
+    count = readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; ++i) {
+        UnlinkedStringJumpTable& jumpTable = codeBlock->addStringSwitchJumpTable();
+        uint32_t length = readCount(2 * sizeof(uint32_t));
+        for (uint32_t j = 0; j < length; ++j) {
+            Identifier key = readIdentifier();
+            int32_t offset = readInt32();
+            if (m_failed || key.isNull())
+                return false;
+            jumpTable.offsetTable.add(key.impl(), offset);
+        }
+    }
+
+    count = readCount(2 * sizeof(uint32_t));
+    rareData->m_expressionInfoFatPositions.reserveInitialCapacity(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        ExpressionRangeInfo::FatPosition position;
+        position.line = read32();
+        position.column = read32();
+        rareData->m_expressionInfoFatPositions.uncheckedAppend(position);
+    }
+
+    return !m_failed;
+}
+
+unsigned BytecodeCacheReader::readFunctionBodyOffset()
+{
+    size_t offset = m_cursor;
+    uint32_t length = read32();
+    if (!length || !readBytes(length))
+        return 0;
+    return offset;
+}
+
+UnlinkedFunctionExecutable* BytecodeCacheReader::readFunctionExecutable()
+{
+    Identifier name = readIdentifier();
+    Identifier inferredName = readIdentifier();
+    uint32_t parameterCount = readCount(sizeof(uint32_t));
+    Vector<Identifier> parameters;
+    parameters.reserveInitialCapacity(parameterCount);
+    for (uint32_t i = 0; i < parameterCount; ++i) {
+        Identifier parameter = readIdentifier();
+        if (m_failed || parameter.isNull())
+            return 0;
+        parameters.uncheckedAppend(parameter);
+    }
+    if (m_failed)
+        return 0;
+
+    UnlinkedFunctionExecutable* executable = new (NotNull, allocateCell<UnlinkedFunctionExecutable>(m_vm.heap)) UnlinkedFunctionExecutable(&m_vm, m_vm.unlinkedFunctionExecutableStructure.get());
+    executable->m_name = name;
+    executable->m_inferredName = inferredName;
+    executable->m_parameters = FunctionParameters::create(parameters);
+
+    uint32_t flags = read32();
+    executable->m_forceUsesArguments = flags & ForceUsesArgumentsFlag;
+    executable->m_isInStrictContext = flags & IsInStrictContextFlag;
+    executable->m_hasCapturedVariables = flags & FunctionHasCapturedVariablesFlag;
+    executable->m_numCapturedVariables = read32();
+    executable->m_firstLineOffset = read32();
+    executable->m_lineCount = read32();
+    executable->m_functionStartOffset = read32();
+    executable->m_functionStartColumn = read32();
+    executable->m_startOffset = read32();
+    executable->m_sourceLength = read32();
+    executable->m_features = read32();
+    executable->m_functionNameIsInScopeToggle = read32() == FunctionNameIsInScope ? FunctionNameIsInScope : FunctionNameIsNotInScope;
+    executable->finishCreation(m_vm);
+
+    executable->m_cachedCodeBlockForCallOffset = readFunctionBodyOffset();
+    executable->m_cachedCodeBlockForConstructOffset = readFunctionBodyOffset();
+    if (m_failed)
+        return 0;
+    if (executable->m_cachedCodeBlockForCallOffset || executable->m_cachedCodeBlockForConstructOffset)
+        executable->m_bytecodeCacheFile = m_file;
+    return executable;
+}
+
+UnlinkedFunctionCodeBlock* BytecodeCacheReader::readFunctionBody()
+{
+    uint32_t length = read32();
+    if (m_failed || length > m_end - m_cursor)
+        return 0;
+    m_end = m_cursor + length;
+
+    uint32_t flags;
+    ExecutableInfo info = readExecutableInfo(flags, FunctionCode);
+    if (m_failed)
+        return 0;
+    UnlinkedFunctionCodeBlock* codeBlock = UnlinkedFunctionCodeBlock::create(&m_vm, FunctionCode, info);
+    if (!readCodeBlock(codeBlock, flags) || !atEnd())
+        return 0;
+    return codeBlock;
+}
+
+UnlinkedProgramCodeBlock* BytecodeCacheReader::readProgramCodeBlock()
+{
+    uint32_t flags;
+    ExecutableInfo info = readExecutableInfo(flags, GlobalCode);
+    if (m_failed)
+        return 0;
+    UnlinkedProgramCodeBlock* codeBlock = UnlinkedProgramCodeBlock::create(&m_vm, info);
+    if (!readCodeBlock(codeBlock, flags))
+        return 0;
+
+    uint32_t count = readCount(2 * sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; ++i) {
+        Identifier name = readIdentifier();
+        bool isConstant = read32();
+        if (m_failed || name.isNull())
+            return 0;
+        codeBlock->addVariableDeclaration(name, isConstant);
+    }
+
+    count = readCount(2 * sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; ++i) {
+        Identifier name = readIdentifier();
+        if (m_failed || name.isNull())
+            return 0;
+        UnlinkedFunctionExecutable* executable = readFunctionExecutable();
+        if (!executable)
+            return 0;
+        codeBlock->addFunctionDeclaration(m_vm, name, executable);
+    }
+
+    return m_failed ? 0 : codeBlock;
+}
+
+BytecodeCacheFile::BytecodeCacheFile()
+    : m_data(0)
+    , m_size(0)
+    , m_isMapped(false)
+{
+}
+
+BytecodeCacheFile::~BytecodeCacheFile()
+{
+#if OS(UNIX)
+    if (m_isMapped)
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+}
+
+PassRefPtr<BytecodeCacheFile> BytecodeCacheFile::open(const String& path)
+{
+    RefPtr<BytecodeCacheFile> result = adoptRef(new BytecodeCacheFile);
+    CString fileName = path.utf8();
+
+#if OS(UNIX)
+    int fd = ::open(fileName.data(), O_RDONLY);
+    if (fd == -1)
+        return 0;
+    struct stat status;
+    if (fstat(fd, &status) || status.st_size <= 0 || static_cast<uint64_t>(status.st_size) > std::numeric_limits<uint32_t>::max()) {
+        close(fd);
+        return 0;
+    }
+    void* data = mmap(0, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return 0;
+    result->m_data = static_cast<const uint8_t*>(data);
+    result->m_size = status.st_size;
+    result->m_isMapped = true;
+#else
+    FILE* file = fopen(fileName.data(), "rb");
+    if (!file)
+        return 0;
+    uint8_t buffer[4096];
+    while (size_t size = fread(buffer, 1, sizeof(buffer), file))
+        result->m_buffer.append(buffer, size);
+    fclose(file);
+    if (result->m_buffer.isEmpty() || result->m_buffer.size() > std::numeric_limits<uint32_t>::max())
+        return 0;
+    result->m_data = result->m_buffer.data();
+    result->m_size = result->m_buffer.size();
+#endif
+
+    return result.release();
+}
+
+UnlinkedFunctionCodeBlock* BytecodeCacheFile::readFunctionCodeBlock(VM& vm, unsigned offset)
+{
+    BytecodeCacheReader reader(vm, this, offset, m_size);
+    return reader.readFunctionBody();
+}
+
+BytecodeCache::Entry::Entry(UnlinkedProgramCodeBlock* codeBlock, unsigned sourceLength, JSParserStrictness strictness, const Vector<uint8_t, 20>& sourceDigest, bool wasLoaded)
+    : codeBlock(codeBlock)
+    , sourceLength(sourceLength)
+    , strictness(strictness)
+    , sourceDigest(sourceDigest)
+    , wasLoaded(wasLoaded)
+{
+}
+
+BytecodeCache::BytecodeCache(const String& directory)
+    : m_directory(directory)
+{
+}
+
+BytecodeCache::~BytecodeCache()
+{
+}
+
+PassOwnPtr<BytecodeCache> BytecodeCache::create(const String& directory)
+{
+    return adoptPtr(new BytecodeCache(directory));
+}
+
+String BytecodeCache::pathFor(const Vector<uint8_t, 20>& sourceDigest, JSParserStrictness strictness) const
+{
+    StringBuilder builder;
+    builder.append(m_directory);
+    builder.append('/');
+    builder.append(SHA1::hexDigest(sourceDigest).data());
+    if (strictness == JSParseStrict)
+        builder.appendLiteral("-strict");
+    builder.appendLiteral(".jsbc");
+    return builder.toString();
+}
+
+bool BytecodeCache::shouldCache(const SourceCode& source) const
+{
+    // Small programs are quicker to parse than to look up, and tend to be generated.
+    return !m_directory.isEmpty() && static_cast<unsigned>(source.length()) >= Options::minimumBytecodeCacheSourceLength();
+}
+
+static void computeSourceDigest(const SourceCode& source, Vector<uint8_t, 20>& digest)
+{
+    // Programs almost always span their whole provider, whose digest is cached.
+    SourceProvider* provider = source.provider();
+    if (!source.startOffset() && static_cast<unsigned>(source.endOffset()) == provider->source().length()) {
+        digest = provider->sourceDigest();
+        return;
+    }
+    computeSourceDigest(source.toString(), digest);
+}
+
+UnlinkedProgramCodeBlock* BytecodeCache::programCodeBlock(VM& vm, const SourceCode& source, JSParserStrictness strictness)
+{
+    if (!shouldCache(source))
+        return 0;
+
+    Vector<uint8_t, 20> sourceDigest;
+    computeSourceDigest(source, sourceDigest);
+    String path = pathFor(sourceDigest, strictness);
+
+    RefPtr<BytecodeCacheFile> file = BytecodeCacheFile::open(path);
+    if (!file)
+        return 0;
+
+    BytecodeCacheReader reader(vm, file.get(), 0, file->size());
+    if (!reader.readHeader(source.length(), strictness, sourceDigest))
+        return 0;
+    UnlinkedProgramCodeBlock* codeBlock = reader.readProgramCodeBlock();
+    if (!codeBlock || !reader.atEnd())
+        return 0;
+
+    if (static_cast<unsigned>(m_pendingEntries.size()) >= maximumNumberOfPendingEntries)
+        flush();
+    m_pendingEntries.set(path, adoptPtr(new Entry(codeBlock, source.length(), strictness, sourceDigest, true)));
+    return codeBlock;
+}
+
+void BytecodeCache::addProgramCodeBlock(const SourceCode& source, JSParserStrictness strictness, UnlinkedProgramCodeBlock* codeBlock)
+{
+    if (!shouldCache(source))
+        return;
+
+    Vector<uint8_t, 20> sourceDigest;
+    computeSourceDigest(source, sourceDigest);
+
+    if (static_cast<unsigned>(m_pendingEntries.size()) >= maximumNumberOfPendingEntries)
+        flush();
+    m_pendingEntries.set(pathFor(sourceDigest, strictness), adoptPtr(new Entry(codeBlock, source.length(), strictness, sourceDigest, false)));
+}
+
+void BytecodeCache::flush()
+{
+    HashMap<String, OwnPtr<Entry> >::iterator end = m_pendingEntries.end();
+    for (HashMap<String, OwnPtr<Entry> >::iterator iter = m_pendingEntries.begin(); iter != end; ++iter)
+        write(iter->key, *iter->value);
+    m_pendingEntries.clear();
+}
+
+void BytecodeCache::write(const String& path, Entry& entry)
+{
+    UnlinkedProgramCodeBlock* codeBlock = entry.codeBlock.get();
+    if (!codeBlock)
+        return;
+
+    BytecodeCacheWriter writer;
+    writer.writeHeader(entry.sourceLength, entry.strictness, entry.sourceDigest);
+    writer.writeProgramCodeBlock(codeBlock);
+    if (writer.failed())
+        return;
+
+    // Nothing has been compiled that the file on disk does not already have.
+    if (entry.wasLoaded && !writer.numberOfNewFunctionBodies())
+        return;
+
+    // Write to a private file and rename it into place, so that readers, including
+    // our own mappings of the previous version, never see a partial file.
+    CString fileName = path.utf8();
+    StringBuilder temporaryPathBuilder;
+    temporaryPathBuilder.append(path);
+    temporaryPathBuilder.appendLiteral(".tmp");
+    temporaryPathBuilder.appendNumber(getCurrentProcessID());
+    CString temporaryFileName = temporaryPathBuilder.toString().utf8();
+
+    FILE* file = fopen(temporaryFileName.data(), "wb");
+    if (!file)
+        return;
+    const Vector<uint8_t>& buffer = writer.buffer();
+    bool succeeded = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    succeeded = !fclose(file) && succeeded;
+    if (succeeded && !rename(temporaryFileName.data(), fileName.data()))
+        return;
+    remove(temporaryFileName.data());
+}
+
+} // namespace JSC
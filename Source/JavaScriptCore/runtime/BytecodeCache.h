@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BytecodeCache_h
+#define BytecodeCache_h
+
+#include "ParserModes.h"
+#include "Weak.h"
+#include <wtf/Forward.h>
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/RefCounted.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class SourceCode;
+class UnlinkedFunctionCodeBlock;
+class UnlinkedProgramCodeBlock;
+class VM;
+
+// A read-only view of one cache file. On POSIX systems the file is mapped rather
+// than read, so the function bodies that are never called never get paged in.
+// UnlinkedFunctionExecutables that were loaded from a file keep it alive and
+// decode their code blocks from it the first time they are linked.
+class BytecodeCacheFile : public RefCounted<BytecodeCacheFile> {
+public:
+    static PassRefPtr<BytecodeCacheFile> open(const String& path);
+    ~BytecodeCacheFile();
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+    // Decodes the function body that an UnlinkedFunctionExecutable recorded at the
+    // given offset while it was being read. Returns 0 if the body is malformed.
+    UnlinkedFunctionCodeBlock* readFunctionCodeBlock(VM&, unsigned offset);
+
+private:
+    BytecodeCacheFile();
+
+    const uint8_t* m_data;
+    size_t m_size;
+    bool m_isMapped;
+    Vector<uint8_t> m_buffer;
+};
+
+// Persists UnlinkedProgramCodeBlocks, together with whatever function code blocks
+// have been generated for them, in a directory of files keyed by a digest of the
+// program source. Programs are written out when the cache is flushed, which the
+// VM does before it is destroyed, so a later process that evaluates the same
+// source can skip parsing and bytecode generation.
+class BytecodeCache {
+    WTF_MAKE_NONCOPYABLE(BytecodeCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static PassOwnPtr<BytecodeCache> create(const String& directory);
+    ~BytecodeCache();
+
+    UnlinkedProgramCodeBlock* programCodeBlock(VM&, const SourceCode&, JSParserStrictness);
+    void addProgramCodeBlock(const SourceCode&, JSParserStrictness, UnlinkedProgramCodeBlock*);
+
+    JS_EXPORT_PRIVATE void flush();
+
+private:
+    BytecodeCache(const String& directory);
+
+    bool shouldCache(const SourceCode&) const;
+
+    struct Entry {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        Entry(UnlinkedProgramCodeBlock*, unsigned sourceLength, JSParserStrictness, const Vector<uint8_t, 20>& sourceDigest, bool wasLoaded);
+
+        Weak<UnlinkedProgramCodeBlock> codeBlock;
+        unsigned sourceLength;
+        JSParserStrictness strictness;
+        Vector<uint8_t, 20> sourceDigest;
+        bool wasLoaded;
+    };
+
+    String pathFor(const Vector<uint8_t, 20>& sourceDigest, JSParserStrictness) const;
+    void write(const String& path, Entry&);
+
+    // Bounds the number of programs we keep weak references to between flushes.
+    static const unsigned maximumNumberOfPendingEntries = 256;
+
+    String m_directory;
+    HashMap<String, OwnPtr<Entry> > m_pendingEntries;
+};
+
+} // namespace JSC
+
+#endif // BytecodeCache_h
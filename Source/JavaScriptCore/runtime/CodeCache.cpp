@@ -27,6 +27,7 @@
 
 #include "CodeCache.h"
 
+#include "BytecodeCache.h"
 #include "BytecodeGenerator.h"
 #include "CodeSpecializationKind.h"
 #include "Operations.h"
@@ -74,11 +75,27 @@ template <typename T> struct CacheTypes { };
 template <> struct CacheTypes<UnlinkedProgramCodeBlock> {
     typedef JSC::ProgramNode RootNode;
     static const SourceCodeKey::CodeType codeType = SourceCodeKey::ProgramType;
+
+    static UnlinkedProgramCodeBlock* loadFromBytecodeCache(VM& vm, const SourceCode& source, JSParserStrictness strictness)
+    {
+        BytecodeCache* bytecodeCache = vm.bytecodeCache();
+        return bytecodeCache ? bytecodeCache->programCodeBlock(vm, source, strictness) : 0;
+    }
+
+    static void addToBytecodeCache(VM& vm, const SourceCode& source, JSParserStrictness strictness, UnlinkedProgramCodeBlock* unlinkedCode)
+    {
+        if (BytecodeCache* bytecodeCache = vm.bytecodeCache())
+            bytecodeCache->addProgramCodeBlock(source, strictness, unlinkedCode);
+    }
 };
 
 template <> struct CacheTypes<UnlinkedEvalCodeBlock> {
     typedef JSC::EvalNode RootNode;
     static const SourceCodeKey::CodeType codeType = SourceCodeKey::EvalType;
+
+    // Eval code is usually small and generated at run time, so it does not go to disk.
+    static UnlinkedEvalCodeBlock* loadFromBytecodeCache(VM&, const SourceCode&, JSParserStrictness) { return 0; }
+    static void addToBytecodeCache(VM&, const SourceCode&, JSParserStrictness, UnlinkedEvalCodeBlock*) { }
 };
 
 template <class UnlinkedCodeBlockType, class ExecutableType>
@@ -113,20 +130,31 @@ UnlinkedCodeBlockType* CodeCache::getCodeBlock(VM& vm, JSScope* scope, Executabl
     CodeCacheMap::AddResult addResult = m_sourceCode.add(key, SourceCodeValue());
     bool canCache = debuggerMode == DebuggerOff && profilerMode == ProfilerOff;
 
-    if (!addResult.isNewEntry && canCache) {
-        UnlinkedCodeBlockType* unlinkedCode = jsCast<UnlinkedCodeBlockType*>(addResult.iterator->value.cell.get());
+    UnlinkedCodeBlockType* unlinkedCode = 0;
+    if (canCache) {
+        if (!addResult.isNewEntry)
+            unlinkedCode = jsCast<UnlinkedCodeBlockType*>(addResult.iterator->value.cell.get());
+        else
+            unlinkedCode = CacheTypes<UnlinkedCodeBlockType>::loadFromBytecodeCache(vm, source, strictness);
+    }
+
+    if (unlinkedCode) {
         unsigned firstLine = source.firstLine() + unlinkedCode->firstLine();
         unsigned startColumn = source.firstLine() ? source.startColumn() : 0;
         executable->recordParse(unlinkedCode->codeFeatures(), unlinkedCode->hasCapturedVariables(), firstLine, firstLine + unlinkedCode->lineCount(), startColumn);
+        if (addResult.isNewEntry)
+            addResult.iterator->value = SourceCodeValue(vm, unlinkedCode, m_sourceCode.age());
         return unlinkedCode;
     }
-    UnlinkedCodeBlockType* unlinkedCode = generateBytecode<UnlinkedCodeBlockType, ExecutableType>(vm, scope, executable, source, strictness, debuggerMode, profilerMode, error);
+
+    unlinkedCode = generateBytecode<UnlinkedCodeBlockType, ExecutableType>(vm, scope, executable, source, strictness, debuggerMode, profilerMode, error);
 
     if (!canCache || !unlinkedCode) {
         m_sourceCode.remove(addResult.iterator);
         return unlinkedCode;
     }
 
+    CacheTypes<UnlinkedCodeBlockType>::addToBytecodeCache(vm, source, strictness, unlinkedCode);
     addResult.iterator->value = SourceCodeValue(vm, unlinkedCode, m_sourceCode.age());
     return unlinkedCode;
 }
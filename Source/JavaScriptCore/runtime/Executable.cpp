@@ -30,6 +30,7 @@
 #include "BytecodeGenerator.h"
 #include "CodeBlock.h"
 #include "DFGDriver.h"
+#include "DFGWorklist.h"
 #include "ExecutionHarness.h"
 #include "JIT.h"
 #include "JITDriver.h"
@@ -40,6 +41,17 @@
 
 namespace JSC {
 
+static void cancelPendingOptimizedCompilations(ScriptExecutable* executable)
+{
+#if ENABLE(DFG_JIT)
+    // Any plan still in flight was built from a CodeBlock we are about to delete.
+    if (DFG::Worklist* worklist = Heap::heap(executable)->vm()->dfgWorklist())
+        worklist->cancelPlansFor(executable);
+#else
+    UNUSED_PARAM(executable);
+#endif
+}
+
 const ClassInfo ExecutableBase::s_info = { "Executable", 0, 0, 0, CREATE_METHOD_TABLE(ExecutableBase) };
 
 #if ENABLE(JIT)
@@ -173,6 +185,15 @@ bool EvalExecutable::jitCompile(ExecState* exec)
 {
     return jitCompileIfAppropriate(exec, m_evalCodeBlock, m_jitCodeForCall, JITCode::bottomTierJIT(), UINT_MAX, JITCompilationCanFail);
 }
+
+bool EvalExecutable::installOptimizedCode(CodeBlock* profiledBlock, PassOwnPtr<CodeBlock> replacement, const JITCode& jitCode)
+{
+    if (!installOptimizedCodeBlock(m_evalCodeBlock, static_pointer_cast<EvalCodeBlock>(replacement), profiledBlock, jitCode, MacroAssemblerCodePtr()))
+        return false;
+    m_jitCodeForCall = jitCode;
+    Heap::heap(this)->reportExtraMemoryCost(sizeof(*m_evalCodeBlock) + m_jitCodeForCall.size());
+    return true;
+}
 #endif
 
 inline const char* samplingDescription(JITCode::JITType jitType)
@@ -271,6 +292,7 @@ void EvalExecutable::unlinkCalls()
 
 void EvalExecutable::clearCode()
 {
+    cancelPendingOptimizedCompilations(this);
     m_evalCodeBlock.clear();
     m_unlinkedEvalCodeBlock.clear();
     Base::clearCode();
@@ -304,6 +326,15 @@ bool ProgramExecutable::jitCompile(ExecState* exec)
 {
     return jitCompileIfAppropriate(exec, m_programCodeBlock, m_jitCodeForCall, JITCode::bottomTierJIT(), UINT_MAX, JITCompilationCanFail);
 }
+
+bool ProgramExecutable::installOptimizedCode(CodeBlock* profiledBlock, PassOwnPtr<CodeBlock> replacement, const JITCode& jitCode)
+{
+    if (!installOptimizedCodeBlock(m_programCodeBlock, static_pointer_cast<ProgramCodeBlock>(replacement), profiledBlock, jitCode, MacroAssemblerCodePtr()))
+        return false;
+    m_jitCodeForCall = jitCode;
+    Heap::heap(this)->reportExtraMemoryCost(sizeof(*m_programCodeBlock) + m_jitCodeForCall.size());
+    return true;
+}
 #endif
 
 JSObject* ProgramExecutable::compileInternal(ExecState* exec, JSScope* scope, JITCode::JITType jitType, unsigned bytecodeIndex)
@@ -433,6 +464,7 @@ void ProgramExecutable::visitChildren(JSCell* cell, SlotVisitor& visitor)
 
 void ProgramExecutable::clearCode()
 {
+    cancelPendingOptimizedCompilations(this);
     m_programCodeBlock.clear();
     m_unlinkedProgramCodeBlock.clear();
     Base::clearCode();
@@ -488,6 +520,26 @@ bool FunctionExecutable::jitCompileForConstruct(ExecState* exec)
 {
     return jitCompileFunctionIfAppropriate(exec, m_codeBlockForConstruct, m_jitCodeForConstruct, m_jitCodeForConstructWithArityCheck, JITCode::bottomTierJIT(), UINT_MAX, JITCompilationCanFail);
 }
+
+bool FunctionExecutable::installOptimizedCodeFor(CodeSpecializationKind kind, CodeBlock* profiledBlock, PassOwnPtr<CodeBlock> replacement, const JITCode& jitCode, MacroAssemblerCodePtr jitCodeWithArityCheck)
+{
+    if (kind == CodeForCall) {
+        if (!installOptimizedCodeBlock(m_codeBlockForCall, static_pointer_cast<FunctionCodeBlock>(replacement), profiledBlock, jitCode, jitCodeWithArityCheck))
+            return false;
+        m_jitCodeForCall = jitCode;
+        m_jitCodeForCallWithArityCheck = jitCodeWithArityCheck;
+        Heap::heap(this)->reportExtraMemoryCost(sizeof(*m_codeBlockForCall) + m_jitCodeForCall.size());
+        return true;
+    }
+
+    ASSERT(kind == CodeForConstruct);
+    if (!installOptimizedCodeBlock(m_codeBlockForConstruct, static_pointer_cast<FunctionCodeBlock>(replacement), profiledBlock, jitCode, jitCodeWithArityCheck))
+        return false;
+    m_jitCodeForConstruct = jitCode;
+    m_jitCodeForConstructWithArityCheck = jitCodeWithArityCheck;
+    Heap::heap(this)->reportExtraMemoryCost(sizeof(*m_codeBlockForConstruct) + m_jitCodeForConstruct.size());
+    return true;
+}
 #endif
 
 PassOwnPtr<FunctionCodeBlock> FunctionExecutable::produceCodeBlockFor(JSScope* scope, CodeSpecializationKind specializationKind, JSObject*& exception)
@@ -627,6 +679,18 @@ void FunctionExecutable::clearCodeIfNotCompiling()
     clearCode();
 }
 
+unsigned FunctionExecutable::updateCodeAge()
+{
+    if (!m_codeBlockForCall && !m_codeBlockForConstruct)
+        return 0;
+    unsigned age = std::numeric_limits<unsigned>::max();
+    if (m_codeBlockForCall)
+        age = m_codeBlockForCall->updateCodeAge();
+    if (m_codeBlockForConstruct)
+        age = std::min(age, m_codeBlockForConstruct->updateCodeAge());
+    return age;
+}
+
 void FunctionExecutable::clearUnlinkedCodeForRecompilationIfNotCompiling()
 {
     if (isCompiling())
@@ -636,6 +700,7 @@ void FunctionExecutable::clearUnlinkedCodeForRecompilationIfNotCompiling()
 
 void FunctionExecutable::clearCode()
 {
+    cancelPendingOptimizedCompilations(this);
     m_codeBlockForCall.clear();
     m_codeBlockForConstruct.clear();
     Base::clearCode();
@@ -453,8 +453,14 @@ namespace JSC {
 #if ENABLE(JIT)
         void jettisonOptimizedCode(VM&);
         bool jitCompile(ExecState*);
+        bool installOptimizedCode(CodeBlock* profiledBlock, PassOwnPtr<CodeBlock> replacement, const JITCode&);
 #endif
 
+        bool isGenerated() const
+        {
+            return !!m_evalCodeBlock;
+        }
+
         EvalCodeBlock& generatedBytecode()
         {
             ASSERT(m_evalCodeBlock);
@@ -531,8 +537,14 @@ namespace JSC {
 #if ENABLE(JIT)
         void jettisonOptimizedCode(VM&);
         bool jitCompile(ExecState*);
+        bool installOptimizedCode(CodeBlock* profiledBlock, PassOwnPtr<CodeBlock> replacement, const JITCode&);
 #endif
 
+        bool isGenerated() const
+        {
+            return !!m_programCodeBlock;
+        }
+
         ProgramCodeBlock& generatedBytecode()
         {
             ASSERT(m_programCodeBlock);
@@ -709,6 +721,8 @@ namespace JSC {
             ASSERT(kind == CodeForConstruct);
             return jitCompileForConstruct(exec);
         }
+
+        bool installOptimizedCodeFor(CodeSpecializationKind, CodeBlock* profiledBlock, PassOwnPtr<CodeBlock> replacement, const JITCode&, MacroAssemblerCodePtr jitCodeWithArityCheck);
 #endif
         
         bool isGeneratedFor(CodeSpecializationKind kind)
@@ -743,6 +757,10 @@ namespace JSC {
 
         void clearCodeIfNotCompiling();
         void clearUnlinkedCodeForRecompilationIfNotCompiling();
+
+        // Called by the heap at each full collection. Returns the number of full
+        // collections in a row during which none of our code has been entered.
+        unsigned updateCodeAge();
         static void visitChildren(JSCell*, SlotVisitor&);
         static Structure* createStructure(VM& vm, JSGlobalObject* globalObject, JSValue proto)
         {
@@ -38,6 +38,7 @@
 #include "JSGlobalObject.h"
 #include "JSLock.h"
 #include "LLIntData.h"
+#include "RegExpJITCodeCache.h"
 #include "WriteBarrier.h"
 #include <wtf/dtoa.h>
 #include <wtf/Threading.h>
@@ -64,6 +65,9 @@ static void initializeThreadingOnce()
 #endif
 #if ENABLE(ASSEMBLER)
     ExecutableAllocator::initializeAllocator();
+#endif
+#if ENABLE(SHARED_REGEXP_JIT_CODE)
+    RegExpJITCodeCache::initialize();
 #endif
     JSStack::initializeThreading();
 #if ENABLE(LLINT)
@@ -34,7 +34,6 @@
 #include "IndexingHeaderInlines.h"
 #include "PropertyNameArray.h"
 #include "Reject.h"
-#include <wtf/AVLTree.h>
 #include <wtf/Assertions.h>
 #include <wtf/OwnPtr.h>
 #include <Operations.h>
@@ -940,26 +939,13 @@ bool JSArray::unshiftCountWithAnyIndexingType(ExecState* exec, unsigned startInd
     }
 }
 
-static int compareNumbersForQSortWithInt32(const void* a, const void* b)
-{
-    int32_t ia = static_cast<const JSValue*>(a)->asInt32();
-    int32_t ib = static_cast<const JSValue*>(b)->asInt32();
-    return ia - ib;
-}
-
-static int compareNumbersForQSortWithDouble(const void* a, const void* b)
-{
-    double da = *static_cast<const double*>(a);
-    double db = *static_cast<const double*>(b);
-    return (da > db) - (da < db);
-}
+struct Int32LessThan {
+    bool operator()(JSValue a, JSValue b) const { return a.asInt32() < b.asInt32(); }
+};
 
-static int compareNumbersForQSort(const void* a, const void* b)
-{
-    double da = static_cast<const JSValue*>(a)->asNumber();
-    double db = static_cast<const JSValue*>(b)->asNumber();
-    return (da > db) - (da < db);
-}
+struct NumberLessThan {
+    bool operator()(JSValue a, JSValue b) const { return a.asNumber() < b.asNumber(); }
+};
 
 static int compareByStringPairForQSort(const void* a, const void* b)
 {
@@ -1008,27 +994,31 @@ void JSArray::sortNumericVector(ExecState* exec, JSValue compareFunction, CallTy
     if (!allValuesAreNumbers)
         return sort(exec, compareFunction, callType, callData);
     
-    // For numeric comparison, which is fast, qsort is faster than mergesort. We
-    // also don't require mergesort's stability, since there's no user visible
-    // side-effect from swapping the order of equal primitive values.
-    int (*compare)(const void*, const void*);
+    // The comparisons are inlined into the sort, rather than made through a function
+    // pointer as qsort would. Equal int32s are indistinguishable, so they need no
+    // stability, but 0 and -0 compare equal and are not, so for doubles we use a
+    // stable sort to get the same answer the comparator would have.
+    ASSERT(data.length() >= newRelevantLength);
     switch (indexingType) {
-    case ArrayWithInt32:
-        compare = compareNumbersForQSortWithInt32;
+    case ArrayWithInt32: {
+        JSValue* begin = reinterpret_cast<JSValue*>(data.data());
+        std::sort(begin, begin + newRelevantLength, Int32LessThan());
         break;
+    }
         
-    case ArrayWithDouble:
-        compare = compareNumbersForQSortWithDouble;
+    case ArrayWithDouble: {
         ASSERT(sizeof(WriteBarrier<Unknown>) == sizeof(double));
+        double* begin = reinterpret_cast<double*>(data.data());
+        std::stable_sort(begin, begin + newRelevantLength);
         break;
+    }
         
-    default:
-        compare = compareNumbersForQSort;
+    default: {
+        JSValue* begin = reinterpret_cast<JSValue*>(data.data());
+        std::stable_sort(begin, begin + newRelevantLength, NumberLessThan());
         break;
     }
-    ASSERT(data.length() >= newRelevantLength);
-    qsort(data.data(), newRelevantLength, sizeof(WriteBarrier<Unknown>), compare);
-    return;
+    }
 }
 
 void JSArray::sortNumeric(ExecState* exec, JSValue compareFunction, CallType callType, const CallData& callData)
@@ -1232,82 +1222,129 @@ void JSArray::sort(ExecState* exec)
     }
 }
 
-struct AVLTreeNodeForArrayCompare {
-    JSValue value;
+class ArraySortComparator {
+public:
+    ArraySortComparator(ExecState* exec, JSValue compareFunction, CallType callType, const CallData& callData)
+        : m_exec(exec)
+        , m_compareFunction(compareFunction)
+        , m_compareCallType(callType)
+        , m_compareCallData(callData)
+    {
+        if (callType == CallTypeJS)
+            m_cachedCall = adoptPtr(new CachedCall(exec, jsCast<JSFunction*>(compareFunction), 2));
+    }
+
+    // Answers whether b has to be moved ahead of a. Anything but a positive result
+    // from the compare function keeps them in order, which is what makes the sort
+    // stable.
+    bool isGreaterThan(JSValue a, JSValue b)
+    {
+        ASSERT(!a.isUndefined());
+        ASSERT(!b.isUndefined());
 
-    // Child pointers.  The high bit of gt is robbed and used as the
-    // balance factor sign.  The high bit of lt is robbed and used as
-    // the magnitude of the balance factor.
-    int32_t gt;
-    int32_t lt;
-};
+        double compareResult;
+        if (m_cachedCall) {
+            m_cachedCall->setThis(jsUndefined());
+            m_cachedCall->setArgument(0, a);
+            m_cachedCall->setArgument(1, b);
+            compareResult = m_cachedCall->call().toNumber(m_cachedCall->newCallFrame(m_exec));
+        } else {
+            MarkedArgumentBuffer arguments;
+            arguments.append(a);
+            arguments.append(b);
+            compareResult = call(m_exec, m_compareFunction, m_compareCallType, m_compareCallData, jsUndefined(), arguments).toNumber(m_exec);
+        }
+        return compareResult > 0;
+    }
 
-struct AVLTreeAbstractorForArrayCompare {
-    typedef int32_t handle; // Handle is an index into m_nodes vector.
-    typedef JSValue key;
-    typedef int32_t size;
+    bool hadException() const { return m_exec->hadException(); }
 
-    Vector<AVLTreeNodeForArrayCompare, 0, UnsafeVectorOverflow> m_nodes;
+private:
     ExecState* m_exec;
     JSValue m_compareFunction;
     CallType m_compareCallType;
-    const CallData* m_compareCallData;
+    const CallData& m_compareCallData;
     OwnPtr<CachedCall> m_cachedCall;
+};
 
-    handle get_less(handle h) { return m_nodes[h].lt & 0x7FFFFFFF; }
-    void set_less(handle h, handle lh) { m_nodes[h].lt &= 0x80000000; m_nodes[h].lt |= lh; }
-    handle get_greater(handle h) { return m_nodes[h].gt & 0x7FFFFFFF; }
-    void set_greater(handle h, handle gh) { m_nodes[h].gt &= 0x80000000; m_nodes[h].gt |= gh; }
+// Runs that are shorter than this are put in order by insertion sort before we
+// start merging, which saves both comparisons and passes over the data.
+static const size_t arraySortMinimumRunLength = 8;
 
-    int get_balance_factor(handle h)
-    {
-        if (m_nodes[h].gt & 0x80000000)
-            return -1;
-        return static_cast<unsigned>(m_nodes[h].lt) >> 31;
+// Merges source[left, middle) and source[middle, right) into destination.
+static bool mergeSortedRuns(const JSValue* values, const unsigned* source, unsigned* destination, size_t left, size_t middle, size_t right, ArraySortComparator& comparator)
+{
+    size_t i = left;
+    size_t j = middle;
+    size_t k = left;
+
+    // Already sorted data is common enough to be worth one comparison per merge.
+    if (j < right) {
+        bool isGreaterThan = comparator.isGreaterThan(values[source[j - 1]], values[source[j]]);
+        if (comparator.hadException())
+            return false;
+        if (isGreaterThan) {
+            while (i < middle && j < right) {
+                isGreaterThan = comparator.isGreaterThan(values[source[i]], values[source[j]]);
+                if (comparator.hadException())
+                    return false;
+                destination[k++] = isGreaterThan ? source[j++] : source[i++];
+            }
+        }
     }
 
-    void set_balance_factor(handle h, int bf)
-    {
-        if (bf == 0) {
-            m_nodes[h].lt &= 0x7FFFFFFF;
-            m_nodes[h].gt &= 0x7FFFFFFF;
-        } else {
-            m_nodes[h].lt |= 0x80000000;
-            if (bf < 0)
-                m_nodes[h].gt |= 0x80000000;
-            else
-                m_nodes[h].gt &= 0x7FFFFFFF;
+    while (i < middle)
+        destination[k++] = source[i++];
+    while (j < right)
+        destination[k++] = source[j++];
+    return true;
+}
+
+// A stable, non-recursive merge sort. We sort indices into the values, rather than
+// the values themselves, so that the values stay where the GC can see them while
+// the compare function runs. The buffer must be as long as the indices.
+// Returns false if the compare function threw, leaving the order unspecified.
+static bool mergeSortIndices(const JSValue* values, Vector<unsigned>& indices, Vector<unsigned>& buffer, ArraySortComparator& comparator)
+{
+    size_t length = indices.size();
+
+    for (size_t runStart = 0; runStart < length; runStart += arraySortMinimumRunLength) {
+        size_t runEnd = min(runStart + arraySortMinimumRunLength, length);
+        for (size_t i = runStart + 1; i < runEnd; ++i) {
+            unsigned index = indices[i];
+            size_t j = i;
+            for (; j > runStart; --j) {
+                bool isGreaterThan = comparator.isGreaterThan(values[indices[j - 1]], values[index]);
+                if (comparator.hadException())
+                    return false;
+                if (!isGreaterThan)
+                    break;
+                indices[j] = indices[j - 1];
+            }
+            indices[j] = index;
         }
     }
 
-    int compare_key_key(key va, key vb)
-    {
-        ASSERT(!va.isUndefined());
-        ASSERT(!vb.isUndefined());
-
-        if (m_exec->hadException())
-            return 1;
+    if (length <= arraySortMinimumRunLength)
+        return true;
 
-        double compareResult;
-        if (m_cachedCall) {
-            m_cachedCall->setThis(jsUndefined());
-            m_cachedCall->setArgument(0, va);
-            m_cachedCall->setArgument(1, vb);
-            compareResult = m_cachedCall->call().toNumber(m_cachedCall->newCallFrame(m_exec));
-        } else {
-            MarkedArgumentBuffer arguments;
-            arguments.append(va);
-            arguments.append(vb);
-            compareResult = call(m_exec, m_compareFunction, m_compareCallType, *m_compareCallData, jsUndefined(), arguments).toNumber(m_exec);
+    ASSERT(buffer.size() == length);
+    unsigned* source = indices.data();
+    unsigned* destination = buffer.data();
+    for (size_t width = arraySortMinimumRunLength; width < length; width *= 2) {
+        for (size_t left = 0; left < length; left += 2 * width) {
+            size_t middle = min(left + width, length);
+            size_t right = min(middle + width, length);
+            if (!mergeSortedRuns(values, source, destination, left, middle, right, comparator))
+                return false;
         }
-        return (compareResult < 0) ? -1 : 1; // Not passing equality through, because we need to store all values, even if equivalent.
+        std::swap(source, destination);
     }
 
-    int compare_key_node(key k, handle h) { return compare_key_key(k, m_nodes[h].value); }
-    int compare_node_node(handle h1, handle h2) { return compare_key_key(m_nodes[h1].value, m_nodes[h2].value); }
-
-    static handle null() { return 0x7FFFFFFF; }
-};
+    if (source != indices.data())
+        memcpy(indices.data(), source, length * sizeof(unsigned));
+    return true;
+}
 
 template<IndexingType indexingType>
 void JSArray::sortVector(ExecState* exec, JSValue compareFunction, CallType callType, const CallData& callData)
@@ -1315,86 +1352,71 @@ void JSArray::sortVector(ExecState* exec, JSValue compareFunction, CallType call
     ASSERT(!inSparseIndexingMode());
     ASSERT(indexingType == structure()->indexingType());
     
-    // FIXME: This ignores exceptions raised in the compare function or in toNumber.
-        
-    // The maximum tree depth is compiled in - but the caller is clearly up to no good
-    // if a larger array is passed.
-    ASSERT(m_butterfly->publicLength() <= static_cast<unsigned>(std::numeric_limits<int>::max()));
-    if (m_butterfly->publicLength() > static_cast<unsigned>(std::numeric_limits<int>::max()))
-        return;
-        
     unsigned usedVectorLength = relevantLength<indexingType>();
-    unsigned nodeCount = usedVectorLength;
         
-    if (!nodeCount)
+    if (!usedVectorLength)
         return;
         
-    AVLTree<AVLTreeAbstractorForArrayCompare, 44> tree; // Depth 44 is enough for 2^31 items
-    tree.abstractor().m_exec = exec;
-    tree.abstractor().m_compareFunction = compareFunction;
-    tree.abstractor().m_compareCallType = callType;
-    tree.abstractor().m_compareCallData = &callData;
-    tree.abstractor().m_nodes.grow(nodeCount);
-        
-    if (callType == CallTypeJS)
-        tree.abstractor().m_cachedCall = adoptPtr(new CachedCall(exec, jsCast<JSFunction*>(compareFunction), 2));
+    ArraySortComparator comparator(exec, compareFunction, callType, callData);
         
-    if (!tree.abstractor().m_nodes.begin()) {
+    // The compare function may modify the array, so we sort copies of the values.
+    Vector<JSValue, 0, UnsafeVectorOverflow> values;
+    if (!values.tryReserveCapacity(usedVectorLength)) {
         throwOutOfMemoryError(exec);
         return;
     }
         
-    // FIXME: If the compare function modifies the array, the vector, map, etc. could be modified
-    // right out from under us while we're building the tree here.
-        
-    unsigned numDefined = 0;
     unsigned numUndefined = 0;
     
-    // Iterate over the array, ignoring missing values, counting undefined ones, and inserting all other ones into the tree.
-    for (; numDefined < usedVectorLength; ++numDefined) {
-        if (numDefined >= m_butterfly->vectorLength())
-            break;
-        JSValue v = getHolyIndexQuickly(numDefined);
-        if (!v || v.isUndefined())
-            break;
-        tree.abstractor().m_nodes[numDefined].value = v;
-        tree.insert(numDefined);
-    }
-    for (unsigned i = numDefined; i < usedVectorLength; ++i) {
+    // Iterate over the array, ignoring missing values and counting undefined ones.
+    for (unsigned i = 0; i < usedVectorLength; ++i) {
         if (i >= m_butterfly->vectorLength())
             break;
         JSValue v = getHolyIndexQuickly(i);
-        if (v) {
-            if (v.isUndefined())
-                ++numUndefined;
-            else {
-                tree.abstractor().m_nodes[numDefined].value = v;
-                tree.insert(numDefined);
-                ++numDefined;
-            }
-        }
+        if (!v)
+            continue;
+        if (v.isUndefined())
+            ++numUndefined;
+        else
+            values.uncheckedAppend(v);
+    }
+    
+    unsigned numDefined = values.size();
+    Vector<unsigned> indices;
+    Vector<unsigned> buffer;
+    if (!indices.tryReserveCapacity(numDefined) || !buffer.tryReserveCapacity(numDefined)) {
+        throwOutOfMemoryError(exec);
+        return;
     }
+    for (unsigned i = 0; i < numDefined; ++i)
+        indices.uncheckedAppend(i);
+    buffer.resize(numDefined);
+    
+    Heap::heap(this)->pushTempSortVector(&values);
+    bool succeeded = mergeSortIndices(values.data(), indices, buffer, comparator);
+    Heap::heap(this)->popTempSortVector(&values);
+    
+    if (!succeeded)
+        return;
     
     unsigned newUsedVectorLength = numDefined + numUndefined;
         
     // The array size may have changed. Figure out the new bounds.
     unsigned newestUsedVectorLength = currentRelevantLength();
         
-    unsigned elementsToExtractThreshold = min(min(newestUsedVectorLength, numDefined), static_cast<unsigned>(tree.abstractor().m_nodes.size()));
+    unsigned elementsToExtractThreshold = min(newestUsedVectorLength, numDefined);
     unsigned undefinedElementsThreshold = min(newestUsedVectorLength, newUsedVectorLength);
     unsigned clearElementsThreshold = min(newestUsedVectorLength, usedVectorLength);
         
     // Copy the values back into m_storage.
-    AVLTree<AVLTreeAbstractorForArrayCompare, 44>::Iterator iter;
-    iter.start_iter_least(tree);
     VM& vm = exec->vm();
     for (unsigned i = 0; i < elementsToExtractThreshold; ++i) {
         ASSERT(i < butterfly()->vectorLength());
+        JSValue value = values[indices[i]];
         if (structure()->indexingType() == ArrayWithDouble)
-            butterfly()->contiguousDouble()[i] = tree.abstractor().m_nodes[*iter].value.asNumber();
+            butterfly()->contiguousDouble()[i] = value.asNumber();
         else
-            currentIndexingData()[i].set(vm, this, tree.abstractor().m_nodes[*iter].value);
-        ++iter;
+            currentIndexingData()[i].set(vm, this, value);
     }
     // Put undefined values back in.
     switch (structure()->indexingType()) {
@@ -127,65 +127,9 @@ static inline int msToWeekDay(double ms)
     return wd;
 }
 
-// Get the combined UTC + DST offset for the time passed in.
-//
-// NOTE: The implementation relies on the fact that no time zones have
-// more than one daylight savings offset change per month.
-// If this function is called with NaN it returns NaN.
-static LocalTimeOffset localTimeOffset(ExecState* exec, double ms)
+static inline LocalTimeOffset localTimeOffset(ExecState* exec, double ms)
 {
-    LocalTimeOffsetCache& cache = exec->vm().localTimeOffsetCache;
-    double start = cache.start;
-    double end = cache.end;
-
-    if (start <= ms) {
-        // If the time fits in the cached interval, return the cached offset.
-        if (ms <= end) return cache.offset;
-
-        // Compute a possible new interval end.
-        double newEnd = end + cache.increment;
-
-        if (ms <= newEnd) {
-            LocalTimeOffset endOffset = calculateLocalTimeOffset(newEnd);
-            if (cache.offset == endOffset) {
-                // If the offset at the end of the new interval still matches
-                // the offset in the cache, we grow the cached time interval
-                // and return the offset.
-                cache.end = newEnd;
-                cache.increment = msPerMonth;
-                return endOffset;
-            }
-            LocalTimeOffset offset = calculateLocalTimeOffset(ms);
-            if (offset == endOffset) {
-                // The offset at the given time is equal to the offset at the
-                // new end of the interval, so that means that we've just skipped
-                // the point in time where the DST offset change occurred. Updated
-                // the interval to reflect this and reset the increment.
-                cache.start = ms;
-                cache.end = newEnd;
-                cache.increment = msPerMonth;
-            } else {
-                // The interval contains a DST offset change and the given time is
-                // before it. Adjust the increment to avoid a linear search for
-                // the offset change point and change the end of the interval.
-                cache.increment /= 3;
-                cache.end = ms;
-            }
-            // Update the offset in the cache and return it.
-            cache.offset = offset;
-            return offset;
-        }
-    }
-
-    // Compute the DST offset for the time and shrink the cache interval
-    // to only contain the time. This allows fast repeated DST offset
-    // computations for the same time.
-    LocalTimeOffset offset = calculateLocalTimeOffset(ms);
-    cache.offset = offset;
-    cache.start = ms;
-    cache.end = ms;
-    cache.increment = msPerMonth;
-    return offset;
+    return exec->vm().localTimeOffsetTable.offsetFor(ms);
 }
 
 double gregorianDateTimeToMS(ExecState* exec, const GregorianDateTime& t, double milliSeconds, bool inputIsUTC)
@@ -242,9 +186,10 @@ double parseDate(ExecState* exec, const String& date)
 {
     if (date == exec->vm().cachedDateString)
         return exec->vm().cachedDateStringValue;
-    double value = parseES5DateFromNullTerminatedCharacters(date.utf8().data());
+    CString dateUTF8 = date.utf8();
+    double value = parseES5DateFromNullTerminatedCharacters(dateUTF8.data());
     if (std::isnan(value))
-        value = parseDateFromNullTerminatedCharacters(exec, date.utf8().data());
+        value = parseDateFromNullTerminatedCharacters(exec, dateUTF8.data());
     exec->vm().cachedDateString = date;
     exec->vm().cachedDateStringValue = value;
     return value;
@@ -38,7 +38,9 @@
 #include "ObjectConstructor.h"
 #include "Operations.h"
 #include "PropertyNameArray.h"
+#include "StrongInlines.h"
 #include <wtf/MathExtras.h>
+#include <wtf/dtoa.h>
 #include <wtf/text/StringBuilder.h>
 
 namespace JSC {
@@ -88,6 +90,8 @@ public:
     void visitAggregate(SlotVisitor&);
 
 private:
+    struct StructurePropertyNames;
+
     class Holder {
     public:
         Holder(VM&, JSObject*);
@@ -103,10 +107,24 @@ private:
         unsigned m_index;
         unsigned m_size;
         RefPtr<PropertyNameArrayData> m_propertyNames;
+        StructurePropertyNames* m_structurePropertyNames;
     };
 
     friend class Holder;
 
+    // The own enumerable property names of a plain object follow from its Structure, so
+    // we look them up, and quote them, once per Structure rather than once per object.
+    struct StructurePropertyNames {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        Strong<Structure> structure;
+        RefPtr<PropertyNameArrayData> propertyNames;
+        Vector<String> quotedPropertyNames;
+        Vector<PropertyOffset> offsets; // Empty if any of the properties is an accessor.
+    };
+
+    StructurePropertyNames* structurePropertyNamesFor(JSObject*);
+
     static void appendQuotedString(StringBuilder&, const String&);
 
     JSValue toJSON(JSValue, const PropertyNameForFunctionCall&);
@@ -130,10 +148,16 @@ private:
     Vector<Holder, 16, UnsafeVectorOverflow> m_holderStack;
     String m_repeatedGap;
     String m_indent;
+
+    typedef HashMap<Structure*, OwnPtr<StructurePropertyNames> > StructurePropertyNamesMap;
+    StructurePropertyNamesMap m_structurePropertyNames;
 };
 
 // ------------------------------ helper functions --------------------------------
 
+// Bounds the work we spend on Structures that we will likely never see again.
+static const unsigned maximumNumberOfCachedStructures = 256;
+
 static inline JSValue unwrapBoxedPrimitive(ExecState* exec, JSValue value)
 {
     if (!value.isObject())
@@ -385,12 +409,19 @@ Stringifier::StringifyResult Stringifier::appendStringifiedValue(StringBuilder&
         return StringifySucceeded;
     }
 
+    if (value.isInt32()) {
+        builder.appendNumber(value.asInt32());
+        return StringifySucceeded;
+    }
+
     if (value.isNumber()) {
         double number = value.asNumber();
         if (!std::isfinite(number))
             builder.appendLiteral("null");
-        else
-            builder.append(String::numberToStringECMAScript(number));
+        else {
+            NumberToStringBuffer buffer;
+            builder.append(numberToString(number, buffer));
+        }
         return StringifySucceeded;
     }
 
@@ -430,6 +461,51 @@ Stringifier::StringifyResult Stringifier::appendStringifiedValue(StringBuilder&
     return StringifySucceeded;
 }
 
+Stringifier::StructurePropertyNames* Stringifier::structurePropertyNamesFor(JSObject* object)
+{
+    Structure* structure = object->structure();
+    if (!isJSFinalObject(object) || structure->isDictionary() || hasIndexedProperties(structure->indexingType()))
+        return 0;
+
+    StructurePropertyNamesMap::iterator iter = m_structurePropertyNames.find(structure);
+    if (iter != m_structurePropertyNames.end())
+        return iter->value.get();
+
+    if (m_structurePropertyNames.size() >= maximumNumberOfCachedStructures)
+        return 0;
+
+    VM& vm = m_exec->vm();
+    OwnPtr<StructurePropertyNames> entry = adoptPtr(new StructurePropertyNames);
+    entry->structure.set(vm, structure);
+
+    PropertyNameArray objectPropertyNames(m_exec);
+    object->methodTable()->getOwnPropertyNames(object, m_exec, objectPropertyNames, ExcludeDontEnumProperties);
+    entry->propertyNames = objectPropertyNames.releaseData();
+
+    const PropertyNameArrayData::PropertyNameVector& propertyNames = entry->propertyNames->propertyNameVector();
+    bool canUseOffsets = !structure->hasGetterSetterProperties();
+    entry->quotedPropertyNames.reserveInitialCapacity(propertyNames.size());
+    for (size_t i = 0; i < propertyNames.size(); ++i) {
+        StringBuilder quotedPropertyName;
+        appendQuotedString(quotedPropertyName, propertyNames[i].string());
+        entry->quotedPropertyNames.uncheckedAppend(quotedPropertyName.toString());
+
+        if (!canUseOffsets)
+            continue;
+        PropertyOffset offset = structure->get(vm, propertyNames[i]);
+        if (offset == invalidOffset)
+            canUseOffsets = false;
+        else
+            entry->offsets.append(offset);
+    }
+    if (!canUseOffsets)
+        entry->offsets.clear();
+
+    StructurePropertyNames* result = entry.get();
+    m_structurePropertyNames.add(structure, entry.release());
+    return result;
+}
+
 inline bool Stringifier::willIndent() const
 {
     return !m_gap.isEmpty();
@@ -466,6 +542,7 @@ inline Stringifier::Holder::Holder(VM& vm, JSObject* object)
 #ifndef NDEBUG
     , m_size(0)
 #endif
+    , m_structurePropertyNames(0)
 {
 }
 
@@ -484,6 +561,8 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
         } else {
             if (stringifier.m_usingArrayReplacer)
                 m_propertyNames = stringifier.m_arrayReplacerPropertyNames.data();
+            else if ((m_structurePropertyNames = stringifier.structurePropertyNamesFor(m_object.get())))
+                m_propertyNames = m_structurePropertyNames->propertyNames;
             else {
                 PropertyNameArray objectPropertyNames(exec);
                 m_object->methodTable()->getOwnPropertyNames(m_object.get(), exec, objectPropertyNames, ExcludeDontEnumProperties);
@@ -530,14 +609,20 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
         // Append the stringified value.
         stringifyResult = stringifier.appendStringifiedValue(builder, value, m_object.get(), index);
     } else {
-        // Get the value.
-        PropertySlot slot(m_object.get());
+        // Get the value. If the object still has the Structure we looked its property
+        // names up in, we can load the value straight out of its storage.
         Identifier& propertyName = m_propertyNames->propertyNameVector()[index];
-        if (!m_object->methodTable()->getOwnPropertySlot(m_object.get(), exec, propertyName, slot))
-            return true;
-        JSValue value = slot.getValue(exec, propertyName);
-        if (exec->hadException())
-            return false;
+        JSValue value;
+        if (m_structurePropertyNames && !m_structurePropertyNames->offsets.isEmpty() && m_object->structure() == m_structurePropertyNames->structure.get())
+            value = m_object->getDirect(m_structurePropertyNames->offsets[index]);
+        else {
+            PropertySlot slot(m_object.get());
+            if (!m_object->methodTable()->getOwnPropertySlot(m_object.get(), exec, propertyName, slot))
+                return true;
+            value = slot.getValue(exec, propertyName);
+            if (exec->hadException())
+                return false;
+        }
 
         rollBackPoint = builder.length();
 
@@ -547,7 +632,10 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
         stringifier.startNewLine(builder);
 
         // Append the property name.
-        appendQuotedString(builder, propertyName.string());
+        if (m_structurePropertyNames)
+            builder.append(m_structurePropertyNames->quotedPropertyNames[index]);
+        else
+            appendQuotedString(builder, propertyName.string());
         builder.append(':');
         if (stringifier.willIndent())
             builder.append(' ');
@@ -69,6 +69,8 @@ JSPropertyNameIterator* JSPropertyNameIterator::create(ExecState* exec, JSObject
         return jsPropertyNameIterator;
     
     size_t count = normalizePrototypeChain(exec, o);
+    if (count == InvalidPrototypeChain)
+        return jsPropertyNameIterator;
     StructureChain* structureChain = o->structure()->prototypeChain(exec);
     WriteBarrier<Structure>* structure = structureChain->head();
     for (size_t i = 0; i < count; ++i) {
@@ -225,9 +225,92 @@ void JSRopeString::outOfMemory(ExecState* exec) const
         throwOutOfMemoryError(exec);
 }
 
+// Walks the fibers that overlap [offset, offset + length) in order, calling the functor
+// with each flat fiber, the offset into it at which the range starts and the number of
+// characters of the range it holds. Subtrees that lie entirely before the range are
+// skipped without being entered. Fibers are kept alive by their parents, and there are
+// no GC points in here, so they can be held in a plain Vector. Returns false if some
+// fiber's contents were lost to a failed resolution, in which case the caller should
+// resolve the rope, which will fail in the same way.
+template<typename Functor>
+bool JSRopeString::forEachFiberSegment(unsigned offset, unsigned length, Functor& functor, unsigned& fibersVisited) const
+{
+    ASSERT(isRope());
+    ASSERT(offset + length <= m_length);
+
+    Vector<JSString*, 32, UnsafeVectorOverflow> workQueue;
+    for (size_t i = s_maxInternalRopeLength; i--;) {
+        if (m_fibers[i])
+            workQueue.append(m_fibers[i].get());
+    }
+
+    unsigned position = 0;
+    unsigned end = offset + length;
+    while (!workQueue.isEmpty() && position < end) {
+        JSString* fiber = workQueue.last();
+        workQueue.removeLast();
+        fibersVisited++;
+
+        unsigned fiberLength = fiber->length();
+        if (position + fiberLength <= offset) {
+            position += fiberLength;
+            continue;
+        }
+
+        if (fiber->isRope()) {
+            JSRopeString* fiberAsRope = static_cast<JSRopeString*>(fiber);
+            if (!fiberAsRope->m_fibers[0])
+                return false;
+            for (size_t i = s_maxInternalRopeLength; i--;) {
+                if (fiberAsRope->m_fibers[i])
+                    workQueue.append(fiberAsRope->m_fibers[i].get());
+            }
+            continue;
+        }
+
+        unsigned segmentStart = std::max(offset, position) - position;
+        unsigned segmentEnd = std::min(end, position + fiberLength) - position;
+        if (!functor(fiber->m_value.impl(), segmentStart, segmentEnd - segmentStart))
+            return true;
+        position += fiberLength;
+    }
+    return position >= end;
+}
+
+class FindFiberContainingCharacter {
+public:
+    FindFiberContainingCharacter()
+        : m_offset(0)
+    {
+    }
+
+    bool operator()(StringImpl* fiber, unsigned offset, unsigned)
+    {
+        m_fiber = fiber;
+        m_offset = offset;
+        return false;
+    }
+
+    const String& fiber() const { return m_fiber; }
+    unsigned offset() const { return m_offset; }
+
+private:
+    String m_fiber;
+    unsigned m_offset;
+};
+
 JSString* JSRopeString::getIndexSlowCase(ExecState* exec, unsigned i)
 {
     ASSERT(isRope());
+    if (!shouldResolveBeforeAccess()) {
+        FindFiberContainingCharacter finder;
+        unsigned fibersVisited = 0;
+        if (forEachFiberSegment(i, 1, finder, fibersVisited)) {
+            didAccessInPlace(fibersVisited);
+            return jsSingleCharacterSubstring(exec, finder.fiber(), finder.offset());
+        }
+    }
+
     resolveRope(exec);
     // Return a safe no-value result, this should never be used, since the excetion will be thrown.
     if (exec->exception())
@@ -237,6 +320,206 @@ JSString* JSRopeString::getIndexSlowCase(ExecState* exec, unsigned i)
     return jsSingleCharacterSubstring(exec, m_value, i);
 }
 
+UChar JSRopeString::characterAtSlowCase(ExecState* exec, unsigned i)
+{
+    ASSERT(isRope());
+    if (!shouldResolveBeforeAccess()) {
+        FindFiberContainingCharacter finder;
+        unsigned fibersVisited = 0;
+        if (forEachFiberSegment(i, 1, finder, fibersVisited)) {
+            didAccessInPlace(fibersVisited);
+            return finder.fiber()[finder.offset()];
+        }
+    }
+
+    resolveRope(exec);
+    if (exec->exception())
+        return 0;
+    ASSERT(!isRope());
+    RELEASE_ASSERT(i < m_value.length());
+    return m_value[i];
+}
+
+// Copies a range of a rope into a new string, unless the range lies within a single
+// fiber, in which case the substring can share that fiber's buffer.
+class CopyFiberSegments {
+public:
+    CopyFiberSegments(unsigned length, bool is8Bit)
+        : m_length(length)
+        , m_is8Bit(is8Bit)
+        , m_position(0)
+        , m_buffer8(0)
+        , m_buffer16(0)
+        , m_sharedOffset(0)
+        , m_didFail(false)
+    {
+    }
+
+    bool operator()(StringImpl* fiber, unsigned offset, unsigned length)
+    {
+        if (!m_position && length == m_length) {
+            m_sharedFiber = fiber;
+            m_sharedOffset = offset;
+            return false;
+        }
+
+        if (!m_result) {
+            m_result = m_is8Bit ? StringImpl::tryCreateUninitialized(m_length, m_buffer8) : StringImpl::tryCreateUninitialized(m_length, m_buffer16);
+            if (!m_result) {
+                m_didFail = true;
+                return false;
+            }
+        }
+
+        if (m_is8Bit)
+            StringImpl::copyChars(m_buffer8 + m_position, fiber->characters8() + offset, length);
+        else if (fiber->is8Bit())
+            StringImpl::copyChars(m_buffer16 + m_position, fiber->characters8() + offset, length);
+        else
+            StringImpl::copyChars(m_buffer16 + m_position, fiber->characters16() + offset, length);
+        m_position += length;
+        return true;
+    }
+
+    bool didFail() const { return m_didFail; }
+    const String& sharedFiber() const { return m_sharedFiber; }
+    unsigned sharedOffset() const { return m_sharedOffset; }
+    PassRefPtr<StringImpl> result() { ASSERT(m_position == m_length); return m_result.release(); }
+
+private:
+    unsigned m_length;
+    bool m_is8Bit;
+    unsigned m_position;
+    LChar* m_buffer8;
+    UChar* m_buffer16;
+    RefPtr<StringImpl> m_result;
+    String m_sharedFiber;
+    unsigned m_sharedOffset;
+    bool m_didFail;
+};
+
+JSString* JSRopeString::substringSlowCase(ExecState* exec, unsigned offset, unsigned length)
+{
+    ASSERT(isRope());
+    ASSERT(length);
+    VM* vm = &exec->vm();
+    if (!shouldResolveBeforeAccess()) {
+        CopyFiberSegments copier(length, is8Bit());
+        unsigned fibersVisited = 0;
+        if (forEachFiberSegment(offset, length, copier, fibersVisited) && !copier.didFail()) {
+            if (!copier.sharedFiber().isNull()) {
+                didAccessInPlace(fibersVisited);
+                return jsSubstring(vm, copier.sharedFiber(), copier.sharedOffset(), length);
+            }
+            didAccessInPlace(fibersVisited + length);
+            RefPtr<StringImpl> result = copier.result();
+            if (length == 1 && (*result)[0] <= maxSingleCharacterString)
+                return vm->smallStrings.singleCharacterString(vm, (*result)[0]);
+            return JSString::create(*vm, result.release());
+        }
+    }
+
+    resolveRope(exec);
+    if (exec->exception())
+        return jsEmptyString(exec);
+    return jsSubstring(vm, m_value, offset, length);
+}
+
+// Searches the fibers one after another. Matches that lie within a fiber are found with
+// StringImpl::find; matches that straddle fibers are found by keeping the last
+// pattern.length() - 1 characters we have seen and checking them against the start of
+// the next fiber before searching it.
+class FindInFiberSegments {
+public:
+    FindInFiberSegments(const String& pattern, unsigned start)
+        : m_pattern(pattern)
+        , m_position(start)
+        , m_result(notFound)
+    {
+    }
+
+    bool operator()(StringImpl* fiber, unsigned offset, unsigned length)
+    {
+        unsigned patternLength = m_pattern.length();
+        if (patternLength > 1 && !m_carry.isEmpty()) {
+            unsigned carryLength = m_carry.size();
+            unsigned headLength = std::min(patternLength - 1, length);
+            for (unsigned i = 0; i < carryLength; ++i) {
+                if (i + patternLength > carryLength + headLength)
+                    break;
+                if (matchesAt(fiber, offset, i)) {
+                    m_result = m_position - carryLength + i;
+                    return false;
+                }
+            }
+        }
+
+        size_t found = fiber->find(m_pattern.impl(), offset);
+        if (found != notFound && found + patternLength <= offset + length) {
+            m_result = m_position + (found - offset);
+            return false;
+        }
+
+        if (patternLength > 1) {
+            unsigned tailLength = std::min(patternLength - 1, length);
+            for (unsigned i = length - tailLength; i < length; ++i)
+                m_carry.append((*fiber)[offset + i]);
+            if (m_carry.size() > patternLength - 1)
+                m_carry.remove(0, m_carry.size() - (patternLength - 1));
+        }
+        m_position += length;
+        return true;
+    }
+
+    size_t result() const { return m_result; }
+    size_t charactersScanned(unsigned start) const { return (m_result == notFound ? m_position : m_result) - start; }
+
+private:
+    // Whether the pattern occurs starting at the given index into the carried characters,
+    // continuing into the fiber's characters from offset onwards.
+    bool matchesAt(StringImpl* fiber, unsigned offset, unsigned carryIndex) const
+    {
+        unsigned carryLength = m_carry.size();
+        for (unsigned j = 0; j < m_pattern.length(); ++j) {
+            unsigned index = carryIndex + j;
+            UChar c = index < carryLength ? m_carry[index] : (*fiber)[offset + index - carryLength];
+            if (c != m_pattern[j])
+                return false;
+        }
+        return true;
+    }
+
+    const String& m_pattern;
+    size_t m_position;
+    size_t m_result;
+    Vector<UChar, 32> m_carry;
+};
+
+size_t JSRopeString::findSlowCase(ExecState* exec, const String& pattern, unsigned start)
+{
+    ASSERT(isRope());
+    if (start > m_length)
+        start = m_length;
+    if (pattern.isEmpty())
+        return start;
+    if (pattern.length() > m_length - start)
+        return notFound;
+
+    if (!shouldResolveBeforeAccess() && pattern.length() <= maximumPatternLengthForFindInPlace) {
+        FindInFiberSegments finder(pattern, start);
+        unsigned fibersVisited = 0;
+        if (forEachFiberSegment(start, m_length - start, finder, fibersVisited)) {
+            didAccessInPlace(fibersVisited + finder.charactersScanned(start));
+            return finder.result();
+        }
+    }
+
+    resolveRope(exec);
+    if (exec->exception())
+        return notFound;
+    return m_value.find(pattern, start);
+}
+
 JSValue JSString::toPrimitive(ExecState*, PreferredPrimitiveType) const
 {
     return const_cast<JSString*>(this);
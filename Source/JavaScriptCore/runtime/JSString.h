@@ -152,6 +152,11 @@ public:
 
     bool canGetIndex(unsigned i) { return i < m_length; }
     JSString* getIndex(ExecState*, unsigned);
+    UChar characterAt(ExecState*, unsigned);
+
+    // Returns the index of the first occurrence of the pattern at or after start,
+    // or notFound. Ropes are searched in place unless flattening them looks cheaper.
+    size_t find(ExecState*, const String& pattern, unsigned start = 0);
 
     static Structure* createStructure(VM& vm, JSGlobalObject* globalObject, JSValue proto)
     {
@@ -166,6 +171,7 @@ public:
 
     static void visitChildren(JSCell*, SlotVisitor&);
 
+    // JSRopeString uses the bits above these to count how much it has been read in place.
     enum {
         HashConsLock = 1u << 2,
         IsHashConsSingleton = 1u << 1,
@@ -191,7 +197,7 @@ protected:
     bool tryHashConsLock();
     void releaseHashConsLock();
 
-    unsigned m_flags;
+    mutable unsigned m_flags;
         
     // A string is represented either by a String or a rope of fibers.
     unsigned m_length;
@@ -216,6 +222,7 @@ class JSRopeString : public JSString {
     friend class JSString;
 
     friend JSRopeString* jsStringBuilder(VM*);
+    friend JSString* jsSubstring(ExecState*, JSString*, unsigned offset, unsigned length);
 
     class RopeBuilder {
     public:
@@ -324,6 +331,32 @@ private:
     void outOfMemory(ExecState*) const;
         
     JSString* getIndexSlowCase(ExecState*, unsigned);
+    UChar characterAtSlowCase(ExecState*, unsigned);
+    JSString* substringSlowCase(ExecState*, unsigned offset, unsigned length);
+    size_t findSlowCase(ExecState*, const String& pattern, unsigned start);
+
+    // Reading a rope in place costs about as much as the part of it that gets
+    // walked; flattening it costs its length once, after which every read is cheap.
+    // We keep reading in place until the work we have done that way adds up to
+    // the cost of flattening, which keeps us within a factor of two of whichever
+    // choice would have been right in hindsight.
+    // The cost is kept in the bits of m_flags above the JSString flags. For the rare
+    // rope that is longer than those bits can count, we stop counting at their maximum.
+    unsigned accessCost() const { return m_flags >> accessCostShift; }
+    unsigned maximumAccessCost() const { return std::min(m_length, UINT_MAX >> accessCostShift); }
+    bool shouldResolveBeforeAccess() const { return m_length < minimumLengthForAccessInPlace || accessCost() >= maximumAccessCost(); }
+    void didAccessInPlace(unsigned cost) const
+    {
+        unsigned newCost = std::min(accessCost() + std::min(cost, m_length), maximumAccessCost());
+        m_flags = (m_flags & ((1u << accessCostShift) - 1)) | (newCost << accessCostShift);
+    }
+
+    template<typename Functor> bool forEachFiberSegment(unsigned offset, unsigned length, Functor&, unsigned& fibersVisited) const;
+
+    static const unsigned accessCostShift = 3;
+    static const unsigned minimumLengthForAccessInPlace = 256;
+    // Longer patterns are cheaper to look for in a flat string than across fibers.
+    static const unsigned maximumPatternLengthForFindInPlace = 32;
 
     mutable FixedArray<WriteBarrier<JSString>, s_maxInternalRopeLength> m_fibers;
 };
@@ -387,6 +420,22 @@ inline JSString* JSString::getIndex(ExecState* exec, unsigned i)
     return jsSingleCharacterSubstring(exec, m_value, i);
 }
 
+inline UChar JSString::characterAt(ExecState* exec, unsigned i)
+{
+    ASSERT(canGetIndex(i));
+    if (isRope())
+        return static_cast<JSRopeString*>(this)->characterAtSlowCase(exec, i);
+    ASSERT(i < m_value.length());
+    return m_value[i];
+}
+
+inline size_t JSString::find(ExecState* exec, const String& pattern, unsigned start)
+{
+    if (isRope())
+        return static_cast<JSRopeString*>(this)->findSlowCase(exec, pattern, start);
+    return m_value.find(pattern, start);
+}
+
 inline JSString* jsString(VM* vm, const String& s)
 {
     int size = s.length();
@@ -408,6 +457,8 @@ inline JSString* jsSubstring(ExecState* exec, JSString* s, unsigned offset, unsi
     VM* vm = &exec->vm();
     if (!length)
         return vm->smallStrings.emptyString();
+    if (s->isRope())
+        return static_cast<JSRopeString*>(s)->substringSlowCase(exec, offset, length);
     return jsSubstring(vm, s->value(exec), offset, length);
 }
 
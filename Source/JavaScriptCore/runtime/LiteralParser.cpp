@@ -37,6 +37,7 @@
 #include "StrongInlines.h"
 #include <wtf/ASCIICType.h>
 #include <wtf/dtoa.h>
+#include <wtf/text/ASCIIFastPath.h>
 #include <wtf/text/StringBuilder.h>
 
 namespace JSC {
@@ -49,6 +50,34 @@ static inline bool isJSONWhiteSpace(const CharType& c)
     return c == ' ' || c == 0x9 || c == 0xA || c == 0xD;
 }
 
+static inline WTF::MachineWord repeatedByte(LChar c)
+{
+    return (static_cast<WTF::MachineWord>(-1) / 0xFF) * c;
+}
+
+template <typename CharType>
+static ALWAYS_INLINE const CharType* skipJSONWhiteSpace(const CharType* ptr, const CharType* end)
+{
+    while (ptr < end && isJSONWhiteSpace(*ptr))
+        ++ptr;
+    return ptr;
+}
+
+template <>
+ALWAYS_INLINE const LChar* skipJSONWhiteSpace<LChar>(const LChar* ptr, const LChar* end)
+{
+    // Pretty printed JSON spends most of its white space on indentation, so once
+    // we are aligned we skip spaces a machine word at a time.
+    while (ptr < end && isJSONWhiteSpace(*ptr)) {
+        ++ptr;
+        if (!WTF::isAlignedToMachineWord(ptr))
+            continue;
+        while (end - ptr >= static_cast<ptrdiff_t>(sizeof(WTF::MachineWord)) && *reinterpret_cast_ptr<const WTF::MachineWord*>(ptr) == repeatedByte(' '))
+            ptr += sizeof(WTF::MachineWord);
+    }
+    return ptr;
+}
+
 template <typename CharType>
 bool LiteralParser<CharType>::tryJSONPParse(Vector<JSONPData>& results, bool needsFullSourceInfo)
 {
@@ -129,6 +158,70 @@ bool LiteralParser<CharType>::tryJSONPParse(Vector<JSONPData>& results, bool nee
     return m_lexer.currentToken().type == TokEnd;
 }
     
+// JSON tends to hold many objects of the same shape, such as the elements of an
+// array of records. For each Structure we remember the last transition that adding
+// a property to one of our objects took out of it; the next object to get to that
+// Structure will most likely add the same property next, and when it does we can
+// recognize the property name without making an Identifier, and add the property
+// without looking up the transition.
+class StructureTransitionPredictor {
+public:
+    StructureTransitionPredictor()
+    {
+        memset(m_predictions, 0, sizeof(m_predictions));
+    }
+
+    StringImpl* predictedPropertyName(Structure* structure)
+    {
+        const Prediction& prediction = predictionFor(structure);
+        return prediction.from == structure ? prediction.propertyName : 0;
+    }
+
+    void putDirect(VM& vm, JSObject* object, PropertyName propertyName, JSValue value)
+    {
+        Structure* structure = object->structure();
+        Prediction& prediction = predictionFor(structure);
+        if (prediction.from == structure && prediction.propertyName == propertyName.uid()) {
+            object->setStructureAndReallocateStorageIfNecessary(vm, prediction.to);
+            object->putDirect(vm, prediction.offset, value);
+            return;
+        }
+
+        object->putDirect(vm, propertyName, value);
+
+        Structure* newStructure = object->structure();
+        if (structure->isDictionary() || newStructure->isDictionary() || newStructure->previousID() != structure)
+            return;
+        if (m_liveStructures.size() >= maximumNumberOfLiveStructures)
+            return;
+        prediction.from = structure;
+        prediction.to = newStructure;
+        prediction.propertyName = propertyName.uid();
+        prediction.offset = newStructure->get(vm, propertyName);
+        // The new Structure keeps the old one and the property name alive.
+        m_liveStructures.append(newStructure);
+    }
+
+private:
+    struct Prediction {
+        Structure* from;
+        Structure* to;
+        StringImpl* propertyName;
+        PropertyOffset offset;
+    };
+
+    Prediction& predictionFor(Structure* structure)
+    {
+        return m_predictions[(reinterpret_cast<uintptr_t>(structure) >> 4) & (numberOfPredictions - 1)];
+    }
+
+    static const size_t numberOfPredictions = 64;
+    static const size_t maximumNumberOfLiveStructures = 1024;
+
+    Prediction m_predictions[numberOfPredictions];
+    MarkedArgumentBuffer m_liveStructures;
+};
+
 template <typename CharType>
 ALWAYS_INLINE const Identifier LiteralParser<CharType>::makeIdentifier(const LChar* characters, size_t length)
 {
@@ -169,11 +262,22 @@ ALWAYS_INLINE const Identifier LiteralParser<CharType>::makeIdentifier(const UCh
     return m_recentIdentifiers[characters[0]];
 }
 
+template <typename CharType>
+const Identifier LiteralParser<CharType>::makePropertyName(const LiteralParserToken<CharType>& token, JSObject* object, StructureTransitionPredictor& transitionPredictor)
+{
+    if (StringImpl* predictedName = transitionPredictor.predictedPropertyName(object->structure())) {
+        if (token.stringIs8Bit ? Identifier::equal(predictedName, token.stringToken8, token.stringLength) : Identifier::equal(predictedName, token.stringToken16, token.stringLength))
+            return Identifier(&m_exec->vm(), predictedName);
+    }
+    if (token.stringIs8Bit)
+        return makeIdentifier(token.stringToken8, token.stringLength);
+    return makeIdentifier(token.stringToken16, token.stringLength);
+}
+
 template <typename CharType>
 template <ParserMode mode> TokenType LiteralParser<CharType>::Lexer::lex(LiteralParserToken<CharType>& token)
 {
-    while (m_ptr < m_end && isJSONWhiteSpace(*m_ptr))
-        ++m_ptr;
+    m_ptr = skipJSONWhiteSpace(m_ptr, m_end);
 
     ASSERT(m_ptr <= m_end);
     if (m_ptr >= m_end) {
@@ -345,6 +449,33 @@ template <ParserMode mode, typename CharType, UChar terminator> static inline bo
     return (c >= ' ' && (mode == StrictJSON || c <= 0xff) && c != '\\' && c != terminator) || (c == '\t' && mode != StrictJSON);
 }
 
+template <ParserMode mode, char terminator> static ALWAYS_INLINE const LChar* skipSafeStringCharacters(const LChar* ptr, const LChar* end)
+{
+    // Checks a machine word at a time for a byte that is below ' ', a backslash
+    // or the terminator, leaving the run that contains it to the caller. Bytes
+    // above 0x7F are all safe, and cannot set the high bit of the result.
+    while (!WTF::isAlignedToMachineWord(ptr)) {
+        if (ptr == end || !isSafeStringCharacter<mode, LChar, terminator>(*ptr))
+            return ptr;
+        ++ptr;
+    }
+    const WTF::MachineWord ones = repeatedByte(1);
+    const WTF::MachineWord highBits = repeatedByte(0x80);
+    for (; end - ptr >= static_cast<ptrdiff_t>(sizeof(WTF::MachineWord)); ptr += sizeof(WTF::MachineWord)) {
+        WTF::MachineWord word = *reinterpret_cast_ptr<const WTF::MachineWord*>(ptr);
+        WTF::MachineWord terminators = word ^ repeatedByte(terminator);
+        WTF::MachineWord backslashes = word ^ repeatedByte('\\');
+        if (((word - repeatedByte(' ')) | (terminators - ones) | (backslashes - ones)) & ~word & highBits)
+            break;
+    }
+    return ptr;
+}
+
+template <ParserMode mode, char terminator> static ALWAYS_INLINE const UChar* skipSafeStringCharacters(const UChar* ptr, const UChar*)
+{
+    return ptr;
+}
+
 template <typename CharType>
 template <ParserMode mode, char terminator> ALWAYS_INLINE TokenType LiteralParser<CharType>::Lexer::lexString(LiteralParserToken<CharType>& token)
 {
@@ -353,6 +484,7 @@ template <ParserMode mode, char terminator> ALWAYS_INLINE TokenType LiteralParse
     StringBuilder builder;
     do {
         runStart = m_ptr;
+        m_ptr = skipSafeStringCharacters<mode, terminator>(m_ptr, m_end);
         while (m_ptr < m_end && isSafeStringCharacter<mode, CharType, terminator>(*m_ptr))
             ++m_ptr;
         if (builder.length())
@@ -548,6 +680,7 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
     JSValue lastValue;
     Vector<ParserState, 16, UnsafeVectorOverflow> stateStack;
     Vector<Identifier, 16, UnsafeVectorOverflow> identifierStack;
+    StructureTransitionPredictor transitionPredictor;
     while (1) {
         switch(state) {
             startParseArray:
@@ -606,10 +739,7 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
                     }
                     
                     m_lexer.next();
-                    if (identifierToken.stringIs8Bit)
-                        identifierStack.append(makeIdentifier(identifierToken.stringToken8, identifierToken.stringLength));
-                    else
-                        identifierStack.append(makeIdentifier(identifierToken.stringToken16, identifierToken.stringLength));
+                    identifierStack.append(makePropertyName(identifierToken, object, transitionPredictor));
                     stateStack.append(DoParseObjectEndExpression);
                     goto startParseExpression;
                 }
@@ -638,10 +768,7 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
                 }
 
                 m_lexer.next();
-                if (identifierToken.stringIs8Bit)
-                    identifierStack.append(makeIdentifier(identifierToken.stringToken8, identifierToken.stringLength));
-                else
-                    identifierStack.append(makeIdentifier(identifierToken.stringToken16, identifierToken.stringLength));
+                identifierStack.append(makePropertyName(identifierToken, asObject(objectStack.last()), transitionPredictor));
                 stateStack.append(DoParseObjectEndExpression);
                 goto startParseExpression;
             }
@@ -653,7 +780,7 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
                 if (i != PropertyName::NotAnIndex)
                     object->putDirectIndex(m_exec, i, lastValue);
                 else
-                    object->putDirect(m_exec->vm(), ident, lastValue);
+                    transitionPredictor.putDirect(m_exec->vm(), object, ident, lastValue);
                 identifierStack.removeLast();
                 if (m_lexer.currentToken().type == TokComma)
                     goto doParseObjectStartExpression;
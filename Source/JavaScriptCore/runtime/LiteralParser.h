@@ -33,6 +33,8 @@
 
 namespace JSC {
 
+class StructureTransitionPredictor;
+
 typedef enum { StrictJSON, NonStrictJSON, JSONP } ParserMode;
 
 enum JSONPPathEntryType {
@@ -159,6 +161,7 @@ private:
     FixedArray<Identifier, MaximumCachableCharacter> m_recentIdentifiers;
     ALWAYS_INLINE const Identifier makeIdentifier(const LChar* characters, size_t length);
     ALWAYS_INLINE const Identifier makeIdentifier(const UChar* characters, size_t length);
+    const Identifier makePropertyName(const LiteralParserToken<CharType>&, JSObject*, StructureTransitionPredictor&);
     };
 
 }
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "LocalTimeOffsetTable.h"
+
+#include <algorithm>
+#include <wtf/MathExtras.h>
+
+namespace JSC {
+
+// Probing once a week finds every change, provided no time zone changes its
+// offset twice within seven days.
+static const double probeInterval = 7 * msPerDay;
+
+LocalTimeOffsetTable::LocalTimeOffsetTable()
+    : m_cachedStart(0)
+    , m_cachedEnd(0)
+{
+}
+
+void LocalTimeOffsetTable::reset()
+{
+    for (size_t i = 0; i < m_years.size(); ++i)
+        m_years[i].clear();
+    m_cachedStart = 0;
+    m_cachedEnd = 0;
+}
+
+const Vector<LocalTimeOffsetTable::Transition>& LocalTimeOffsetTable::transitionsForYear(int equivalentYear)
+{
+    Vector<Transition>& transitions = m_years[equivalentYear - firstYear];
+    if (!transitions.isEmpty())
+        return transitions;
+
+    double yearStart = dateToDaysFrom1970(equivalentYear, 0, 1) * msPerDay;
+    double lastSecond = dateToDaysFrom1970(equivalentYear + 1, 0, 1) * msPerDay - msPerSecond;
+
+    LocalTimeOffset offset = calculateLocalTimeOffset(yearStart);
+    transitions.append(Transition(yearStart, offset));
+
+    double low = yearStart;
+    while (low < lastSecond) {
+        double high = std::min(low + probeInterval, lastSecond);
+        LocalTimeOffset highOffset = calculateLocalTimeOffset(high);
+        if (highOffset != offset) {
+            // Offsets are computed for whole seconds, so that is as far as we
+            // need to narrow it down.
+            while (high - low > msPerSecond) {
+                double middle = low + floor((high - low) / (2 * msPerSecond)) * msPerSecond;
+                LocalTimeOffset middleOffset = calculateLocalTimeOffset(middle);
+                if (middleOffset == offset)
+                    low = middle;
+                else {
+                    high = middle;
+                    highOffset = middleOffset;
+                }
+            }
+            offset = highOffset;
+            transitions.append(Transition(high, offset));
+        }
+        low = high;
+    }
+
+    transitions.shrinkToFit();
+    return transitions;
+}
+
+LocalTimeOffset LocalTimeOffsetTable::offsetFor(double ms)
+{
+    if (ms >= m_cachedStart && ms < m_cachedEnd)
+        return m_cachedOffset;
+
+    if (!std::isfinite(ms))
+        return calculateLocalTimeOffset(ms);
+
+    int year = msToYear(ms);
+    int equivalentYear = equivalentYearForDST(year);
+    if (equivalentYear < firstYear || equivalentYear > lastYear)
+        return calculateLocalTimeOffset(ms);
+
+    // Work out how far calculateLocalTimeOffset() moves this instant, and over
+    // what span of real time it moves everything by that same amount: the whole
+    // year if the two years have the same number of days, otherwise the month.
+    double validStart;
+    double validEnd;
+    double shift;
+    bool leapYear = isLeapYear(year);
+    if (leapYear == isLeapYear(equivalentYear)) {
+        validStart = dateToDaysFrom1970(year, 0, 1) * msPerDay;
+        validEnd = dateToDaysFrom1970(year + 1, 0, 1) * msPerDay;
+        shift = dateToDaysFrom1970(equivalentYear, 0, 1) * msPerDay - validStart;
+    } else {
+        int month = monthFromDayInYear(dayInYear(ms, year), leapYear);
+        validStart = dateToDaysFrom1970(year, month, 1) * msPerDay;
+        validEnd = month == 11 ? dateToDaysFrom1970(year + 1, 0, 1) * msPerDay : dateToDaysFrom1970(year, month + 1, 1) * msPerDay;
+        shift = dateToDaysFrom1970(equivalentYear, month, 1) * msPerDay - validStart;
+    }
+
+    const Vector<Transition>& transitions = transitionsForYear(equivalentYear);
+    double equivalentMS = ms + shift;
+    size_t low = 0;
+    size_t high = transitions.size();
+    while (high - low > 1) {
+        size_t middle = (low + high) / 2;
+        if (transitions[middle].start <= equivalentMS)
+            low = middle;
+        else
+            high = middle;
+    }
+
+    double transitionEnd = low + 1 < transitions.size()
+        ? transitions[low + 1].start
+        : dateToDaysFrom1970(equivalentYear + 1, 0, 1) * msPerDay;
+    m_cachedStart = std::max(transitions[low].start - shift, validStart);
+    m_cachedEnd = std::min(transitionEnd - shift, validEnd);
+    m_cachedOffset = transitions[low].offset;
+    return m_cachedOffset;
+}
+
+} // namespace JSC
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LocalTimeOffsetTable_h
+#define LocalTimeOffsetTable_h
+
+#include <wtf/DateMath.h>
+#include <wtf/FixedArray.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+// Answers the same questions as calculateLocalTimeOffset() without calling into
+// the C library every time. calculateLocalTimeOffset() moves every instant to
+// the same month, day and time of an equivalent year between the current year
+// and 2037, so the table only ever has to describe those years. The first time
+// we are asked about a year, we probe it once a week and bisect down to the
+// second at which each offset change happens; after that, a lookup is a binary
+// search over the handful of transitions in that year.
+//
+// This assumes that no time zone changes its offset twice within seven days: a
+// change that is undone before the next probe is never seen, and of two changes
+// between the same pair of probes only one is found.
+class LocalTimeOffsetTable {
+    WTF_MAKE_NONCOPYABLE(LocalTimeOffsetTable);
+public:
+    JS_EXPORT_PRIVATE LocalTimeOffsetTable();
+
+    JS_EXPORT_PRIVATE LocalTimeOffset offsetFor(double utcInMilliseconds);
+
+    // Must be called when the time zone may have changed.
+    JS_EXPORT_PRIVATE void reset();
+
+private:
+    struct Transition {
+        Transition()
+            : start(0)
+        {
+        }
+
+        Transition(double start, LocalTimeOffset offset)
+            : start(start)
+            , offset(offset)
+        {
+        }
+
+        double start;
+        LocalTimeOffset offset;
+    };
+
+    static const int firstYear = 1970;
+    static const int lastYear = 2037;
+
+    const Vector<Transition>& transitionsForYear(int equivalentYear);
+
+    // Each year's transitions are sorted and the first one starts on the first
+    // of January. A year that has not been computed yet has none.
+    FixedArray<Vector<Transition>, lastYear - firstYear + 1> m_years;
+
+    // The span of real time, around the last instant we were asked about, over
+    // which the offset stays the same.
+    double m_cachedStart;
+    double m_cachedEnd;
+    LocalTimeOffset m_cachedOffset;
+};
+
+} // namespace JSC
+
+#endif // LocalTimeOffsetTable_h
@@ -231,6 +231,8 @@ inline size_t normalizePrototypeChainForChainAccess(CallFrame* callFrame, JSValu
         // Since we're accessing a prototype in a loop, it's a good bet that it
         // should not be treated as a dictionary.
         if (cell->structure()->isDictionary()) {
+            if (cell->structure()->hasBeenFlattenedBefore())
+                return InvalidPrototypeChain;
             asObject(cell)->flattenDictionaryObject(callFrame->vm());
             if (slotBase == cell)
                 slotOffset = cell->structure()->get(callFrame->vm(), propertyName); 
@@ -258,8 +260,11 @@ inline size_t normalizePrototypeChain(CallFrame* callFrame, JSCell* base)
 
         // Since we're accessing a prototype in a loop, it's a good bet that it
         // should not be treated as a dictionary.
-        if (base->structure()->isDictionary())
+        if (base->structure()->isDictionary()) {
+            if (base->structure()->hasBeenFlattenedBefore())
+                return InvalidPrototypeChain;
             asObject(base)->flattenDictionaryObject(callFrame->vm());
+        }
 
         ++count;
     }
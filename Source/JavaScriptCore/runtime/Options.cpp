@@ -109,6 +109,18 @@ static unsigned computeNumberOfGCMarkers(int maxNumberOfGCMarkers)
     return cpusToUse;
 }
 
+static unsigned computeNumberOfWorkerThreads(int maxNumberOfWorkerThreads)
+{
+    int cpusToUse = std::min(WTF::numberOfProcessorCores(), maxNumberOfWorkerThreads);
+
+    // Be paranoid, it is the OS we're dealing with, after all.
+    ASSERT(cpusToUse >= 1);
+    if (cpusToUse < 1)
+        cpusToUse = 1;
+
+    return cpusToUse;
+}
+
 bool OptionRange::init(const char* rangeString)
 {
     // rangeString should be in the form of [!]<low>[:<high>]
@@ -205,6 +217,11 @@ void Options::initialize()
     useJIT() = false;
     useDFGJIT() = false;
 #endif
+#if !ENABLE(DFG_JIT)
+    enableConcurrentJIT() = false;
+#endif
+    if (!numberOfCompilationThreads())
+        enableConcurrentJIT() = false;
 #if !ENABLE(YARR_JIT)
     useRegExpJIT() = false;
 #endif
@@ -92,6 +92,12 @@ typedef OptionRange optionRange;
     v(bool, useJIT,    true) \
     v(bool, useDFGJIT, true) \
     v(bool, useRegExpJIT, true) \
+    v(bool, useSharedRegExpJITCode, false) \
+    v(bool, useRegExpLastMatchCache, false) \
+    \
+    /* The number of structures the LLInt caches at a get_by_id or put_by_id, up to 4. */ \
+    v(unsigned, llintPolymorphicAccessCacheSize, 4) \
+    v(bool, reportLLIntPropertyCacheStatistics, false) \
     \
     v(bool, forceDFGCodeBlockLiveness, false) \
     \
@@ -112,6 +118,23 @@ typedef OptionRange optionRange;
     \
     v(bool, enableProfiler, false) \
     \
+    /* Stack traces are written to JSC_SAMPLING_PROFILER_PATH, or the current directory, when the VM is destroyed. */ \
+    v(bool, useSamplingProfiler, false) \
+    v(unsigned, samplingProfilerIntervalInMicroseconds, 1000) \
+    \
+    /* The cache directory is taken from the JSC_BYTECODE_CACHE_PATH environment variable. */ \
+    v(bool, enableBytecodeCache, false) \
+    v(unsigned, minimumBytecodeCacheSourceLength, 4096) \
+    \
+    /* Keeps the parser's function caches in serialized form in their providers across GCs. */ \
+    v(bool, serializeSourceProviderCachesOnGC, false) \
+    \
+    v(bool, enableConcurrentJIT, false) \
+    v(unsigned, numberOfCompilationThreads, computeNumberOfWorkerThreads(2)) \
+    v(bool, verboseCompilationQueue, false) \
+    v(bool, reportCompileTimes, false) \
+    v(bool, logExecutableMemoryStatisticsAtExit, false) \
+    \
     v(unsigned, maximumOptimizationCandidateInstructionCount, 10000) \
     \
     v(unsigned, maximumFunctionForCallInlineCandidateInstructionCount, 180) \
@@ -159,12 +182,23 @@ typedef OptionRange optionRange;
     v(double, minHeapUtilization, 0.8) \
     v(double, minCopiedBlockUtilization, 0.9) \
     \
+    v(bool, enableGenerationalGC, false) \
+    v(unsigned, maximumEdenCollectionsBeforeFullCollection, 8) \
+    v(double, storageGrowthFactorForFullCollection, 2) \
+    \
+    v(bool, enableIncrementalMarking, false) \
+    v(double, incrementalMarkingSliceMilliseconds, 2) \
+    v(double, minimumMutatorUtilizationDuringIncrementalMarking, 0.5) \
+    \
+    v(unsigned, numberOfFullCollectionsBeforeCodeEviction, 4) \
+    \
     v(bool, forceWeakRandomSeed, false) \
     v(unsigned, forcedWeakRandomSeed, 0) \
     \
     v(bool, useZombieMode, false) \
     v(bool, objectsAreImmortal, false) \
     v(bool, showObjectStatistics, false) \
+    v(bool, sampleAllocationSites, false) \
     \
     v(unsigned, gcMaxHeapSize, 0) \
     v(bool, recordGCPauseTimes, false) \
@@ -26,6 +26,7 @@
 #include "Lexer.h"
 #include "Operations.h"
 #include "RegExpCache.h"
+#include "RegExpJITCodeCache.h"
 #include "Yarr.h"
 #include "YarrJIT.h"
 #include <stdio.h>
@@ -262,8 +263,38 @@ RegExp* RegExp::create(VM& vm, const String& patternString, RegExpFlags flags)
     return vm.regExpCache()->lookupOrCreate(patternString, flags);
 }
 
+#if ENABLE(SHARED_REGEXP_JIT_CODE)
+bool RegExp::useSharedJITCode(VM* vm, Yarr::YarrCharSize charSize, Yarr::YarrJITCompileMode compileMode)
+{
+    if (!vm->canUseRegExpJIT() || !Options::useSharedRegExpJITCode())
+        return false;
+
+    RegExpJITCodeCache::shared()->copyCode(key(), m_regExpJITCode);
+
+    bool hasSharedCode;
+    if (compileMode == Yarr::MatchOnly)
+        hasSharedCode = charSize == Yarr::Char8 ? m_regExpJITCode.has8BitCodeMatchOnly() : m_regExpJITCode.has16BitCodeMatchOnly();
+    else
+        hasSharedCode = charSize == Yarr::Char8 ? m_regExpJITCode.has8BitCode() : m_regExpJITCode.has16BitCode();
+    if (!hasSharedCode)
+        return false;
+
+    if (!hasCode()) {
+        ASSERT(m_state == NotCompiled);
+        vm->regExpCache()->addToStrongCache(this);
+    }
+    m_state = JITCode;
+    return true;
+}
+#endif
+
 void RegExp::compile(VM* vm, Yarr::YarrCharSize charSize)
 {
+#if ENABLE(SHARED_REGEXP_JIT_CODE)
+    if (useSharedJITCode(vm, charSize, Yarr::IncludeSubpatterns))
+        return;
+#endif
+
     Yarr::YarrPattern pattern(m_patternString, ignoreCase(), multiline(), &m_constructionError);
     if (m_constructionError) {
         RELEASE_ASSERT_NOT_REACHED();
@@ -289,6 +320,10 @@ void RegExp::compile(VM* vm, Yarr::YarrCharSize charSize)
 #else
         if (!m_regExpJITCode.isFallBack()) {
             m_state = JITCode;
+#if ENABLE(SHARED_REGEXP_JIT_CODE)
+            if (Options::useSharedRegExpJITCode())
+                RegExpJITCodeCache::shared()->addCode(key(), m_regExpJITCode);
+#endif
             return;
         }
 #endif
@@ -325,9 +360,15 @@ int RegExp::match(VM& vm, const String& s, unsigned startOffset, Vector<int, 32>
 #endif
 
     ASSERT(m_state != ParseError);
-    compileIfNecessary(vm, s.is8Bit() ? Yarr::Char8 : Yarr::Char16);
 
     int offsetVectorSize = (m_numSubpatterns + 1) * 2;
+    if (hasLastMatch(s, startOffset) && m_lastMatch->hasSubpatterns) {
+        ovector = m_lastMatch->offsets;
+        return m_lastMatch->result;
+    }
+
+    compileIfNecessary(vm, s.is8Bit() ? Yarr::Char8 : Yarr::Char16);
+
     ovector.resize(offsetVectorSize);
     int* offsetVector = ovector.data();
 
@@ -381,11 +422,19 @@ int RegExp::match(VM& vm, const String& s, unsigned startOffset, Vector<int, 32>
         m_rtMatchFoundCount++;
 #endif
 
+    if (Options::useRegExpLastMatchCache())
+        setLastMatch(vm, s, startOffset, result, offsetVector, offsetVectorSize);
+
     return result;
 }
 
 void RegExp::compileMatchOnly(VM* vm, Yarr::YarrCharSize charSize)
 {
+#if ENABLE(SHARED_REGEXP_JIT_CODE)
+    if (useSharedJITCode(vm, charSize, Yarr::MatchOnly))
+        return;
+#endif
+
     Yarr::YarrPattern pattern(m_patternString, ignoreCase(), multiline(), &m_constructionError);
     if (m_constructionError) {
         RELEASE_ASSERT_NOT_REACHED();
@@ -411,6 +460,10 @@ void RegExp::compileMatchOnly(VM* vm, Yarr::YarrCharSize charSize)
 #else
         if (!m_regExpJITCode.isFallBack()) {
             m_state = JITCode;
+#if ENABLE(SHARED_REGEXP_JIT_CODE)
+            if (Options::useSharedRegExpJITCode())
+                RegExpJITCodeCache::shared()->addCode(key(), m_regExpJITCode);
+#endif
             return;
         }
 #endif
@@ -447,6 +500,13 @@ MatchResult RegExp::match(VM& vm, const String& s, unsigned startOffset)
 #endif
 
     ASSERT(m_state != ParseError);
+
+    if (hasLastMatch(s, startOffset)) {
+        if (m_lastMatch->result < 0)
+            return MatchResult::failed();
+        return MatchResult(m_lastMatch->result, m_lastMatch->offsets[1]);
+    }
+
     compileIfNecessaryMatchOnly(vm, s.is8Bit() ? Yarr::Char8 : Yarr::Char16);
 
 #if ENABLE(YARR_JIT)
@@ -458,6 +518,10 @@ MatchResult RegExp::match(VM& vm, const String& s, unsigned startOffset)
         if (!result)
             m_rtMatchFoundCount++;
 #endif
+        if (Options::useRegExpLastMatchCache()) {
+            int offsets[2] = { result ? static_cast<int>(result.start) : -1, result ? static_cast<int>(result.end) : -1 };
+            setLastMatch(vm, s, startOffset, offsets[0], offsets, 2);
+        }
         return result;
     }
 #endif
@@ -472,6 +536,9 @@ MatchResult RegExp::match(VM& vm, const String& s, unsigned startOffset)
     RegExpFunctionalTestCollector::get()->outputOneTest(this, s, startOffset, offsetVector, result);
 #endif
 
+    if (Options::useRegExpLastMatchCache())
+        setLastMatch(vm, s, startOffset, r, offsetVector, offsetVectorSize);
+
     if (r >= 0) {
 #if ENABLE(REGEXP_TRACING)
         m_rtMatchFoundCount++;
@@ -482,8 +549,26 @@ MatchResult RegExp::match(VM& vm, const String& s, unsigned startOffset)
     return MatchResult::failed();
 }
 
+void RegExp::setLastMatch(VM& vm, const String& s, unsigned startOffset, int result, const int* offsetVector, unsigned offsetVectorSize)
+{
+    if (!m_lastMatch)
+        m_lastMatch = adoptPtr(new LastMatch);
+
+    // The memo may be all that keeps a large input alive, so let the GC know about it.
+    if (m_lastMatch->input != s.impl() && s.impl())
+        vm.heap.reportExtraMemoryCost(s.impl()->sizeInBytes());
+
+    m_lastMatch->input = s.impl();
+    m_lastMatch->startOffset = startOffset;
+    m_lastMatch->result = result;
+    m_lastMatch->hasSubpatterns = offsetVectorSize == (m_numSubpatterns + 1) * 2;
+    m_lastMatch->offsets.clear();
+    m_lastMatch->offsets.append(offsetVector, offsetVectorSize);
+}
+
 void RegExp::invalidateCode()
 {
+    m_lastMatch.clear();
     if (!hasCode())
         return;
     m_state = NotCompiled;
@@ -32,6 +32,7 @@
 #include <wtf/text/WTFString.h>
 
 #if ENABLE(YARR_JIT)
+#include "RegExpJITCodeCache.h"
 #include "yarr/YarrJIT.h"
 #endif
 
@@ -106,6 +107,13 @@ namespace JSC {
         void compileMatchOnly(VM*, Yarr::YarrCharSize);
         void compileIfNecessaryMatchOnly(VM&, Yarr::YarrCharSize);
 
+#if ENABLE(SHARED_REGEXP_JIT_CODE)
+        bool useSharedJITCode(VM*, Yarr::YarrCharSize, Yarr::YarrJITCompileMode);
+#endif
+
+        bool hasLastMatch(const String& s, unsigned startOffset) const { return m_lastMatch && m_lastMatch->input == s.impl() && m_lastMatch->startOffset == startOffset; }
+        void setLastMatch(VM&, const String&, unsigned startOffset, int result, const int* offsetVector, unsigned offsetVectorSize);
+
 #if ENABLE(YARR_JIT_DEBUG)
         void matchCompareWithInterpreter(const String&, int startOffset, int* offsetVector, int jitResult);
 #endif
@@ -123,6 +131,20 @@ namespace JSC {
         Yarr::YarrCodeBlock m_regExpJITCode;
 #endif
         OwnPtr<Yarr::BytecodePattern> m_regExpBytecode;
+
+        // The result of the last match, if Options::useRegExpLastMatchCache() is set.
+        // Strings are immutable, so matching the same one from the same offset again
+        // has the same result. We hold on to the input so that its address stays unique.
+        struct LastMatch {
+            WTF_MAKE_FAST_ALLOCATED;
+        public:
+            RefPtr<StringImpl> input;
+            unsigned startOffset;
+            int result;
+            bool hasSubpatterns;
+            Vector<int> offsets;
+        };
+        OwnPtr<LastMatch> m_lastMatch;
     };
 
 } // namespace JSC
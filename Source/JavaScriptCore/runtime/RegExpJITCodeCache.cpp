@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "RegExpJITCodeCache.h"
+
+#if ENABLE(SHARED_REGEXP_JIT_CODE)
+
+namespace JSC {
+
+RegExpJITCodeCache* RegExpJITCodeCache::s_shared;
+
+void RegExpJITCodeCache::initialize()
+{
+    ASSERT(!s_shared);
+    s_shared = new RegExpJITCodeCache();
+}
+
+void RegExpJITCodeCache::copyCode(const RegExpKey& key, Yarr::YarrCodeBlock& codeBlock)
+{
+    MutexLocker locker(m_lock);
+    HashMap<RegExpKey, Yarr::YarrCodeBlock>::iterator iter = m_entries.find(key);
+    if (iter != m_entries.end())
+        codeBlock.addCodeFrom(iter->value);
+}
+
+void RegExpJITCodeCache::addCode(const RegExpKey& key, const Yarr::YarrCodeBlock& codeBlock)
+{
+    ASSERT(key.pattern);
+    RegExpKey isolatedKey(key.flagsValue, String(key.pattern.get()).isolatedCopy());
+
+    MutexLocker locker(m_lock);
+    HashMap<RegExpKey, Yarr::YarrCodeBlock>::AddResult result = m_entries.add(isolatedKey, Yarr::YarrCodeBlock());
+    result.iterator->value.addCodeFrom(codeBlock);
+    if (!result.isNewEntry)
+        return;
+
+    m_insertionOrder.append(isolatedKey);
+    if (m_insertionOrder.size() > maximumNumberOfEntries)
+        m_entries.remove(m_insertionOrder.takeFirst());
+}
+
+void RegExpJITCodeCache::removeUnusedCode()
+{
+    MutexLocker locker(m_lock);
+    // RegExps only take references while holding the lock, so no entry can become
+    // used again while we look.
+    Deque<RegExpKey> insertionOrder;
+    insertionOrder.swap(m_insertionOrder);
+    while (!insertionOrder.isEmpty()) {
+        RegExpKey key = insertionOrder.takeFirst();
+        HashMap<RegExpKey, Yarr::YarrCodeBlock>::iterator iter = m_entries.find(key);
+        ASSERT(iter != m_entries.end());
+        if (iter->value.isOnlyOwner())
+            m_entries.remove(iter);
+        else
+            m_insertionOrder.append(key);
+    }
+}
+
+} // namespace JSC
+
+#endif // ENABLE(SHARED_REGEXP_JIT_CODE)
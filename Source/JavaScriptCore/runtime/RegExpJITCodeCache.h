@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RegExpJITCodeCache_h
+#define RegExpJITCodeCache_h
+
+#include <wtf/Platform.h>
+
+#if ENABLE(SHARED_REGEXP_JIT_CODE)
+
+#include "RegExpKey.h"
+#include "yarr/YarrJIT.h"
+#include <wtf/Deque.h>
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+
+namespace JSC {
+
+// A process-wide cache of the code the YARR JIT generates, keyed by pattern and flags,
+// so that VMs on different threads that use the same regular expressions only compile
+// them once. The generated code does not depend on the VM that compiled it, and its
+// executable memory is reference counted atomically, so a RegExp can keep running
+// code that has since been evicted from here.
+class RegExpJITCodeCache {
+    WTF_MAKE_NONCOPYABLE(RegExpJITCodeCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static void initialize();
+    static RegExpJITCodeCache* shared() { return s_shared; }
+
+    // Copies into the code block whatever code has been compiled for this key that
+    // it does not already have.
+    void copyCode(const RegExpKey&, Yarr::YarrCodeBlock&);
+
+    // Publishes the code in the code block, which must not be a fall back.
+    void addCode(const RegExpKey&, const Yarr::YarrCodeBlock&);
+
+    // Drops the code that no RegExp in any VM uses any more. Code that other VMs
+    // still run stays shared.
+    void removeUnusedCode();
+
+private:
+    RegExpJITCodeCache() { }
+
+    // Bounds the number of patterns whose code we keep alive.
+    static const unsigned maximumNumberOfEntries = 1024;
+
+    static RegExpJITCodeCache* s_shared;
+
+    Mutex m_lock;
+    // Keys are isolated copies, which are never ref'ed outside the lock.
+    HashMap<RegExpKey, Yarr::YarrCodeBlock> m_entries;
+    Deque<RegExpKey> m_insertionOrder;
+};
+
+} // namespace JSC
+
+#endif // ENABLE(SHARED_REGEXP_JIT_CODE)
+
+#endif // RegExpJITCodeCache_h
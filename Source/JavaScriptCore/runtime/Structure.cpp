@@ -163,6 +163,7 @@ Structure::Structure(VM& vm, JSGlobalObject* globalObject, JSValue prototype, co
     , m_inlineCapacity(inlineCapacity)
     , m_dictionaryKind(NoneDictionaryKind)
     , m_isPinnedPropertyTable(false)
+    , m_hasBeenFlattenedBefore(false)
     , m_hasGetterSetterProperties(false)
     , m_hasReadOnlyOrGetterSetterPropertiesExcludingProto(false)
     , m_hasNonEnumerableProperties(false)
@@ -190,6 +191,7 @@ Structure::Structure(VM& vm)
     , m_inlineCapacity(0)
     , m_dictionaryKind(NoneDictionaryKind)
     , m_isPinnedPropertyTable(false)
+    , m_hasBeenFlattenedBefore(false)
     , m_hasGetterSetterProperties(false)
     , m_hasReadOnlyOrGetterSetterPropertiesExcludingProto(false)
     , m_hasNonEnumerableProperties(false)
@@ -212,6 +214,7 @@ Structure::Structure(VM& vm, const Structure* previous)
     , m_inlineCapacity(previous->m_inlineCapacity)
     , m_dictionaryKind(previous->m_dictionaryKind)
     , m_isPinnedPropertyTable(false)
+    , m_hasBeenFlattenedBefore(previous->m_hasBeenFlattenedBefore)
     , m_hasGetterSetterProperties(previous->m_hasGetterSetterProperties)
     , m_hasReadOnlyOrGetterSetterPropertiesExcludingProto(previous->m_hasReadOnlyOrGetterSetterPropertiesExcludingProto)
     , m_hasNonEnumerableProperties(previous->m_hasNonEnumerableProperties)
@@ -408,7 +411,7 @@ Structure* Structure::changePrototypeTransition(VM& vm, Structure* structure, JS
     transition->m_prototype.set(vm, transition, prototype);
 
     structure->materializePropertyMapIfNecessary(vm);
-    transition->propertyTable().set(vm, transition, structure->copyPropertyTableForPinning(vm, transition));
+    transition->propertyTable().set(vm, transition, structure->takePropertyTableOrCloneForPinning(vm, transition));
     transition->m_offset = structure->m_offset;
     transition->pin();
 
@@ -424,7 +427,7 @@ Structure* Structure::despecifyFunctionTransition(VM& vm, Structure* structure,
     ++transition->m_specificFunctionThrashCount;
 
     structure->materializePropertyMapIfNecessary(vm);
-    transition->propertyTable().set(vm, transition, structure->copyPropertyTableForPinning(vm, transition));
+    transition->propertyTable().set(vm, transition, structure->takePropertyTableOrCloneForPinning(vm, transition));
     transition->m_offset = structure->m_offset;
     transition->pin();
 
@@ -445,7 +448,7 @@ Structure* Structure::attributeChangeTransition(VM& vm, Structure* structure, Pr
         Structure* transition = create(vm, structure);
 
         structure->materializePropertyMapIfNecessary(vm);
-        transition->propertyTable().set(vm, transition, structure->copyPropertyTableForPinning(vm, transition));
+        transition->propertyTable().set(vm, transition, structure->takePropertyTableOrCloneForPinning(vm, transition));
         transition->m_offset = structure->m_offset;
         transition->pin();
         
@@ -468,7 +471,7 @@ Structure* Structure::toDictionaryTransition(VM& vm, Structure* structure, Dicti
     Structure* transition = create(vm, structure);
 
     structure->materializePropertyMapIfNecessary(vm);
-    transition->propertyTable().set(vm, transition, structure->copyPropertyTableForPinning(vm, transition));
+    transition->propertyTable().set(vm, transition, structure->takePropertyTableOrCloneForPinning(vm, transition));
     transition->m_offset = structure->m_offset;
     transition->m_dictionaryKind = kind;
     transition->pin();
@@ -528,7 +531,7 @@ Structure* Structure::preventExtensionsTransition(VM& vm, Structure* structure)
     // Don't set m_offset, as one can not transition to this.
 
     structure->materializePropertyMapIfNecessary(vm);
-    transition->propertyTable().set(vm, transition, structure->copyPropertyTableForPinning(vm, transition));
+    transition->propertyTable().set(vm, transition, structure->takePropertyTableOrCloneForPinning(vm, transition));
     transition->m_offset = structure->m_offset;
     transition->m_preventExtensions = true;
     transition->pin();
@@ -649,6 +652,7 @@ Structure* Structure::flattenDictionaryStructure(VM& vm, JSObject* object)
     }
 
     m_dictionaryKind = NoneDictionaryKind;
+    m_hasBeenFlattenedBefore = true;
     return this;
 }
 
@@ -736,8 +740,16 @@ PropertyTable* Structure::copyPropertyTable(VM& vm, Structure* owner)
     return PropertyTable::clone(vm, owner, *propertyTable().get());
 }
 
-PropertyTable* Structure::copyPropertyTableForPinning(VM& vm, Structure* owner)
+PropertyTable* Structure::takePropertyTableOrCloneForPinning(VM& vm, Structure* owner)
 {
+    // An unpinned structure can rebuild its table from the transitions that led
+    // to it, which it has to do after every collection anyway, so the structure
+    // that is about to pin the table may as well have it.
+    if (!m_isPinnedPropertyTable && previousID() && propertyTable()) {
+        PropertyTable* takenPropertyTable = propertyTable().get();
+        propertyTable().clear();
+        return takenPropertyTable;
+    }
     if (propertyTable())
         return PropertyTable::clone(vm, owner, *propertyTable().get());
     return PropertyTable::create(vm, numberOfSlotsForLastOffset(m_offset, m_inlineCapacity));
@@ -124,6 +124,11 @@ public:
     bool isDictionary() const { return m_dictionaryKind != NoneDictionaryKind; }
     bool isUncacheableDictionary() const { return m_dictionaryKind == UncachedDictionaryKind; }
 
+    // An object that has gone back to being a dictionary after we flattened it is
+    // being used as a hash map. Caches give up on it instead of flattening it
+    // again, since every round trip copies its whole property table.
+    bool hasBeenFlattenedBefore() const { return m_hasBeenFlattenedBefore; }
+
     bool propertyAccessesAreCacheable() { return m_dictionaryKind != UncachedDictionaryKind && !typeInfo().prohibitsPropertyCaching(); }
 
     // Type accessors.
@@ -372,7 +377,7 @@ private:
     WriteBarrier<PropertyTable>& propertyTable();
     PropertyTable* takePropertyTableOrCloneIfPinned(VM&, Structure* owner);
     PropertyTable* copyPropertyTable(VM&, Structure* owner);
-    PropertyTable* copyPropertyTableForPinning(VM&, Structure* owner);
+    PropertyTable* takePropertyTableOrCloneForPinning(VM&, Structure* owner);
     JS_EXPORT_PRIVATE void materializePropertyMap(VM&);
     void materializePropertyMapIfNecessary(VM& vm)
     {
@@ -466,6 +471,7 @@ private:
     uint8_t m_inlineCapacity;
     unsigned m_dictionaryKind : 2;
     bool m_isPinnedPropertyTable : 1;
+    bool m_hasBeenFlattenedBefore : 1;
     bool m_hasGetterSetterProperties : 1;
     bool m_hasReadOnlyOrGetterSetterPropertiesExcludingProto : 1;
     bool m_hasNonEnumerableProperties : 1;
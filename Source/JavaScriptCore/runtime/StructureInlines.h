@@ -92,6 +92,10 @@ ALWAYS_INLINE void SlotVisitor::internalAppend(JSCell* cell)
 #if ENABLE(GC_VALIDATION)
     validate(cell);
 #endif
+    if (UNLIKELY(!!m_heapSnapshotWriter)) {
+        appendToHeapSnapshot(cell);
+        return;
+    }
     if (Heap::testAndSetMarked(cell) || !cell->structure())
         return;
 
@@ -30,9 +30,11 @@
 #include "VM.h"
 
 #include "ArgList.h"
+#include "BytecodeCache.h"
 #include "CodeCache.h"
 #include "CommonIdentifiers.h"
 #include "DFGLongLivedState.h"
+#include "DFGWorklist.h"
 #include "DebuggerActivation.h"
 #include "FunctionConstructor.h"
 #include "GCActivityCallback.h"
@@ -55,7 +57,9 @@
 #include "Nodes.h"
 #include "ParserArena.h"
 #include "RegExpCache.h"
+#include "RegExpJITCodeCache.h"
 #include "RegExpObject.h"
+#include "SamplingProfiler.h"
 #include "SourceProviderCache.h"
 #include "StrictEvalActivation.h"
 #include "StrongInlines.h"
@@ -162,7 +166,7 @@ VM::VM(VMType vmType, HeapType heapType)
     , identifierTable(vmType == Default ? wtfThreadData().currentIdentifierTable() : createIdentifierTable())
     , propertyNames(new CommonIdentifiers(this))
     , emptyList(new MarkedArgumentBuffer)
-    , parserArena(adoptPtr(new ParserArena))
+    , parserArena(adoptPtr(new ParserArena(ParserArenaPoolCache::create())))
     , keywords(adoptPtr(new Keywords(this)))
     , interpreter(0)
     , jsArrayClassInfo(&JSArray::s_info)
@@ -257,9 +261,25 @@ VM::VM(VMType vmType, HeapType heapType)
         m_perBytecodeProfiler->registerToSaveAtExit(pathOut.toCString().data());
     }
 
+#if !OS(WINCE)
+    if (Options::enableBytecodeCache()) {
+        const char* bytecodeCachePath = getenv("JSC_BYTECODE_CACHE_PATH");
+        if (bytecodeCachePath && *bytecodeCachePath)
+            m_bytecodeCache = BytecodeCache::create(String::fromUTF8(bytecodeCachePath));
+    }
+#endif
+
 #if ENABLE(DFG_JIT)
-    if (canUseJIT())
+    if (canUseJIT()) {
         m_dfgState = adoptPtr(new DFG::LongLivedState());
+        if (Options::useDFGJIT() && Options::enableConcurrentJIT())
+            m_dfgWorklist = DFG::Worklist::create(Options::numberOfCompilationThreads());
+    }
+#endif
+
+#if ENABLE(SAMPLING_PROFILER)
+    if (Options::useSamplingProfiler() && canUseJIT())
+        m_samplingProfiler = SamplingProfiler::create(*this);
 #endif
 }
 
@@ -270,6 +290,33 @@ VM::~VM()
     
     ASSERT(m_apiLock->currentThreadIsHoldingLock());
     m_apiLock->willDestroyVM(this);
+
+#if ENABLE(DFG_JIT)
+    // Stop the compiler threads before the heap goes away; pending plans hold
+    // CodeBlocks that reference it.
+    m_dfgWorklist.clear();
+#endif
+
+#if ENABLE(SAMPLING_PROFILER)
+    // Stack traces name functions through their CodeBlocks, so write them out
+    // while those are still alive.
+    if (m_samplingProfiler) {
+        StringPrintStream pathOut;
+        if (const char* samplingProfilerPath = getenv("JSC_SAMPLING_PROFILER_PATH"))
+            pathOut.print(samplingProfilerPath, "/");
+        pathOut.print("JSCSamples-", getCurrentProcessID(), "-", m_samplingProfiler->profilerID(), ".txt");
+        if (!m_samplingProfiler->save(pathOut.toCString().data()))
+            dataLog("Could not write sampling profile to ", pathOut.toCString(), "\n");
+        m_samplingProfiler.clear();
+    }
+#endif
+
+    // Write out whatever we have compiled while the code blocks are still alive.
+    if (m_bytecodeCache) {
+        m_bytecodeCache->flush();
+        m_bytecodeCache.clear();
+    }
+
     heap.lastChanceToFinalize();
 
     delete interpreter;
@@ -424,7 +471,7 @@ VM::ClientData::~ClientData()
 
 void VM::resetDateCache()
 {
-    localTimeOffsetCache.reset();
+    localTimeOffsetTable.reset();
     cachedDateString = String();
     cachedDateStringValue = QNaN;
     dateInstanceCache.reset();
@@ -458,13 +505,36 @@ void VM::dumpSampleData(ExecState* exec)
 SourceProviderCache* VM::addSourceProviderCache(SourceProvider* sourceProvider)
 {
     SourceProviderCacheMap::AddResult addResult = sourceProviderCacheMap.add(sourceProvider, 0);
-    if (addResult.isNewEntry)
+    if (addResult.isNewEntry) {
         addResult.iterator->value = adoptRef(new SourceProviderCache);
+        // Reload the function cache from before the last GC, or from an earlier load
+        // if the embedder kept one.
+        if (!sourceProvider->serializedFunctionCache().isEmpty()
+            && !addResult.iterator->value->deserialize(*this, sourceProvider, sourceProvider->serializedFunctionCache()))
+            sourceProvider->clearSerializedFunctionCache();
+    }
     return addResult.iterator->value.get();
 }
 
+void VM::serializeSourceProviderCaches()
+{
+    SourceProviderCacheMap::iterator end = sourceProviderCacheMap.end();
+    for (SourceProviderCacheMap::iterator iter = sourceProviderCacheMap.begin(); iter != end; ++iter) {
+        if (!iter->value->hasUnserializedItems())
+            continue;
+        Vector<uint8_t> buffer;
+        iter->value->serialize(iter->key.get(), buffer);
+        iter->key->setSerializedFunctionCache(buffer);
+    }
+}
+
 void VM::clearSourceProviderCaches()
 {
+    // The caches are thrown away on every GC. Serializing them costs time on every GC
+    // too, so by default only embedders that ask for it keep the much smaller
+    // serialized form for when the same functions get parsed again.
+    if (Options::serializeSourceProviderCachesOnGC())
+        serializeSourceProviderCaches();
     sourceProviderCacheMap.clear();
 }
 
@@ -483,6 +553,9 @@ struct StackPreservingRecompiler : public MarkedBlock::VoidFunctor {
 
 void VM::releaseExecutableMemory()
 {
+    // Throwing away code in the middle of incremental marking is not allowed.
+    heap.finishIncrementalMarking();
+
     if (dynamicGlobalObject) {
         StackPreservingRecompiler recompiler;
         HashSet<JSCell*> roots;
@@ -510,6 +583,9 @@ void VM::releaseExecutableMemory()
         heap.objectSpace().forEachLiveCell<StackPreservingRecompiler>(recompiler);
     }
     m_regExpCache->invalidateCode();
+#if ENABLE(SHARED_REGEXP_JIT_CODE)
+    RegExpJITCodeCache::shared()->removeUnusedCode();
+#endif
     heap.collectAllGarbage();
 }
 
@@ -39,6 +39,7 @@
 #include "JSCJSValue.h"
 #include "JSLock.h"
 #include "LLIntData.h"
+#include "LocalTimeOffsetTable.h"
 #include "MacroAssemblerCodeRef.h"
 #include "NumericStrings.h"
 #include "ProfilerDatabase.h"
@@ -65,6 +66,7 @@
 
 namespace JSC {
 
+    class BytecodeCache;
     class CodeBlock;
     class CodeCache;
     class CommonIdentifiers;
@@ -80,6 +82,7 @@ namespace JSC {
     class NativeExecutable;
     class ParserArena;
     class RegExpCache;
+    class SamplingProfiler;
     class SourceProvider;
     class SourceProviderCache;
     struct StackFrame;
@@ -96,34 +99,13 @@ namespace JSC {
 #if ENABLE(DFG_JIT)
     namespace DFG {
     class LongLivedState;
+    class Worklist;
     }
 #endif // ENABLE(DFG_JIT)
 
     struct HashTable;
     struct Instruction;
 
-    struct LocalTimeOffsetCache {
-        LocalTimeOffsetCache()
-            : start(0.0)
-            , end(-1.0)
-            , increment(0.0)
-        {
-        }
-        
-        void reset()
-        {
-            offset = LocalTimeOffset();
-            start = 0.0;
-            end = -1.0;
-            increment = 0.0;
-        }
-
-        LocalTimeOffset offset;
-        double start;
-        double end;
-        double increment;
-    };
-
 #if ENABLE(DFG_JIT)
     class ConservativeRoots;
 
@@ -209,6 +191,8 @@ namespace JSC {
         
 #if ENABLE(DFG_JIT)
         OwnPtr<DFG::LongLivedState> m_dfgState;
+        OwnPtr<DFG::Worklist> m_dfgWorklist;
+        DFG::Worklist* dfgWorklist() { return m_dfgWorklist.get(); }
 #endif // ENABLE(DFG_JIT)
 
         VMType vmType;
@@ -310,6 +294,9 @@ namespace JSC {
 
         SourceProviderCache* addSourceProviderCache(SourceProvider*);
         void clearSourceProviderCaches();
+        // Saves the parser's function caches into their providers, see
+        // SourceProvider::serializedFunctionCache().
+        JS_EXPORT_PRIVATE void serializeSourceProviderCaches();
 
         PrototypeMap prototypeMap;
 
@@ -373,7 +360,7 @@ namespace JSC {
 
         HashSet<JSObject*> stringRecursionCheckVisitedObjects;
 
-        LocalTimeOffsetCache localTimeOffsetCache;
+        LocalTimeOffsetTable localTimeOffsetTable;
         
         String cachedDateString;
         double cachedDateStringValue;
@@ -471,6 +458,10 @@ namespace JSC {
 
         JSLock& apiLock() { return *m_apiLock; }
         CodeCache* codeCache() { return m_codeCache.get(); }
+        BytecodeCache* bytecodeCache() { return m_bytecodeCache.get(); }
+#if ENABLE(SAMPLING_PROFILER)
+        SamplingProfiler* samplingProfiler() { return m_samplingProfiler.get(); }
+#endif
 
         JS_EXPORT_PRIVATE void discardAllCode();
 
@@ -494,6 +485,10 @@ namespace JSC {
 #endif
         bool m_inDefineOwnProperty;
         RefPtr<CodeCache> m_codeCache;
+        OwnPtr<BytecodeCache> m_bytecodeCache;
+#if ENABLE(SAMPLING_PROFILER)
+        OwnPtr<SamplingProfiler> m_samplingProfiler;
+#endif
         RefCountedArray<StackFrame> m_exceptionStack;
 
         TypedArrayDescriptor m_int8ArrayDescriptor;
@@ -60,11 +60,13 @@ struct CommandLine {
     CommandLine()
         : interactive(false)
         , verbose(false)
+        , benchmark(false)
     {
     }
 
     bool interactive;
     bool verbose;
+    bool benchmark;
     Vector<String> arguments;
     Vector<String> files;
 };
@@ -470,6 +472,64 @@ static bool runFromFiles(GlobalObject* globalObject, const Vector<String>& files
     return success;
 }
 
+struct RegExpBenchmark {
+    const char* pattern;
+    RegExpFlags flags;
+};
+
+static const RegExpBenchmark regExpBenchmarks[] = {
+    { "foo[a-z]+", NoFlags },
+    { "needle", FlagIgnoreCase },
+    { "[<>&]", NoFlags },
+    { "x", NoFlags },
+};
+
+static String benchmarkSubject(bool is8Bit, const char* tail)
+{
+    static const unsigned subjectLength = 1024 * 1024;
+    static const char filler[] = "lorem ipsum dolor sit amet, consectetur adipiscing elit. ";
+
+    // Every pattern matches only at the very end, so each iteration scans the whole subject.
+    StringBuilder builder;
+    builder.reserveCapacity(subjectLength);
+    if (!is8Bit)
+        builder.append(static_cast<UChar>(0x2026));
+    while (builder.length() + sizeof(filler) - 1 + strlen(tail) <= subjectLength)
+        builder.append(filler, sizeof(filler) - 1);
+    builder.append(tail, strlen(tail));
+    return builder.toString();
+}
+
+static void runBenchmarks(GlobalObject* globalObject)
+{
+    static const unsigned iterations = 50;
+
+    VM& vm = globalObject->vm();
+    for (unsigned i = 0; i < 2; ++i) {
+        bool is8Bit = !i;
+        String subject = benchmarkSubject(is8Bit, "<foobar needle x>");
+        ASSERT(subject.is8Bit() == is8Bit);
+        printf("%s subject of %u characters:\n", is8Bit ? "Latin-1" : "UTF-16", subject.length());
+
+        for (size_t j = 0; j < WTF_ARRAY_LENGTH(regExpBenchmarks); ++j) {
+            RegExp* regexp = RegExp::create(vm, regExpBenchmarks[j].pattern, regExpBenchmarks[j].flags);
+            Vector<int, 32> outVector;
+
+            // The first match compiles the expression; leave it out of the timing.
+            int result = regexp->match(vm, subject, 0, outVector);
+
+            StopWatch stopWatch;
+            stopWatch.start();
+            for (unsigned k = 0; k < iterations; ++k)
+                regexp->match(vm, subject, 0, outVector);
+            stopWatch.stop();
+
+            printf("  /%s/%s: match at %d, %.2f ms per match\n", regExpBenchmarks[j].pattern, regExpBenchmarks[j].flags & FlagIgnoreCase ? "i" : "",
+                result, static_cast<double>(stopWatch.getElapsedMS()) / iterations);
+        }
+    }
+}
+
 #define RUNNING_FROM_XCODE 0
 
 static NO_RETURN void printUsageStatement(bool help = false)
@@ -477,6 +537,7 @@ static NO_RETURN void printUsageStatement(bool help = false)
     fprintf(stderr, "Usage: regexp_test [options] file\n");
     fprintf(stderr, "  -h|--help  Prints this help message\n");
     fprintf(stderr, "  -v|--verbose  Verbose output\n");
+    fprintf(stderr, "  -b|--benchmark  Time matches against large Latin-1 and UTF-16 subjects\n");
 
     exit(help ? EXIT_SUCCESS : EXIT_FAILURE);
 }
@@ -490,6 +551,8 @@ static void parseArguments(int argc, char** argv, CommandLine& options)
             printUsageStatement(true);
         if (!strcmp(arg, "-v") || !strcmp(arg, "--verbose"))
             options.verbose = true;
+        else if (!strcmp(arg, "-b") || !strcmp(arg, "--benchmark"))
+            options.benchmark = true;
         else
             options.files.append(argv[i]);
     }
@@ -508,6 +571,8 @@ int realMain(int argc, char** argv)
 
     GlobalObject* globalObject = GlobalObject::create(*vm, GlobalObject::createStructure(*vm, jsNull()), options.arguments);
     bool success = runFromFiles(globalObject, options.files, options.verbose);
+    if (options.benchmark)
+        runBenchmarks(globalObject);
 
     return success ? 0 : 3;
 }
@@ -0,0 +1,19 @@
+(function () {
+    var seed = 1;
+    function random() {
+        seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+        return seed;
+    }
+
+    var records = new Array(20000);
+    for (var i = 0; i < records.length; ++i)
+        records[i] = { key: random() % 1000, index: i };
+
+    for (var i = 0; i < 20; ++i) {
+        var sorted = records.slice().sort(function (a, b) { return a.key - b.key; });
+        for (var j = 1; j < sorted.length; ++j) {
+            if (sorted[j - 1].key == sorted[j].key && sorted[j - 1].index > sorted[j].index)
+                throw "Sort was not stable";
+        }
+    }
+})();
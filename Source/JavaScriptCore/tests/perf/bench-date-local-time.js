@@ -0,0 +1,20 @@
+(function () {
+    // Formats timestamps spread over a few years, the way a dashboard would, and
+    // parses the ISO strings that JSON gives us back.
+    var start = Date.UTC(2011, 0, 1);
+    var strings = [];
+    for (var i = 0; i < 20000; ++i)
+        strings.push(new Date(start + ((i * 7919) % 20000) * 5003000).toISOString());
+
+    for (var j = 0; j < 10; ++j) {
+        var hours = 0;
+        for (var i = 0; i < strings.length; ++i) {
+            var date = new Date(Date.parse(strings[i]));
+            hours += date.getHours();
+            if (date.toISOString() != strings[i])
+                throw "Bad round trip: " + strings[i];
+        }
+        if (!(hours > 0))
+            throw "Bad hours: " + hours;
+    }
+})();
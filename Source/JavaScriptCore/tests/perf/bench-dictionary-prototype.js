@@ -0,0 +1,14 @@
+(function () {
+    // Methods are added to a prototype that is already being called through,
+    // which used to flatten it and copy its property table on every add.
+    function Thing() { }
+    var thing = new Thing();
+    var sum = 0;
+    for (var i = 0; i < 20000; ++i) {
+        Thing.prototype["method" + i] = function () { return 1; };
+        sum += thing["method" + (i >> 1)]();
+        sum += thing.method0();
+    }
+    if (sum != 40000)
+        throw "Bad sum: " + sum;
+})();
@@ -0,0 +1,12 @@
+(function () {
+    var records = [];
+    for (var i = 0; i < 5000; ++i)
+        records.push({ id: i, name: "record number " + i, email: "user" + i + "@example.com", active: !!(i & 1), score: i / 7 });
+    var text = JSON.stringify(records, null, 4);
+
+    for (var i = 0; i < 50; ++i) {
+        var result = JSON.parse(text);
+        if (result.length != records.length || result[4999].email != "user4999@example.com")
+            throw "Bad parse";
+    }
+})();
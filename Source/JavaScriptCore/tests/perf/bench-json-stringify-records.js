@@ -0,0 +1,11 @@
+(function () {
+    var events = [];
+    for (var i = 0; i < 5000; ++i)
+        events.push({ type: "click", target: "button-" + (i % 20), timestamp: 1370000000000 + i, x: i % 1024, y: (i * 7) % 768, duration: i / 3 });
+
+    for (var i = 0; i < 50; ++i) {
+        var text = JSON.stringify({ session: "abc", events: events });
+        if (text.length < events.length * 80)
+            throw "Bad stringify";
+    }
+})();
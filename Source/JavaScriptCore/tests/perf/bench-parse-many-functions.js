@@ -0,0 +1,16 @@
+(function () {
+    // Every function is parsed once by eval and again when it is first called.
+    var source = "";
+    for (var i = 0; i < 3000; ++i)
+        source += "function f" + i + "(a, b) { var c = a + b * " + i + "; if (c > 10) return [c, { x: a, y: b }]; return c - " + i + "; }\n";
+    source += "[" + Array.apply(null, { length: 3000 }).map(function (x, i) { return "f" + i; }).join(", ") + "]";
+
+    for (var j = 0; j < 10; ++j) {
+        var functions = eval(source + " // " + j);
+        var sum = 0;
+        for (var i = 0; i < functions.length; ++i)
+            sum += typeof functions[i](1, 2) == "number" ? 1 : 0;
+        if (sum != 5)
+            throw "Bad sum: " + sum;
+    }
+})();
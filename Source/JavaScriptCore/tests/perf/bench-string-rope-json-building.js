@@ -0,0 +1,15 @@
+(function () {
+    // Builds JSON text with += and peeks at what has been built so far, the way
+    // hand-written serializers check for a trailing comma or an opening bracket.
+    for (var i = 0; i < 200; ++i) {
+        var json = "[";
+        for (var j = 0; j < 2000; ++j) {
+            if (json.charAt(json.length - 1) != "[")
+                json += ",";
+            json += "{\"id\":" + j + ",\"name\":\"item" + j + "\",\"tags\":[\"a\",\"b\"]}";
+        }
+        json += "]";
+        if (json.indexOf("\"id\":1999") < 0)
+            throw "Bad result";
+    }
+})();
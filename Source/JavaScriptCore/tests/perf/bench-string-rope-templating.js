@@ -0,0 +1,20 @@
+(function () {
+    // Expands a template by concatenation, then looks up placeholders and slices out
+    // pieces of the result, without ever needing the whole string in one buffer.
+    var rows = [];
+    for (var i = 0; i < 500; ++i)
+        rows.push({ name: "row" + i, value: i * 3 });
+
+    for (var i = 0; i < 200; ++i) {
+        var html = "<table>";
+        for (var j = 0; j < rows.length; ++j)
+            html += "<tr><td>" + rows[j].name + "</td><td>{{value" + j + "}}</td></tr>";
+        html += "</table>";
+
+        var start = html.indexOf("{{value250}}");
+        if (html.substring(start - 15, start - 9) != "row250")
+            throw "Bad result";
+        if (html.slice(-8) != "</table>")
+            throw "Bad result";
+    }
+})();
@@ -109,6 +109,11 @@ class YarrGenerator : private MacroAssembler {
     static const RegisterID returnRegister2 = X86Registers::edx;
 #endif
 
+#if CPU(X86) || CPU(X86_64)
+    // The most distinct characters we will scan for with vector compares; one register each.
+    static const unsigned maximumCharactersToScanFor = 4;
+#endif
+
     void optimizeAlternative(PatternAlternative* alternative)
     {
         if (!alternative->m_terms.size())
@@ -1343,6 +1348,128 @@ class YarrGenerator : private MacroAssembler {
         }
     }
 
+#if CPU(X86) || CPU(X86_64)
+    // Returns the first term of the alternative if it is one that we can scan ahead for: a
+    // literal character, or a class of a few characters, that every match must start with.
+    // The characters that term matches are returned in 'characters'; if 'ignoreCaseBit' is
+    // set the term is an ASCII letter that is matched in either case.
+    PatternTerm* firstTermToScanFor(PatternAlternative* alternative, Vector<UChar, maximumCharactersToScanFor>& characters, bool& ignoreCaseBit)
+    {
+        // If this is the only alternative, and it is not anchored, then every match attempt
+        // funnels through its head, and the only thing that can stop it is running out of input.
+        if (m_pattern.m_body->m_alternatives.size() != 1 || alternative->onceThrough() || !alternative->m_terms.size())
+            return 0;
+        ASSERT(alternative->m_minimumSize == m_pattern.m_body->m_minimumSize);
+
+        PatternTerm* term = &alternative->m_terms[0];
+        if (term->quantityType != QuantifierFixedCount || !term->quantityCount)
+            return 0;
+
+        ignoreCaseBit = false;
+        if (term->type == PatternTerm::TypePatternCharacter) {
+            UChar ch = term->patternCharacter;
+            if (m_charSize == Char8 && ch > 0xff)
+                return 0;
+            if (m_pattern.m_ignoreCase && isASCIIAlpha(ch)) {
+                ignoreCaseBit = true;
+                ch |= 0x20;
+            }
+            characters.append(ch);
+        } else if (term->type == PatternTerm::TypeCharacterClass && !term->invert()) {
+            CharacterClass* charClass = term->characterClass;
+            if (charClass->m_table || charClass->m_ranges.size() || charClass->m_matchesUnicode.size() || charClass->m_rangesUnicode.size())
+                return 0;
+            if (!charClass->m_matches.size() || charClass->m_matches.size() > maximumCharactersToScanFor)
+                return 0;
+            characters.append(charClass->m_matches.data(), charClass->m_matches.size());
+        } else
+            return 0;
+
+        ASSERT(term->inputPosition >= 0 && static_cast<unsigned>(term->inputPosition) < alternative->m_minimumSize);
+        return term;
+    }
+
+    // Advances the input position to the next position at which the first term of the
+    // alternative could match, comparing 16 bytes of input at a time, and jumps to
+    // 'noMatch' if there is none. The input position is expected to have already been
+    // checked for the alternative, as it is at the reentry point for its head.
+    void generateFirstTermScan(PatternAlternative* alternative, PatternTerm* term, const Vector<UChar, maximumCharactersToScanFor>& characters, bool ignoreCaseBit, JumpList& noMatch)
+    {
+        const XMMRegisterID inputVector = X86Registers::xmm0;
+        const XMMRegisterID matchVector = X86Registers::xmm1;
+        const XMMRegisterID firstCharacterVector = X86Registers::xmm2;
+        const XMMRegisterID caseBitVector = X86Registers::xmm3;
+
+        unsigned charactersPerVector = m_charSize == Char8 ? 16 : 8;
+        uint32_t lanesPerWord = m_charSize == Char8 ? 0x01010101 : 0x00010001;
+        int inputPosition = term->inputPosition - m_checked;
+        BaseIndex vectorAddress(input, index, m_charScale, inputPosition * (m_charSize == Char8 ? sizeof(LChar) : sizeof(UChar)));
+
+        for (unsigned i = 0; i < characters.size(); ++i) {
+            XMMRegisterID characterVector = static_cast<XMMRegisterID>(firstCharacterVector + i);
+            move(TrustedImm32(static_cast<int32_t>(characters[i] * lanesPerWord)), regT0);
+            moveInt32ToPacked(regT0, characterVector);
+            splatInt32Packed(characterVector);
+        }
+        if (ignoreCaseBit) {
+            ASSERT(characters.size() == 1);
+            move(TrustedImm32(static_cast<int32_t>(0x20 * lanesPerWord)), regT0);
+            moveInt32ToPacked(regT0, caseBitVector);
+            splatInt32Packed(caseBitVector);
+        }
+
+        Label vectorLoop(this);
+        // Only compare a whole vector if every position it covers leaves room for the alternative.
+        add32(TrustedImm32(charactersPerVector - 1), index, regT0);
+        Jump tooShortForVector = branch32(Above, regT0, length);
+
+        for (unsigned i = 0; i < characters.size(); ++i) {
+            XMMRegisterID characterVector = static_cast<XMMRegisterID>(firstCharacterVector + i);
+            XMMRegisterID compared = i ? inputVector : matchVector;
+            loadPacked(vectorAddress, compared);
+            if (ignoreCaseBit)
+                orPacked(caseBitVector, compared);
+            if (m_charSize == Char8)
+                compareEqualInt8Packed(characterVector, compared);
+            else
+                compareEqualInt16Packed(characterVector, compared);
+            if (i)
+                orPacked(inputVector, matchVector);
+        }
+        moveMaskInt8Packed(matchVector, regT0);
+        Jump foundInVector = branchTest32(NonZero, regT0);
+        add32(TrustedImm32(charactersPerVector), index);
+        jump(vectorLoop);
+
+        foundInVector.link(this);
+        countTrailingZeros32(regT0, regT0);
+        if (m_charSize != Char8)
+            urshift32(TrustedImm32(1), regT0);
+        add32(regT0, index);
+        JumpList found;
+        found.append(jump());
+
+        // Check whatever is left over one character at a time.
+        tooShortForVector.link(this);
+        Label scalarLoop(this);
+        noMatch.append(branch32(Above, index, length));
+        readCharacter(inputPosition, regT0);
+        if (ignoreCaseBit)
+            or32(TrustedImm32(0x20), regT0);
+        for (unsigned i = 0; i < characters.size(); ++i)
+            found.append(branch32(Equal, regT0, Imm32(characters[i])));
+        add32(TrustedImm32(1), index);
+        jump(scalarLoop);
+
+        found.link(this);
+        if (!m_pattern.m_body->m_hasFixedSize) {
+            move(index, regT0);
+            sub32(Imm32(alternative->m_minimumSize), regT0);
+            setMatchStart(regT0);
+        }
+    }
+#endif
+
     void generate()
     {
         // Forwards generate the matching code.
@@ -1390,6 +1517,18 @@ class YarrGenerator : private MacroAssembler {
                 op.m_reentry = label();
 
                 m_checked += alternative->m_minimumSize;
+
+#if CPU(X86) || CPU(X86_64)
+                // Rather than attempting a match at every position, skip ahead to the next
+                // one at which the first term can match. Running out of input is the same
+                // as failing the input check above.
+                Vector<UChar, maximumCharactersToScanFor> characters;
+                bool ignoreCaseBit;
+                if (supportsFloatingPoint()) {
+                    if (PatternTerm* term = firstTermToScanFor(alternative, characters, ignoreCaseBit))
+                        generateFirstTermScan(alternative, term, characters, ignoreCaseBit, op.m_jumps);
+                }
+#endif
                 break;
             }
             case OpBodyAlternativeNext:
@@ -111,6 +111,25 @@ public:
     void *getAddr() { return m_ref.code().executableAddress(); }
 #endif
 
+    // Takes whatever code 'other' has that we do not.
+    void addCodeFrom(const YarrCodeBlock& other)
+    {
+        if (!m_ref8.size())
+            m_ref8 = other.m_ref8;
+        if (!m_ref16.size())
+            m_ref16 = other.m_ref16;
+        if (!m_matchOnly8.size())
+            m_matchOnly8 = other.m_matchOnly8;
+        if (!m_matchOnly16.size())
+            m_matchOnly16 = other.m_matchOnly16;
+    }
+
+    // Whether no other code block holds on to any of our code.
+    bool isOnlyOwner() const
+    {
+        return isOnlyOwner(m_ref8) && isOnlyOwner(m_ref16) && isOnlyOwner(m_matchOnly8) && isOnlyOwner(m_matchOnly16);
+    }
+
     void clear()
     {
         m_ref8 = MacroAssemblerCodeRef();
@@ -121,6 +140,11 @@ public:
     }
 
 private:
+    static bool isOnlyOwner(const MacroAssemblerCodeRef& ref)
+    {
+        return !ref.executableMemory() || ref.executableMemory()->hasOneRef();
+    }
+
     MacroAssemblerCodeRef m_ref8;
     MacroAssemblerCodeRef m_ref16;
     MacroAssemblerCodeRef m_matchOnly8;
@@ -163,6 +163,7 @@ HEADERS += \
     ThreadSafeRefCounted.h \
     ThreadSpecific.h \
     TypeTraits.h \
+    TypedArrayConversion.h \
     Uint16Array.h \
     Uint32Array.h \
     Uint8Array.h \
@@ -231,6 +232,7 @@ SOURCES += \
     TCSystemAlloc.cpp \
     Threading.cpp \
     TypeTraits.cpp \
+    TypedArrayConversion.cpp \
     WTFThreadData.cpp \
     text/AtomicString.cpp \
     text/AtomicStringTable.cpp \
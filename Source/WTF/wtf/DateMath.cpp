@@ -723,6 +723,79 @@ static char* parseES5TimePortion(char* currentPosition, long& hours, long& minut
     return currentPosition;
 }
 
+static inline bool readFixedWidthNumber(const char* position, unsigned width, long& result)
+{
+    long value = 0;
+    for (unsigned i = 0; i < width; ++i) {
+        if (!isASCIIDigit(position[i]))
+            return false;
+        value = value * 10 + (position[i] - '0');
+    }
+    result = value;
+    return true;
+}
+
+// Parses the exact shape that Date.prototype.toISOString() and JSON produce,
+// YYYY-MM-DD[THH:mm[:ss[.sss]][Z|(+|-)HH:mm]], reading the digits in place.
+// Anything else, including out of range time zone offsets, is left to the
+// general parser, so this never accepts a string that the general parser would
+// reject or read differently.
+static bool parseFixedWidthES5Date(const char* dateString, int& year, long& month, long& day, long& hours, long& minutes, double& seconds, long& timeZoneSeconds)
+{
+    long fourDigitYear;
+    if (!readFixedWidthNumber(dateString, 4, fourDigitYear) || dateString[4] != '-'
+        || !readFixedWidthNumber(dateString + 5, 2, month) || dateString[7] != '-'
+        || !readFixedWidthNumber(dateString + 8, 2, day))
+        return false;
+    year = fourDigitYear;
+
+    const char* currentPosition = dateString + 10;
+    if (!*currentPosition)
+        return true;
+    if (*currentPosition != 'T')
+        return false;
+
+    if (!readFixedWidthNumber(currentPosition + 1, 2, hours) || currentPosition[3] != ':'
+        || !readFixedWidthNumber(currentPosition + 4, 2, minutes))
+        return false;
+    currentPosition += 6;
+
+    if (*currentPosition == ':') {
+        long intSeconds;
+        if (!readFixedWidthNumber(currentPosition + 1, 2, intSeconds))
+            return false;
+        seconds = intSeconds;
+        currentPosition += 3;
+        if (*currentPosition == '.') {
+            long fracSeconds;
+            if (!readFixedWidthNumber(currentPosition + 1, 3, fracSeconds) || isASCIIDigit(currentPosition[4]))
+                return false;
+            seconds += fracSeconds * pow(10.0, -3.0);
+            currentPosition += 4;
+        }
+    }
+
+    if (*currentPosition == 'Z')
+        return !currentPosition[1];
+    if (!*currentPosition)
+        return true;
+    if (*currentPosition != '+' && *currentPosition != '-')
+        return false;
+
+    long tzHours;
+    long tzMinutes;
+    if (!readFixedWidthNumber(currentPosition + 1, 2, tzHours) || currentPosition[3] != ':'
+        || !readFixedWidthNumber(currentPosition + 4, 2, tzMinutes) || currentPosition[6])
+        return false;
+    if (tzHours > 24 || tzMinutes > 59)
+        return false;
+
+    timeZoneSeconds = 60 * (tzMinutes + (60 * tzHours));
+    if (*currentPosition == '-')
+        timeZoneSeconds = -timeZoneSeconds;
+    return true;
+}
+
 double parseES5DateFromNullTerminatedCharacters(const char* dateString)
 {
     // This parses a date of the form defined in ECMA-262-5, section 15.9.1.15
@@ -740,20 +813,30 @@ double parseES5DateFromNullTerminatedCharacters(const char* dateString)
     double seconds = 0;
     long timeZoneSeconds = 0;
 
-    // Parse the date YYYY[-MM[-DD]]
-    char* currentPosition = parseES5DatePortion(dateString, year, month, day);
-    if (!currentPosition)
-        return std::numeric_limits<double>::quiet_NaN();
-    // Look for a time portion.
-    if (*currentPosition == 'T') {
-        // Parse the time HH:mm[:ss[.sss]][Z|(+|-)00:00]
-        currentPosition = parseES5TimePortion(currentPosition + 1, hours, minutes, seconds, timeZoneSeconds);
+    if (!parseFixedWidthES5Date(dateString, year, month, day, hours, minutes, seconds, timeZoneSeconds)) {
+        year = 0;
+        month = 1;
+        day = 1;
+        hours = 0;
+        minutes = 0;
+        seconds = 0;
+        timeZoneSeconds = 0;
+
+        // Parse the date YYYY[-MM[-DD]]
+        char* currentPosition = parseES5DatePortion(dateString, year, month, day);
         if (!currentPosition)
             return std::numeric_limits<double>::quiet_NaN();
+        // Look for a time portion.
+        if (*currentPosition == 'T') {
+            // Parse the time HH:mm[:ss[.sss]][Z|(+|-)00:00]
+            currentPosition = parseES5TimePortion(currentPosition + 1, hours, minutes, seconds, timeZoneSeconds);
+            if (!currentPosition)
+                return std::numeric_limits<double>::quiet_NaN();
+        }
+        // Check that we have parsed all characters in the string.
+        if (*currentPosition)
+            return std::numeric_limits<double>::quiet_NaN();
     }
-    // Check that we have parsed all characters in the string.
-    if (*currentPosition)
-        return std::numeric_limits<double>::quiet_NaN();
 
     // A few of these checks could be done inline above, but since many of them are interrelated
     // we would be sacrificing readability to "optimize" the (presumably less common) failure path.
@@ -83,7 +83,7 @@ struct LocalTimeOffset {
 };
 
 void initializeDates();
-int equivalentYearForDST(int year);
+WTF_EXPORT_PRIVATE int equivalentYearForDST(int year);
 
 // Not really math related, but this is currently the only shared place to put these.
 WTF_EXPORT_PRIVATE double parseES5DateFromNullTerminatedCharacters(const char* dateString);
@@ -135,6 +135,7 @@ using WTF::isLeapYear;
 using WTF::dateToDaysFrom1970;
 using WTF::dayInMonthFromDayInYear;
 using WTF::dayInYear;
+using WTF::equivalentYearForDST;
 using WTF::minutesPerHour;
 using WTF::monthFromDayInYear;
 using WTF::msPerDay;
@@ -120,6 +120,7 @@ MetaAllocator::MetaAllocator(size_t allocationGranule, size_t pageSize)
     , m_bytesAllocated(0)
     , m_bytesReserved(0)
     , m_bytesCommitted(0)
+    , m_maximumBytesAllocated(0)
     , m_tracker(0)
 #ifndef NDEBUG
     , m_mallocBalance(0)
@@ -180,6 +181,8 @@ PassRefPtr<MetaAllocatorHandle> MetaAllocator::allocate(size_t sizeInBytes, void
     }
     incrementPageOccupancy(start, sizeInBytes);
     m_bytesAllocated += sizeInBytes;
+    if (m_bytesAllocated > m_maximumBytesAllocated)
+        m_maximumBytesAllocated = m_bytesAllocated;
 #if ENABLE(META_ALLOCATOR_PROFILE)
     m_numAllocations++;
 #endif
@@ -199,6 +202,10 @@ MetaAllocator::Statistics MetaAllocator::currentStatistics()
     result.bytesAllocated = m_bytesAllocated;
     result.bytesReserved = m_bytesReserved;
     result.bytesCommitted = m_bytesCommitted;
+    result.maximumBytesAllocated = m_maximumBytesAllocated;
+    result.numberOfFreeSpaces = m_freeSpaceStartAddressMap.size();
+    FreeSpaceNode* largestFreeSpace = m_freeSpaceSizeMap.last();
+    result.bytesInLargestFreeSpace = largestFreeSpace ? largestFreeSpace->m_sizeInBytes : 0;
     return result;
 }
 
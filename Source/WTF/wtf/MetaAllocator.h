@@ -85,6 +85,12 @@ public:
         size_t bytesAllocated;
         size_t bytesReserved;
         size_t bytesCommitted;
+        size_t maximumBytesAllocated;
+        
+        // The free space is fragmented if the largest piece is much smaller than
+        // bytesReserved - bytesAllocated.
+        size_t numberOfFreeSpaces;
+        size_t bytesInLargestFreeSpace;
     };
     Statistics currentStatistics();
 
@@ -119,6 +125,10 @@ protected:
     // destruction, in part because a MetaAllocator cannot die so long
     // as there are Handles that refer to it.
 
+    // The above methods are called with this lock held. Subclasses take it
+    // to read any state of their own that those methods update.
+    SpinLock& lock() { return m_lock; }
+
 private:
     
     friend class MetaAllocatorHandle;
@@ -182,6 +192,7 @@ private:
     size_t m_bytesAllocated;
     size_t m_bytesReserved;
     size_t m_bytesCommitted;
+    size_t m_maximumBytesAllocated;
     
     SpinLock m_lock;
 
@@ -911,6 +911,11 @@
 #define ENABLE_YARR_JIT_DEBUG 0
 #endif
 
+/* Share RegExp JIT code between VMs. This needs them all to allocate code from the same pool. */
+#if !defined(ENABLE_SHARED_REGEXP_JIT_CODE) && ENABLE(YARR_JIT) && !ENABLE(ASSEMBLER_WX_EXCLUSIVE) && !ENABLE(YARR_JIT_DEBUG)
+#define ENABLE_SHARED_REGEXP_JIT_CODE 1
+#endif
+
 /* If either the JIT or the RegExp JIT is enabled, then the Assembler must be
    enabled as well: */
 #if ENABLE(JIT) || ENABLE(YARR_JIT)
@@ -932,6 +937,19 @@
 #endif
 #endif
 
+/* The sampling profiler interrupts the JavaScript thread with a signal and needs to
+   be able to tell from the interrupted program counter whether it was running
+   generated code, so it relies on the fixed executable allocator. */
+#if !defined(ENABLE_SAMPLING_PROFILER) && OS(LINUX) && CPU(X86_64) \
+    && ENABLE(JIT) && ENABLE(LLINT) && !ENABLE(LLINT_C_LOOP) && ENABLE(EXECUTABLE_ALLOCATOR_FIXED)
+#define ENABLE_SAMPLING_PROFILER 1
+#endif
+
+/* The CSS selector compiler emits SysV x86-64 code directly, so it is only enabled there. */
+#if !defined(ENABLE_CSS_SELECTOR_JIT) && CPU(X86_64) && !OS(WINDOWS) && ENABLE(JIT)
+#define ENABLE_CSS_SELECTOR_JIT 1
+#endif
+
 /* Use the QXmlStreamReader implementation for XMLDocumentParser */
 /* Use the QXmlQuery implementation for XSLTProcessor */
 #if PLATFORM(QT)
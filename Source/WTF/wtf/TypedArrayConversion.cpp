@@ -0,0 +1,304 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "TypedArrayConversion.h"
+
+#include <limits>
+#include <string.h>
+#include <wtf/MathExtras.h>
+#include <wtf/Vector.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace WTF {
+
+// Tags the element type of Uint8ClampedArray, which is stored as an unsigned
+// char but converted differently.
+struct ClampedUint8 {
+    uint8_t value;
+};
+COMPILE_ASSERT(sizeof(ClampedUint8) == 1, ClampedUint8_is_one_byte);
+
+template<bool sourceIsIntegral> struct IntegralElementConversion;
+
+template<> struct IntegralElementConversion<true> {
+    template<typename Destination, typename Source>
+    static Destination convert(Source value) { return static_cast<Destination>(value); }
+};
+
+template<> struct IntegralElementConversion<false> {
+    template<typename Destination, typename Source>
+    static Destination convert(Source value)
+    {
+        // Matches IntegralTypedArrayBase::set().
+        if (std::isnan(value))
+            return 0;
+        return static_cast<Destination>(static_cast<int64_t>(value));
+    }
+};
+
+template<typename Destination> struct ElementConversion {
+    template<typename Source>
+    static void store(Destination* destination, Source value)
+    {
+        *destination = IntegralElementConversion<std::numeric_limits<Source>::is_integer>::template convert<Destination>(value);
+    }
+};
+
+template<> struct ElementConversion<float> {
+    template<typename Source>
+    static void store(float* destination, Source value) { *destination = static_cast<float>(value); }
+};
+
+template<> struct ElementConversion<double> {
+    template<typename Source>
+    static void store(double* destination, Source value) { *destination = static_cast<double>(value); }
+};
+
+template<> struct ElementConversion<ClampedUint8> {
+    template<typename Source>
+    static void store(ClampedUint8* destination, Source value)
+    {
+        // Matches Uint8ClampedArray::set().
+        double number = value;
+        if (std::isnan(number) || number < 0)
+            number = 0;
+        else if (number > 255)
+            number = 255;
+        destination->value = static_cast<uint8_t>(lrint(number));
+    }
+};
+
+template<typename Destination, typename Source>
+static void convertElements(Destination* destination, const Source* source, unsigned length)
+{
+    for (unsigned i = 0; i < length; ++i)
+        ElementConversion<Destination>::store(destination + i, source[i]);
+}
+
+#ifdef __SSE2__
+// The vector loops below assume that the rounding mode is the default
+// round-to-nearest-even, which is what lrint() uses as well.
+
+template<>
+void convertElements(ClampedUint8* destination, const float* source, unsigned length)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 maximum = _mm_set1_ps(255);
+    unsigned i = 0;
+    for (; i + 16 <= length; i += 16) {
+        // _mm_max_ps() returns its second operand if either is NaN, so NaN clamps to zero.
+        __m128i a = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i), zero), maximum));
+        __m128i b = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i + 4), zero), maximum));
+        __m128i c = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i + 8), zero), maximum));
+        __m128i d = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i + 12), zero), maximum));
+        __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), bytes);
+    }
+    for (; i < length; ++i)
+        ElementConversion<ClampedUint8>::store(destination + i, source[i]);
+}
+
+template<>
+void convertElements(float* destination, const int16_t* source, unsigned length)
+{
+    unsigned i = 0;
+    for (; i + 8 <= length; i += 8) {
+        __m128i shorts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        // Put each short in the high half of an int, then shift it back down to sign extend it.
+        __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(shorts, shorts), 16);
+        __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(shorts, shorts), 16);
+        _mm_storeu_ps(destination + i, _mm_cvtepi32_ps(low));
+        _mm_storeu_ps(destination + i + 4, _mm_cvtepi32_ps(high));
+    }
+    for (; i < length; ++i)
+        destination[i] = source[i];
+}
+
+template<>
+void convertElements(float* destination, const uint8_t* source, unsigned length)
+{
+    const __m128i zero = _mm_setzero_si128();
+    unsigned i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        __m128i low = _mm_unpacklo_epi8(bytes, zero);
+        __m128i high = _mm_unpackhi_epi8(bytes, zero);
+        _mm_storeu_ps(destination + i, _mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)));
+        _mm_storeu_ps(destination + i + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)));
+        _mm_storeu_ps(destination + i + 8, _mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)));
+        _mm_storeu_ps(destination + i + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)));
+    }
+    for (; i < length; ++i)
+        destination[i] = source[i];
+}
+
+template<>
+void convertElements(ClampedUint8* destination, const int16_t* source, unsigned length)
+{
+    unsigned i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i + 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(a, b));
+    }
+    for (; i < length; ++i)
+        ElementConversion<ClampedUint8>::store(destination + i, source[i]);
+}
+#endif // __SSE2__
+
+template<typename Destination>
+static void convertElementsFrom(Destination* destination, ArrayBufferView::ViewType sourceType, const void* source, unsigned length)
+{
+    switch (sourceType) {
+    case ArrayBufferView::TypeInt8:
+        convertElements(destination, static_cast<const int8_t*>(source), length);
+        return;
+    case ArrayBufferView::TypeUint8:
+    case ArrayBufferView::TypeUint8Clamped:
+        convertElements(destination, static_cast<const uint8_t*>(source), length);
+        return;
+    case ArrayBufferView::TypeInt16:
+        convertElements(destination, static_cast<const int16_t*>(source), length);
+        return;
+    case ArrayBufferView::TypeUint16:
+        convertElements(destination, static_cast<const uint16_t*>(source), length);
+        return;
+    case ArrayBufferView::TypeInt32:
+        convertElements(destination, static_cast<const int32_t*>(source), length);
+        return;
+    case ArrayBufferView::TypeUint32:
+        convertElements(destination, static_cast<const uint32_t*>(source), length);
+        return;
+    case ArrayBufferView::TypeFloat32:
+        convertElements(destination, static_cast<const float*>(source), length);
+        return;
+    case ArrayBufferView::TypeFloat64:
+        convertElements(destination, static_cast<const double*>(source), length);
+        return;
+    case ArrayBufferView::TypeDataView:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+}
+
+static size_t elementSize(ArrayBufferView::ViewType type)
+{
+    switch (type) {
+    case ArrayBufferView::TypeInt8:
+    case ArrayBufferView::TypeUint8:
+    case ArrayBufferView::TypeUint8Clamped:
+        return 1;
+    case ArrayBufferView::TypeInt16:
+    case ArrayBufferView::TypeUint16:
+        return 2;
+    case ArrayBufferView::TypeInt32:
+    case ArrayBufferView::TypeUint32:
+    case ArrayBufferView::TypeFloat32:
+        return 4;
+    case ArrayBufferView::TypeFloat64:
+        return 8;
+    case ArrayBufferView::TypeDataView:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+    return 1;
+}
+
+static bool isIntegral(ArrayBufferView::ViewType type)
+{
+    return type != ArrayBufferView::TypeFloat32 && type != ArrayBufferView::TypeFloat64;
+}
+
+static bool convertsByCopyingBits(ArrayBufferView::ViewType destinationType, ArrayBufferView::ViewType sourceType)
+{
+    if (destinationType == sourceType)
+        return true;
+    if (destinationType == ArrayBufferView::TypeUint8Clamped)
+        return sourceType == ArrayBufferView::TypeUint8;
+    // Integers of the same size wrap around to the same bits.
+    return isIntegral(destinationType) && isIntegral(sourceType) && elementSize(destinationType) == elementSize(sourceType);
+}
+
+void convertTypedArrayElements(ArrayBufferView::ViewType destinationType, void* destination, ArrayBufferView::ViewType sourceType, const void* source, unsigned length)
+{
+    ASSERT(destinationType != ArrayBufferView::TypeDataView);
+    ASSERT(sourceType != ArrayBufferView::TypeDataView);
+
+    size_t sourceByteLength = length * elementSize(sourceType);
+    if (convertsByCopyingBits(destinationType, sourceType)) {
+        memmove(destination, source, sourceByteLength);
+        return;
+    }
+
+    // Converting in place could overwrite elements before they are read when
+    // the two views share a buffer, so convert from a copy instead.
+    Vector<char> sourceCopy;
+    const char* sourceBytes = static_cast<const char*>(source);
+    const char* destinationBytes = static_cast<const char*>(destination);
+    size_t destinationByteLength = length * elementSize(destinationType);
+    if (sourceBytes < destinationBytes + destinationByteLength && destinationBytes < sourceBytes + sourceByteLength) {
+        sourceCopy.append(sourceBytes, sourceByteLength);
+        source = sourceCopy.data();
+    }
+
+    switch (destinationType) {
+    case ArrayBufferView::TypeInt8:
+        convertElementsFrom(static_cast<int8_t*>(destination), sourceType, source, length);
+        return;
+    case ArrayBufferView::TypeUint8:
+        convertElementsFrom(static_cast<uint8_t*>(destination), sourceType, source, length);
+        return;
+    case ArrayBufferView::TypeUint8Clamped:
+        convertElementsFrom(static_cast<ClampedUint8*>(destination), sourceType, source, length);
+        return;
+    case ArrayBufferView::TypeInt16:
+        convertElementsFrom(static_cast<int16_t*>(destination), sourceType, source, length);
+        return;
+    case ArrayBufferView::TypeUint16:
+        convertElementsFrom(static_cast<uint16_t*>(destination), sourceType, source, length);
+        return;
+    case ArrayBufferView::TypeInt32:
+        convertElementsFrom(static_cast<int32_t*>(destination), sourceType, source, length);
+        return;
+    case ArrayBufferView::TypeUint32:
+        convertElementsFrom(static_cast<uint32_t*>(destination), sourceType, source, length);
+        return;
+    case ArrayBufferView::TypeFloat32:
+        convertElementsFrom(static_cast<float*>(destination), sourceType, source, length);
+        return;
+    case ArrayBufferView::TypeFloat64:
+        convertElementsFrom(static_cast<double*>(destination), sourceType, source, length);
+        return;
+    case ArrayBufferView::TypeDataView:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+}
+
+} // namespace WTF
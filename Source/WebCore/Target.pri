@@ -354,6 +354,7 @@ SOURCES += \
     css/WebKitCSSShaderValue.cpp \
     css/WebKitCSSTransformValue.cpp \
     css/WebKitCSSViewportRule.cpp \
+    cssjit/SelectorCompiler.cpp \
     dom/ActiveDOMObject.cpp \
     dom/Attr.cpp \
     dom/BeforeTextInsertedEvent.cpp \
@@ -489,6 +490,7 @@ SOURCES += \
     dom/Traversal.cpp \
     dom/TreeScope.cpp \
     dom/TreeScopeAdopter.cpp \
+    dom/TreeScopeElementIndex.cpp \
     dom/TreeWalker.cpp \
     dom/UIEvent.cpp \
     dom/UIEventWithKeyState.cpp \
@@ -1568,6 +1570,7 @@ HEADERS += \
     css/WebKitCSSShaderValue.h \
     css/WebKitCSSTransformValue.h \
     css/WebKitCSSViewportRule.h \
+    cssjit/SelectorCompiler.h \
     dom/ActiveDOMObject.h \
     dom/Attr.h \
     dom/Attribute.h \
@@ -1694,6 +1697,7 @@ HEADERS += \
     dom/TreeDepthLimit.h \
     dom/TreeScope.h \
     dom/TreeScopeAdopter.h \
+    dom/TreeScopeElementIndex.h \
     dom/TreeWalker.h \
     dom/UIEvent.h \
     dom/UIEventWithKeyState.h \
@@ -29,6 +29,7 @@ INCLUDEPATH += \
     $$SOURCE_DIR/bridge \
     $$SOURCE_DIR/bridge/qt \
     $$SOURCE_DIR/css \
+    $$SOURCE_DIR/cssjit \
     $$SOURCE_DIR/dom \
     $$SOURCE_DIR/dom/default \
     $$SOURCE_DIR/editing \
@@ -38,6 +38,7 @@
 #include <runtime/Operations.h>
 #include <wtf/ArrayBufferView.h>
 #include <wtf/TypedArrayBase.h>
+#include <wtf/TypedArrayConversion.h>
 
 namespace WebCore {
 
@@ -58,44 +59,7 @@ bool copyTypedArrayBuffer(C* target, ArrayBufferView* source, unsigned sourceLen
     if (!target->checkInboundData(offset, sourceLength))
         return false;
 
-    switch (sourceType) {
-    case ArrayBufferView::TypeInt8:
-        for (unsigned i = 0; i < sourceLength; ++i)
-            target->set(i + offset, (T)(static_cast<TypedArrayBase<signed char> *>(source)->item(i)));
-        break;
-    case ArrayBufferView::TypeUint8:
-    case ArrayBufferView::TypeUint8Clamped:
-        for (unsigned i = 0; i < sourceLength; ++i)
-            target->set(i + offset, (T)(static_cast<TypedArrayBase<unsigned char> *>(source)->item(i)));
-        break;
-    case ArrayBufferView::TypeInt16:
-        for (unsigned i = 0; i < sourceLength; ++i)
-            target->set(i + offset, (T)(static_cast<TypedArrayBase<signed short> *>(source)->item(i)));
-        break;
-    case ArrayBufferView::TypeUint16:
-        for (unsigned i = 0; i < sourceLength; ++i)
-            target->set(i + offset, (T)(static_cast<TypedArrayBase<unsigned short> *>(source)->item(i)));
-        break;
-    case ArrayBufferView::TypeInt32:
-        for (unsigned i = 0; i < sourceLength; ++i)
-            target->set(i + offset, (T)(static_cast<TypedArrayBase<int> *>(source)->item(i)));
-        break;
-    case ArrayBufferView::TypeUint32:
-        for (unsigned i = 0; i < sourceLength; ++i)
-            target->set(i + offset, (T)(static_cast<TypedArrayBase<unsigned int> *>(source)->item(i)));
-        break;
-    case ArrayBufferView::TypeFloat32:
-        for (unsigned i = 0; i < sourceLength; ++i)
-            target->set(i + offset, (T)(static_cast<TypedArrayBase<float> *>(source)->item(i)));
-        break;
-    case ArrayBufferView::TypeFloat64:
-        for (unsigned i = 0; i < sourceLength; ++i)
-            target->set(i + offset, (T)(static_cast<TypedArrayBase<double> *>(source)->item(i)));
-        break;
-    default:
-        break;
-    }
-
+    convertTypedArrayElements(target->getType(), target->data() + offset, sourceType, source->baseAddress(), sourceLength);
     return true;
 }
 
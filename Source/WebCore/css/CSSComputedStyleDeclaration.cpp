@@ -1608,7 +1608,7 @@ PassRefPtr<MutableStylePropertySet> CSSComputedStyleDeclaration::copyProperties(
 
 static inline bool nodeOrItsAncestorNeedsStyleRecalc(Node* styledNode)
 {
-    if (styledNode->document()->hasPendingForcedStyleRecalc())
+    if (styledNode->document()->hasPendingForcedStyleRecalc() || styledNode->document()->hasPendingDescendantStyleInvalidation())
         return true;
     for (Node* n = styledNode; n; n = n->parentNode()) {// FIXME: Call parentOrShadowHostNode() instead
         if (n->needsStyleRecalc())
@@ -36,9 +36,11 @@
 #include "CSSSelectorList.h"
 #include "CSSValueKeywords.h"
 #include "HTMLElement.h"
+#include "JSDOMWindowBase.h"
 #include "RenderRegion.h"
 #include "SVGElement.h"
 #include "SelectorCheckerFastPath.h"
+#include "Settings.h"
 #include "StylePropertySet.h"
 #include "StyledElement.h"
 
@@ -343,7 +345,15 @@ void ElementRuleCollector::matchUARules(RuleSet* rules)
     sortAndTransferMatchedRules();
 }
 
-inline bool ElementRuleCollector::ruleMatches(const RuleData& ruleData, const ContainerNode* scope, PseudoId& dynamicPseudo)
+#if ENABLE(CSS_SELECTOR_JIT)
+bool ElementRuleCollector::selectorJITEnabled(Document* document)
+{
+    Settings* settings = document->settings();
+    return settings && settings->selectorJITEnabled();
+}
+#endif
+
+inline bool ElementRuleCollector::ruleMatches(const RuleData& ruleData, const RuleSet* ruleSet, const ContainerNode* scope, PseudoId& dynamicPseudo)
 {
     const StyleResolver::State& state = m_state;
 
@@ -357,6 +367,19 @@ inline bool ElementRuleCollector::ruleMatches(const RuleData& ruleData, const Co
             if (!ruleData.hasMultipartSelector())
                 return true;
         }
+#if ENABLE(CSS_SELECTOR_JIT)
+        if (m_selectorJITEnabled) {
+            CompiledSelector& compiledSelector = ruleSet->compiledSelectorForRule(ruleData);
+            if (compiledSelector.status == SelectorCompilationStatus::NotCompiled)
+                compiledSelector.status = SelectorCompiler::compileSelector(ruleData.selector(), JSDOMWindowBase::commonVM(), compiledSelector.codeRef);
+            if (compiledSelector.status == SelectorCompilationStatus::SimpleSelectorChecker) {
+                SelectorCompiler::SimpleSelectorChecker selectorChecker = SelectorCompiler::simpleSelectorCheckerFunction(compiledSelector.codeRef, compiledSelector.status);
+                return selectorChecker(state.element());
+            }
+        }
+#else
+        UNUSED_PARAM(ruleSet);
+#endif
         if (ruleData.selector()->m_match == CSSSelector::Tag && !SelectorChecker::tagMatches(state.element(), ruleData.selector()->tagQName()))
             return false;
         SelectorCheckerFastPath selectorCheckerFastPath(ruleData.selector(), state.element());
@@ -411,7 +434,7 @@ void ElementRuleCollector::doCollectMatchingRulesForList(const Vector<RuleData>*
         if (hasInspectorFrontends)
             cookie = InspectorInstrumentation::willMatchRule(document(), rule, m_inspectorCSSOMWrappers, document()->styleSheetCollection());
         PseudoId dynamicPseudo = NOPSEUDO;
-        if (ruleMatches(ruleData, matchRequest.scope, dynamicPseudo)) {
+        if (ruleMatches(ruleData, matchRequest.ruleSet, matchRequest.scope, dynamicPseudo)) {
             // If the rule has no properties to apply, then ignore it in the non-debug mode.
             const StylePropertySet* properties = rule->properties();
             if (!properties || (properties->isEmpty() && !matchRequest.includeEmptyRules)) {
@@ -51,7 +51,11 @@ public:
         , m_sameOriginOnly(false)
         , m_mode(SelectorChecker::ResolvingStyle)
         , m_canUseFastReject(m_selectorFilter.parentStackIsConsistent(state.parentNode()))
-        , m_behaviorAtBoundary(SelectorChecker::DoesNotCrossBoundary) { }
+        , m_behaviorAtBoundary(SelectorChecker::DoesNotCrossBoundary)
+#if ENABLE(CSS_SELECTOR_JIT)
+        , m_selectorJITEnabled(selectorJITEnabled(state.document()))
+#endif
+    { }
 
     void matchAllRules(bool matchAuthorAndUserStyles, bool includeSMILProperties);
     void matchUARules();
@@ -71,6 +75,9 @@ public:
 
 private:
     Document* document() { return m_state.document(); }
+#if ENABLE(CSS_SELECTOR_JIT)
+    static bool selectorJITEnabled(Document*);
+#endif
     void addElementStyleProperties(const StylePropertySet*, bool isCacheable = true);
 
     void matchUARules(RuleSet*);
@@ -80,7 +87,7 @@ private:
     void collectMatchingRules(const MatchRequest&, StyleResolver::RuleRange&);
     void collectMatchingRulesForRegion(const MatchRequest&, StyleResolver::RuleRange&);
     void collectMatchingRulesForList(const Vector<RuleData>*, const MatchRequest&, StyleResolver::RuleRange&);
-    bool ruleMatches(const RuleData&, const ContainerNode* scope, PseudoId&);
+    bool ruleMatches(const RuleData&, const RuleSet*, const ContainerNode* scope, PseudoId&);
 
     void sortMatchedRules();
     void sortAndTransferMatchedRules();
@@ -105,6 +112,9 @@ private:
     SelectorChecker::Mode m_mode;
     bool m_canUseFastReject;
     SelectorChecker::BehaviorAtBoundary m_behaviorAtBoundary;
+#if ENABLE(CSS_SELECTOR_JIT)
+    bool m_selectorJITEnabled;
+#endif
 
     OwnPtr<Vector<const RuleData*, 32> > m_matchedRules;
 
@@ -30,9 +30,139 @@
 #include "RuleFeature.h"
 
 #include "CSSSelector.h"
+#include "CSSSelectorList.h"
 
 namespace WebCore {
 
+static void addHashSet(HashSet<AtomicStringImpl*>& set, const HashSet<AtomicStringImpl*>& other)
+{
+    HashSet<AtomicStringImpl*>::const_iterator end = other.end();
+    for (HashSet<AtomicStringImpl*>::const_iterator it = other.begin(); it != end; ++it)
+        set.add(*it);
+}
+
+void InvalidationSet::add(const InvalidationSet& other)
+{
+    invalidatesSelf = invalidatesSelf || other.invalidatesSelf;
+    invalidatesWholeSubtree = invalidatesWholeSubtree || other.invalidatesWholeSubtree;
+    addHashSet(classes, other.classes);
+    addHashSet(ids, other.ids);
+    addHashSet(tagNames, other.tagNames);
+    addHashSet(attributes, other.attributes);
+}
+
+static void addNames(Vector<AtomicString>& names, const Vector<AtomicString>& other)
+{
+    // Only a few features change on an element between two style recalcs.
+    for (unsigned i = 0; i < other.size(); ++i) {
+        if (!names.contains(other[i]))
+            names.append(other[i]);
+    }
+}
+
+void PendingDescendantInvalidation::add(const PendingDescendantInvalidation& other)
+{
+    addNames(classes, other.classes);
+    addNames(ids, other.ids);
+    addNames(attributes, other.attributes);
+}
+
+static void addInvalidationSets(RuleFeatureSet::InvalidationSetMap& map, const RuleFeatureSet::InvalidationSetMap& other)
+{
+    RuleFeatureSet::InvalidationSetMap::const_iterator end = other.end();
+    for (RuleFeatureSet::InvalidationSetMap::const_iterator it = other.begin(); it != end; ++it) {
+        OwnPtr<InvalidationSet>& invalidationSet = map.add(it->key, nullptr).iterator->value;
+        if (!invalidationSet)
+            invalidationSet = adoptPtr(new InvalidationSet);
+        invalidationSet->add(*it->value);
+    }
+}
+
+static void addSubjectFeature(const CSSSelector* selector, InvalidationSet& subjectFeatures)
+{
+    if (selector->m_match == CSSSelector::Id)
+        subjectFeatures.ids.add(selector->value().impl());
+    else if (selector->m_match == CSSSelector::Class)
+        subjectFeatures.classes.add(selector->value().impl());
+    else if (selector->m_match == CSSSelector::Tag && selector->tagQName().localName() != starAtom)
+        subjectFeatures.tagNames.add(selector->tagQName().localName().impl());
+    else if (selector->isAttributeSelector())
+        subjectFeatures.attributes.add(selector->attribute().localName().impl());
+}
+
+enum SelectorPosition { SubjectPosition, AncestorPosition, OtherPosition };
+
+static void addInvalidationForFeature(RuleFeatureSet::InvalidationSetMap& map, AtomicStringImpl* key, SelectorPosition position, const InvalidationSet& subjectFeatures, bool usesPseudoElement)
+{
+    OwnPtr<InvalidationSet>& invalidationSet = map.add(key, nullptr).iterator->value;
+    if (!invalidationSet)
+        invalidationSet = adoptPtr(new InvalidationSet);
+
+    if (usesPseudoElement || position == OtherPosition) {
+        invalidationSet->invalidatesWholeSubtree = true;
+        return;
+    }
+    if (position == SubjectPosition) {
+        invalidationSet->invalidatesSelf = true;
+        return;
+    }
+    if (!subjectFeatures.invalidatesDescendants()) {
+        invalidationSet->invalidatesWholeSubtree = true;
+        return;
+    }
+    invalidationSet->add(subjectFeatures);
+}
+
+static void addInvalidationForSimpleSelector(RuleFeatureSet& features, const CSSSelector* selector, SelectorPosition position, const InvalidationSet& subjectFeatures, bool usesPseudoElement)
+{
+    if (selector->m_match == CSSSelector::Id)
+        addInvalidationForFeature(features.idInvalidationSets, selector->value().impl(), position, subjectFeatures, usesPseudoElement);
+    else if (selector->m_match == CSSSelector::Class)
+        addInvalidationForFeature(features.classInvalidationSets, selector->value().impl(), position, subjectFeatures, usesPseudoElement);
+    else if (selector->isAttributeSelector())
+        addInvalidationForFeature(features.attributeInvalidationSets, selector->attribute().localName().impl(), position, subjectFeatures, usesPseudoElement);
+}
+
+void RuleFeatureSet::collectInvalidationSetsFromSelector(const CSSSelector* rightmostSelector)
+{
+    // Elements in the subtree of a changed element that can start or stop matching a
+    // selector are the ones matching its rightmost compound selector; we describe them
+    // by the classes, ids, tag names and attributes it requires.
+    InvalidationSet subjectFeatures;
+    bool usesPseudoElement = false;
+    for (const CSSSelector* selector = rightmostSelector; selector; selector = selector->tagHistory()) {
+        if (selector->matchesPseudoElement())
+            usesPseudoElement = true;
+        addSubjectFeature(selector, subjectFeatures);
+        if (selector->relation() != CSSSelector::SubSelector)
+            break;
+    }
+
+    SelectorPosition position = SubjectPosition;
+    for (const CSSSelector* selector = rightmostSelector; selector; selector = selector->tagHistory()) {
+        addInvalidationForSimpleSelector(*this, selector, position, subjectFeatures, usesPseudoElement);
+        if (const CSSSelectorList* selectorList = selector->selectorList()) {
+            for (const CSSSelector* subSelector = selectorList->first(); subSelector; subSelector = CSSSelectorList::next(subSelector)) {
+                for (const CSSSelector* component = subSelector; component; component = component->tagHistory())
+                    addInvalidationForSimpleSelector(*this, component, position, subjectFeatures, usesPseudoElement);
+            }
+        }
+
+        switch (selector->relation()) {
+        case CSSSelector::SubSelector:
+            break;
+        case CSSSelector::Descendant:
+        case CSSSelector::Child:
+            if (position == SubjectPosition)
+                position = AncestorPosition;
+            break;
+        default:
+            position = OtherPosition;
+            break;
+        }
+    }
+}
+
 void RuleFeatureSet::collectFeaturesFromSelector(const CSSSelector* selector)
 {
     if (selector->m_match == CSSSelector::Id)
@@ -65,6 +195,9 @@ void RuleFeatureSet::add(const RuleFeatureSet& other)
     end = other.attrsInRules.end();
     for (HashSet<AtomicStringImpl*>::const_iterator it = other.attrsInRules.begin(); it != end; ++it)
         attrsInRules.add(*it);
+    addInvalidationSets(idInvalidationSets, other.idInvalidationSets);
+    addInvalidationSets(classInvalidationSets, other.classInvalidationSets);
+    addInvalidationSets(attributeInvalidationSets, other.attributeInvalidationSets);
     siblingRules.appendVector(other.siblingRules);
     uncommonAttributeRules.appendVector(other.uncommonAttributeRules);
     usesFirstLineRules = usesFirstLineRules || other.usesFirstLineRules;
@@ -76,6 +209,9 @@ void RuleFeatureSet::clear()
     idsInRules.clear();
     classesInRules.clear();
     attrsInRules.clear();
+    idInvalidationSets.clear();
+    classInvalidationSets.clear();
+    attributeInvalidationSets.clear();
     siblingRules.clear();
     uncommonAttributeRules.clear();
     usesFirstLineRules = false;
@@ -25,6 +25,7 @@
 #include <wtf/Forward.h>
 #include <wtf/HashMap.h>
 #include <wtf/HashSet.h>
+#include <wtf/OwnPtr.h>
 #include <wtf/text/AtomicString.h>
 
 namespace WebCore {
@@ -44,6 +45,45 @@ struct RuleFeature {
     bool hasDocumentSecurityOrigin;
 };
 
+// Describes which elements have to be restyled when an element gains or loses a
+// given class, id or attribute.
+struct InvalidationSet {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    InvalidationSet()
+        : invalidatesSelf(false)
+        , invalidatesWholeSubtree(false)
+    { }
+
+    void add(const InvalidationSet&);
+    bool invalidatesDescendants() const { return !classes.isEmpty() || !ids.isEmpty() || !tagNames.isEmpty() || !attributes.isEmpty(); }
+
+    // Some selector that may start or stop matching the element itself uses the feature.
+    bool invalidatesSelf;
+    // The feature is used in a way we do not track, for example in front of a sibling
+    // combinator or with a pseudo element; the old behavior of restyling the element
+    // and everything below it applies.
+    bool invalidatesWholeSubtree;
+    // Otherwise, only descendants that have one of these can start or stop matching.
+    HashSet<AtomicStringImpl*> classes;
+    HashSet<AtomicStringImpl*> ids;
+    HashSet<AtomicStringImpl*> tagNames;
+    HashSet<AtomicStringImpl*> attributes;
+};
+
+// The classes, ids and attribute names that changed on an element whose descendants
+// are restyled at the next style recalc. Names rather than invalidation sets are kept
+// since the rule features can be rebuilt in the meantime.
+struct PendingDescendantInvalidation {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    void add(const PendingDescendantInvalidation&);
+
+    Vector<AtomicString> classes;
+    Vector<AtomicString> ids;
+    Vector<AtomicString> attributes;
+};
+
 struct RuleFeatureSet {
     RuleFeatureSet()
         : usesFirstLineRules(false)
@@ -54,10 +94,20 @@ struct RuleFeatureSet {
     void clear();
 
     void collectFeaturesFromSelector(const CSSSelector*);
+    void collectInvalidationSetsFromSelector(const CSSSelector* rightmostSelector);
+
+    const InvalidationSet* classInvalidationSet(AtomicStringImpl* className) const { return classInvalidationSets.get(className); }
+    const InvalidationSet* idInvalidationSet(AtomicStringImpl* id) const { return idInvalidationSets.get(id); }
+    const InvalidationSet* attributeInvalidationSet(AtomicStringImpl* attributeName) const { return attributeInvalidationSets.get(attributeName); }
+
+    typedef HashMap<AtomicStringImpl*, OwnPtr<InvalidationSet> > InvalidationSetMap;
 
     HashSet<AtomicStringImpl*> idsInRules;
     HashSet<AtomicStringImpl*> classesInRules;
     HashSet<AtomicStringImpl*> attrsInRules;
+    InvalidationSetMap idInvalidationSets;
+    InvalidationSetMap classInvalidationSets;
+    InvalidationSetMap attributeInvalidationSets;
     Vector<RuleFeature> siblingRules;
     Vector<RuleFeature> uncommonAttributeRules;
     bool usesFirstLineRules;
@@ -161,6 +161,7 @@ static void collectFeaturesFromRuleData(RuleFeatureSet& features, const RuleData
         } else if (!foundSiblingSelector && selector->isSiblingSelector())
             foundSiblingSelector = true;
     }
+    features.collectInvalidationSetsFromSelector(ruleData.selector());
     if (foundSiblingSelector)
         features.siblingRules.append(RuleFeature(ruleData.rule(), ruleData.selectorIndex(), ruleData.hasDocumentSecurityOrigin()));
     if (ruleData.containsUncommonAttributeSelector())
@@ -373,4 +374,14 @@ void RuleSet::shrinkToFit()
     m_pageRules.shrinkToFit();
 }
 
+#if ENABLE(CSS_SELECTOR_JIT)
+CompiledSelector& RuleSet::compiledSelectorForRule(const RuleData& ruleData) const
+{
+    ASSERT(ruleData.position() < m_ruleCount);
+    if (ruleData.position() >= m_compiledSelectors.size())
+        m_compiledSelectors.grow(m_ruleCount);
+    return m_compiledSelectors[ruleData.position()];
+}
+#endif
+
 } // namespace WebCore
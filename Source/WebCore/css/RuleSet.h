@@ -23,6 +23,7 @@
 #define RuleSet_h
 
 #include "RuleFeature.h"
+#include "SelectorCompiler.h"
 #include "StyleRule.h"
 #include <wtf/Forward.h>
 #include <wtf/HashMap.h>
@@ -103,6 +104,13 @@ struct SameSizeAsRuleData {
 
 COMPILE_ASSERT(sizeof(RuleData) == sizeof(SameSizeAsRuleData), RuleData_should_stay_small);
 
+#if ENABLE(CSS_SELECTOR_JIT)
+struct CompiledSelector {
+    SelectorCompilationStatus status;
+    JSC::MacroAssemblerCodeRef codeRef;
+};
+#endif
+
 class RuleSet {
     WTF_MAKE_NONCOPYABLE(RuleSet); WTF_MAKE_FAST_ALLOCATED;
 public:
@@ -134,6 +142,12 @@ public:
     const Vector<RuleData>* universalRules() const { return &m_universalRules; }
     const Vector<StyleRulePage*>& pageRules() const { return m_pageRules; }
 
+#if ENABLE(CSS_SELECTOR_JIT)
+    // Selectors are compiled the first time their rule is matched. The code is
+    // kept here, indexed by rule position, so that RuleData stays small.
+    CompiledSelector& compiledSelectorForRule(const RuleData&) const;
+#endif
+
 private:
     void addChildRules(const Vector<RefPtr<StyleRuleBase> >&, const MediaQueryEvaluator& medium, StyleResolver*, const ContainerNode* scope, bool hasDocumentSecurityOrigin, AddRuleFlags);
     bool findBestRuleSetAndAdd(const CSSSelector*, RuleData&);
@@ -155,6 +169,9 @@ public:
     unsigned m_ruleCount;
     bool m_autoShrinkToFitEnabled;
     RuleFeatureSet m_features;
+#if ENABLE(CSS_SELECTOR_JIT)
+    mutable Vector<CompiledSelector> m_compiledSelectors;
+#endif
 
     struct RuleSetSelectorPair {
         RuleSetSelectorPair(const CSSSelector* selector, PassOwnPtr<RuleSet> ruleSet) : selector(selector), ruleSet(ruleSet) { }
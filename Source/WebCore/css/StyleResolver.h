@@ -299,6 +299,7 @@ public:
     bool usesSiblingRules() const { return !m_ruleSets.features().siblingRules.isEmpty(); }
     bool usesFirstLineRules() const { return m_ruleSets.features().usesFirstLineRules; }
     bool usesBeforeAfterRules() const { return m_ruleSets.features().usesBeforeAfterRules; }
+    const RuleFeatureSet& ruleFeatureSet() const { return m_ruleSets.features(); }
     
     void invalidateMatchedPropertiesCache();
 
@@ -630,6 +631,9 @@ private:
     CSSToStyleMap m_styleMap;
     InspectorCSSOMWrappers m_inspectorCSSOMWrappers;
 
+    // Resolution state for the element being styled. Together with the selector
+    // filter's parent stack, the matched properties cache and the refcounts in
+    // RenderStyle's shared data, this ties style resolution to the main thread.
     State m_state;
 
 #if ENABLE(CSS_SHADERS)
@@ -0,0 +1,361 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SelectorCompiler.h"
+
+#if ENABLE(CSS_SELECTOR_JIT)
+
+#include "CSSSelector.h"
+#include "Element.h"
+#include "HTMLDocument.h"
+#include "HTMLNames.h"
+#include "LinkBuffer.h"
+#include "MacroAssembler.h"
+#include "QualifiedName.h"
+#include "SelectorChecker.h"
+#include <wtf/StdLibExtras.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+namespace SelectorCompiler {
+
+using namespace HTMLNames;
+
+typedef JSC::MacroAssembler Assembler;
+
+// The generated function follows the SysV x86-64 calling convention. The element being
+// looked at lives in a callee-saved register so that it survives calls to the helpers
+// below, and so does the element the last descendant fragment matched, which is where
+// the search resumes when a child fragment further left fails.
+static const Assembler::RegisterID elementAddressRegister = JSC::X86Registers::ebx;
+static const Assembler::RegisterID backtrackingRegister = JSC::X86Registers::r12;
+static const Assembler::RegisterID argumentRegister0 = JSC::X86Registers::edi;
+static const Assembler::RegisterID argumentRegister1 = JSC::X86Registers::esi;
+static const Assembler::RegisterID returnRegister = JSC::X86Registers::eax;
+static const Assembler::RegisterID scratchRegister = JSC::X86Registers::eax;
+
+enum FragmentRelation {
+    NoRelation,
+    Descendant,
+    Child
+};
+
+// A compound selector, that is every component that has to match the same element.
+struct SelectorFragment {
+    SelectorFragment()
+        : relationToLeftFragment(NoRelation)
+        , relationToRightFragment(NoRelation)
+        , tagName(0)
+    {
+    }
+
+    FragmentRelation relationToLeftFragment;
+    FragmentRelation relationToRightFragment;
+
+    const QualifiedName* tagName;
+    Vector<const AtomicStringImpl*, 1> ids;
+    Vector<const AtomicString*, 4> classNames;
+    Vector<const CSSSelector*, 2> attributes;
+};
+
+typedef Vector<SelectorFragment, 8> SelectorFragmentList;
+
+class SelectorCodeGenerator {
+public:
+    explicit SelectorCodeGenerator(const CSSSelector*);
+    SelectorCompilationStatus compile(JSC::VM*, JSC::MacroAssemblerCodeRef&);
+
+private:
+    static bool addSelectorToFragment(const CSSSelector*, SelectorFragment&);
+
+    void generatePrologue();
+    void generateEpilogue();
+    void generateWalkToParentElement(Assembler::JumpList& failureCases);
+    void generateElementMatching(Assembler::JumpList& failureCases, const SelectorFragment&);
+    void generateElementHasTagName(Assembler::JumpList& failureCases, const QualifiedName& nameToMatch);
+    void generateElementHasId(Assembler::JumpList& failureCases, const AtomicStringImpl* idToMatch);
+    void generateElementHasClassName(Assembler::JumpList& failureCases, const AtomicString* classNameToMatch);
+    void generateElementAttributeMatching(Assembler::JumpList& failureCases, const CSSSelector* attributeSelector);
+
+    struct BacktrackingEntry {
+        Assembler::Label searchNextAncestor;
+        Assembler::JumpList failureCases;
+    };
+
+    Assembler m_assembler;
+    SelectorCompilationStatus m_compilationStatus;
+    SelectorFragmentList m_selectorFragments;
+    Vector<BacktrackingEntry, 4> m_backtrackingEntries;
+    Vector<std::pair<Assembler::Call, JSC::FunctionPtr>, 4> m_functionCalls;
+};
+
+SelectorCompilationStatus compileSelector(const CSSSelector* selector, JSC::VM* vm, JSC::MacroAssemblerCodeRef& codeRef)
+{
+    if (!vm->canUseJIT())
+        return SelectorCompilationStatus::CannotCompile;
+    SelectorCodeGenerator codeGenerator(selector);
+    return codeGenerator.compile(vm, codeRef);
+}
+
+static inline bool attributeSelectorIsCompilable(const CSSSelector* selector)
+{
+    // The style attribute is synchronized lazily, and case insensitive values would need
+    // folding; neither is worth doing in generated code.
+    if (selector->attribute() == styleAttr)
+        return false;
+    return selector->m_match == CSSSelector::Set || HTMLDocument::isCaseSensitiveAttribute(selector->attribute());
+}
+
+bool SelectorCodeGenerator::addSelectorToFragment(const CSSSelector* selector, SelectorFragment& fragment)
+{
+    switch (selector->m_match) {
+    case CSSSelector::Tag:
+        if (fragment.tagName)
+            return false;
+        if (selector->tagQName() != anyQName())
+            fragment.tagName = &selector->tagQName();
+        return true;
+    case CSSSelector::Id:
+        fragment.ids.append(selector->value().impl());
+        return true;
+    case CSSSelector::Class:
+        fragment.classNames.append(&selector->value());
+        return true;
+    case CSSSelector::Set:
+    case CSSSelector::Exact:
+        if (!attributeSelectorIsCompilable(selector))
+            return false;
+        fragment.attributes.append(selector);
+        return true;
+    default:
+        return false;
+    }
+}
+
+SelectorCodeGenerator::SelectorCodeGenerator(const CSSSelector* rootSelector)
+    : m_compilationStatus(SelectorCompilationStatus::SimpleSelectorChecker)
+{
+    SelectorFragment fragment;
+    FragmentRelation relationToPreviousFragment = NoRelation;
+    for (const CSSSelector* selector = rootSelector; selector; selector = selector->tagHistory()) {
+        if (!addSelectorToFragment(selector, fragment)) {
+            m_compilationStatus = SelectorCompilationStatus::CannotCompile;
+            return;
+        }
+
+        if (!selector->tagHistory())
+            break;
+
+        FragmentRelation relationToLeftFragment;
+        switch (selector->relation()) {
+        case CSSSelector::SubSelector:
+            continue;
+        case CSSSelector::Descendant:
+            relationToLeftFragment = Descendant;
+            break;
+        case CSSSelector::Child:
+            relationToLeftFragment = Child;
+            break;
+        default:
+            m_compilationStatus = SelectorCompilationStatus::CannotCompile;
+            return;
+        }
+
+        fragment.relationToRightFragment = relationToPreviousFragment;
+        fragment.relationToLeftFragment = relationToLeftFragment;
+        m_selectorFragments.append(fragment);
+        fragment = SelectorFragment();
+        relationToPreviousFragment = relationToLeftFragment;
+    }
+    fragment.relationToRightFragment = relationToPreviousFragment;
+    m_selectorFragments.append(fragment);
+}
+
+SelectorCompilationStatus SelectorCodeGenerator::compile(JSC::VM* vm, JSC::MacroAssemblerCodeRef& codeRef)
+{
+    if (m_compilationStatus == SelectorCompilationStatus::CannotCompile)
+        return m_compilationStatus;
+
+    generatePrologue();
+    m_assembler.move(argumentRegister0, elementAddressRegister);
+
+    // Fragments are matched right to left. A descendant fragment searches up the ancestors
+    // until it matches and remembers where it did; if a chain of child fragments after it
+    // then fails, the search resumes from the parent of that element. This is the same
+    // backtracking SelectorCheckerFastPath does.
+    Assembler::JumpList failureCases;
+    size_t backtrackingEntryIndex = notFound;
+    for (size_t i = 0; i < m_selectorFragments.size(); ++i) {
+        const SelectorFragment& fragment = m_selectorFragments[i];
+        switch (fragment.relationToRightFragment) {
+        case NoRelation:
+            generateElementMatching(failureCases, fragment);
+            break;
+        case Child: {
+            Assembler::JumpList& childFailureCases = backtrackingEntryIndex == notFound ? failureCases : m_backtrackingEntries[backtrackingEntryIndex].failureCases;
+            generateWalkToParentElement(childFailureCases);
+            generateElementMatching(childFailureCases, fragment);
+            break;
+        }
+        case Descendant: {
+            Assembler::Label searchNextAncestor = m_assembler.label();
+            generateWalkToParentElement(failureCases);
+            Assembler::JumpList ancestorFailureCases;
+            generateElementMatching(ancestorFailureCases, fragment);
+            ancestorFailureCases.linkTo(searchNextAncestor, &m_assembler);
+
+            backtrackingEntryIndex = notFound;
+            if (fragment.relationToLeftFragment == Child) {
+                m_assembler.move(elementAddressRegister, backtrackingRegister);
+                backtrackingEntryIndex = m_backtrackingEntries.size();
+                m_backtrackingEntries.append(BacktrackingEntry());
+                m_backtrackingEntries.last().searchNextAncestor = searchNextAncestor;
+            }
+            break;
+        }
+        }
+    }
+
+    m_assembler.move(Assembler::TrustedImm32(1), returnRegister);
+    generateEpilogue();
+
+    for (size_t i = 0; i < m_backtrackingEntries.size(); ++i) {
+        BacktrackingEntry& entry = m_backtrackingEntries[i];
+        if (entry.failureCases.empty())
+            continue;
+        entry.failureCases.link(&m_assembler);
+        m_assembler.move(backtrackingRegister, elementAddressRegister);
+        m_assembler.jump().linkTo(entry.searchNextAncestor, &m_assembler);
+    }
+
+    failureCases.link(&m_assembler);
+    m_assembler.move(Assembler::TrustedImm32(0), returnRegister);
+    generateEpilogue();
+
+    JSC::LinkBuffer linkBuffer(*vm, &m_assembler, 0, JSC::JITCompilationCanFail);
+    if (linkBuffer.didFailToAllocate())
+        return SelectorCompilationStatus::CannotCompile;
+    for (size_t i = 0; i < m_functionCalls.size(); ++i)
+        linkBuffer.link(m_functionCalls[i].first, m_functionCalls[i].second);
+
+    codeRef = linkBuffer.finalizeCodeWithoutDisassembly();
+    return m_compilationStatus;
+}
+
+void SelectorCodeGenerator::generatePrologue()
+{
+    // Keeps the stack 16 byte aligned for the helper calls.
+    m_assembler.push(JSC::X86Registers::ebp);
+    m_assembler.move(JSC::X86Registers::esp, JSC::X86Registers::ebp);
+    m_assembler.push(elementAddressRegister);
+    m_assembler.push(backtrackingRegister);
+}
+
+void SelectorCodeGenerator::generateEpilogue()
+{
+    m_assembler.pop(backtrackingRegister);
+    m_assembler.pop(elementAddressRegister);
+    m_assembler.pop(JSC::X86Registers::ebp);
+    m_assembler.ret();
+}
+
+void SelectorCodeGenerator::generateWalkToParentElement(Assembler::JumpList& failureCases)
+{
+    // Elements are never shadow roots, so their parent node is the parent pointer itself.
+    m_assembler.loadPtr(Assembler::Address(elementAddressRegister, Node::parentNodeMemoryOffset()), elementAddressRegister);
+    failureCases.append(m_assembler.branchTestPtr(Assembler::Zero, elementAddressRegister));
+    failureCases.append(m_assembler.branchTest32(Assembler::Zero, Assembler::Address(elementAddressRegister, Node::nodeFlagsMemoryOffset()), Assembler::TrustedImm32(Node::flagIsElement())));
+}
+
+void SelectorCodeGenerator::generateElementMatching(Assembler::JumpList& failureCases, const SelectorFragment& fragment)
+{
+    // Cheapest checks first; class names and attributes need a call.
+    if (fragment.tagName)
+        generateElementHasTagName(failureCases, *fragment.tagName);
+    for (size_t i = 0; i < fragment.ids.size(); ++i)
+        generateElementHasId(failureCases, fragment.ids[i]);
+    for (size_t i = 0; i < fragment.classNames.size(); ++i)
+        generateElementHasClassName(failureCases, fragment.classNames[i]);
+    for (size_t i = 0; i < fragment.attributes.size(); ++i)
+        generateElementAttributeMatching(failureCases, fragment.attributes[i]);
+}
+
+void SelectorCodeGenerator::generateElementHasTagName(Assembler::JumpList& failureCases, const QualifiedName& nameToMatch)
+{
+    // Same as SelectorChecker::tagMatches(). Both names are atomic, so comparing the
+    // string pointers is enough.
+    COMPILE_ASSERT(sizeof(AtomicString) == sizeof(AtomicStringImpl*), AtomicString_is_a_single_pointer);
+    const AtomicString& localName = nameToMatch.localName();
+    const AtomicString& namespaceURI = nameToMatch.namespaceURI();
+
+    m_assembler.loadPtr(Assembler::Address(elementAddressRegister, Element::tagQNameMemoryOffset() + QualifiedName::implMemoryOffset()), scratchRegister);
+    if (localName != starAtom)
+        failureCases.append(m_assembler.branchPtr(Assembler::NotEqual, Assembler::Address(scratchRegister, OBJECT_OFFSETOF(QualifiedName::QualifiedNameImpl, m_localName)), Assembler::TrustedImmPtr(localName.impl())));
+    if (namespaceURI != starAtom)
+        failureCases.append(m_assembler.branchPtr(Assembler::NotEqual, Assembler::Address(scratchRegister, OBJECT_OFFSETOF(QualifiedName::QualifiedNameImpl, m_namespace)), Assembler::TrustedImmPtr(namespaceURI.impl())));
+}
+
+void SelectorCodeGenerator::generateElementHasId(Assembler::JumpList& failureCases, const AtomicStringImpl* idToMatch)
+{
+    m_assembler.loadPtr(Assembler::Address(elementAddressRegister, Element::elementDataMemoryOffset()), scratchRegister);
+    failureCases.append(m_assembler.branchTestPtr(Assembler::Zero, scratchRegister));
+    failureCases.append(m_assembler.branchPtr(Assembler::NotEqual, Assembler::Address(scratchRegister, ElementData::idForStyleResolutionMemoryOffset()), Assembler::TrustedImmPtr(idToMatch)));
+}
+
+static unsigned elementHasClassName(const Element* element, const AtomicString* className)
+{
+    return element->hasClass() && element->classNames().contains(*className);
+}
+
+void SelectorCodeGenerator::generateElementHasClassName(Assembler::JumpList& failureCases, const AtomicString* classNameToMatch)
+{
+    // Elements without any attributes cannot have a class; don't bother calling out for them.
+    m_assembler.loadPtr(Assembler::Address(elementAddressRegister, Element::elementDataMemoryOffset()), scratchRegister);
+    failureCases.append(m_assembler.branchTestPtr(Assembler::Zero, scratchRegister));
+
+    m_assembler.move(elementAddressRegister, argumentRegister0);
+    m_assembler.move(Assembler::TrustedImmPtr(classNameToMatch), argumentRegister1);
+    m_functionCalls.append(std::make_pair(m_assembler.call(), JSC::FunctionPtr(elementHasClassName)));
+    failureCases.append(m_assembler.branchTest32(Assembler::Zero, returnRegister));
+}
+
+static unsigned elementAttributeMatches(const Element* element, const CSSSelector* attributeSelector)
+{
+    return SelectorChecker::checkExactAttribute(element, attributeSelector, attributeSelector->attribute(), attributeSelector->value().impl());
+}
+
+void SelectorCodeGenerator::generateElementAttributeMatching(Assembler::JumpList& failureCases, const CSSSelector* attributeSelector)
+{
+    m_assembler.move(elementAddressRegister, argumentRegister0);
+    m_assembler.move(Assembler::TrustedImmPtr(attributeSelector), argumentRegister1);
+    m_functionCalls.append(std::make_pair(m_assembler.call(), JSC::FunctionPtr(elementAttributeMatches)));
+    failureCases.append(m_assembler.branchTest32(Assembler::Zero, returnRegister));
+}
+
+} // namespace SelectorCompiler
+} // namespace WebCore
+
+#endif // ENABLE(CSS_SELECTOR_JIT)
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SelectorCompiler_h
+#define SelectorCompiler_h
+
+#if ENABLE(CSS_SELECTOR_JIT)
+
+#include "MacroAssemblerCodeRef.h"
+
+namespace JSC {
+class VM;
+}
+
+namespace WebCore {
+
+class CSSSelector;
+class Element;
+
+class SelectorCompilationStatus {
+public:
+    enum Status {
+        NotCompiled,
+        CannotCompile,
+        SimpleSelectorChecker
+    };
+
+    SelectorCompilationStatus()
+        : m_status(NotCompiled)
+    {
+    }
+
+    SelectorCompilationStatus(Status status)
+        : m_status(status)
+    {
+    }
+
+    operator Status() const { return m_status; }
+
+private:
+    Status m_status;
+};
+
+namespace SelectorCompiler {
+
+typedef unsigned (*SimpleSelectorChecker)(const Element*);
+
+// Compiles a selector made of tag, id, class and exact or set attribute components,
+// joined by descendant, child and subselector combinators, into a function that
+// returns whether an element matches it. This covers the same selectors as
+// SelectorCheckerFastPath, with the same semantics, minus the rightmost pseudo
+// classes. Anything else is CannotCompile and has to go through the interpreter.
+// The generated code refers to the selector's strings, so it must not outlive it.
+SelectorCompilationStatus compileSelector(const CSSSelector*, JSC::VM*, JSC::MacroAssemblerCodeRef& outputCodeRef);
+
+inline SimpleSelectorChecker simpleSelectorCheckerFunction(const JSC::MacroAssemblerCodeRef& codeRef, SelectorCompilationStatus status)
+{
+    ASSERT_UNUSED(status, status == SelectorCompilationStatus::SimpleSelectorChecker);
+    return reinterpret_cast<SimpleSelectorChecker>(codeRef.code().executableAddress());
+}
+
+} // namespace SelectorCompiler
+} // namespace WebCore
+
+#endif // ENABLE(CSS_SELECTOR_JIT)
+
+#endif // SelectorCompiler_h
@@ -33,6 +33,7 @@
 #include "Document.h"
 #include "NodeRareData.h"
 #include "StyledElement.h"
+#include "TreeScope.h"
 
 namespace WebCore {
 
@@ -53,4 +54,16 @@ bool ClassNodeList::nodeMatches(Element* testNode) const
     return nodeMatchesInlined(testNode);
 }
 
+const Vector<Element*>* ClassNodeList::elementsFromIndex(ContainerNode* root) const
+{
+    if (m_classNames.size() != 1 || !root->isInTreeScope() || root != root->treeScope()->rootNode())
+        return 0;
+    TreeScope* scope = root->treeScope();
+    const Vector<Element*>* elements = scope->elementsWithClassName(m_classNames[0]);
+    // Elements that are neither HTML nor SVG can have a class, but are not in the index.
+    if (!elements || !scope->indexesAllElementsWithClassNames())
+        return 0;
+    return elements;
+}
+
 } // namespace WebCore
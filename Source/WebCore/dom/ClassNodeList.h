@@ -52,6 +52,7 @@ private:
     ClassNodeList(PassRefPtr<Node> rootNode, const String& classNames);
 
     virtual bool nodeMatches(Element*) const;
+    virtual const Vector<Element*>* elementsFromIndex(ContainerNode*) const OVERRIDE;
 
     SpaceSplitString m_classNames;
     String m_originalClassNames;
@@ -146,6 +146,7 @@
 #include "Traversal.cpp"
 #include "TreeScope.cpp"
 #include "TreeScopeAdopter.cpp"
+#include "TreeScopeElementIndex.cpp"
 #include "TreeWalker.cpp"
 #include "UIEvent.cpp"
 #include "UIEventWithKeyState.cpp"
@@ -1742,6 +1742,35 @@ void Document::styleRecalcTimerFired(Timer<Document>*)
     updateStyleIfNeeded();
 }
 
+void Document::scheduleDescendantStyleInvalidation(Element* element, const PendingDescendantInvalidation& pendingDescendantInvalidation)
+{
+    ASSERT(element->document() == this);
+    OwnPtr<PendingDescendantInvalidation>& pending = m_pendingDescendantInvalidations.add(element, nullptr).iterator->value;
+    if (!pending)
+        pending = adoptPtr(new PendingDescendantInvalidation);
+    pending->add(pendingDescendantInvalidation);
+
+    setChildNeedsStyleRecalc();
+    scheduleStyleRecalc();
+}
+
+void Document::cancelDescendantStyleInvalidation(Element* element)
+{
+    if (!m_pendingDescendantInvalidations.isEmpty())
+        m_pendingDescendantInvalidations.remove(element);
+}
+
+void Document::invalidatePendingDescendantStyle()
+{
+    if (m_pendingDescendantInvalidations.isEmpty())
+        return;
+    PendingDescendantInvalidationMap pendingDescendantInvalidations;
+    pendingDescendantInvalidations.swap(m_pendingDescendantInvalidations);
+    PendingDescendantInvalidationMap::const_iterator end = pendingDescendantInvalidations.end();
+    for (PendingDescendantInvalidationMap::const_iterator it = pendingDescendantInvalidations.begin(); it != end; ++it)
+        it->key->invalidateDescendantStyle(*it->value);
+}
+
 bool Document::childNeedsAndNotInStyleRecalc()
 {
     return childNeedsStyleRecalc() && !m_inStyleRecalc;
@@ -1767,6 +1796,9 @@ void Document::recalcStyle(StyleChange change)
     if (m_styleSheetCollection->needsUpdateActiveStylesheetsOnStyleRecalc())
         m_styleSheetCollection->updateActiveStyleSheets(DocumentStyleSheetCollection::FullUpdate);
 
+    // Done once the active style sheets are known, so that their invalidation sets are used.
+    invalidatePendingDescendantStyle();
+
     InspectorInstrumentationCookie cookie = InspectorInstrumentation::willRecalculateStyle(this);
 
     if (m_elemSheet && m_elemSheet->contents()->usesRemUnits())
@@ -1821,6 +1853,12 @@ void Document::recalcStyle(StyleChange change)
 
         m_inStyleRecalc = false;
 
+        // Attribute changes made while restyling wait for the next style recalc.
+        if (!m_pendingDescendantInvalidations.isEmpty()) {
+            setChildNeedsStyleRecalc();
+            scheduleStyleRecalc();
+        }
+
         // Pseudo element removal and similar may only work with these flags still set. Reset them after the style recalc.
         if (m_styleResolver)
             m_styleSheetCollection->resetCSSFeatureFlags();
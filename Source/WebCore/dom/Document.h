@@ -122,6 +122,7 @@ class NamedFlowCollection;
 class NodeFilter;
 class NodeIterator;
 class Page;
+struct PendingDescendantInvalidation;
 class PlatformMouseEvent;
 class ProcessingInstruction;
 class Range;
@@ -698,6 +699,12 @@ public:
     bool hasPendingForcedStyleRecalc() const;
     void styleRecalcTimerFired(Timer<Document>*);
 
+    // Descendants of elements whose classes, id or attributes changed are checked
+    // against the invalidation sets for the changes at the start of the next style recalc.
+    void scheduleDescendantStyleInvalidation(Element*, const PendingDescendantInvalidation&);
+    void cancelDescendantStyleInvalidation(Element*);
+    bool hasPendingDescendantStyleInvalidation() const { return !m_pendingDescendantInvalidations.isEmpty(); }
+
     void registerNodeList(LiveNodeListBase*);
     void unregisterNodeList(LiveNodeListBase*);
     bool shouldInvalidateNodeListCaches(const QualifiedName* attrName = 0) const;
@@ -1212,6 +1219,8 @@ private:
 
     void detachParser();
 
+    void invalidatePendingDescendantStyle();
+
     typedef void (*ArgumentsCallback)(const String& keyString, const String& valueString, Document*, void* data);
     void processArguments(const String& features, void* data, ArgumentsCallback);
 
@@ -1368,6 +1377,8 @@ private:
     bool m_bParsing;
     
     Timer<Document> m_styleRecalcTimer;
+    typedef HashMap<Element*, OwnPtr<PendingDescendantInvalidation> > PendingDescendantInvalidationMap;
+    PendingDescendantInvalidationMap m_pendingDescendantInvalidations;
     bool m_pendingStyleRecalcShouldForce;
     bool m_inStyleRecalc;
     bool m_closeAfterStyleRecalc;
@@ -1011,16 +1011,167 @@ static inline AtomicString makeIdForStyleResolution(const AtomicString& value, b
     return value;
 }
 
-static bool checkNeedsStyleInvalidationForIdChange(const AtomicString& oldId, const AtomicString& newId, StyleResolver* styleResolver)
-{
-    ASSERT(newId != oldId);
-    if (!oldId.isEmpty() && styleResolver->hasSelectorForId(oldId))
+// Gathers the invalidation sets for the classes, ids and attributes that changed on
+// an element. The element itself is marked right away; the descendants that may
+// depend on the changes are found at the next style recalc, see
+// Document::scheduleDescendantStyleInvalidation().
+class StyleInvalidationCollector {
+public:
+    explicit StyleInvalidationCollector(const RuleFeatureSet& features)
+        : m_features(features)
+        , m_invalidatesSelf(false)
+        , m_invalidatesWholeSubtree(false)
+    {
+    }
+
+    void addClass(const AtomicString& className)
+    {
+        if (add(m_features.classesInRules.contains(className.impl()), m_features.classInvalidationSet(className.impl())))
+            m_pendingDescendantInvalidation.classes.append(className);
+    }
+
+    void addId(const AtomicString& id)
+    {
+        if (id.isEmpty())
+            return;
+        if (add(m_features.idsInRules.contains(id.impl()), m_features.idInvalidationSet(id.impl())))
+            m_pendingDescendantInvalidation.ids.append(id);
+    }
+
+    void addAttribute(const AtomicString& localName)
+    {
+        if (add(m_features.attrsInRules.contains(localName.impl()), m_features.attributeInvalidationSet(localName.impl())))
+            m_pendingDescendantInvalidation.attributes.append(localName);
+    }
+
+    void add(const PendingDescendantInvalidation& pendingDescendantInvalidation)
+    {
+        for (unsigned i = 0; i < pendingDescendantInvalidation.classes.size(); ++i)
+            addClass(pendingDescendantInvalidation.classes[i]);
+        for (unsigned i = 0; i < pendingDescendantInvalidation.ids.size(); ++i)
+            addId(pendingDescendantInvalidation.ids[i]);
+        for (unsigned i = 0; i < pendingDescendantInvalidation.attributes.size(); ++i)
+            addAttribute(pendingDescendantInvalidation.attributes[i]);
+    }
+
+    void invalidateStyle(Element*) const;
+    void invalidateDescendantStyle(Element*) const;
+
+private:
+    // Returns true when the descendants have to be checked against the invalidation set.
+    bool add(bool usedInRules, const InvalidationSet* invalidationSet)
+    {
+        if (!usedInRules)
+            return false;
+        // Attributes referenced by attr() in generated content are in the feature set
+        // without having come from a selector.
+        if (!invalidationSet || invalidationSet->invalidatesWholeSubtree) {
+            m_invalidatesWholeSubtree = true;
+            return false;
+        }
+        m_invalidatesSelf |= invalidationSet->invalidatesSelf;
+        if (!invalidationSet->invalidatesDescendants())
+            return false;
+        m_descendantSets.append(invalidationSet);
         return true;
-    if (!newId.isEmpty() && styleResolver->hasSelectorForId(newId))
+    }
+
+    bool descendantMatches(Element*) const;
+
+    const RuleFeatureSet& m_features;
+    bool m_invalidatesSelf;
+    bool m_invalidatesWholeSubtree;
+    Vector<const InvalidationSet*, 8> m_descendantSets;
+    PendingDescendantInvalidation m_pendingDescendantInvalidation;
+};
+
+// Tag and attribute names of elements outside the HTML namespace keep their case, so
+// they are compared to the names in the invalidation sets ignoring case.
+static bool namesContain(const HashSet<AtomicStringImpl*>& names, const AtomicString& name, Element* element)
+{
+    if (names.contains(name.impl()))
         return true;
+    if (element->isHTMLElement())
+        return false;
+    HashSet<AtomicStringImpl*>::const_iterator end = names.end();
+    for (HashSet<AtomicStringImpl*>::const_iterator it = names.begin(); it != end; ++it) {
+        if (equalIgnoringCase(*it, name.impl()))
+            return true;
+    }
+    return false;
+}
+
+bool StyleInvalidationCollector::descendantMatches(Element* element) const
+{
+    for (unsigned i = 0; i < m_descendantSets.size(); ++i) {
+        const InvalidationSet& invalidationSet = *m_descendantSets[i];
+        if (!invalidationSet.tagNames.isEmpty() && namesContain(invalidationSet.tagNames, element->localName(), element))
+            return true;
+        if (!invalidationSet.ids.isEmpty() && element->hasID() && invalidationSet.ids.contains(element->idForStyleResolution().impl()))
+            return true;
+        if (!invalidationSet.classes.isEmpty() && element->hasClass()) {
+            const SpaceSplitString& classNames = element->classNames();
+            for (unsigned j = 0; j < classNames.size(); ++j) {
+                if (invalidationSet.classes.contains(classNames[j].impl()))
+                    return true;
+            }
+        }
+        if (!invalidationSet.attributes.isEmpty() && element->hasAttributes()) {
+            unsigned attributeCount = element->attributeCount();
+            for (unsigned j = 0; j < attributeCount; ++j) {
+                if (namesContain(invalidationSet.attributes, element->attributeItem(j)->localName(), element))
+                    return true;
+            }
+        }
+    }
     return false;
 }
 
+void StyleInvalidationCollector::invalidateStyle(Element* element) const
+{
+    if (m_invalidatesWholeSubtree) {
+        element->setNeedsStyleRecalc();
+        return;
+    }
+    if (m_invalidatesSelf)
+        element->setNeedsStyleRecalc(InlineStyleChange);
+    // Several changes to the same element before the next style recalc then cost
+    // a single walk of its descendants.
+    if (!m_descendantSets.isEmpty())
+        element->document()->scheduleDescendantStyleInvalidation(element, m_pendingDescendantInvalidation);
+}
+
+void StyleInvalidationCollector::invalidateDescendantStyle(Element* element) const
+{
+    if (m_invalidatesWholeSubtree) {
+        element->setNeedsStyleRecalc();
+        return;
+    }
+
+    // Restyling only the descendants that can be affected is much cheaper than
+    // forcing a recalc of the whole subtree when a class on a container changes.
+    Element* descendant = ElementTraversal::firstWithin(element);
+    while (descendant) {
+        if (descendant->styleChangeType() >= FullStyleChange) {
+            descendant = ElementTraversal::nextSkippingChildren(descendant, element);
+            continue;
+        }
+        if (descendantMatches(descendant))
+            descendant->setNeedsStyleRecalc(InlineStyleChange);
+        descendant = ElementTraversal::next(descendant, element);
+    }
+}
+
+void Element::invalidateDescendantStyle(const PendingDescendantInvalidation& pendingDescendantInvalidation)
+{
+    StyleResolver* styleResolver = document()->styleResolverIfExists();
+    if (!attached() || !styleResolver || styleChangeType() >= FullStyleChange)
+        return;
+    StyleInvalidationCollector collector(styleResolver->ruleFeatureSet());
+    collector.add(pendingDescendantInvalidation);
+    collector.invalidateDescendantStyle(this);
+}
+
 void Element::attributeChanged(const QualifiedName& name, const AtomicString& newValue, AttributeModificationReason)
 {
     parseAttribute(name, newValue);
@@ -1036,7 +1187,12 @@ void Element::attributeChanged(const QualifiedName& name, const AtomicString& ne
         AtomicString newId = makeIdForStyleResolution(newValue, document()->inQuirksMode());
         if (newId != oldId) {
             elementData()->setIdForStyleResolution(newId);
-            shouldInvalidateStyle = testShouldInvalidateStyle && checkNeedsStyleInvalidationForIdChange(oldId, newId, styleResolver);
+            if (testShouldInvalidateStyle) {
+                StyleInvalidationCollector collector(styleResolver->ruleFeatureSet());
+                collector.addId(oldId);
+                collector.addId(newId);
+                collector.invalidateStyle(this);
+            }
         }
     } else if (name == classAttr)
         classAttributeChanged(newValue);
@@ -1096,70 +1252,77 @@ static inline bool classStringHasClassName(const AtomicString& newClassString)
     return classStringHasClassName(newClassString.characters16(), length);
 }
 
-template<typename Checker>
-static bool checkSelectorForClassChange(const SpaceSplitString& changedClasses, const Checker& checker)
+static void collectInvalidationSetsForClassChange(const SpaceSplitString& changedClasses, StyleInvalidationCollector& collector)
 {
     unsigned changedSize = changedClasses.size();
-    for (unsigned i = 0; i < changedSize; ++i) {
-        if (checker.hasSelectorForClass(changedClasses[i]))
-            return true;
-    }
-    return false;
+    for (unsigned i = 0; i < changedSize; ++i)
+        collector.addClass(changedClasses[i]);
 }
 
-template<typename Checker>
-static bool checkSelectorForClassChange(const SpaceSplitString& oldClasses, const SpaceSplitString& newClasses, const Checker& checker)
+static void collectInvalidationSetsForClassChange(const SpaceSplitString& oldClasses, const SpaceSplitString& newClasses, StyleInvalidationCollector& collector)
 {
     unsigned oldSize = oldClasses.size();
-    if (!oldSize)
-        return checkSelectorForClassChange(newClasses, checker);
+    if (!oldSize) {
+        collectInvalidationSetsForClassChange(newClasses, collector);
+        return;
+    }
     BitVector remainingClassBits;
     remainingClassBits.ensureSize(oldSize);
     // Class vectors tend to be very short. This is faster than using a hash table.
     unsigned newSize = newClasses.size();
     for (unsigned i = 0; i < newSize; ++i) {
+        bool found = false;
         for (unsigned j = 0; j < oldSize; ++j) {
             if (newClasses[i] == oldClasses[j]) {
                 remainingClassBits.quickSet(j);
-                continue;
+                found = true;
             }
         }
-        if (checker.hasSelectorForClass(newClasses[i]))
-            return true;
+        if (!found)
+            collector.addClass(newClasses[i]);
     }
     for (unsigned i = 0; i < oldSize; ++i) {
         // If the bit is not set the the corresponding class has been removed.
         if (remainingClassBits.quickGet(i))
             continue;
-        if (checker.hasSelectorForClass(oldClasses[i]))
-            return true;
+        collector.addClass(oldClasses[i]);
     }
-    return false;
 }
 
 void Element::classAttributeChanged(const AtomicString& newClassString)
 {
     StyleResolver* styleResolver = document()->styleResolverIfExists();
     bool testShouldInvalidateStyle = attached() && styleResolver && styleChangeType() < FullStyleChange;
-    bool shouldInvalidateStyle = false;
+    TreeScopeElementIndex* elementIndex = isInTreeScope() ? treeScope()->elementIndex() : 0;
 
     if (classStringHasClassName(newClassString)) {
         const bool shouldFoldCase = document()->inQuirksMode();
         const SpaceSplitString oldClasses = elementData()->classNames();
         elementData()->setClass(newClassString, shouldFoldCase);
         const SpaceSplitString& newClasses = elementData()->classNames();
-        shouldInvalidateStyle = testShouldInvalidateStyle && checkSelectorForClassChange(oldClasses, newClasses, *styleResolver);
+        if (elementIndex) {
+            elementIndex->removeClassNames(this, oldClasses);
+            elementIndex->addClassNames(this, newClasses);
+        }
+        if (testShouldInvalidateStyle) {
+            StyleInvalidationCollector collector(styleResolver->ruleFeatureSet());
+            collectInvalidationSetsForClassChange(oldClasses, newClasses, collector);
+            collector.invalidateStyle(this);
+        }
     } else {
         const SpaceSplitString& oldClasses = elementData()->classNames();
-        shouldInvalidateStyle = testShouldInvalidateStyle && checkSelectorForClassChange(oldClasses, *styleResolver);
+        if (elementIndex)
+            elementIndex->removeClassNames(this, oldClasses);
+        if (testShouldInvalidateStyle) {
+            StyleInvalidationCollector collector(styleResolver->ruleFeatureSet());
+            collectInvalidationSetsForClassChange(oldClasses, collector);
+            collector.invalidateStyle(this);
+        }
         elementData()->clearClass();
     }
 
     if (hasRareData())
         elementRareData()->clearClassListValueForQuirksMode();
-
-    if (shouldInvalidateStyle)
-        setNeedsStyleRecalc();
 }
 
 // Returns true is the given attribute is an event handler.
@@ -1355,6 +1518,14 @@ Node::InsertionNotificationRequest Element::insertedInto(ContainerNode* insertio
             updateLabel(newScope, nullAtom, fastGetAttribute(forAttr));
     }
 
+    if (newScope && !isPseudoElement()) {
+        if (TreeScopeElementIndex* elementIndex = newScope->elementIndex()) {
+            elementIndex->addElement(this);
+            if (hasClass())
+                elementIndex->addClassNames(this, classNames());
+        }
+    }
+
     return InsertionDone;
 }
 
@@ -1410,6 +1581,14 @@ void Element::removedFrom(ContainerNode* insertionPoint)
             if (oldScope->shouldCacheLabelsByForAttribute())
                 updateLabel(oldScope, fastGetAttribute(forAttr), nullAtom);
         }
+
+        if (oldScope && !isPseudoElement()) {
+            if (TreeScopeElementIndex* elementIndex = oldScope->elementIndex()) {
+                elementIndex->removeElement(this);
+                if (hasClass())
+                    elementIndex->removeClassNames(this, classNames());
+            }
+        }
     }
 
     ContainerNode::removedFrom(insertionPoint);
@@ -1469,6 +1648,7 @@ void Element::detach(const AttachContext& context)
     WidgetHierarchyUpdatesSuspensionScope suspendWidgetHierarchyUpdates;
     unregisterNamedFlowContentNode();
     cancelFocusAppearanceUpdate();
+    document()->cancelDescendantStyleInvalidation(this);
     if (hasRareData()) {
         ElementRareData* data = elementRareData();
         data->setPseudoElement(BEFORE, 0);
@@ -3008,8 +3188,12 @@ void Element::willModifyAttribute(const QualifiedName& name, const AtomicString&
     }
 
     if (oldValue != newValue) {
-        if (attached() && document()->styleResolverIfExists() && document()->styleResolverIfExists()->hasSelectorForAttribute(name.localName()))
-            setNeedsStyleRecalc();
+        StyleResolver* styleResolver = document()->styleResolverIfExists();
+        if (attached() && styleResolver && styleChangeType() < FullStyleChange) {
+            StyleInvalidationCollector collector(styleResolver->ruleFeatureSet());
+            collector.addAttribute(name.localName());
+            collector.invalidateStyle(this);
+        }
     }
 
     if (OwnPtr<MutationObserverInterestGroup> recipients = MutationObserverInterestGroup::createForAttributesMutation(this, name))
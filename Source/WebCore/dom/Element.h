@@ -49,6 +49,7 @@ class IntSize;
 class Locale;
 class UniqueElementData;
 class PseudoElement;
+struct PendingDescendantInvalidation;
 class RenderRegion;
 class ShadowRoot;
 class StylePropertySet;
@@ -67,6 +68,7 @@ public:
     const SpaceSplitString& classNames() const { return m_classNames; }
 
     const AtomicString& idForStyleResolution() const { return m_idForStyleResolution; }
+    static ptrdiff_t idForStyleResolutionMemoryOffset() { return OBJECT_OFFSETOF(ElementData, m_idForStyleResolution); }
     void setIdForStyleResolution(const AtomicString& newId) const { m_idForStyleResolution = newId; }
 
     const StylePropertySet* inlineStyle() const { return m_inlineStyle.get(); }
@@ -354,6 +356,7 @@ public:
     virtual CSSStyleDeclaration* style();
 
     const QualifiedName& tagQName() const { return m_tagName; }
+    static ptrdiff_t tagQNameMemoryOffset() { return OBJECT_OFFSETOF(Element, m_tagName); }
     String tagName() const { return nodeName(); }
     bool hasTagName(const QualifiedName& tagName) const { return m_tagName.matches(tagName); }
     
@@ -396,6 +399,7 @@ public:
     void stripScriptingAttributes(Vector<Attribute>&) const;
 
     const ElementData* elementData() const { return m_elementData.get(); }
+    static ptrdiff_t elementDataMemoryOffset() { return OBJECT_OFFSETOF(Element, m_elementData); }
     UniqueElementData* ensureUniqueElementData();
 
     void synchronizeAllAttributes() const;
@@ -416,6 +420,7 @@ public:
     virtual bool rendererIsNeeded(const NodeRenderingContext&);
     void recalcStyle(StyleChange = NoChange);
     void didAffectSelector(AffectedSelectorMask);
+    void invalidateDescendantStyle(const PendingDescendantInvalidation&);
 
     ElementShadow* shadow() const;
     ElementShadow* ensureShadow();
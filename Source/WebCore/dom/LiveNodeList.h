@@ -200,6 +200,10 @@ public:
     virtual Node* namedItem(const AtomicString&) const OVERRIDE;
     virtual bool nodeMatches(Element*) const = 0;
 
+    // Lists whose items are exactly the elements of a TreeScopeElementIndex list
+    // return it here, so that item() and length() need not walk the tree.
+    virtual const Vector<Element*>* elementsFromIndex(ContainerNode*) const { return 0; }
+
 private:
     virtual bool isLiveNodeList() const OVERRIDE { return true; }
 };
@@ -638,6 +638,11 @@ public:
     virtual void unregisterScopedHTMLStyleChild();
     size_t numberOfScopedHTMLStyleChildren() const;
 
+    // Used by the CSS selector compiler to walk the tree from generated code.
+    static ptrdiff_t nodeFlagsMemoryOffset() { return OBJECT_OFFSETOF(Node, m_nodeFlags); }
+    static ptrdiff_t parentNodeMemoryOffset() { return OBJECT_OFFSETOF(Node, m_parentOrShadowHostNode); }
+    static int32_t flagIsElement() { return IsElementFlag; }
+
     void textRects(Vector<IntRect>&) const;
 
     unsigned connectedSubframeCount() const;
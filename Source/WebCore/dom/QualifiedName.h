@@ -94,6 +94,7 @@ public:
     String toString() const;
 
     QualifiedNameImpl* impl() const { return m_impl; }
+    static ptrdiff_t implMemoryOffset() { return OBJECT_OFFSETOF(QualifiedName, m_impl); }
     
     // Init routine for globals
     static void init();
@@ -29,11 +29,14 @@
 #include "CSSParser.h"
 #include "CSSSelectorList.h"
 #include "Document.h"
+#include "JSDOMWindowBase.h"
 #include "NodeTraversal.h"
 #include "SelectorChecker.h"
 #include "SelectorCheckerFastPath.h"
+#include "Settings.h"
 #include "StaticNodeList.h"
 #include "StyledElement.h"
+#include "TreeScope.h"
 
 namespace WebCore {
 
@@ -50,9 +53,27 @@ void SelectorDataList::initialize(const CSSSelectorList& selectorList)
         m_selectors.uncheckedAppend(SelectorData(selector, SelectorCheckerFastPath::canUse(selector)));
 }
 
+#if ENABLE(CSS_SELECTOR_JIT)
+static inline bool selectorJITEnabled(Document* document)
+{
+    Settings* settings = document->settings();
+    return settings && settings->selectorJITEnabled();
+}
+#endif
+
 inline bool SelectorDataList::selectorMatches(const SelectorData& selectorData, Element* element, const Node* rootNode) const
 {
     if (selectorData.isFastCheckable && !element->isSVGElement()) {
+#if ENABLE(CSS_SELECTOR_JIT)
+        if (selectorJITEnabled(element->document())) {
+            if (selectorData.compilationStatus == SelectorCompilationStatus::NotCompiled)
+                selectorData.compilationStatus = SelectorCompiler::compileSelector(selectorData.selector, JSDOMWindowBase::commonVM(), selectorData.compiledSelectorCodeRef);
+            if (selectorData.compilationStatus == SelectorCompilationStatus::SimpleSelectorChecker) {
+                SelectorCompiler::SimpleSelectorChecker selectorChecker = SelectorCompiler::simpleSelectorCheckerFunction(selectorData.compiledSelectorCodeRef, selectorData.compilationStatus);
+                return selectorChecker(element);
+            }
+        }
+#endif
         SelectorCheckerFastPath selectorCheckerFastPath(selectorData.selector, element);
         if (!selectorCheckerFastPath.matchesRightmostSelector(SelectorChecker::VisitedMatchDisabled))
             return false;
@@ -122,6 +143,43 @@ static inline bool isTreeScopeRoot(const Node* node)
     return node->isDocumentNode() || node->isShadowRoot();
 }
 
+// When a compound selector to the left of the rightmost one has an id, every match
+// is a descendant of the element with that id, or of its parent if a sibling
+// combinator follows it. Walking only that subtree is much cheaper than walking
+// the whole root.
+static const Node* searchRootForIdAncestor(const Node* rootNode, const CSSSelector* selector)
+{
+    if (!rootNode->inDocument())
+        return rootNode;
+    if (rootNode->document()->inQuirksMode())
+        return rootNode;
+
+    // Skip the rightmost compound selector, an id in it is on the matched elements themselves.
+    while (selector->relation() == CSSSelector::SubSelector) {
+        selector = selector->tagHistory();
+        if (!selector)
+            return rootNode;
+    }
+
+    bool inAdjacentChain = selector->relation() == CSSSelector::DirectAdjacent || selector->relation() == CSSSelector::IndirectAdjacent;
+    for (selector = selector->tagHistory(); selector; selector = selector->tagHistory()) {
+        if (selector->m_match == CSSSelector::Id) {
+            const AtomicString& idToMatch = selector->value();
+            if (!rootNode->treeScope()->containsMultipleElementsWithId(idToMatch)) {
+                const Node* searchRoot = rootNode->treeScope()->getElementById(idToMatch);
+                if (searchRoot && inAdjacentChain)
+                    searchRoot = searchRoot->parentNode();
+                if (searchRoot && (isTreeScopeRoot(rootNode) || searchRoot == rootNode || searchRoot->isDescendantOf(rootNode)))
+                    return searchRoot;
+            }
+        }
+        if (selector->relation() == CSSSelector::SubSelector)
+            continue;
+        inAdjacentChain = selector->relation() == CSSSelector::DirectAdjacent || selector->relation() == CSSSelector::IndirectAdjacent;
+    }
+    return rootNode;
+}
+
 template <bool firstMatchOnly>
 ALWAYS_INLINE void SelectorDataList::executeFastPathForIdSelector(const Node* rootNode, const SelectorData& selectorData, const CSSSelector* idSelector, Vector<RefPtr<Node> >& matchedElements) const
 {
@@ -155,9 +213,30 @@ static bool isSingleTagNameSelector(const CSSSelector* selector)
     return selector->isLastInTagHistory() && selector->m_match == CSSSelector::Tag;
 }
 
+template <bool firstMatchOnly>
+static inline void appendIndexedElements(const Vector<Element*>& elements, Vector<RefPtr<Node> >& matchedElements)
+{
+    if (elements.isEmpty())
+        return;
+    if (firstMatchOnly) {
+        matchedElements.append(elements.first());
+        return;
+    }
+    matchedElements.reserveCapacity(matchedElements.size() + elements.size());
+    for (size_t i = 0; i < elements.size(); ++i)
+        matchedElements.uncheckedAppend(elements[i]);
+}
+
 template <bool firstMatchOnly>
 static inline void elementsForLocalName(const Node* rootNode, const AtomicString& localName, Vector<RefPtr<Node> >& matchedElements)
 {
+    if (isTreeScopeRoot(rootNode)) {
+        if (const Vector<Element*>* elements = rootNode->treeScope()->elementsWithLocalName(localName)) {
+            appendIndexedElements<firstMatchOnly>(*elements, matchedElements);
+            return;
+        }
+    }
+
     for (Element* element = ElementTraversal::firstWithin(rootNode); element; element = ElementTraversal::next(element, rootNode)) {
         if (element->localName() == localName) {
             matchedElements.append(element);
@@ -226,6 +305,15 @@ ALWAYS_INLINE void SelectorDataList::executeSingleClassNameSelectorData(const No
     ASSERT(isSingleClassNameSelector(selectorData.selector));
 
     const AtomicString& className = selectorData.selector->value();
+    if (isTreeScopeRoot(rootNode)) {
+        TreeScope* scope = rootNode->treeScope();
+        const Vector<Element*>* elements = scope->elementsWithClassName(className);
+        if (elements && scope->indexesAllElementsWithClassNames()) {
+            appendIndexedElements<firstMatchOnly>(*elements, matchedElements);
+            return;
+        }
+    }
+
     for (Element* element = ElementTraversal::firstWithin(rootNode); element; element = ElementTraversal::next(element, rootNode)) {
         if (element->hasClass() && element->classNames().contains(className)) {
             matchedElements.append(element);
@@ -235,12 +323,66 @@ ALWAYS_INLINE void SelectorDataList::executeSingleClassNameSelectorData(const No
     }
 }
 
+static bool isCompoundClassNameSelector(const CSSSelector* selector)
+{
+    for (; selector; selector = selector->tagHistory()) {
+        if (selector->m_match != CSSSelector::Class)
+            return false;
+        if (!selector->isLastInTagHistory() && selector->relation() != CSSSelector::SubSelector)
+            return false;
+    }
+    return true;
+}
+
+static inline bool hasAllClassNames(const Element* element, const CSSSelector* compoundSelector)
+{
+    if (!element->hasClass())
+        return false;
+    const SpaceSplitString& classNames = element->classNames();
+    for (const CSSSelector* selector = compoundSelector; selector; selector = selector->tagHistory()) {
+        if (!classNames.contains(selector->value()))
+            return false;
+    }
+    return true;
+}
+
 template <bool firstMatchOnly>
-ALWAYS_INLINE void SelectorDataList::executeSingleSelectorData(const Node* rootNode, const SelectorData& selectorData, Vector<RefPtr<Node> >& matchedElements) const
+ALWAYS_INLINE void SelectorDataList::executeCompoundClassNameSelectorData(const Node* rootNode, const SelectorData& selectorData, Vector<RefPtr<Node> >& matchedElements) const
 {
     ASSERT(m_selectors.size() == 1);
+    ASSERT(isCompoundClassNameSelector(selectorData.selector));
+
+    if (isTreeScopeRoot(rootNode)) {
+        TreeScope* scope = rootNode->treeScope();
+        const Vector<Element*>* elements = scope->elementsWithClassName(selectorData.selector->value());
+        if (elements && scope->indexesAllElementsWithClassNames()) {
+            for (size_t i = 0; i < elements->size(); ++i) {
+                Element* element = elements->at(i);
+                if (hasAllClassNames(element, selectorData.selector)) {
+                    matchedElements.append(element);
+                    if (firstMatchOnly)
+                        return;
+                }
+            }
+            return;
+        }
+    }
 
     for (Element* element = ElementTraversal::firstWithin(rootNode); element; element = ElementTraversal::next(element, rootNode)) {
+        if (hasAllClassNames(element, selectorData.selector)) {
+            matchedElements.append(element);
+            if (firstMatchOnly)
+                return;
+        }
+    }
+}
+
+template <bool firstMatchOnly>
+ALWAYS_INLINE void SelectorDataList::executeSingleSelectorData(const Node* rootNode, const Node* searchRootNode, const SelectorData& selectorData, Vector<RefPtr<Node> >& matchedElements) const
+{
+    ASSERT(m_selectors.size() == 1);
+
+    for (Element* element = ElementTraversal::firstWithin(searchRootNode); element; element = ElementTraversal::next(element, searchRootNode)) {
         if (selectorMatches(selectorData, element, rootNode)) {
             matchedElements.append(element);
             if (firstMatchOnly)
@@ -276,8 +418,10 @@ ALWAYS_INLINE void SelectorDataList::execute(Node* rootNode, Vector<RefPtr<Node>
             executeSingleTagNameSelectorData<firstMatchOnly>(rootNode, selectorData, matchedElements);
         else if (isSingleClassNameSelector(selectorData.selector))
             executeSingleClassNameSelectorData<firstMatchOnly>(rootNode, selectorData, matchedElements);
+        else if (isCompoundClassNameSelector(selectorData.selector))
+            executeCompoundClassNameSelectorData<firstMatchOnly>(rootNode, selectorData, matchedElements);
         else
-            executeSingleSelectorData<firstMatchOnly>(rootNode, selectorData, matchedElements);
+            executeSingleSelectorData<firstMatchOnly>(rootNode, searchRootForIdAncestor(rootNode, selectorData.selector), selectorData, matchedElements);
         return;
     }
     executeSingleMultiSelectorData<firstMatchOnly>(rootNode, matchedElements);
@@ -292,8 +436,12 @@ SelectorQuery::SelectorQuery(const CSSSelectorList& selectorList)
 SelectorQuery* SelectorQueryCache::add(const AtomicString& selectors, Document* document, ExceptionCode& ec)
 {
     HashMap<AtomicString, OwnPtr<SelectorQuery> >::iterator it = m_entries.find(selectors);
-    if (it != m_entries.end())
+    if (it != m_entries.end()) {
+        ++m_hitCount;
+        m_recentlyUsed.appendOrMoveToLast(selectors);
         return it->value.get();
+    }
+    ++m_missCount;
 
     CSSParser parser(document);
     CSSSelectorList selectorList;
@@ -310,19 +458,22 @@ SelectorQuery* SelectorQueryCache::add(const AtomicString& selectors, Document*
         return 0;
     }
 
-    const int maximumSelectorQueryCacheSize = 256;
-    if (m_entries.size() == maximumSelectorQueryCacheSize)
-        m_entries.remove(m_entries.begin());
-    
+    if (m_entries.size() == maximumSize) {
+        m_entries.remove(m_recentlyUsed.first());
+        m_recentlyUsed.removeFirst();
+    }
+
     OwnPtr<SelectorQuery> selectorQuery = adoptPtr(new SelectorQuery(selectorList));
     SelectorQuery* rawSelectorQuery = selectorQuery.get();
     m_entries.add(selectors, selectorQuery.release());
+    m_recentlyUsed.add(selectors);
     return rawSelectorQuery;
 }
 
 void SelectorQueryCache::invalidate()
 {
     m_entries.clear();
+    m_recentlyUsed.clear();
 }
 
 }
@@ -28,7 +28,9 @@
 
 #include "CSSSelectorList.h"
 #include "NodeList.h"
+#include "SelectorCompiler.h"
 #include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
 #include <wtf/PassRefPtr.h>
 #include <wtf/Vector.h>
 #include <wtf/text/AtomicStringHash.h>
@@ -55,6 +57,10 @@ private:
         SelectorData(const CSSSelector* selector, bool isFastCheckable) : selector(selector), isFastCheckable(isFastCheckable) { }
         const CSSSelector* selector;
         bool isFastCheckable;
+#if ENABLE(CSS_SELECTOR_JIT)
+        mutable SelectorCompilationStatus compilationStatus;
+        mutable JSC::MacroAssemblerCodeRef compiledSelectorCodeRef;
+#endif
     };
 
     bool selectorMatches(const SelectorData&, Element*, const Node*) const;
@@ -64,7 +70,8 @@ private:
     template <bool firstMatchOnly> void executeFastPathForIdSelector(const Node* rootNode, const SelectorData&, const CSSSelector* idSelector, Vector<RefPtr<Node> >&) const;
     template <bool firstMatchOnly> void executeSingleTagNameSelectorData(const Node* rootNode, const SelectorData&, Vector<RefPtr<Node> >&) const;
     template <bool firstMatchOnly> void executeSingleClassNameSelectorData(const Node* rootNode, const SelectorData&, Vector<RefPtr<Node> >&) const;
-    template <bool firstMatchOnly> void executeSingleSelectorData(const Node* rootNode, const SelectorData&, Vector<RefPtr<Node> >&) const;
+    template <bool firstMatchOnly> void executeCompoundClassNameSelectorData(const Node* rootNode, const SelectorData&, Vector<RefPtr<Node> >&) const;
+    template <bool firstMatchOnly> void executeSingleSelectorData(const Node* rootNode, const Node* searchRootNode, const SelectorData&, Vector<RefPtr<Node> >&) const;
     template <bool firstMatchOnly> void executeSingleMultiSelectorData(const Node* rootNode, Vector<RefPtr<Node> >&) const;
 
     Vector<SelectorData> m_selectors;
@@ -83,14 +90,33 @@ private:
     CSSSelectorList m_selectorList;
 };
 
+// Keeps the parsed form of the most recently used selector strings, so that
+// repeated querySelector calls with the same string skip the CSS parser. Once
+// the cache is full, the least recently used entry is dropped.
 class SelectorQueryCache {
     WTF_MAKE_FAST_ALLOCATED;
 public:
+    SelectorQueryCache()
+        : m_hitCount(0)
+        , m_missCount(0)
+    {
+    }
+
     SelectorQuery* add(const AtomicString&, Document*, ExceptionCode&);
     void invalidate();
 
+    unsigned size() const { return m_entries.size(); }
+    unsigned hitCount() const { return m_hitCount; }
+    unsigned missCount() const { return m_missCount; }
+
 private:
+    static const unsigned maximumSize = 256;
+
     HashMap<AtomicString, OwnPtr<SelectorQuery> > m_entries;
+    // Least recently used first.
+    ListHashSet<AtomicString> m_recentlyUsed;
+    unsigned m_hitCount;
+    unsigned m_missCount;
 };
 
 inline bool SelectorQuery::matches(Element* element) const
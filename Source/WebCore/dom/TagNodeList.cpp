@@ -26,6 +26,7 @@
 
 #include "Element.h"
 #include "NodeRareData.h"
+#include "TreeScope.h"
 #include <wtf/Assertions.h>
 
 namespace WebCore {
@@ -55,6 +56,20 @@ bool TagNodeList::nodeMatches(Element* testNode) const
     return m_namespaceURI == starAtom || m_namespaceURI == testNode->namespaceURI();
 }
 
+static inline const Vector<Element*>* elementsWithLocalNameFromIndex(ContainerNode* root, const AtomicString& localName)
+{
+    if (localName == starAtom || !root->isInTreeScope() || root != root->treeScope()->rootNode())
+        return 0;
+    return root->treeScope()->elementsWithLocalName(localName);
+}
+
+const Vector<Element*>* TagNodeList::elementsFromIndex(ContainerNode* root) const
+{
+    if (m_namespaceURI != starAtom)
+        return 0;
+    return elementsWithLocalNameFromIndex(root, m_localName);
+}
+
 HTMLTagNodeList::HTMLTagNodeList(PassRefPtr<Node> rootNode, const AtomicString& localName)
     : TagNodeList(rootNode, HTMLTagNodeListType, starAtom, localName)
     , m_loweredLocalName(localName.lower())
@@ -66,4 +81,13 @@ bool HTMLTagNodeList::nodeMatches(Element* testNode) const
     return nodeMatchesInlined(testNode);
 }
 
+const Vector<Element*>* HTMLTagNodeList::elementsFromIndex(ContainerNode* root) const
+{
+    // HTML elements are matched against the lowered name and others against the
+    // name as given, so the index only has the answer when the two are the same.
+    if (m_localName != m_loweredLocalName)
+        return 0;
+    return elementsWithLocalNameFromIndex(root, m_localName);
+}
+
 } // namespace WebCore
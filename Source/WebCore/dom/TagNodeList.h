@@ -51,6 +51,7 @@ protected:
     TagNodeList(PassRefPtr<Node> rootNode, CollectionType, const AtomicString& namespaceURI, const AtomicString& localName);
 
     virtual bool nodeMatches(Element*) const;
+    virtual const Vector<Element*>* elementsFromIndex(ContainerNode*) const OVERRIDE;
 
     AtomicString m_namespaceURI;
     AtomicString m_localName;
@@ -70,6 +71,7 @@ private:
     HTMLTagNodeList(PassRefPtr<Node> rootNode, const AtomicString& localName);
 
     virtual bool nodeMatches(Element*) const;
+    virtual const Vector<Element*>* elementsFromIndex(ContainerNode*) const OVERRIDE;
 
     AtomicString m_loweredLocalName;
 };
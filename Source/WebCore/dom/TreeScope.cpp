@@ -46,6 +46,7 @@
 #include "Page.h"
 #include "RenderView.h"
 #include "RuntimeEnabledFeatures.h"
+#include "Settings.h"
 #include "ShadowRoot.h"
 #include "TreeScopeAdopter.h"
 #include <wtf/Vector.h>
@@ -56,7 +57,7 @@ namespace WebCore {
 
 struct SameSizeAsTreeScope {
     virtual ~SameSizeAsTreeScope();
-    void* pointers[9];
+    void* pointers[10];
     int ints[1];
 };
 
@@ -116,6 +117,7 @@ void TreeScope::destroyTreeScopeData()
     m_elementsById.clear();
     m_imageMapsByName.clear();
     m_labelsByForAttribute.clear();
+    m_elementIndex.clear();
 }
 
 void TreeScope::clearDocumentScope()
@@ -311,6 +313,38 @@ HTMLLabelElement* TreeScope::labelElementForId(const AtomicString& forAttributeV
     return toHTMLLabelElement(m_labelsByForAttribute->getElementByLabelForAttribute(forAttributeValue.impl(), this));
 }
 
+static bool elementIndexesEnabled(Document* document)
+{
+    Settings* settings = document ? document->settings() : 0;
+    return settings && settings->elementIndexesEnabled();
+}
+
+TreeScopeElementIndex* TreeScope::elementIndexIfEnabled()
+{
+    // The setting can be turned off after the index was built; stop paying for
+    // keeping it up to date then.
+    if (!elementIndexesEnabled(documentScope())) {
+        m_elementIndex.clear();
+        return 0;
+    }
+    // Populate the index on first access.
+    if (!m_elementIndex)
+        m_elementIndex = TreeScopeElementIndex::create(this);
+    return m_elementIndex.get();
+}
+
+const Vector<Element*>* TreeScope::elementsWithClassName(const AtomicString& className)
+{
+    TreeScopeElementIndex* elementIndex = elementIndexIfEnabled();
+    return elementIndex ? &elementIndex->elementsWithClassName(className.impl()) : 0;
+}
+
+const Vector<Element*>* TreeScope::elementsWithLocalName(const AtomicString& localName)
+{
+    TreeScopeElementIndex* elementIndex = elementIndexIfEnabled();
+    return elementIndex ? &elementIndex->elementsWithLocalName(localName.impl()) : 0;
+}
+
 DOMSelection* TreeScope::getSelection() const
 {
     if (!rootNode()->document()->frame())
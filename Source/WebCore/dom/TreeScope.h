@@ -28,6 +28,7 @@
 #define TreeScope_h
 
 #include "DocumentOrderedMap.h"
+#include "TreeScopeElementIndex.h"
 #include <wtf/Forward.h>
 #include <wtf/text/AtomicString.h>
 
@@ -84,6 +85,12 @@ public:
     void removeLabel(const AtomicString& forAttributeValue, HTMLLabelElement*);
     HTMLLabelElement* labelElementForId(const AtomicString& forAttributeValue);
 
+    // Returns 0 unless the elementIndexesEnabled setting is on. The lists are in document order.
+    const Vector<Element*>* elementsWithClassName(const AtomicString&);
+    const Vector<Element*>* elementsWithLocalName(const AtomicString&);
+    bool indexesAllElementsWithClassNames() const { return m_elementIndex && m_elementIndex->indexesAllElementsWithClassNames(); }
+    TreeScopeElementIndex* elementIndex() const { return m_elementIndex.get(); }
+
     DOMSelection* getSelection() const;
 
     // Find first anchor with the given name.
@@ -153,6 +160,8 @@ private:
 
     virtual void dispose() { }
 
+    TreeScopeElementIndex* elementIndexIfEnabled();
+
     int refCount() const;
 #ifndef NDEBUG
     bool deletionHasBegun();
@@ -171,6 +180,7 @@ private:
     OwnPtr<DocumentOrderedMap> m_elementsByName;
     OwnPtr<DocumentOrderedMap> m_imageMapsByName;
     OwnPtr<DocumentOrderedMap> m_labelsByForAttribute;
+    OwnPtr<TreeScopeElementIndex> m_elementIndex;
 
     OwnPtr<IdTargetObserverRegistry> m_idTargetObserverRegistry;
 
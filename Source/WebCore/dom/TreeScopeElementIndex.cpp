@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "TreeScopeElementIndex.h"
+
+#include "Element.h"
+#include "NodeTraversal.h"
+#include "SpaceSplitString.h"
+#include "TreeScope.h"
+#include <algorithm>
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+static bool isBeforeInDocumentOrder(Element* a, Element* b)
+{
+    return a->compareDocumentPosition(b) & Node::DOCUMENT_POSITION_FOLLOWING;
+}
+
+PassOwnPtr<TreeScopeElementIndex> TreeScopeElementIndex::create(const TreeScope* scope)
+{
+    OwnPtr<TreeScopeElementIndex> index = adoptPtr(new TreeScopeElementIndex);
+    Node* root = scope->rootNode();
+    // The walk is in document order, so the elements are appended without comparing positions.
+    for (Element* element = ElementTraversal::firstWithin(root); element; element = ElementTraversal::next(element, root)) {
+        append(index->m_elementsByLocalName, element->localName().impl(), element);
+        if (!element->hasClass())
+            continue;
+        if (!element->isStyledElement()) {
+            index->m_unindexedElementsWithClassNames.add(element);
+            continue;
+        }
+        const SpaceSplitString& classNames = element->classNames();
+        for (unsigned i = 0; i < classNames.size(); ++i)
+            append(index->m_elementsByClassName, classNames[i].impl(), element);
+    }
+    return index.release();
+}
+
+void TreeScopeElementIndex::ElementList::append(Element* element)
+{
+    if (!m_elements.add(element).isNewEntry)
+        return;
+    if (m_isOrdered)
+        m_orderedElements.append(element);
+}
+
+void TreeScopeElementIndex::ElementList::add(Element* element)
+{
+    if (!m_elements.add(element).isNewEntry || !m_isOrdered)
+        return;
+
+    // Elements are most often added at the end of the tree scope, for example by the parser.
+    if (m_orderedElements.isEmpty() || isBeforeInDocumentOrder(m_orderedElements.last(), element)) {
+        m_orderedElements.append(element);
+        return;
+    }
+    m_orderedElements.clear();
+    m_isOrdered = false;
+}
+
+void TreeScopeElementIndex::ElementList::remove(Element* element)
+{
+    // The element can already be out of the tree here, so it is looked up by identity
+    // rather than by position.
+    HashSet<Element*>::iterator it = m_elements.find(element);
+    if (it == m_elements.end())
+        return;
+    m_elements.remove(it);
+    if (!m_isOrdered)
+        return;
+
+    if (m_orderedElements.last() == element) {
+        m_orderedElements.removeLast();
+        return;
+    }
+    m_orderedElements.clear();
+    m_isOrdered = false;
+}
+
+const Vector<Element*>& TreeScopeElementIndex::ElementList::orderedElements() const
+{
+    if (!m_isOrdered) {
+        copyToVector(m_elements, m_orderedElements);
+        std::sort(m_orderedElements.begin(), m_orderedElements.end(), isBeforeInDocumentOrder);
+        m_isOrdered = true;
+    }
+    return m_orderedElements;
+}
+
+void TreeScopeElementIndex::append(Map& map, AtomicStringImpl* key, Element* element)
+{
+    OwnPtr<ElementList>& elements = map.add(key, nullptr).iterator->value;
+    if (!elements)
+        elements = adoptPtr(new ElementList);
+    elements->append(element);
+}
+
+void TreeScopeElementIndex::add(Map& map, AtomicStringImpl* key, Element* element)
+{
+    OwnPtr<ElementList>& elements = map.add(key, nullptr).iterator->value;
+    if (!elements)
+        elements = adoptPtr(new ElementList);
+    elements->add(element);
+}
+
+void TreeScopeElementIndex::remove(Map& map, AtomicStringImpl* key, Element* element)
+{
+    Map::iterator it = map.find(key);
+    if (it == map.end())
+        return;
+    it->value->remove(element);
+    if (it->value->isEmpty())
+        map.remove(it);
+}
+
+const Vector<Element*>& TreeScopeElementIndex::get(const Map& map, AtomicStringImpl* key)
+{
+    DEFINE_STATIC_LOCAL(Vector<Element*>, emptyList, ());
+
+    Map::const_iterator it = map.find(key);
+    if (it == map.end())
+        return emptyList;
+    ASSERT(!it->value->isEmpty());
+    return it->value->orderedElements();
+}
+
+void TreeScopeElementIndex::addElement(Element* element)
+{
+    add(m_elementsByLocalName, element->localName().impl(), element);
+}
+
+void TreeScopeElementIndex::removeElement(Element* element)
+{
+    remove(m_elementsByLocalName, element->localName().impl(), element);
+}
+
+void TreeScopeElementIndex::addClassNames(Element* element, const SpaceSplitString& classNames)
+{
+    if (!classNames.size())
+        return;
+    if (!element->isStyledElement()) {
+        m_unindexedElementsWithClassNames.add(element);
+        return;
+    }
+    for (unsigned i = 0; i < classNames.size(); ++i)
+        add(m_elementsByClassName, classNames[i].impl(), element);
+}
+
+void TreeScopeElementIndex::removeClassNames(Element* element, const SpaceSplitString& classNames)
+{
+    if (!classNames.size())
+        return;
+    if (!element->isStyledElement()) {
+        m_unindexedElementsWithClassNames.remove(element);
+        return;
+    }
+    for (unsigned i = 0; i < classNames.size(); ++i)
+        remove(m_elementsByClassName, classNames[i].impl(), element);
+}
+
+const Vector<Element*>& TreeScopeElementIndex::elementsWithClassName(AtomicStringImpl* className) const
+{
+    return get(m_elementsByClassName, className);
+}
+
+const Vector<Element*>& TreeScopeElementIndex::elementsWithLocalName(AtomicStringImpl* localName) const
+{
+    return get(m_elementsByLocalName, localName);
+}
+
+} // namespace WebCore
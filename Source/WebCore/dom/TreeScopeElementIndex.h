@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TreeScopeElementIndex_h
+#define TreeScopeElementIndex_h
+
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+#include <wtf/text/AtomicStringImpl.h>
+
+namespace WebCore {
+
+class Element;
+class SpaceSplitString;
+class TreeScope;
+
+// Maps class names and local names to the elements of a tree scope that have them,
+// so that getElementsByClassName, getElementsByTagName and the matching
+// querySelectorAll fast paths cost O(matches) instead of a walk of the whole tree.
+// A TreeScope only builds its index on first use, when the elementIndexesEnabled
+// setting is on, and then keeps it up to date as elements are inserted, removed
+// and have their class attribute changed.
+class TreeScopeElementIndex {
+    WTF_MAKE_NONCOPYABLE(TreeScopeElementIndex); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static PassOwnPtr<TreeScopeElementIndex> create(const TreeScope*);
+
+    void addElement(Element*);
+    void removeElement(Element*);
+    void addClassNames(Element*, const SpaceSplitString&);
+    void removeClassNames(Element*, const SpaceSplitString&);
+
+    // Like getElementsByClassName, only StyledElements are indexed by class name.
+    // The lists are in document order.
+    const Vector<Element*>& elementsWithClassName(AtomicStringImpl*) const;
+    const Vector<Element*>& elementsWithLocalName(AtomicStringImpl*) const;
+
+    // Whether every element with a class in the tree scope is in the index.
+    bool indexesAllElementsWithClassNames() const { return m_unindexedElementsWithClassNames.isEmpty(); }
+
+private:
+    TreeScopeElementIndex() { }
+
+    // The elements for one key. Adding and removing an element is O(1), so that
+    // removing a large subtree stays linear. The list in document order is kept
+    // as long as elements are only added after the last one and removed from the
+    // end, as the parser and most scripts do, and sorted again on the next read
+    // otherwise.
+    class ElementList {
+        WTF_MAKE_NONCOPYABLE(ElementList); WTF_MAKE_FAST_ALLOCATED;
+    public:
+        ElementList()
+            : m_isOrdered(true)
+        {
+        }
+
+        // The caller knows that the element comes after all the others.
+        void append(Element*);
+        void add(Element*);
+        void remove(Element*);
+
+        bool isEmpty() const { return m_elements.isEmpty(); }
+        const Vector<Element*>& orderedElements() const;
+
+    private:
+        HashSet<Element*> m_elements;
+        mutable Vector<Element*> m_orderedElements;
+        mutable bool m_isOrdered;
+    };
+
+    typedef HashMap<AtomicStringImpl*, OwnPtr<ElementList> > Map;
+
+    static void append(Map&, AtomicStringImpl*, Element*);
+    static void add(Map&, AtomicStringImpl*, Element*);
+    static void remove(Map&, AtomicStringImpl*, Element*);
+    static const Vector<Element*>& get(const Map&, AtomicStringImpl*);
+
+    Map m_elementsByClassName;
+    Map m_elementsByLocalName;
+    HashSet<Element*> m_unindexedElementsWithClassNames;
+};
+
+} // namespace WebCore
+
+#endif // TreeScopeElementIndex_h
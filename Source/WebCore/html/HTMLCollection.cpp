@@ -459,6 +459,16 @@ Node* LiveNodeListBase::item(unsigned offset) const
         return 0;
     }
 
+    if (isNodeList(type()) && type() != ChildNodeListType) {
+        if (const Vector<Element*>* elements = static_cast<const LiveNodeList*>(this)->elementsFromIndex(root)) {
+            setLengthCache(elements->size());
+            if (offset >= elements->size())
+                return 0;
+            setItemCache(elements->at(offset), offset, 0);
+            return elements->at(offset);
+        }
+    }
+
     if (isLengthCacheValid() && !overridesItemAfter() && isLastItemCloserThanLastOrCachedItem(offset)) {
         Node* lastItem = itemBefore(0);
         ASSERT(lastItem);
@@ -86,6 +86,7 @@
 #include "RuntimeEnabledFeatures.h"
 #include "SchemeRegistry.h"
 #include "ScrollingCoordinator.h"
+#include "SelectorQuery.h"
 #include "SerializedScriptValue.h"
 #include "Settings.h"
 #include "ShadowRoot.h"
@@ -1612,6 +1613,36 @@ unsigned Internals::numberOfScrollableAreas(Document* document, ExceptionCode&)
 
     return count;
 }
+
+unsigned Internals::selectorQueryCacheSize(Document* document, ExceptionCode& ec)
+{
+    if (!document) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    return document->selectorQueryCache()->size();
+}
+
+unsigned Internals::selectorQueryCacheHitCount(Document* document, ExceptionCode& ec)
+{
+    if (!document) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    return document->selectorQueryCache()->hitCount();
+}
+
+unsigned Internals::selectorQueryCacheMissCount(Document* document, ExceptionCode& ec)
+{
+    if (!document) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    return document->selectorQueryCache()->missCount();
+}
     
 bool Internals::isPageBoxVisible(Document* document, int pageNumber, ExceptionCode& ec)
 {
@@ -204,6 +204,10 @@ public:
 
     unsigned numberOfScrollableAreas(Document*, ExceptionCode&);
 
+    unsigned selectorQueryCacheSize(Document*, ExceptionCode&);
+    unsigned selectorQueryCacheHitCount(Document*, ExceptionCode&);
+    unsigned selectorQueryCacheMissCount(Document*, ExceptionCode&);
+
     bool isPageBoxVisible(Document*, int pageNumber, ExceptionCode&);
 
     static const char* internalsId;
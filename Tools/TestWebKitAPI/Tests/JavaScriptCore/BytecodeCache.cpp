@@ -0,0 +1,297 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include "WTFStringUtilities.h"
+#include <dirent.h>
+#include <parser/SourceCode.h>
+#include <runtime/Completion.h>
+#include <runtime/InitializeThreading.h>
+#include <runtime/JSGlobalObject.h>
+#include <runtime/JSLock.h>
+#include <runtime/Options.h>
+#include <runtime/VM.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/StringBuilder.h>
+
+using namespace JSC;
+
+namespace TestWebKitAPI {
+
+#if OS(UNIX)
+
+// Only called if the program was told to, so that we can tell whether its body
+// is decoded before it is needed.
+static const char lazyFunctionMarker[] = "returned by a lazily decoded body";
+
+static String programSource()
+{
+    StringBuilder builder;
+    builder.appendLiteral("function lazyFunction() { return \"");
+    builder.append(lazyFunctionMarker);
+    builder.appendLiteral("\"; }\n"
+        "function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }\n"
+        "function makeItem(i) { return { index: i, name: \"item\" + i }; }\n"
+        "var results = [];\n"
+        "for (var i = 0; i < 10; ++i)\n"
+        "    results.push(makeItem(i).name);\n"
+        "results.push(fib(15));\n"
+        "if (callLazyFunction)\n"
+        "    results.push(lazyFunction());\n"
+        "results.join(\",\");\n");
+    // Programs shorter than Options::minimumBytecodeCacheSourceLength() are not cached.
+    while (builder.length() < 2 * Options::minimumBytecodeCacheSourceLength())
+        builder.appendLiteral("// Padding that makes the program long enough to be cached.\n");
+    return builder.toString();
+}
+
+static String expectedResult(bool callLazyFunction)
+{
+    String result = "item0,item1,item2,item3,item4,item5,item6,item7,item8,item9,610";
+    if (callLazyFunction)
+        result = result + "," + lazyFunctionMarker;
+    return result;
+}
+
+// Runs the program in a new VM, which reads the cache when it evaluates the program
+// and writes it when it is destroyed.
+static String runProgram(bool callLazyFunction)
+{
+    RefPtr<VM> vm = VM::create(LargeHeap);
+    JSLockHolder locker(vm.get());
+    JSGlobalObject* globalObject = JSGlobalObject::create(*vm, JSGlobalObject::createStructure(*vm, jsNull()));
+    ExecState* exec = globalObject->globalExec();
+    evaluate(exec, makeSource(callLazyFunction ? "var callLazyFunction = true;" : "var callLazyFunction = false;"));
+    JSValue exception;
+    JSValue result = evaluate(exec, makeSource(programSource()), JSValue(), &exception);
+    if (exception)
+        return "exception";
+    String resultString = result.toString(exec)->value(exec);
+    vm.clear();
+    return resultString;
+}
+
+class BytecodeCacheTest : public testing::Test {
+public:
+    virtual void SetUp()
+    {
+        initializeThreading();
+
+        char directoryTemplate[] = "/tmp/BytecodeCacheTestXXXXXX";
+        ASSERT_TRUE(mkdtemp(directoryTemplate));
+        m_directory = directoryTemplate;
+        setenv("JSC_BYTECODE_CACHE_PATH", m_directory.data(), 1);
+
+        m_savedEnableBytecodeCache = Options::enableBytecodeCache();
+        Options::enableBytecodeCache() = true;
+    }
+
+    virtual void TearDown()
+    {
+        Options::enableBytecodeCache() = m_savedEnableBytecodeCache;
+        unsetenv("JSC_BYTECODE_CACHE_PATH");
+
+        if (DIR* directory = opendir(m_directory.data())) {
+            while (struct dirent* entry = readdir(directory)) {
+                if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, ".."))
+                    continue;
+                unlink(String(String::fromUTF8(m_directory.data()) + "/" + entry->d_name).utf8().data());
+            }
+            closedir(directory);
+        }
+        rmdir(m_directory.data());
+    }
+
+    // The program is the only script long enough to be cached.
+    CString cacheFilePath()
+    {
+        CString result;
+        if (DIR* directory = opendir(m_directory.data())) {
+            while (struct dirent* entry = readdir(directory)) {
+                String name = String::fromUTF8(entry->d_name);
+                if (name.endsWith(".jsbc")) {
+                    EXPECT_TRUE(result.isNull());
+                    result = String(String::fromUTF8(m_directory.data()) + "/" + name).utf8();
+                }
+            }
+            closedir(directory);
+        }
+        return result;
+    }
+
+    // The cache replaces a file by renaming a new one over it, so a file that keeps
+    // its inode was only read.
+    ino_t cacheFileInode()
+    {
+        struct stat status;
+        if (stat(cacheFilePath().data(), &status))
+            return 0;
+        return status.st_ino;
+    }
+
+    Vector<uint8_t> readCacheFile()
+    {
+        Vector<uint8_t> result;
+        if (FILE* file = fopen(cacheFilePath().data(), "rb")) {
+            uint8_t buffer[4096];
+            while (size_t size = fread(buffer, 1, sizeof(buffer), file))
+                result.append(buffer, size);
+            fclose(file);
+        }
+        return result;
+    }
+
+    // Writes in place, so the file keeps its inode.
+    void writeCacheFile(const Vector<uint8_t>& data)
+    {
+        FILE* file = fopen(cacheFilePath().data(), "r+b");
+        ASSERT_TRUE(file);
+        EXPECT_EQ(data.size(), fwrite(data.data(), 1, data.size(), file));
+        fclose(file);
+        EXPECT_EQ(0, truncate(cacheFilePath().data(), data.size()));
+    }
+
+    uint32_t headerWord(const Vector<uint8_t>& data, size_t index)
+    {
+        uint32_t result;
+        memcpy(&result, data.data() + index * sizeof(result), sizeof(result));
+        return result;
+    }
+
+    void setHeaderWord(Vector<uint8_t>& data, size_t index, uint32_t value)
+    {
+        memcpy(data.data() + index * sizeof(value), &value, sizeof(value));
+    }
+
+    // Fills the cache, corrupts the file, and checks that the next run parses the
+    // program again and replaces the file with a good one.
+    void expectMissAfterCorrupting(void (*corrupt)(Vector<uint8_t>&))
+    {
+        EXPECT_EQ(expectedResult(true), runProgram(true));
+        Vector<uint8_t> original = readCacheFile();
+        ASSERT_LT(5 * sizeof(uint32_t), original.size());
+
+        Vector<uint8_t> corrupted = original;
+        corrupt(corrupted);
+        writeCacheFile(corrupted);
+        ino_t corruptedInode = cacheFileInode();
+
+        EXPECT_EQ(expectedResult(true), runProgram(true));
+        EXPECT_NE(corruptedInode, cacheFileInode());
+        Vector<uint8_t> rewritten = readCacheFile();
+        ASSERT_LT(5 * sizeof(uint32_t), rewritten.size());
+        for (size_t i = 0; i < 5; ++i)
+            EXPECT_EQ(headerWord(original, i), headerWord(rewritten, i));
+    }
+
+    CString m_directory;
+    bool m_savedEnableBytecodeCache;
+};
+
+TEST_F(BytecodeCacheTest, SecondRunReadsTheCache)
+{
+    String firstResult = runProgram(true);
+    EXPECT_EQ(expectedResult(true), firstResult);
+    ino_t inode = cacheFileInode();
+    ASSERT_TRUE(inode);
+
+    // The second run compiles nothing new, so it has no reason to write the file.
+    EXPECT_EQ(firstResult, runProgram(true));
+    EXPECT_EQ(inode, cacheFileInode());
+}
+
+TEST_F(BytecodeCacheTest, FunctionBodiesAreDecodedWhenFirstCalled)
+{
+    EXPECT_EQ(expectedResult(true), runProgram(true));
+
+    // Make lazyFunction's body undecodable by giving its string constant, which is
+    // a 32-bit length followed by an 8-bit flag and the characters, a length that
+    // runs past the end of the file.
+    Vector<uint8_t> data = readCacheFile();
+    size_t markerLength = strlen(lazyFunctionMarker);
+    size_t markerOffset = notFound;
+    for (size_t i = 5; i + markerLength <= data.size(); ++i) {
+        if (!memcmp(data.data() + i, lazyFunctionMarker, markerLength)) {
+            EXPECT_EQ(notFound, markerOffset);
+            markerOffset = i;
+        }
+    }
+    ASSERT_NE(notFound, markerOffset);
+    uint32_t hugeLength = 0xfffffff0;
+    memcpy(data.data() + markerOffset - 5, &hugeLength, sizeof(hugeLength));
+    writeCacheFile(data);
+    ino_t inode = cacheFileInode();
+
+    // A run that never calls lazyFunction does not notice. Had the body been
+    // decoded along with the program, the file would have been a miss and
+    // been replaced.
+    EXPECT_EQ(expectedResult(false), runProgram(false));
+    EXPECT_EQ(inode, cacheFileInode());
+
+    // Calling it decodes the body, which fails, so it is compiled from source.
+    EXPECT_EQ(expectedResult(true), runProgram(true));
+}
+
+static void truncateToHalf(Vector<uint8_t>& data)
+{
+    data.shrink(data.size() / 2);
+}
+
+TEST_F(BytecodeCacheTest, TruncatedFileIsAMiss)
+{
+    expectMissAfterCorrupting(truncateToHalf);
+}
+
+// The header is the magic number, the format version, the opcode fingerprint,
+// the source length and the strictness, followed by the source digest.
+static void changeFormatVersion(Vector<uint8_t>& data)
+{
+    data[sizeof(uint32_t)] ^= 0x80;
+}
+
+TEST_F(BytecodeCacheTest, VersionMismatchIsAMiss)
+{
+    expectMissAfterCorrupting(changeFormatVersion);
+}
+
+static void changeOpcodeFingerprint(Vector<uint8_t>& data)
+{
+    data[2 * sizeof(uint32_t)] ^= 0x80;
+}
+
+TEST_F(BytecodeCacheTest, OpcodeFingerprintMismatchIsAMiss)
+{
+    expectMissAfterCorrupting(changeOpcodeFingerprint);
+}
+
+#endif // OS(UNIX)
+
+} // namespace TestWebKitAPI
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <runtime/LocalTimeOffsetTable.h>
+#include <stdlib.h>
+#include <time.h>
+#include <wtf/DateMath.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/WTFString.h>
+
+using namespace JSC;
+
+namespace TestWebKitAPI {
+
+// A fixed seed keeps failures reproducible.
+static unsigned randomState = 20131017;
+
+static double randomFraction()
+{
+    randomState = randomState * 1103515245 + 12345;
+    return (randomState >> 8) / static_cast<double>(1 << 24);
+}
+
+static void expectSameOffset(LocalTimeOffsetTable& table, double ms, const char* timeZone)
+{
+    LocalTimeOffset expected = calculateLocalTimeOffset(ms);
+    LocalTimeOffset actual = table.offsetFor(ms);
+    EXPECT_EQ(expected.offset, actual.offset) << timeZone << " at " << ms;
+    EXPECT_EQ(expected.isDST, actual.isDST) << timeZone << " at " << ms;
+}
+
+static void compareWithCalculateLocalTimeOffset(const char* timeZone)
+{
+    setenv("TZ", timeZone, 1);
+    tzset();
+
+    LocalTimeOffsetTable table;
+    double first = dateToDaysFrom1970(1900, 0, 1) * msPerDay;
+    double last = dateToDaysFrom1970(2100, 0, 1) * msPerDay;
+    for (unsigned i = 0; i < 20000; ++i)
+        expectSameOffset(table, floor(first + randomFraction() * (last - first)), timeZone);
+
+    // Walk a few years every few minutes, so that every transition is crossed
+    // both between and within the spans the table caches.
+    double start = dateToDaysFrom1970(2011, 0, 1) * msPerDay;
+    double end = dateToDaysFrom1970(2014, 0, 1) * msPerDay;
+    for (double ms = start; ms < end; ms += msPerSecond + floor(randomFraction() * 10 * msPerMinute))
+        expectSameOffset(table, ms, timeZone);
+
+    table.reset();
+    for (unsigned i = 0; i < 1000; ++i)
+        expectSameOffset(table, floor(first + randomFraction() * (last - first)), timeZone);
+}
+
+TEST(JSC, LocalTimeOffsetTable)
+{
+    const char* savedTimeZone = getenv("TZ");
+    CString savedTimeZoneCopy = savedTimeZone ? CString(savedTimeZone) : CString();
+
+    const char* timeZones[] = {
+        "UTC",
+        "America/Los_Angeles",
+        "America/Sao_Paulo",
+        "Europe/London",
+        "Europe/Moscow",
+        "Asia/Tehran",
+        "Australia/Lord_Howe",
+        "Pacific/Chatham",
+    };
+    for (size_t i = 0; i < WTF_ARRAY_LENGTH(timeZones); ++i)
+        compareWithCalculateLocalTimeOffset(timeZones[i]);
+
+    if (savedTimeZone)
+        setenv("TZ", savedTimeZoneCopy.data(), 1);
+    else
+        unsetenv("TZ");
+    tzset();
+}
+
+} // namespace TestWebKitAPI
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <parser/SourceCode.h>
+#include <profiler/SamplingProfiler.h>
+#include <runtime/Completion.h>
+#include <runtime/InitializeThreading.h>
+#include <runtime/JSGlobalObject.h>
+#include <runtime/JSLock.h>
+#include <runtime/Options.h>
+#include <runtime/VM.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/StringPrintStream.h>
+
+using namespace JSC;
+
+namespace TestWebKitAPI {
+
+#if ENABLE(SAMPLING_PROFILER)
+
+static VM& sharedVM()
+{
+    static VM* vm;
+    if (!vm) {
+        initializeThreading();
+        vm = VM::createLeaked(LargeHeap).leakRef();
+    }
+    return *vm;
+}
+
+static PassOwnPtr<SamplingProfiler> createProfiler(unsigned intervalInMicroseconds)
+{
+    unsigned savedInterval = Options::samplingProfilerIntervalInMicroseconds();
+    Options::samplingProfilerIntervalInMicroseconds() = intervalInMicroseconds;
+    OwnPtr<SamplingProfiler> profiler = SamplingProfiler::create(sharedVM());
+    Options::samplingProfilerIntervalInMicroseconds() = savedInterval;
+    return profiler.release();
+}
+
+// Long enough that the profiler never samples while a test is looking.
+static const unsigned neverInMicroseconds = 100 * 1000 * 1000;
+
+static volatile sig_atomic_t numberOfSignalsHandled;
+
+static void countSignal(int)
+{
+    numberOfSignalsHandled++;
+}
+
+static void installCountingHandler(struct sigaction& savedAction)
+{
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = countSignal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, &savedAction);
+}
+
+static bool isCountingHandlerInstalled()
+{
+    struct sigaction action;
+    sigaction(SIGPROF, 0, &action);
+    return !(action.sa_flags & SA_SIGINFO) && action.sa_handler == countSignal;
+}
+
+TEST(JSC, SamplingProfilerRestoresPreviousSignalHandler)
+{
+    struct sigaction savedAction;
+    installCountingHandler(savedAction);
+
+    OwnPtr<SamplingProfiler> profiler = createProfiler(neverInMicroseconds);
+    EXPECT_FALSE(isCountingHandlerInstalled());
+    OwnPtr<SamplingProfiler> secondProfiler = createProfiler(neverInMicroseconds);
+    profiler.clear();
+    EXPECT_FALSE(isCountingHandlerInstalled());
+    secondProfiler.clear();
+    EXPECT_TRUE(isCountingHandlerInstalled());
+
+    sigaction(SIGPROF, &savedAction, 0);
+}
+
+TEST(JSC, SamplingProfilerChainsToPreviousSignalHandler)
+{
+    struct sigaction savedAction;
+    installCountingHandler(savedAction);
+
+    OwnPtr<SamplingProfiler> profiler = createProfiler(neverInMicroseconds);
+    numberOfSignalsHandled = 0;
+    raise(SIGPROF);
+    kill(getpid(), SIGPROF);
+    // The process-directed signal may be delivered to another thread.
+    for (unsigned i = 0; i < 1000 && numberOfSignalsHandled < 2; ++i)
+        usleep(1000);
+    EXPECT_EQ(2, numberOfSignalsHandled);
+    profiler.clear();
+
+    sigaction(SIGPROF, &savedAction, 0);
+}
+
+TEST(JSC, SamplingProfilerRecordsStackTraces)
+{
+    VM& vm = sharedVM();
+    if (!vm.canUseJIT())
+        return;
+
+    JSLockHolder locker(vm);
+    JSGlobalObject* globalObject = JSGlobalObject::create(vm, JSGlobalObject::createStructure(vm, jsNull()));
+    OwnPtr<SamplingProfiler> profiler = createProfiler(100);
+    evaluate(globalObject->globalExec(), makeSource("function spinForAWhile() { var end = Date.now() + 200; while (Date.now() < end) { } } spinForAWhile();"));
+
+    StringPrintStream out;
+    profiler->writeStackTraces(out);
+    EXPECT_NE(notFound, out.toString().find("spinForAWhile"));
+}
+
+// This test leaves the profiler's signal handler installed, so it comes last.
+TEST(JSC, SamplingProfilerGivesUpOnBlockedThread)
+{
+    struct sigaction savedAction;
+    installCountingHandler(savedAction);
+
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGPROF);
+    sigset_t savedSignals;
+    pthread_sigmask(SIG_BLOCK, &signals, &savedSignals);
+
+    // The profiler's thread must stop waiting for a sample that cannot be taken,
+    // or destroying the profiler would never return.
+    OwnPtr<SamplingProfiler> profiler = createProfiler(1000);
+    usleep(50 * 1000);
+    profiler.clear();
+
+    // The request is still pending, and must not reach the previous handler.
+    numberOfSignalsHandled = 0;
+    pthread_sigmask(SIG_SETMASK, &savedSignals, 0);
+    EXPECT_EQ(0, numberOfSignalsHandled);
+}
+
+#endif // ENABLE(SAMPLING_PROFILER)
+
+} // namespace TestWebKitAPI
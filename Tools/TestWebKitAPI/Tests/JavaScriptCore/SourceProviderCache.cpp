@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <heap/Heap.h>
+#include <parser/SourceCode.h>
+#include <parser/SourceProvider.h>
+#include <parser/SourceProviderCache.h>
+#include <parser/SourceProviderCacheItem.h>
+#include <runtime/Completion.h>
+#include <runtime/InitializeThreading.h>
+#include <runtime/JSGlobalObject.h>
+#include <runtime/JSLock.h>
+#include <runtime/Options.h>
+#include <runtime/VM.h>
+
+using namespace JSC;
+
+namespace TestWebKitAPI {
+
+static const char source[] =
+    "function first(a) { var x = a; return x + y; }\n"
+    "function second() { return eval('1'); }\n";
+
+static void addItem(VM& vm, SourceProviderCache& cache, const String& sourceString, const char* functionName, bool usesEval, const char* usedVariable, const char* writtenVariable)
+{
+    SourceProviderCacheItemCreationParameters parameters;
+    unsigned functionStart = sourceString.find(functionName);
+    unsigned openBraceOffset = sourceString.find('{', functionStart);
+    parameters.functionStart = functionStart;
+    parameters.closeBraceOffset = sourceString.find('}', openBraceOffset);
+    parameters.closeBraceLine = sourceString.left(openBraceOffset).contains('\n') ? 2 : 1;
+    parameters.closeBraceLineStartOffset = parameters.closeBraceLine == 1 ? 0 : sourceString.find('\n') + 1;
+    parameters.needsFullActivation = usesEval;
+    parameters.usesEval = usesEval;
+    parameters.strictMode = false;
+    if (usedVariable)
+        parameters.usedVariables.append(Identifier(&vm, usedVariable).impl());
+    if (writtenVariable)
+        parameters.writtenVariables.append(Identifier(&vm, writtenVariable).impl());
+    cache.add(openBraceOffset, SourceProviderCacheItem::create(parameters));
+}
+
+static const SourceProviderCacheItem* itemFor(const SourceProviderCache& cache, const String& sourceString, const char* functionName)
+{
+    return cache.get(sourceString.find('{', sourceString.find(functionName)));
+}
+
+TEST(JSC, SourceProviderCacheRoundTrip)
+{
+    initializeThreading();
+    RefPtr<VM> vm = VM::create(LargeHeap);
+    JSLockHolder locker(vm.get());
+
+    SourceCode sourceCode = makeSource(source);
+    String sourceString = sourceCode.provider()->source();
+
+    RefPtr<SourceProviderCache> cache = adoptRef(new SourceProviderCache);
+    addItem(*vm, *cache, sourceString, "first", false, "y", "x");
+    addItem(*vm, *cache, sourceString, "second", true, 0, 0);
+    EXPECT_TRUE(cache->hasUnserializedItems());
+
+    Vector<uint8_t> serialized;
+    cache->serialize(sourceCode.provider(), serialized);
+    EXPECT_FALSE(cache->hasUnserializedItems());
+
+    RefPtr<SourceProviderCache> reloaded = adoptRef(new SourceProviderCache);
+    ASSERT_TRUE(reloaded->deserialize(*vm, sourceCode.provider(), serialized));
+    EXPECT_FALSE(reloaded->hasUnserializedItems());
+
+    const char* functionNames[] = { "first", "second" };
+    for (size_t i = 0; i < WTF_ARRAY_LENGTH(functionNames); ++i) {
+        const SourceProviderCacheItem* original = itemFor(*cache, sourceString, functionNames[i]);
+        const SourceProviderCacheItem* item = itemFor(*reloaded, sourceString, functionNames[i]);
+        ASSERT_TRUE(original);
+        ASSERT_TRUE(item);
+        EXPECT_EQ(original->functionStart, item->functionStart);
+        EXPECT_EQ(original->closeBraceLine, item->closeBraceLine);
+        EXPECT_EQ(original->closeBraceOffset, item->closeBraceOffset);
+        EXPECT_EQ(original->closeBraceLineStartOffset, item->closeBraceLineStartOffset);
+        EXPECT_EQ(original->needsFullActivation, item->needsFullActivation);
+        EXPECT_EQ(original->usesEval, item->usesEval);
+        EXPECT_EQ(original->strictMode, item->strictMode);
+        ASSERT_EQ(original->usedVariablesCount, item->usedVariablesCount);
+        ASSERT_EQ(original->writtenVariablesCount, item->writtenVariablesCount);
+        // Identifiers are atomic, so equal names are the same string.
+        for (unsigned j = 0; j < item->usedVariablesCount; ++j)
+            EXPECT_EQ(original->usedVariables()[j], item->usedVariables()[j]);
+        for (unsigned j = 0; j < item->writtenVariablesCount; ++j)
+            EXPECT_EQ(original->writtenVariables()[j], item->writtenVariables()[j]);
+    }
+}
+
+TEST(JSC, SourceProviderCacheRejectsMismatchedTables)
+{
+    initializeThreading();
+    RefPtr<VM> vm = VM::create(LargeHeap);
+    JSLockHolder locker(vm.get());
+
+    SourceCode sourceCode = makeSource(source);
+    String sourceString = sourceCode.provider()->source();
+    RefPtr<SourceProviderCache> cache = adoptRef(new SourceProviderCache);
+    addItem(*vm, *cache, sourceString, "first", false, "y", "x");
+    addItem(*vm, *cache, sourceString, "second", true, 0, 0);
+    Vector<uint8_t> serialized;
+    cache->serialize(sourceCode.provider(), serialized);
+
+    // Same length, different text: the digest no longer matches.
+    String otherSourceString = sourceString;
+    otherSourceString.replace("first", "third");
+    SourceCode otherSourceCode = makeSource(otherSourceString);
+    RefPtr<SourceProviderCache> mismatched = adoptRef(new SourceProviderCache);
+    EXPECT_FALSE(mismatched->deserialize(*vm, otherSourceCode.provider(), serialized));
+    EXPECT_FALSE(itemFor(*mismatched, otherSourceString, "third"));
+    EXPECT_FALSE(itemFor(*mismatched, otherSourceString, "second"));
+
+    // A table cut short is rejected as a whole, rather than leaving the items
+    // that were read before the end.
+    Vector<uint8_t> truncated = serialized;
+    truncated.shrink(truncated.size() - 1);
+    RefPtr<SourceProviderCache> partial = adoptRef(new SourceProviderCache);
+    EXPECT_FALSE(partial->deserialize(*vm, sourceCode.provider(), truncated));
+    EXPECT_FALSE(itemFor(*partial, sourceString, "first"));
+    EXPECT_FALSE(itemFor(*partial, sourceString, "second"));
+
+    // The header starts with a magic number and a format version.
+    Vector<uint8_t> otherVersion = serialized;
+    otherVersion[sizeof(uint32_t)] ^= 0x80;
+    RefPtr<SourceProviderCache> versioned = adoptRef(new SourceProviderCache);
+    EXPECT_FALSE(versioned->deserialize(*vm, sourceCode.provider(), otherVersion));
+    EXPECT_FALSE(itemFor(*versioned, sourceString, "first"));
+}
+
+TEST(JSC, SourceProviderCachesAreSerializedOnRequest)
+{
+    initializeThreading();
+    bool savedSerializeOnGC = Options::serializeSourceProviderCachesOnGC();
+    Options::serializeSourceProviderCachesOnGC() = false;
+    {
+        RefPtr<VM> vm = VM::create(LargeHeap);
+        JSLockHolder locker(vm.get());
+        JSGlobalObject* globalObject = JSGlobalObject::create(*vm, JSGlobalObject::createStructure(*vm, jsNull()));
+
+        // Parsing the program caches the bodies of the functions it declares.
+        SourceCode collected = makeSource(source);
+        evaluate(globalObject->globalExec(), collected);
+        vm->heap.collectAllGarbage();
+        EXPECT_TRUE(collected.provider()->serializedFunctionCache().isEmpty());
+
+        SourceCode requested = makeSource(String(source) + "first(1);\n");
+        evaluate(globalObject->globalExec(), requested);
+        vm->serializeSourceProviderCaches();
+        const Vector<uint8_t>& serialized = requested.provider()->serializedFunctionCache();
+        EXPECT_FALSE(serialized.isEmpty());
+        RefPtr<SourceProviderCache> reloaded = adoptRef(new SourceProviderCache);
+        EXPECT_TRUE(reloaded->deserialize(*vm, requested.provider(), serialized));
+        EXPECT_TRUE(itemFor(*reloaded, requested.provider()->source(), "first"));
+
+        vm.clear();
+    }
+
+    Options::serializeSourceProviderCachesOnGC() = true;
+    {
+        RefPtr<VM> vm = VM::create(LargeHeap);
+        JSLockHolder locker(vm.get());
+        JSGlobalObject* globalObject = JSGlobalObject::create(*vm, JSGlobalObject::createStructure(*vm, jsNull()));
+
+        SourceCode collected = makeSource(source);
+        evaluate(globalObject->globalExec(), collected);
+        vm->heap.collectAllGarbage();
+        EXPECT_FALSE(collected.provider()->serializedFunctionCache().isEmpty());
+
+        vm.clear();
+    }
+    Options::serializeSourceProviderCachesOnGC() = savedSerializeOnGC;
+}
+
+} // namespace TestWebKitAPI
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <limits>
+#include <string.h>
+#include <wtf/MathExtras.h>
+#include <wtf/TypedArrayConversion.h>
+#include <wtf/Vector.h>
+
+namespace TestWebKitAPI {
+
+// The vector loops convert 8 or 16 elements at a time, so every length up to a
+// few vectors long is tried, starting both at an aligned address and just past one.
+static const unsigned maximumLength = 3 * 16 + 1;
+
+static uint8_t expectedClamped(double value)
+{
+    // Round half to even, after clamping; NaN becomes zero.
+    if (!(value > 0))
+        return 0;
+    if (value >= 255)
+        return 255;
+    double result = floor(value);
+    double fraction = value - result;
+    if (fraction > 0.5 || (fraction == 0.5 && fmod(result, 2)))
+        result += 1;
+    return static_cast<uint8_t>(result);
+}
+
+static uint8_t expectedClampedFromFloat(float value) { return expectedClamped(value); }
+static uint8_t expectedClampedFromInt16(int16_t value) { return expectedClamped(value); }
+static uint8_t expectedClampedFromDouble(double value) { return expectedClamped(value); }
+static float expectedFloatFromInt16(int16_t value) { return value; }
+static float expectedFloatFromUint8(uint8_t value) { return value; }
+
+static int8_t expectedInt8FromDouble(double value)
+{
+    // Truncate, then wrap modulo 2^8; NaN becomes zero.
+    if (std::isnan(value))
+        return 0;
+    return static_cast<int8_t>(static_cast<uint8_t>(static_cast<int64_t>(value)));
+}
+
+template<typename Destination, typename Source>
+static void expectConversion(ArrayBufferView::ViewType destinationType, ArrayBufferView::ViewType sourceType, const Source* values, size_t valueCount, Destination (*expected)(Source))
+{
+    for (unsigned offset = 0; offset < 2; ++offset) {
+        for (unsigned length = 0; length <= maximumLength; ++length) {
+            // Move the interesting values around so that each of them lands in every
+            // lane of the vector loops, and in their scalar tails.
+            Vector<Source> source(offset + length);
+            for (unsigned i = 0; i < length; ++i)
+                source[offset + i] = values[(i + length) % valueCount];
+
+            Vector<Destination> destination(offset + length + 1);
+            memset(destination.data(), 0xAA, destination.size() * sizeof(Destination));
+            Vector<Destination> untouched = destination;
+
+            convertTypedArrayElements(destinationType, destination.data() + offset, sourceType, source.data() + offset, length);
+
+            for (unsigned i = 0; i < length; ++i)
+                EXPECT_EQ(expected(source[offset + i]), destination[offset + i]) << "offset " << offset << ", length " << length << ", index " << i;
+            EXPECT_EQ(0, memcmp(destination.data(), untouched.data(), offset * sizeof(Destination)));
+            EXPECT_EQ(0, memcmp(destination.data() + offset + length, untouched.data() + offset + length, sizeof(Destination)));
+        }
+    }
+}
+
+TEST(WTF_TypedArrayConversion, Uint8ClampedFromFloat32)
+{
+    const float values[] = {
+        0, 1, 2.5f, 0.5f, 1.5f, 3.5f, 254.5f, 255.5f, 253.49f, 127.51f,
+        -0.5f, -1, -1000, 255, 256, 300.75f, 1e10f, -1e10f,
+        std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        -0.0f, 0.49999997f, 42.25f
+    };
+    expectConversion<uint8_t, float>(ArrayBufferView::TypeUint8Clamped, ArrayBufferView::TypeFloat32, values, WTF_ARRAY_LENGTH(values), expectedClampedFromFloat);
+}
+
+TEST(WTF_TypedArrayConversion, Uint8ClampedFromInt16)
+{
+    const int16_t values[] = { 0, 1, 127, 128, 254, 255, 256, 1000, std::numeric_limits<int16_t>::max(), -1, -255, -256, std::numeric_limits<int16_t>::min(), 77 };
+    expectConversion<uint8_t, int16_t>(ArrayBufferView::TypeUint8Clamped, ArrayBufferView::TypeInt16, values, WTF_ARRAY_LENGTH(values), expectedClampedFromInt16);
+}
+
+TEST(WTF_TypedArrayConversion, Uint8ClampedFromFloat64)
+{
+    const double values[] = {
+        0, 0.5, 1.5, 2.5, 253.5, 254.5, 255.5, 254.50000000000003, 0.49999999999999994,
+        -0.5, -1, 256, 1e300, -1e300,
+        std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()
+    };
+    expectConversion<uint8_t, double>(ArrayBufferView::TypeUint8Clamped, ArrayBufferView::TypeFloat64, values, WTF_ARRAY_LENGTH(values), expectedClampedFromDouble);
+}
+
+TEST(WTF_TypedArrayConversion, Float32FromInt16)
+{
+    const int16_t values[] = { 0, 1, -1, 255, -256, 12345, -12345, std::numeric_limits<int16_t>::max(), std::numeric_limits<int16_t>::min(), 2 };
+    expectConversion<float, int16_t>(ArrayBufferView::TypeFloat32, ArrayBufferView::TypeInt16, values, WTF_ARRAY_LENGTH(values), expectedFloatFromInt16);
+}
+
+TEST(WTF_TypedArrayConversion, Float32FromUint8)
+{
+    const uint8_t values[] = { 0, 1, 127, 128, 200, 254, 255, 3 };
+    expectConversion<float, uint8_t>(ArrayBufferView::TypeFloat32, ArrayBufferView::TypeUint8, values, WTF_ARRAY_LENGTH(values), expectedFloatFromUint8);
+}
+
+TEST(WTF_TypedArrayConversion, Int8FromFloat64)
+{
+    const double values[] = { 0, 1.9, -1.9, 127, 128, -128, -129, 255.5, 256, 300.75, -300.75, 1e15, -1e15, std::numeric_limits<double>::quiet_NaN(), -0.0 };
+    expectConversion<int8_t, double>(ArrayBufferView::TypeInt8, ArrayBufferView::TypeFloat64, values, WTF_ARRAY_LENGTH(values), expectedInt8FromDouble);
+}
+
+// Converts between two views of the same buffer, and checks that the result is
+// what converting from a separate copy of the source would have given.
+static void expectOverlappingConversion(ArrayBufferView::ViewType destinationType, unsigned destinationByteOffset, ArrayBufferView::ViewType sourceType, size_t sourceElementSize, unsigned sourceByteOffset, unsigned length)
+{
+    Vector<char> buffer(512);
+    // Fill the buffer with valid values of the source type, lined up with the source.
+    unsigned firstElementOffset = sourceByteOffset % sourceElementSize;
+    for (unsigned i = 0; firstElementOffset + (i + 1) * sourceElementSize <= buffer.size(); ++i) {
+        char* element = buffer.data() + firstElementOffset + i * sourceElementSize;
+        switch (sourceType) {
+        case ArrayBufferView::TypeInt16: {
+            int16_t value = static_cast<int16_t>(i * 997 - 20000);
+            memcpy(element, &value, sizeof(value));
+            break;
+        }
+        case ArrayBufferView::TypeFloat32: {
+            float value = i * 13.5f - 100;
+            memcpy(element, &value, sizeof(value));
+            break;
+        }
+        case ArrayBufferView::TypeFloat64: {
+            double value = i * 37.25 - 500;
+            memcpy(element, &value, sizeof(value));
+            break;
+        }
+        default:
+            for (unsigned j = 0; j < sourceElementSize; ++j)
+                element[j] = static_cast<char>(i * 31 + j);
+            break;
+        }
+    }
+
+    Vector<char> sourceCopy(length * sourceElementSize);
+    memcpy(sourceCopy.data(), buffer.data() + sourceByteOffset, sourceCopy.size());
+    Vector<char> expected = buffer;
+    convertTypedArrayElements(destinationType, expected.data() + destinationByteOffset, sourceType, sourceCopy.data(), length);
+
+    convertTypedArrayElements(destinationType, buffer.data() + destinationByteOffset, sourceType, buffer.data() + sourceByteOffset, length);
+    EXPECT_EQ(0, memcmp(expected.data(), buffer.data(), buffer.size())) << "destination offset " << destinationByteOffset << ", source offset " << sourceByteOffset << ", length " << length;
+}
+
+TEST(WTF_TypedArrayConversion, OverlappingViews)
+{
+    const unsigned offsets[][2] = { { 0, 0 }, { 0, 8 }, { 8, 0 }, { 0, 40 }, { 40, 0 }, { 4, 12 }, { 12, 4 } };
+    const unsigned lengths[] = { 1, 7, 20, 33 };
+    for (unsigned i = 0; i < WTF_ARRAY_LENGTH(offsets); ++i) {
+        unsigned destinationOffset = offsets[i][0];
+        unsigned sourceOffset = offsets[i][1];
+        for (unsigned j = 0; j < WTF_ARRAY_LENGTH(lengths); ++j) {
+            unsigned length = lengths[j];
+            // Widening, where the destination runs past the end of the source.
+            expectOverlappingConversion(ArrayBufferView::TypeFloat32, destinationOffset, ArrayBufferView::TypeInt16, 2, sourceOffset, length);
+            // Narrowing, where the source runs past the end of the destination.
+            expectOverlappingConversion(ArrayBufferView::TypeUint8Clamped, destinationOffset, ArrayBufferView::TypeFloat32, 4, sourceOffset, length);
+            expectOverlappingConversion(ArrayBufferView::TypeInt8, destinationOffset, ArrayBufferView::TypeFloat64, 8, sourceOffset, length);
+            // Same size, converted value by value, and same bits, which is a move.
+            expectOverlappingConversion(ArrayBufferView::TypeFloat32, destinationOffset, ArrayBufferView::TypeInt32, 4, sourceOffset, length);
+            expectOverlappingConversion(ArrayBufferView::TypeUint32, destinationOffset, ArrayBufferView::TypeInt32, 4, sourceOffset, length);
+        }
+    }
+}
+
+} // namespace TestWebKitAPI
@@ -21,6 +21,7 @@ SOURCES += \
     StringImpl.cpp \
     StringOperators.cpp \
     TemporaryChange.cpp \
+    TypedArrayConversion.cpp \
     Vector.cpp \
     VectorBasic.cpp \
     VectorReverse.cpp \